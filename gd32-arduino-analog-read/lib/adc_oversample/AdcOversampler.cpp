@@ -0,0 +1,172 @@
+#include "AdcOversampler.h"
+
+#if defined(GD32F30x)
+#include "gd32f30x.h"
+#define ADC_OVERSAMPLE_HW 1
+#elif defined(GD32E23x)
+#include "gd32e23x.h"
+#define ADC_OVERSAMPLE_HW 1
+#endif
+
+#define ADC_BITS 12U
+
+#ifdef ADC_OVERSAMPLE_HW
+/* 55.5 cycles of the ADC clock per sample for inputs up to some 10 kOhm,
+ * plus 12.5 cycles for the conversion */
+#define SAMPLETIME ADC_SAMPLETIME_55POINT5
+#define SAMPLE_CYCLES_X2 (111U + 25U)
+
+static const uint32_t ratios[] = {ADC_OVERSAMPLING_RATIO_MUL2,  ADC_OVERSAMPLING_RATIO_MUL4,
+                                  ADC_OVERSAMPLING_RATIO_MUL8,  ADC_OVERSAMPLING_RATIO_MUL16,
+                                  ADC_OVERSAMPLING_RATIO_MUL32, ADC_OVERSAMPLING_RATIO_MUL64,
+                                  ADC_OVERSAMPLING_RATIO_MUL128, ADC_OVERSAMPLING_RATIO_MUL256};
+static const uint32_t shifts[] = {ADC_OVERSAMPLING_SHIFT_NONE, ADC_OVERSAMPLING_SHIFT_1B, ADC_OVERSAMPLING_SHIFT_2B,
+                                  ADC_OVERSAMPLING_SHIFT_3B,   ADC_OVERSAMPLING_SHIFT_4B, ADC_OVERSAMPLING_SHIFT_5B,
+                                  ADC_OVERSAMPLING_SHIFT_6B,   ADC_OVERSAMPLING_SHIFT_7B, ADC_OVERSAMPLING_SHIFT_8B};
+
+static uint8_t log2_ratio(uint16_t ratio)
+{
+  uint8_t n = 0;
+  while (ratio > 1U)
+  {
+    ratio >>= 1;
+    n++;
+  }
+  return n;
+}
+
+/* ADC clock: APB2 / 6, 20 MHz on a GD32F303 at 120 MHz, 12 MHz on a
+ * GD32E230 at 72 MHz */
+static uint32_t adc_clock(void)
+{
+  return rcu_clock_freq_get(CK_APB2) / 6U;
+}
+
+#if defined(GD32F30x)
+static void adc_hw_config(uint8_t channel, uint16_t ratio, uint8_t shift)
+{
+  rcu_periph_clock_enable(RCU_ADC0);
+  rcu_adc_clock_config(RCU_CKADC_CKAPB2_DIV6);
+  adc_deinit(ADC0);
+  adc_mode_config(ADC_MODE_FREE);
+  adc_special_function_config(ADC0, ADC_SCAN_MODE, DISABLE);
+  adc_special_function_config(ADC0, ADC_CONTINUOUS_MODE, DISABLE);
+  adc_data_alignment_config(ADC0, ADC_DATAALIGN_RIGHT);
+  adc_channel_length_config(ADC0, ADC_REGULAR_CHANNEL, 1U);
+  adc_regular_channel_config(ADC0, 0U, channel, SAMPLETIME);
+  adc_external_trigger_source_config(ADC0, ADC_REGULAR_CHANNEL, ADC0_1_2_EXTTRIG_REGULAR_NONE);
+  adc_external_trigger_config(ADC0, ADC_REGULAR_CHANNEL, ENABLE);
+  /* the oversampling is configured while the ADC is off */
+  if (ratio > 1U)
+  {
+    adc_oversample_mode_config(ADC0, ADC_OVERSAMPLING_ALL_CONVERT, shifts[shift], ratios[log2_ratio(ratio) - 1U]);
+    adc_oversample_mode_enable(ADC0);
+  }
+  adc_enable(ADC0);
+  delayMicroseconds(10);
+  adc_calibration_enable(ADC0);
+}
+
+static uint32_t adc_hw_read(void)
+{
+  adc_software_trigger_enable(ADC0, ADC_REGULAR_CHANNEL);
+  /* set after the last of the ratio conversions */
+  while (!adc_flag_get(ADC0, ADC_FLAG_EOC))
+    ;
+  adc_flag_clear(ADC0, ADC_FLAG_EOC);
+  return adc_regular_data_read(ADC0);
+}
+#else
+static void adc_hw_config(uint8_t channel, uint16_t ratio, uint8_t shift)
+{
+  rcu_periph_clock_enable(RCU_ADC);
+  rcu_adc_clock_config(RCU_ADCCK_APB2_DIV6);
+  adc_deinit();
+  adc_special_function_config(ADC_SCAN_MODE, DISABLE);
+  adc_special_function_config(ADC_CONTINUOUS_MODE, DISABLE);
+  adc_data_alignment_config(ADC_DATAALIGN_RIGHT);
+  adc_channel_length_config(ADC_REGULAR_CHANNEL, 1U);
+  adc_regular_channel_config(0U, channel, SAMPLETIME);
+  adc_external_trigger_source_config(ADC_REGULAR_CHANNEL, ADC_EXTTRIG_REGULAR_NONE);
+  adc_external_trigger_config(ADC_REGULAR_CHANNEL, ENABLE);
+  /* the oversampling is configured while the ADC is off */
+  if (ratio > 1U)
+  {
+    adc_oversample_mode_config(ADC_OVERSAMPLING_ALL_CONVERT, shifts[shift], ratios[log2_ratio(ratio) - 1U]);
+    adc_oversample_mode_enable();
+  }
+  adc_enable();
+  delayMicroseconds(10);
+  adc_calibration_enable();
+}
+
+static uint32_t adc_hw_read(void)
+{
+  adc_software_trigger_enable(ADC_REGULAR_CHANNEL);
+  /* set after the last of the ratio conversions */
+  while (!adc_flag_get(ADC_FLAG_EOC))
+    ;
+  adc_flag_clear(ADC_FLAG_EOC);
+  return adc_regular_data_read();
+}
+#endif
+#endif /* ADC_OVERSAMPLE_HW */
+
+bool AdcOversampler::begin(uint32_t pin, uint8_t channel, uint16_t ratio, uint8_t shift)
+{
+  if (adc_decimator_init(&decimator_, ratio, shift) != 0 || adc_decimator_bits(&decimator_, ADC_BITS) > 16U)
+  {
+    return false;
+  }
+  pin_ = pin;
+  /* puts the pin into analog mode */
+  analogReadResolution(ADC_BITS);
+  analogRead(pin);
+#ifdef ADC_OVERSAMPLE_HW
+  adc_hw_config(channel, ratio, shift);
+  rate_ = (uint32_t)((uint64_t)adc_clock() * 2U / ((uint64_t)SAMPLE_CYCLES_X2 * ratio));
+#else
+  (void)channel;
+  read();
+#endif
+  return true;
+}
+
+uint32_t AdcOversampler::read()
+{
+#ifdef ADC_OVERSAMPLE_HW
+  return adc_hw_read();
+#else
+  uint32_t result = 0;
+  uint32_t start = micros();
+  while (!adc_decimator_push(&decimator_, (uint16_t)analogRead(pin_), &result))
+    ;
+  uint32_t duration = micros() - start;
+  rate_ = duration != 0U ? 1000000U / duration : 0U;
+  return result;
+#endif
+}
+
+uint8_t AdcOversampler::resolution() const
+{
+  return adc_decimator_bits(&decimator_, ADC_BITS);
+}
+
+uint32_t AdcOversampler::fullScale() const
+{
+  return ((((uint32_t)1U << ADC_BITS) - 1U) * decimator_.ratio) >> decimator_.shift;
+}
+
+uint32_t AdcOversampler::rate() const
+{
+  return rate_;
+}
+
+bool AdcOversampler::hardware() const
+{
+#ifdef ADC_OVERSAMPLE_HW
+  return true;
+#else
+  return false;
+#endif
+}
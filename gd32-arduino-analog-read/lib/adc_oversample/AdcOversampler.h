@@ -0,0 +1,48 @@
+#ifndef ADC_OVERSAMPLER_H_
+#define ADC_OVERSAMPLER_H_
+
+#include <Arduino.h>
+#include "adc_decimator.h"
+
+/* Oversampled reads of one analog input with more bits than the 12-bit ADC.
+ *
+ * On the GD32F30x and GD32E23x, the oversampling unit of the ADC (ADC0 on
+ * the F30x) sums ratio conversions of the channel and shifts the sum right
+ * by shift bits in hardware: read() starts the conversions and waits for the
+ * one result, the CPU does not touch the single samples. On the other
+ * series, ratio analogRead() calls are decimated the same way in software
+ * (adc_decimator.h), with the overhead of the Arduino core per sample.
+ *
+ * The result has 12 + log2(ratio) - shift bits, at most 16. As a rule,
+ * ratio = 4^n and shift = n give n more bits: 16x and 2 bits shift give 14
+ * bits, 256x and 4 bits shift 16 bits. How many of them are effective
+ * depends on the noise at the input, see scripts/adc_oversample.py for a
+ * model of the ENOB against the result rate. */
+class AdcOversampler
+{
+public:
+  /* pin: the analog pin, channel: its ADC channel (0 .. 17), used by the
+   * hardware oversampling only. Returns false if ratio is not a power of
+   * two up to 256, shift above 8 or the result wider than 16 bits. */
+  bool begin(uint32_t pin, uint8_t channel, uint16_t ratio, uint8_t shift);
+
+  /* one oversampled result, 0 .. fullScale() */
+  uint32_t read();
+
+  /* bits of the results */
+  uint8_t resolution() const;
+  uint32_t fullScale() const;
+
+  /* results per second: computed from the ADC clock with the hardware,
+   * measured over the last read() in software */
+  uint32_t rate() const;
+
+  bool hardware() const;
+
+private:
+  uint32_t pin_ = 0;
+  adc_decimator_t decimator_ = {};
+  uint32_t rate_ = 0;
+};
+
+#endif /* ADC_OVERSAMPLER_H_ */
@@ -0,0 +1,37 @@
+#include "adc_decimator.h"
+
+int adc_decimator_init(adc_decimator_t *dec, uint16_t ratio, uint8_t shift)
+{
+  if (ratio == 0 || ratio > 256U || (ratio & (ratio - 1U)) != 0 || shift > 8U)
+  {
+    return -1;
+  }
+  dec->sum = 0;
+  dec->count = 0;
+  dec->ratio = ratio;
+  dec->shift = shift;
+  return 0;
+}
+
+int adc_decimator_push(adc_decimator_t *dec, uint16_t sample, uint32_t *result)
+{
+  dec->sum += sample;
+  if (++dec->count < dec->ratio)
+  {
+    return 0;
+  }
+  *result = dec->sum >> dec->shift;
+  dec->sum = 0;
+  dec->count = 0;
+  return 1;
+}
+
+uint8_t adc_decimator_bits(const adc_decimator_t *dec, uint8_t adc_bits)
+{
+  uint8_t bits = adc_bits;
+  for (uint16_t r = dec->ratio; r > 1U; r >>= 1)
+  {
+    bits++;
+  }
+  return (uint8_t)(bits - dec->shift);
+}
@@ -0,0 +1,38 @@
+#ifndef ADC_DECIMATOR_H_
+#define ADC_DECIMATOR_H_
+
+/* Software decimation with the arithmetic of the oversampling unit of the
+ * GD32F30x and GD32E23x ADCs: ratio samples are summed, the sum is shifted
+ * right by shift bits (truncated) and is one result. With ratio = 4^n and
+ * shift = n, the result has n bits more than the ADC; they carry information
+ * only if the input is noisy by about one LSB or more (see
+ * scripts/adc_oversample.py). Plain C, also compiled for the host model. */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+  uint32_t sum;
+  uint16_t count;
+  uint16_t ratio; /* 1 .. 256, a power of two */
+  uint8_t shift;  /* 0 .. 8 */
+} adc_decimator_t;
+
+/* 0, or -1 if ratio or shift are out of range */
+int adc_decimator_init(adc_decimator_t *dec, uint16_t ratio, uint8_t shift);
+
+/* adds a sample, returns 1 and sets *result after every ratio samples */
+int adc_decimator_push(adc_decimator_t *dec, uint16_t sample, uint32_t *result);
+
+/* bits of the results for samples of adc_bits bits */
+uint8_t adc_decimator_bits(const adc_decimator_t *dec, uint8_t adc_bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ADC_DECIMATOR_H_ */
@@ -3,6 +3,7 @@
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include <AdcOversampler.h>
 
 #define SCREEN_WIDTH 128    // OLED display width, in pixels
 #define SCREEN_HEIGHT 64    // OLED display height, in pixels
@@ -24,16 +25,27 @@ Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 #if defined(PA7) && ANALOG_PIN_SELECT == ANALOG_PIN_SELECT_PA7
 #define ANALOG_IN_PIN PA7
 #define ANALOG_IN_PIN_STR "PA7"
+#define ANALOG_IN_CHANNEL 7
 #elif ANALOG_PIN_SELECT == ANALOG_PIN_SELECT_A0
 #define ANALOG_IN_PIN A0
 #define ANALOG_IN_PIN_STR "A0"
+#define ANALOG_IN_CHANNEL 0
 #else
 #define ANALOG_IN_PIN A1
 #define ANALOG_IN_PIN_STR "A1"
+#define ANALOG_IN_CHANNEL 1
 #endif
 
-#define NUM_SAMPLES  50
-#define SAMPLE_DELAY 5
+/* samples per result and right shift of their sum: 16 samples, 2 bits shift
+ * give 14-bit results (see lib/adc_oversample) */
+#ifndef OVERSAMPLE_RATIO
+#define OVERSAMPLE_RATIO 16
+#endif
+#ifndef OVERSAMPLE_SHIFT
+#define OVERSAMPLE_SHIFT 2
+#endif
+
+AdcOversampler adc;
 
 void setup()
 {
@@ -50,26 +62,24 @@ void setup()
   display.clearDisplay();
   display.display();
   pinMode(ANALOG_IN_PIN, INPUT);
-  //default is 10-bit ADC (arduino-compatibility).
-  //change to 12-bit ADC
-  analogReadResolution(12);
+  //the 12-bit ADC, oversampled in hardware on the GD32F30x and GD32E23x
+  if (!adc.begin(ANALOG_IN_PIN, ANALOG_IN_CHANNEL, OVERSAMPLE_RATIO, OVERSAMPLE_SHIFT))
+  {
+    Serial.println(F("Invalid oversampling ratio or shift"));
+    for (;;)
+      ;
+  }
 }
 
 void loop()
 {
-  //uint32_t is large enough so that sum does not overflow
-  uint32_t sum = 0;
-  for(int i=0; i < NUM_SAMPLES; i++) {
-    uint32_t val = analogRead(ANALOG_IN_PIN);
-    sum += val;
-    delay(SAMPLE_DELAY);
-  }
-  uint32_t val = sum / NUM_SAMPLES;
-  float in_volts = val * 3.3f / 4095; //for 12-bit resolution and V_REF = 3.3V
+  uint32_t val = adc.read();
+  float in_volts = val * 3.3f / adc.fullScale(); //V_REF = 3.3V
 
   display.clearDisplay();
   display.setCursor(0, 0);
-  display.println(String(ANALOG_IN_PIN_STR) + ": " + String(val) + " (" + String(in_volts, 2) + "V)");
+  display.println(String(ANALOG_IN_PIN_STR) + ": " + String(val) + " (" + String(in_volts, 4) + "V)");
+  display.println(String(adc.resolution()) + " bit, " + String(adc.rate()) + "/s " + (adc.hardware() ? "hw" : "sw"));
   display.display();
   delay(50);
 }
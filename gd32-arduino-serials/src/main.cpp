@@ -1,4 +1,7 @@
 #include <Arduino.h>
+#ifdef SERIAL_BENCH
+#include <serial_bench.h>
+#endif
 
 #ifdef LED_BUILTIN
 #define LED LED_BUILTIN
@@ -10,8 +13,35 @@
 // Uncomment this macro to do a Serial1 <--> Serial2 bridge test
 //#define DO_BRIDGE_TEST
 
+#ifdef SERIAL_BENCH
+// Target of scripts/serial_bench.py on Serial (USB CDC or Serial1)
+static size_t bench_read(uint8_t *data, size_t len) {
+    size_t available = (size_t) Serial.available();
+    if (available < len) {
+        len = available;
+    }
+    return len ? Serial.readBytes((char*) data, len) : 0;
+}
+static void bench_write(const uint8_t *data, size_t len) {
+    Serial.write(data, len);
+}
+static void bench_set_baudrate(uint32_t baudrate) {
+    // let the reply leave at the old baud rate
+    Serial.flush();
+    Serial.begin(baudrate);
+}
+static uint32_t bench_millis() {
+    return millis();
+}
+static const serial_bench_io_t bench_io = {bench_read, bench_write, bench_set_baudrate, bench_millis};
+#endif
+
 static int i=0;
 void setup(){
+#ifdef SERIAL_BENCH
+    // no greeting, the benchmark expects only its replies
+    Serial.begin(115200);
+#else
     // Serial is a macro for Serial1 only if no USB CDC is used
     // otherwise it's the USB serial
 #if USBCON
@@ -29,12 +59,15 @@ void setup(){
 #ifdef HAVE_HWSERIAL3
     Serial3.begin(115200);
     Serial3.println("Start on Serial3!");
+#endif
 #endif
     pinMode(LED, OUTPUT);
 }
 
 void loop(){
-#if !defined(DO_BRIDGE_TEST)
+#if defined(SERIAL_BENCH)
+    serial_bench_run(&bench_io);
+#elif !defined(DO_BRIDGE_TEST)
     digitalWrite(LED, LOW);
     delay(500);
     digitalWrite(LED, HIGH);
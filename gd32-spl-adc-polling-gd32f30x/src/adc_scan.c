@@ -0,0 +1,211 @@
+#include "gd32f30x.h"
+#include "adc_scan.h"
+
+#define SCAN_TIMER TIMER2
+#define SCAN_TIMER_RCU RCU_TIMER2
+/* ADC0 requests are on DMA0 channel 0 */
+#define SCAN_DMA_ARGS DMA0, DMA_CH0
+
+static uint16_t scan_buffer[2U * ADC_SCAN_SCANS_PER_HALF * ADC_SCAN_MAX_CHANNELS];
+static uint8_t scan_channels;
+static adc_scan_callback_t scan_callback;
+static void *scan_arg;
+static uint32_t last_half_cycles;
+static volatile adc_scan_stats_t scan_stats;
+
+uint32_t adc_scan_max_sample_rate(uint32_t adc_clock_hz)
+{
+    return (uint32_t)((uint64_t)adc_clock_hz * 2U / (ADC_SCAN_SAMPLETIME_CYCLES_X2 + ADC_SCAN_CONVERSION_CYCLES_X2));
+}
+
+/* TIMER2 is on APB1, its clock is doubled if the APB1 is divided */
+static uint32_t timer_clock(void)
+{
+    uint32_t clock = rcu_clock_freq_get(CK_APB1);
+    return ((RCU_CFG0 & RCU_CFG0_APB1PSC) == RCU_APB1_CKAHB_DIV1) ? clock : 2U * clock;
+}
+
+/* TIMER2 updates scan_rate_hz times per second, the update is the TRGO */
+static uint32_t timer_config(uint32_t scan_rate_hz)
+{
+    timer_parameter_struct timer;
+    uint32_t clock = timer_clock();
+    uint32_t ticks = clock / scan_rate_hz;
+    uint32_t prescaler = (ticks - 1U) / 0x10000U;
+    uint32_t period = ticks / (prescaler + 1U);
+
+    rcu_periph_clock_enable(SCAN_TIMER_RCU);
+    timer_deinit(SCAN_TIMER);
+    timer.prescaler = (uint16_t)prescaler;
+    timer.alignedmode = TIMER_COUNTER_EDGE;
+    timer.counterdirection = TIMER_COUNTER_UP;
+    timer.period = period - 1U;
+    timer.clockdivision = TIMER_CKDIV_DIV1;
+    timer.repetitioncounter = 0;
+    timer_init(SCAN_TIMER, &timer);
+    timer_master_output_trigger_source_select(SCAN_TIMER, TIMER_TRI_OUT_SRC_UPDATE);
+    return clock / ((prescaler + 1U) * period);
+}
+
+static void dma_config(uint32_t number)
+{
+    dma_parameter_struct dma_init_struct;
+
+    rcu_periph_clock_enable(RCU_DMA0);
+    dma_deinit(SCAN_DMA_ARGS);
+    dma_init_struct.direction = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.memory_addr = (uint32_t)scan_buffer;
+    dma_init_struct.memory_inc = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_16BIT;
+    dma_init_struct.number = number;
+    dma_init_struct.periph_addr = (uint32_t)&ADC_RDATA(ADC0);
+    dma_init_struct.periph_inc = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_16BIT;
+    dma_init_struct.priority = DMA_PRIORITY_HIGH;
+    dma_init(SCAN_DMA_ARGS, &dma_init_struct);
+    dma_circulation_enable(SCAN_DMA_ARGS);
+    dma_memory_to_memory_disable(SCAN_DMA_ARGS);
+    dma_interrupt_enable(SCAN_DMA_ARGS, DMA_INT_HTF | DMA_INT_FTF);
+    dma_channel_enable(SCAN_DMA_ARGS);
+
+    NVIC_SetPriority(DMA0_Channel0_IRQn, 1U);
+    NVIC_EnableIRQ(DMA0_Channel0_IRQn);
+}
+
+static void adc_scan_config(const uint8_t *channels, uint8_t count)
+{
+    adc_deinit(ADC0);
+    adc_mode_config(ADC_MODE_FREE);
+    adc_data_alignment_config(ADC0, ADC_DATAALIGN_RIGHT);
+    /* one trigger converts the whole group, no continuous conversion */
+    adc_special_function_config(ADC0, ADC_SCAN_MODE, ENABLE);
+    adc_special_function_config(ADC0, ADC_CONTINUOUS_MODE, DISABLE);
+    adc_channel_length_config(ADC0, ADC_REGULAR_CHANNEL, count);
+    for (uint8_t rank = 0; rank < count; rank++)
+    {
+        adc_regular_channel_config(ADC0, rank, channels[rank], ADC_SCAN_SAMPLETIME);
+    }
+    adc_external_trigger_source_config(ADC0, ADC_REGULAR_CHANNEL, ADC0_1_EXTTRIG_REGULAR_T2_TRGO);
+    adc_external_trigger_config(ADC0, ADC_REGULAR_CHANNEL, ENABLE);
+    adc_dma_mode_enable(ADC0);
+
+    adc_enable(ADC0);
+    /* at least 14 ADC clocks between enabling and the calibration */
+    uint32_t start = DWT->CYCCNT;
+    while (DWT->CYCCNT - start < SystemCoreClock / 100000U)
+        ;
+    adc_calibration_enable(ADC0);
+}
+
+int adc_scan_init(const uint8_t *channels, uint8_t count, uint32_t scan_rate_hz, uint32_t adc_clock_hz,
+                  adc_scan_callback_t callback, void *arg)
+{
+    if (count == 0 || count > ADC_SCAN_MAX_CHANNELS || scan_rate_hz == 0 ||
+        (uint64_t)scan_rate_hz * count > adc_scan_max_sample_rate(adc_clock_hz))
+    {
+        return -1;
+    }
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    scan_channels = count;
+    scan_callback = callback;
+    scan_arg = arg;
+    adc_scan_config(channels, count);
+    dma_config(2U * ADC_SCAN_SCANS_PER_HALF * count);
+    uint32_t rate = timer_config(scan_rate_hz);
+    adc_scan_reset_stats();
+    scan_stats.scan_rate_hz = rate;
+    scan_stats.expected_interval = (uint32_t)((uint64_t)SystemCoreClock * ADC_SCAN_SCANS_PER_HALF / rate);
+    return 0;
+}
+
+void adc_scan_start(void)
+{
+    last_half_cycles = DWT->CYCCNT;
+    timer_enable(SCAN_TIMER);
+}
+
+void adc_scan_stop(void)
+{
+    timer_disable(SCAN_TIMER);
+}
+
+void adc_scan_get_stats(adc_scan_stats_t *stats)
+{
+    __disable_irq();
+    *stats = scan_stats;
+    __enable_irq();
+}
+
+void adc_scan_reset_stats(void)
+{
+    __disable_irq();
+    uint32_t rate = scan_stats.scan_rate_hz;
+    uint32_t expected = scan_stats.expected_interval;
+    scan_stats = (adc_scan_stats_t){0};
+    scan_stats.scan_rate_hz = rate;
+    scan_stats.expected_interval = expected;
+    scan_stats.interval_min = UINT32_MAX;
+    __enable_irq();
+}
+
+/* the timing of the half that just completed */
+static void half_timing(uint32_t now)
+{
+    uint32_t interval = now - last_half_cycles;
+    last_half_cycles = now;
+    /* the first half after the start or a reset includes the start */
+    if (scan_stats.halves != 0)
+    {
+        scan_stats.cycles += interval;
+        if (interval < scan_stats.interval_min)
+        {
+            scan_stats.interval_min = interval;
+        }
+        if (interval > scan_stats.interval_max)
+        {
+            scan_stats.interval_max = interval;
+        }
+    }
+    scan_stats.halves++;
+}
+
+void DMA0_Channel0_IRQHandler(void)
+{
+    uint32_t entry = DWT->CYCCNT;
+    uint32_t number = 2U * ADC_SCAN_SCANS_PER_HALF * scan_channels;
+    const uint16_t *half;
+    int first;
+
+    if (dma_interrupt_flag_get(SCAN_DMA_ARGS, DMA_INT_FLAG_HTF))
+    {
+        dma_interrupt_flag_clear(SCAN_DMA_ARGS, DMA_INT_FLAG_HTF);
+        half = scan_buffer;
+        first = 1;
+    }
+    else if (dma_interrupt_flag_get(SCAN_DMA_ARGS, DMA_INT_FLAG_FTF))
+    {
+        dma_interrupt_flag_clear(SCAN_DMA_ARGS, DMA_INT_FLAG_FTF);
+        half = &scan_buffer[number / 2U];
+        first = 0;
+    }
+    else
+    {
+        return;
+    }
+    half_timing(entry);
+    if (scan_callback != NULL)
+    {
+        scan_callback(half, ADC_SCAN_SCANS_PER_HALF, scan_arg);
+    }
+    /* the DMA should still be in the other half; the counter counts down
+     * from number and is reloaded after the last sample */
+    uint32_t remaining = dma_transfer_number_get(SCAN_DMA_ARGS);
+    int dma_in_first = remaining > number / 2U;
+    if (dma_in_first == first)
+    {
+        scan_stats.overruns++;
+    }
+    scan_stats.isr_cycles += DWT->CYCCNT - entry;
+}
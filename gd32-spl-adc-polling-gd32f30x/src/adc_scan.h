@@ -0,0 +1,74 @@
+#ifndef ADC_SCAN_H_
+#define ADC_SCAN_H_
+
+/* Continuous acquisition with ADC0: the regular channel group is converted
+ * in scan mode, one scan of all channels per update of TIMER2 (TRGO), and
+ * DMA0 channel 0 moves the results into a double buffer in circular mode.
+ * The CPU is not involved per sample: the half and full transfer interrupts
+ * hand one half of the buffer (ADC_SCAN_SCANS_PER_HALF scans) to a callback
+ * while the DMA fills the other half.
+ *
+ * The sampling instants are set by the timer in hardware. What the software
+ * sees is the arrival of the halves, whose intervals are measured with the
+ * DWT cycle counter: their jitter is the interrupt latency, their average
+ * gives the real scan rate. A trigger that comes while the previous scan is
+ * still converting is ignored by the ADC, then the measured rate stays below
+ * the configured one. A callback that takes longer than one half lets the
+ * DMA overwrite the half it is reading, this is counted as an overrun. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* scans per half of the double buffer, i.e. per callback */
+#ifndef ADC_SCAN_SCANS_PER_HALF
+#define ADC_SCAN_SCANS_PER_HALF 16U
+#endif
+/* length of the regular sequence of the ADC */
+#define ADC_SCAN_MAX_CHANNELS 16U
+/* sample time of every channel and twice the cycles of the ADC clock it
+ * takes, to be changed together */
+#ifndef ADC_SCAN_SAMPLETIME
+#define ADC_SCAN_SAMPLETIME ADC_SAMPLETIME_7POINT5
+#endif
+#ifndef ADC_SCAN_SAMPLETIME_CYCLES_X2
+#define ADC_SCAN_SAMPLETIME_CYCLES_X2 15U
+#endif
+/* 12.5 cycles of the ADC clock for the conversion itself */
+#define ADC_SCAN_CONVERSION_CYCLES_X2 25U
+
+/* samples[scan * channels + rank] of scans in a row, called from the DMA
+ * interrupt */
+typedef void (*adc_scan_callback_t)(const uint16_t *samples, size_t scans, void *arg);
+
+typedef struct
+{
+    uint32_t scan_rate_hz;      /* timer clock / timer period, may differ from the requested rate */
+    uint32_t halves;            /* callbacks */
+    uint32_t overruns;          /* callbacks that were still reading when the DMA came back */
+    uint64_t cycles;            /* CPU cycles between the first and the last half */
+    uint64_t isr_cycles;        /* in the interrupt, including the callback */
+    uint32_t expected_interval; /* cycles per half at scan_rate_hz */
+    uint32_t interval_min;      /* cycles between two halves */
+    uint32_t interval_max;
+} adc_scan_stats_t;
+
+/* configures ADC0, TIMER2 and the DMA for a scan of count channels
+ * (ADC_CHANNEL_x) scan_rate_hz times per second. The ADC clock must be
+ * configured (rcu_adc_clock_config()) and the pins in analog mode. Returns 0,
+ * or -1 if the scans would not fit between the triggers at adc_clock_hz or
+ * the count is invalid. */
+int adc_scan_init(const uint8_t *channels, uint8_t count, uint32_t scan_rate_hz, uint32_t adc_clock_hz,
+                  adc_scan_callback_t callback, void *arg);
+
+/* starts and stops the timer, the DMA keeps its position */
+void adc_scan_start(void);
+void adc_scan_stop(void);
+
+void adc_scan_get_stats(adc_scan_stats_t *stats);
+void adc_scan_reset_stats(void);
+
+/* highest aggregate sample rate of the ADC in scan mode: every sample takes
+ * the sample time plus 12.5 cycles of the ADC clock */
+uint32_t adc_scan_max_sample_rate(uint32_t adc_clock_hz);
+
+#endif /* ADC_SCAN_H_ */
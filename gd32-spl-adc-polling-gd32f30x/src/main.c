@@ -27,10 +27,20 @@ OF SUCH DAMAGE.
 
 /* 
  * Sets pins PA1 to PA8 in ADC input mode, measures them and prints them via USART0.
+ * With ADC_SCAN, the channels are sampled continuously by a timer triggered
+ * scan with DMA (adc_scan.h) instead of one by one.
 **/
 
 #include "gd32f30x.h"
 #include <stdio.h>
+#ifdef ADC_SCAN
+#include "adc_scan.h"
+
+/* scans of all 8 channels per second */
+#ifndef ADC_SCAN_RATE_HZ
+#define ADC_SCAN_RATE_HZ 10000U
+#endif
+#endif
 
 void systick_config(void);
 void delay_1ms(uint32_t count);
@@ -41,6 +51,10 @@ void rcu_config(void);
 void gpio_config(void);
 void adc_config(void);
 uint16_t adc_channel_sample(uint8_t channel);
+#ifdef ADC_SCAN
+void adc_scan_average(const uint16_t *samples, size_t scans, void *arg);
+void print_scan_stats(void);
+#endif
 
 /*!
     \brief      main function
@@ -56,8 +70,13 @@ int main(void)
     systick_config();  
     /* GPIO configuration */
     gpio_config();
+    /* cycle counter for the comparison of polling and scan */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#ifndef ADC_SCAN
     /* ADC configuration */
     adc_config();
+#endif
     /* USART configuration */
     rcu_periph_clock_enable(RCU_GPIOA);
     rcu_periph_clock_enable(RCU_USART0);
@@ -69,7 +88,26 @@ int main(void)
     usart_transmit_config(USART0, USART_TRANSMIT_ENABLE);
     usart_enable(USART0);
 
+#ifdef ADC_SCAN
+    static const uint8_t channels[8] = {ADC_CHANNEL_1, ADC_CHANNEL_2, ADC_CHANNEL_3, ADC_CHANNEL_4,
+                                        ADC_CHANNEL_5, ADC_CHANNEL_6, ADC_CHANNEL_7, ADC_CHANNEL_8};
+    /* the ADC clock is APB2 / 6, see rcu_config() */
+    uint32_t adc_clock = rcu_clock_freq_get(CK_APB2) / 6U;
+    if (adc_scan_init(channels, 8U, ADC_SCAN_RATE_HZ, adc_clock, adc_scan_average, NULL) != 0)
+    {
+        printf("ADC scan: %lu scans/s of 8 channels exceed %lu samples/s\n", (unsigned long)ADC_SCAN_RATE_HZ,
+               (unsigned long)adc_scan_max_sample_rate(adc_clock));
+        while (1)
+            ;
+    }
+    adc_scan_start();
+#endif
+
     while(1){
+#ifdef ADC_SCAN
+        /* adc_value is updated by adc_scan_average() in the DMA interrupt */
+#else
+        uint32_t start = DWT->CYCCNT;
         adc_value[0]=adc_channel_sample(ADC_CHANNEL_1);
         adc_value[1]=adc_channel_sample(ADC_CHANNEL_2);
         adc_value[2]=adc_channel_sample(ADC_CHANNEL_3);
@@ -78,11 +116,20 @@ int main(void)
         adc_value[5]=adc_channel_sample(ADC_CHANNEL_6);
         adc_value[6]=adc_channel_sample(ADC_CHANNEL_7);
         adc_value[7]=adc_channel_sample(ADC_CHANNEL_8);
+        uint32_t cycles = DWT->CYCCNT - start;
+#endif
 
         //print 16-bit ADC values and convert to voltage (VRef = 3.3V)
         for(int i=0; i < (int)sizeof(adc_value)/sizeof(adc_value[0]); i++) {
             printf("ADC0 channel %d (PA%d): %d (%1.2fV)\n", i+1, i+1, adc_value[i], adc_value[i] * 3.3f / 4095.f);
         }
+#ifdef ADC_SCAN
+        print_scan_stats();
+#else
+        /* the CPU waits for every conversion */
+        printf("polling: 8 samples in %lu cycles, at most %lu samples/s with the CPU busy\n", (unsigned long)cycles,
+               (unsigned long)((uint64_t)SystemCoreClock * 8U / cycles));
+#endif
         printf("\n");
         delay_1ms(500);
     }
@@ -172,6 +219,58 @@ uint16_t adc_channel_sample(uint8_t channel)
     return (adc_regular_data_read(ADC0));
 }
 
+#ifdef ADC_SCAN
+/*!
+    \brief      average of every channel over one half of the DMA buffer
+    \param[in]  samples: scans of the 8 channels
+    \param[in]  scans: number of scans
+    \param[in]  arg: unused
+    \param[out] none
+    \retval     none
+*/
+void adc_scan_average(const uint16_t *samples, size_t scans, void *arg)
+{
+    (void)arg;
+    for (size_t channel = 0; channel < 8U; channel++)
+    {
+        uint32_t sum = 0;
+        for (size_t scan = 0; scan < scans; scan++)
+        {
+            sum += samples[scan * 8U + channel];
+        }
+        adc_value[channel] = (uint16_t)((sum + scans / 2U) / scans);
+    }
+}
+
+/*!
+    \brief      print and reset the rate, CPU load and jitter of the scan
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void print_scan_stats(void)
+{
+    adc_scan_stats_t stats;
+    adc_scan_get_stats(&stats);
+    adc_scan_reset_stats();
+    if (stats.halves < 2U || stats.cycles == 0U)
+    {
+        return;
+    }
+    uint64_t scans = (uint64_t)(stats.halves - 1U) * ADC_SCAN_SCANS_PER_HALF;
+    uint32_t measured = (uint32_t)(scans * SystemCoreClock / stats.cycles);
+    /* deviation of the halves from the timer, i.e. the interrupt latency */
+    long early = (long)stats.expected_interval - (long)stats.interval_min;
+    long late = (long)stats.interval_max - (long)stats.expected_interval;
+    printf("scan: %lu scans/s (%lu samples/s), measured %lu scans/s, ADC maximum %lu samples/s\n",
+           (unsigned long)stats.scan_rate_hz, (unsigned long)stats.scan_rate_hz * 8U, (unsigned long)measured,
+           (unsigned long)adc_scan_max_sample_rate(rcu_clock_freq_get(CK_APB2) / 6U));
+    printf("CPU %.3f%% in the interrupt, %lu cycles per half, jitter %ld/+%ld cycles, %lu overruns\n",
+           (double)stats.isr_cycles * 100.0 / (double)stats.cycles, (unsigned long)stats.expected_interval,
+           -early, late, (unsigned long)stats.overruns);
+}
+#endif
+
 /* retarget the gcc's C library printf function to the USART */
 #include  <errno.h>
 #include  <sys/unistd.h> // STDOUT_FILENO, STDERR_FILENO
@@ -0,0 +1,208 @@
+/* Host-side accuracy harness for the CMSIS-DSP kernels used in the firmware.
+ * Runs every kernel over a large set of random inputs and compares the result
+ * against a double precision reference. Prints one CSV line per kernel:
+ *   kernel,variant,samples,max_abs_err,rms_err,max_ulp,mean_ulp,ulp_0,ulp_1,
+ *   ulp_2,ulp_3_4,ulp_5_16,ulp_17_256,ulp_gt_256
+ * This file must NOT be compiled with -ffast-math, see dsp_accuracy.py. */
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dsp_kernels.h"
+
+#ifdef __FAST_MATH__
+#error "the reference must be compiled without -ffast-math"
+#endif
+
+#define BLOCK_SIZE 32
+#define NUM_ULP_BUCKETS 7
+#define PI 3.14159265358979323846
+
+typedef enum
+{
+    REF_SIN,
+    REF_COS,
+    REF_SQRT,
+    REF_MULT,
+    REF_ADD,
+    REF_DOT_PROD,
+    REF_RMS,
+} ref_op_t;
+
+typedef struct
+{
+    const char *name;
+    dsp_kernel_fn kernel;
+    ref_op_t op;
+    int is_reduction; /* one output per block instead of one per sample */
+    double lo, hi;    /* range of the random input values */
+} kernel_desc_t;
+
+static const kernel_desc_t kernels[] = {
+    {"arm_sin_f32", kernel_sin_f32, REF_SIN, 0, -4.0 * PI, 4.0 * PI},
+    {"arm_cos_f32", kernel_cos_f32, REF_COS, 0, -4.0 * PI, 4.0 * PI},
+    {"arm_sqrt_f32", kernel_sqrt_f32, REF_SQRT, 0, 0.0, 1.0e6},
+    {"arm_mult_f32", kernel_mult_f32, REF_MULT, 0, -1.0e3, 1.0e3},
+    {"arm_add_f32", kernel_add_f32, REF_ADD, 0, -1.0e3, 1.0e3},
+    {"arm_dot_prod_f32", kernel_dot_prod_f32, REF_DOT_PROD, 1, -1.0, 1.0},
+    {"arm_rms_f32", kernel_rms_f32, REF_RMS, 1, -1.0, 1.0},
+};
+
+typedef struct
+{
+    uint64_t count;
+    double max_abs_err;
+    double sum_sq_err;
+    uint64_t max_ulp;
+    double sum_ulp;
+    uint64_t ulp_buckets[NUM_ULP_BUCKETS];
+} error_stats_t;
+
+/* xorshift64*, deterministic for a given seed on every host */
+static uint64_t rng_state;
+
+static double rng_uniform(double lo, double hi)
+{
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    uint64_t r = rng_state * 0x2545F4914F6CDD1DULL;
+    return lo + (hi - lo) * ((double)(r >> 11) * (1.0 / 9007199254740992.0));
+}
+
+/* maps a float onto a monotonic integer line so that the difference of two
+ * mapped values is their distance in units in the last place (ULP) */
+static int64_t float_to_ordered(float f)
+{
+    int32_t i;
+    memcpy(&i, &f, sizeof(i));
+    return (i < 0) ? (int64_t)INT32_MIN - (int64_t)i : (int64_t)i;
+}
+
+static uint64_t ulp_distance(float value, double reference)
+{
+    if (isnan(value) || isinf(value))
+        return UINT64_MAX;
+    int64_t d = float_to_ordered(value) - float_to_ordered((float)reference);
+    return (uint64_t)(d < 0 ? -d : d);
+}
+
+static int ulp_bucket(uint64_t ulp)
+{
+    if (ulp == 0) return 0;
+    if (ulp == 1) return 1;
+    if (ulp == 2) return 2;
+    if (ulp <= 4) return 3;
+    if (ulp <= 16) return 4;
+    if (ulp <= 256) return 5;
+    return 6;
+}
+
+static void stats_add(error_stats_t *s, float value, double reference)
+{
+    double err = fabs((double)value - reference);
+    uint64_t ulp = ulp_distance(value, reference);
+    if (isnan(err) || err > s->max_abs_err)
+        s->max_abs_err = isnan(err) ? INFINITY : err;
+    s->sum_sq_err += err * err;
+    if (ulp > s->max_ulp)
+        s->max_ulp = ulp;
+    s->sum_ulp += (double)ulp;
+    s->ulp_buckets[ulp_bucket(ulp)]++;
+    s->count++;
+}
+
+static double reference_element(ref_op_t op, float a, float b)
+{
+    switch (op)
+    {
+    case REF_SIN: return sin((double)a);
+    case REF_COS: return cos((double)a);
+    case REF_SQRT: return sqrt((double)a);
+    case REF_MULT: return (double)a * (double)b;
+    case REF_ADD: return (double)a + (double)b;
+    default: return NAN;
+    }
+}
+
+static double reference_reduction(ref_op_t op, const float *a, const float *b, uint32_t n)
+{
+    double acc = 0.0;
+    for (uint32_t i = 0; i < n; i++)
+        acc += (op == REF_DOT_PROD) ? (double)a[i] * (double)b[i] : (double)a[i] * (double)a[i];
+    return (op == REF_RMS) ? sqrt(acc / n) : acc;
+}
+
+static void run_kernel(const kernel_desc_t *k, uint64_t samples, uint64_t seed, error_stats_t *s)
+{
+    float a[BLOCK_SIZE], b[BLOCK_SIZE], out[BLOCK_SIZE];
+    uint64_t done = 0;
+
+    memset(s, 0, sizeof(*s));
+    rng_state = seed ? seed : 1;
+    while (done < samples)
+    {
+        for (uint32_t i = 0; i < BLOCK_SIZE; i++)
+        {
+            a[i] = (float)rng_uniform(k->lo, k->hi);
+            b[i] = (float)rng_uniform(k->lo, k->hi);
+        }
+        k->kernel(a, b, out, BLOCK_SIZE);
+        if (k->is_reduction)
+        {
+            stats_add(s, out[0], reference_reduction(k->op, a, b, BLOCK_SIZE));
+            done++;
+        }
+        else
+        {
+            for (uint32_t i = 0; i < BLOCK_SIZE; i++)
+                stats_add(s, out[i], reference_element(k->op, a[i], b[i]));
+            done += BLOCK_SIZE;
+        }
+    }
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr, "usage: %s [--samples N] [--seed S] [--kernel NAME]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t samples = 1000000;
+    uint64_t seed = 0x6d3a2f5b1c0e9487ULL;
+    const char *only = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--samples") && i + 1 < argc)
+            samples = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = strtoull(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--kernel") && i + 1 < argc)
+            only = argv[++i];
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    printf("kernel,variant,samples,max_abs_err,rms_err,max_ulp,mean_ulp,"
+           "ulp_0,ulp_1,ulp_2,ulp_3_4,ulp_5_16,ulp_17_256,ulp_gt_256\n");
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+        error_stats_t s;
+        if (only && strcmp(only, kernels[k].name))
+            continue;
+        run_kernel(&kernels[k], samples, seed, &s);
+        printf("%s,%s,%llu,%.9g,%.9g,%llu,%.4f", kernels[k].name, dsp_kernels_variant,
+               (unsigned long long)s.count, s.max_abs_err, sqrt(s.sum_sq_err / s.count),
+               (unsigned long long)s.max_ulp, s.sum_ulp / s.count);
+        for (int b = 0; b < NUM_ULP_BUCKETS; b++)
+            printf(",%llu", (unsigned long long)s.ulp_buckets[b]);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Host-side accuracy/performance harness for the CMSIS-DSP kernels.
+
+Compiles the CMSIS-DSP sources used by the firmware for the host, once with
+and once without -ffast-math, runs both against a double precision reference
+(see dsp_accuracy.c) and prints the error statistics side by side.
+
+If benchmark CSV output of the firmware (build with -DDSP_BENCHMARK) is given
+via --bench, the cycle counts measured on the target are merged in and a
+per-kernel recommendation for the compiler flags is printed.
+
+Example:
+    python3 host/dsp_accuracy.py --bench bench_precise.txt --bench bench_fast.txt
+"""
+import argparse
+import csv
+import io
+import os
+import shutil
+import subprocess
+import sys
+from os.path import abspath, dirname, expanduser, isdir, join
+
+HOST_DIR = dirname(abspath(__file__))
+DEFAULT_CMSIS_DSP = join(expanduser("~"), ".platformio", "packages", "framework-spl-gd32",
+                         "gd32", "cmsis", "libraries", "cmsis_dsp_from_source")
+CMSIS_SOURCES = [
+    "arm_sin_f32.c", "arm_cos_f32.c", "arm_common_tables.c",
+    "arm_mult_f32.c", "arm_add_f32.c", "arm_dot_prod_f32.c", "arm_rms_f32.c",
+]
+VARIANTS = {
+    "precise": [],
+    "fast-math": ["-ffast-math"],
+}
+
+
+def find_cmsis_dsp(root):
+    """returns (include dirs, source files) of the CMSIS-DSP tree at root"""
+    include_dirs = set()
+    sources = {}
+    for dirpath, _, filenames in os.walk(root):
+        for f in filenames:
+            if f.startswith("arm_") and f.endswith(".h"):
+                include_dirs.add(dirpath)
+            if f in CMSIS_SOURCES and f not in sources:
+                sources[f] = join(dirpath, f)
+    missing = [f for f in CMSIS_SOURCES if f not in sources]
+    if missing:
+        sys.exit("error: CMSIS-DSP sources not found in %s: %s" % (root, ", ".join(missing)))
+    return sorted(include_dirs), [sources[f] for f in CMSIS_SOURCES]
+
+
+def run(cmd):
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("error: command failed: %s\n%s" % (" ".join(cmd), result.stdout))
+    return result.stdout
+
+
+def build_variant(args, variant, include_dirs, sources):
+    build_dir = join(args.build_dir, variant)
+    os.makedirs(build_dir, exist_ok=True)
+    common = ["-O2", "-std=gnu11", "-D__GNUC_PYTHON__"] + args.cflags
+    common += ["-I" + d for d in include_dirs + [HOST_DIR]]
+    objects = []
+    # kernels and CMSIS-DSP get the flags of the variant
+    for src in sources + [join(HOST_DIR, "dsp_kernels.c")]:
+        obj = join(build_dir, os.path.basename(src) + ".o")
+        run([args.cc, "-c", src, "-o", obj] + common + VARIANTS[variant])
+        objects.append(obj)
+    # the reference is always compiled without -ffast-math
+    obj = join(build_dir, "dsp_accuracy.c.o")
+    run([args.cc, "-c", join(HOST_DIR, "dsp_accuracy.c"), "-o", obj] + common)
+    objects.append(obj)
+    # link without -ffast-math, otherwise crtfastmath.o would switch
+    # the host FPU to flush-to-zero mode for the reference, too.
+    exe = join(build_dir, "dsp_accuracy")
+    run([args.cc, "-o", exe] + objects + ["-lm"])
+    return exe
+
+
+def parse_csv(text):
+    rows = []
+    for row in csv.DictReader(io.StringIO(text)):
+        rows.append(row)
+    return rows
+
+
+def load_bench(paths):
+    """reads the firmware's benchmark output, returns {(kernel, variant): cycles_per_sample}"""
+    bench = {}
+    for path in paths:
+        with open(path) as f:
+            for line in f:
+                fields = line.strip().split(",")
+                if len(fields) != 5 or fields[1] not in VARIANTS:
+                    continue  # other firmware output or the CSV header
+                kernel, variant, block_size, _, cycles = fields
+                bench[(kernel, variant)] = float(cycles) / float(block_size)
+    return bench
+
+
+def recommend(acc_precise, acc_fast, cyc_precise, cyc_fast, args):
+    abs_increase = float(acc_fast["max_abs_err"]) - float(acc_precise["max_abs_err"])
+    if abs_increase > args.max_abs_err_increase:
+        return "precise", "fast-math adds %g abs. error" % abs_increase
+    ulp_increase = int(acc_fast["max_ulp"]) - int(acc_precise["max_ulp"])
+    if ulp_increase > args.max_ulp_increase:
+        return "precise", "fast-math loses %d ULP" % ulp_increase
+    if cyc_precise is None or cyc_fast is None:
+        return "fast-math", "no worse accuracy (no cycle data)"
+    if cyc_fast >= cyc_precise:
+        return "precise", "fast-math not faster on target"
+    return "fast-math", "%.1f%% fewer cycles" % (100.0 * (cyc_precise - cyc_fast) / cyc_precise)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--cmsis-dsp", default=DEFAULT_CMSIS_DSP,
+                        help="CMSIS-DSP source tree (default: the one of the SPL package)")
+    parser.add_argument("--cc", default=os.environ.get("CC", "gcc"), help="host C compiler")
+    parser.add_argument("--cflags", action="append", default=[],
+                        help="additional compiler flags for all variants")
+    parser.add_argument("--build-dir", default=join(HOST_DIR, ".build"))
+    parser.add_argument("--samples", type=int, default=1000000)
+    parser.add_argument("--seed", default="0x6d3a2f5b1c0e9487")
+    parser.add_argument("--bench", action="append", default=[],
+                        help="captured serial output of a DSP_BENCHMARK firmware (repeatable)")
+    parser.add_argument("--max-abs-err-increase", type=float, default=1e-4,
+                        help="maximum tolerated increase of the max. absolute error by fast-math "
+                             "(default: DELTA of the firmware test)")
+    parser.add_argument("--max-ulp-increase", type=int, default=2,
+                        help="maximum tolerated increase of the max. ULP error by fast-math")
+    parser.add_argument("--csv", help="also write the merged results to this CSV file")
+    args = parser.parse_args()
+
+    if not isdir(args.cmsis_dsp):
+        sys.exit("error: CMSIS-DSP not found at %s, use --cmsis-dsp" % args.cmsis_dsp)
+    if shutil.which(args.cc) is None:
+        sys.exit("error: host compiler %s not found" % args.cc)
+    include_dirs, sources = find_cmsis_dsp(args.cmsis_dsp)
+
+    acc = {}
+    for variant in VARIANTS:
+        exe = build_variant(args, variant, include_dirs, sources)
+        out = run([exe, "--samples", str(args.samples), "--seed", args.seed])
+        for row in parse_csv(out):
+            acc[(row["kernel"], variant)] = row
+    bench = load_bench(args.bench)
+
+    kernels = [k for (k, v) in acc if v == "precise"]
+    header = ["kernel", "max_abs_err_precise", "max_abs_err_fast", "rms_err_precise", "rms_err_fast",
+              "max_ulp_precise", "max_ulp_fast", "cycles_per_sample_precise",
+              "cycles_per_sample_fast", "recommended", "reason"]
+    rows = []
+    for k in kernels:
+        p, f = acc[(k, "precise")], acc[(k, "fast-math")]
+        cp, cf = bench.get((k, "precise")), bench.get((k, "fast-math"))
+        choice, reason = recommend(p, f, cp, cf, args)
+        rows.append([k, p["max_abs_err"], f["max_abs_err"], p["rms_err"], f["rms_err"],
+                     p["max_ulp"], f["max_ulp"],
+                     "-" if cp is None else "%.2f" % cp, "-" if cf is None else "%.2f" % cf,
+                     choice, reason])
+
+    widths = [max(len(str(r[i])) for r in rows + [header]) for i in range(len(header))]
+    for r in [header] + rows:
+        print("  ".join(str(c).ljust(w) for c, w in zip(r, widths)).rstrip())
+
+    print("\nULP distribution (0 / 1 / 2 / 3-4 / 5-16 / 17-256 / >256):")
+    buckets = ["ulp_0", "ulp_1", "ulp_2", "ulp_3_4", "ulp_5_16", "ulp_17_256", "ulp_gt_256"]
+    for k in kernels:
+        for variant in VARIANTS:
+            row = acc[(k, variant)]
+            total = float(row["samples"])
+            dist = " / ".join("%.3f%%" % (100.0 * int(row[b]) / total) for b in buckets)
+            print("  %-18s %-10s %s" % (k, variant, dist))
+
+    fast = [r[0] for r in rows if r[9] == "fast-math"]
+    print("\nKernels that can use -ffast-math: %s" % (", ".join(fast) if fast else "none"))
+
+    if args.csv:
+        with open(args.csv, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(header)
+            writer.writerows(rows)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+#include "arm_math.h"
+#include "dsp_kernels.h"
+
+#ifdef __FAST_MATH__
+const char *const dsp_kernels_variant = "fast-math";
+#else
+const char *const dsp_kernels_variant = "precise";
+#endif
+
+void kernel_sin_f32(const float *a, const float *b, float *out, uint32_t n)
+{
+    (void)b;
+    for (uint32_t i = 0; i < n; i++)
+        out[i] = arm_sin_f32(a[i]);
+}
+
+void kernel_cos_f32(const float *a, const float *b, float *out, uint32_t n)
+{
+    (void)b;
+    for (uint32_t i = 0; i < n; i++)
+        out[i] = arm_cos_f32(a[i]);
+}
+
+void kernel_sqrt_f32(const float *a, const float *b, float *out, uint32_t n)
+{
+    (void)b;
+    /* arm_sqrt_f32() is an inline function in the header, so it is compiled
+     * with the flags of this file. */
+    for (uint32_t i = 0; i < n; i++)
+        arm_sqrt_f32(a[i], &out[i]);
+}
+
+void kernel_mult_f32(const float *a, const float *b, float *out, uint32_t n)
+{
+    arm_mult_f32(a, b, out, n);
+}
+
+void kernel_add_f32(const float *a, const float *b, float *out, uint32_t n)
+{
+    arm_add_f32(a, b, out, n);
+}
+
+void kernel_dot_prod_f32(const float *a, const float *b, float *out, uint32_t n)
+{
+    arm_dot_prod_f32(a, b, n, out);
+}
+
+void kernel_rms_f32(const float *a, const float *b, float *out, uint32_t n)
+{
+    (void)b;
+    arm_rms_f32(a, n, out);
+}
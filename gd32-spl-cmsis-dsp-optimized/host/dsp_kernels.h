@@ -0,0 +1,25 @@
+#ifndef DSP_KERNELS_H_
+#define DSP_KERNELS_H_
+
+#include <stdint.h>
+
+/* Thin wrappers around the CMSIS-DSP kernels under test.
+ * This file and the CMSIS-DSP sources are compiled once per variant
+ * (with and without -ffast-math), the rest of the harness is always
+ * compiled without it so that the double precision reference stays exact. */
+
+/* element-wise kernels write n outputs, reductions write exactly one output */
+typedef void (*dsp_kernel_fn)(const float *a, const float *b, float *out, uint32_t n);
+
+void kernel_sin_f32(const float *a, const float *b, float *out, uint32_t n);
+void kernel_cos_f32(const float *a, const float *b, float *out, uint32_t n);
+void kernel_sqrt_f32(const float *a, const float *b, float *out, uint32_t n);
+void kernel_mult_f32(const float *a, const float *b, float *out, uint32_t n);
+void kernel_add_f32(const float *a, const float *b, float *out, uint32_t n);
+void kernel_dot_prod_f32(const float *a, const float *b, float *out, uint32_t n);
+void kernel_rms_f32(const float *a, const float *b, float *out, uint32_t n);
+
+/* "fast-math" or "precise", depending on how the kernels were compiled */
+extern const char *const dsp_kernels_variant;
+
+#endif /* DSP_KERNELS_H_ */
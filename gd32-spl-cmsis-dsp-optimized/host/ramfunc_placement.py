@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""Selects hot functions for SRAM placement from a map file and a profile.
+
+Reads the GCC map file of a build (-Wl,-Map=output.map) for the size and
+address of every function section, weights the functions with a profile and
+writes the ones that give the most benefit per byte, up to a RAM budget, into
+ldscripts/ramfunc_hot.ld. The next build links them into .ramfunc (see
+ldscripts/ramfunc.ld), ramfunc_init() copies them to SRAM at startup.
+
+Profiles (can be combined, all weights are summed up):
+  --bench       serial output of a DSP_BENCHMARK firmware, cycles per kernel
+  --profile     CSV "function,cycles" from any other measurement
+  --pc-samples  one hex PC value per line, e.g. from DWT PC sampling or
+                repeated "halt; reg pc; resume" in OpenOCD/pyOCD
+
+Before/after comparison of two benchmark runs:
+  python3 host/ramfunc_placement.py --compare bench_flash.txt bench_ram.txt
+
+Example:
+  python3 host/ramfunc_placement.py --map output.map --bench bench.txt --budget 2K
+"""
+import argparse
+import bisect
+import re
+import sys
+from os.path import abspath, basename, dirname, join
+
+PROJECT_DIR = dirname(dirname(abspath(__file__)))
+DEFAULT_OUTPUT = join(PROJECT_DIR, "ldscripts", "ramfunc_hot.ld")
+
+# functions that run before ramfunc_init() or only once, never worth moving
+DEFAULT_EXCLUDE = [
+    "Reset_Handler", "SystemInit", "main", "ramfunc_init", "__libc_init_array",
+    "memcpy", "memset", "_start", "_mainCRTStartup", "exit", "_exit",
+]
+
+SECTION_RE = re.compile(r"^ (\.text\.\S+)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*))?$")
+ADDR_SIZE_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(\S.*)$")
+SYMBOL_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+([A-Za-z_][\w.$]*)$")
+REGION_RE = re.compile(r"^(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)")
+
+
+class Function:
+    def __init__(self, section, address, size, obj):
+        self.section = section
+        self.address = address
+        self.size = size
+        self.obj = obj
+        self.symbols = []
+        self.weight = 0.0
+
+    @property
+    def name(self):
+        return self.symbols[0] if self.symbols else self.section[len(".text."):]
+
+
+def parse_map(path):
+    """returns (functions, memory regions) of a GCC map file"""
+    functions = []
+    regions = {}
+    in_regions = False
+    in_map = False
+    pending = None
+    current = None
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip("\r\n")
+            if line.startswith("Memory Configuration"):
+                in_regions = True
+                continue
+            if line.startswith("Linker script and memory map"):
+                in_regions, in_map = False, True
+                continue
+            if in_regions:
+                m = REGION_RE.match(line)
+                if m and m.group(1) != "Name":
+                    regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+                continue
+            if not in_map:
+                continue
+            if pending is not None:
+                # long section names put address and size on the next line
+                m = ADDR_SIZE_RE.match(line)
+                if m:
+                    current = add_function(functions, pending, m.group(1), m.group(2), m.group(3))
+                pending = None
+                continue
+            m = SECTION_RE.match(line)
+            if m:
+                if m.group(2) is None:
+                    pending = m.group(1)
+                    current = None
+                else:
+                    current = add_function(functions, m.group(1), m.group(2), m.group(3), m.group(4))
+                continue
+            m = SYMBOL_RE.match(line)
+            if m and current is not None and int(m.group(1), 16) >= current.address:
+                current.symbols.append(m.group(2))
+                continue
+            if line.startswith(" ") and not line.startswith("  "):
+                current = None  # next input section of another kind
+    return functions, regions
+
+
+def add_function(functions, section, address, size, obj):
+    address, size = int(address, 16), int(size, 16)
+    if size == 0 or address == 0:
+        return None  # discarded by --gc-sections
+    fn = Function(section, address, size, obj.strip())
+    functions.append(fn)
+    return fn
+
+
+def parse_size(text):
+    text = text.strip().upper()
+    factor = 1
+    if text.endswith("K"):
+        factor, text = 1024, text[:-1]
+    return int(text, 0) * factor
+
+
+def load_bench(paths):
+    """reads DSP_BENCHMARK output, returns {kernel: cycles per block}"""
+    bench = {}
+    for path in paths:
+        with open(path) as f:
+            for line in f:
+                fields = line.strip().split(",")
+                if len(fields) != 5 or fields[0] == "kernel":
+                    continue
+                try:
+                    bench[fields[0]] = float(fields[4])
+                except ValueError:
+                    continue
+    return bench
+
+
+def load_profile(paths):
+    """reads "function,cycles" CSV files"""
+    profile = {}
+    for path in paths:
+        with open(path) as f:
+            for line in f:
+                fields = [x.strip() for x in line.split(",")]
+                if len(fields) < 2:
+                    continue
+                try:
+                    profile[fields[0]] = profile.get(fields[0], 0.0) + float(fields[1])
+                except ValueError:
+                    continue  # header
+    return profile
+
+
+def apply_pc_samples(functions, paths):
+    """attributes every PC sample to the function containing it"""
+    ordered = sorted(functions, key=lambda fn: fn.address)
+    starts = [fn.address for fn in ordered]
+    total = unknown = 0
+    for path in paths:
+        with open(path) as f:
+            for line in f:
+                token = line.strip().split()[-1] if line.strip() else ""
+                try:
+                    pc = int(token, 16) & ~1  # thumb bit
+                except ValueError:
+                    continue
+                total += 1
+                i = bisect.bisect_right(starts, pc) - 1
+                if i >= 0 and pc < ordered[i].address + ordered[i].size:
+                    ordered[i].weight += 1
+                else:
+                    unknown += 1
+    return total, unknown
+
+
+def select(functions, budget, exclude):
+    """greedy knapsack: best weight per byte first, until the budget is used up"""
+    candidates = [fn for fn in functions if fn.weight > 0 and fn.name not in exclude
+                  and fn.section[len(".text."):] not in exclude]
+    candidates.sort(key=lambda fn: fn.weight / fn.size, reverse=True)
+    chosen, used = [], 0
+    for fn in candidates:
+        size = (fn.size + 3) & ~3
+        if used + size <= budget:
+            chosen.append(fn)
+            used += size
+    return chosen, used
+
+
+def write_ldscript(path, chosen, args):
+    with open(path, "w") as f:
+        f.write("/* Function sections to place into SRAM, included by ramfunc.ld.\n")
+        f.write(" * Generated by host/ramfunc_placement.py from %s,\n" % basename(args.map))
+        f.write(" * budget %d bytes. Do not edit by hand. */\n" % args.budget)
+        for fn in chosen:
+            f.write("*(%s) /* %d bytes */\n" % (fn.section, fn.size))
+
+
+def compare(before_path, after_path):
+    before, after = load_bench([before_path]), load_bench([after_path])
+    print("%-20s %14s %14s %9s" % ("kernel", "cycles before", "cycles after", "speedup"))
+    for kernel in before:
+        if kernel not in after:
+            continue
+        b, a = before[kernel], after[kernel]
+        print("%-20s %14.0f %14.0f %8.2fx" % (kernel, b, a, b / a if a else 0.0))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--map", default=join(PROJECT_DIR, "output.map"), help="GCC map file of the build")
+    parser.add_argument("--bench", action="append", default=[], help="DSP_BENCHMARK output (repeatable)")
+    parser.add_argument("--profile", action="append", default=[], help="CSV function,cycles (repeatable)")
+    parser.add_argument("--pc-samples", action="append", default=[], help="file with one hex PC per line (repeatable)")
+    parser.add_argument("--budget", default="1K", help="SRAM bytes for hot functions, e.g. 2048, 0x800 or 2K")
+    parser.add_argument("--exclude", action="append", default=[], help="function to never move (repeatable)")
+    parser.add_argument("--output", default=DEFAULT_OUTPUT)
+    parser.add_argument("--dry-run", action="store_true", help="only print the selection")
+    parser.add_argument("--compare", nargs=2, metavar=("BEFORE", "AFTER"),
+                        help="compare two DSP_BENCHMARK outputs and exit")
+    args = parser.parse_args()
+
+    if args.compare:
+        compare(*args.compare)
+        return
+    args.budget = parse_size(args.budget)
+    if not (args.bench or args.profile or args.pc_samples):
+        sys.exit("error: no profile given, use --bench, --profile or --pc-samples")
+
+    functions, regions = parse_map(args.map)
+    if not functions:
+        sys.exit("error: no function sections in %s (built with -ffunction-sections?)" % args.map)
+    by_name = {}
+    for fn in functions:
+        for key in [fn.section[len(".text."):]] + fn.symbols:
+            by_name.setdefault(key, fn)
+
+    weights = load_bench(args.bench)
+    for name, cycles in load_profile(args.profile).items():
+        weights[name] = weights.get(name, 0.0) + cycles
+    for name, cycles in weights.items():
+        if name in by_name:
+            by_name[name].weight += cycles
+        else:
+            print("warning: %s not found in the map file" % name, file=sys.stderr)
+    if args.pc_samples:
+        total, unknown = apply_pc_samples(functions, args.pc_samples)
+        print("%d PC samples, %d outside of any function section" % (total, unknown))
+
+    if "RAM" in regions:
+        origin, length = regions["RAM"]
+        if args.budget > length // 2:
+            print("warning: budget is more than half of the RAM (%d bytes)" % length, file=sys.stderr)
+
+    chosen, used = select(functions, args.budget, set(DEFAULT_EXCLUDE + args.exclude))
+    total_weight = sum(fn.weight for fn in functions)
+    print("%-32s %6s %12s %8s" % ("function", "bytes", "weight", "share"))
+    for fn in chosen:
+        print("%-32s %6d %12.0f %7.1f%%" % (fn.name, fn.size, fn.weight,
+                                           100.0 * fn.weight / total_weight if total_weight else 0.0))
+    print("%d functions, %d of %d bytes budget" % (len(chosen), used, args.budget))
+    if not args.dry_run:
+        write_ldscript(args.output, chosen, args)
+        print("written to %s" % args.output)
+
+
+if __name__ == "__main__":
+    main()
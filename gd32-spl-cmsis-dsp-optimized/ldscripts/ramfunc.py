@@ -0,0 +1,11 @@
+# Adds ramfunc.ld to the link, see ldscripts/ramfunc.ld.
+# Must run as "post" script: PlatformIO prepends the main linker script
+# to LINKFLAGS while building the program, and ramfunc.ld has to come
+# before it on the command line.
+from os.path import join
+Import("env")
+
+ldscripts_dir = join(env.subst("$PROJECT_DIR"), "ldscripts")
+# search path for the INCLUDE of ramfunc_hot.ld
+env.Append(LIBPATH=[ldscripts_dir])
+env.Prepend(LINKFLAGS=["-Wl,-T,\"%s\"" % join(ldscripts_dir, "ramfunc.ld")])
@@ -0,0 +1,19 @@
+#ifndef CYCLE_COUNTER_H_
+#define CYCLE_COUNTER_H_
+
+#include <stdint.h>
+
+/* Initializes the CPU cycle counter.
+ * Uses the DWT cycle counter (DWT->CYCCNT) on Cortex-M3/M4/M33 cores.
+ * The Cortex-M23 (GD32E23x) has no DWT cycle counter, so there the count is
+ * derived from the SysTick (which must be running, e.g. via systick_config()). */
+void cycle_counter_init(void);
+
+/* Returns the current cycle count. Wraps around at 32 bit, so only take the
+ * difference of two values that are less than 2^32 cycles apart. */
+uint32_t cycle_counter_get(void);
+
+/* called from the SysTick handler to extend the SysTick based counter */
+void cycle_counter_systick_increment(void);
+
+#endif /* CYCLE_COUNTER_H_ */
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <math.h>
+#include <gd32_include.h>
+#include <dsp_benchmark.h>
+#include <cycle_counter.h>
+
+#define BENCH_ITERATIONS 100
+#define BENCH_MAX_BLOCKSIZE 32
+
+#ifdef __FAST_MATH__
+#define BENCH_VARIANT "fast-math"
+#else
+#define BENCH_VARIANT "precise"
+#endif
+
+/* results are written here so that the compiler can't optimize the kernels away */
+static volatile float32_t bench_sink;
+static float32_t bench_out[BENCH_MAX_BLOCKSIZE];
+static float32_t bench_positive[BENCH_MAX_BLOCKSIZE];
+
+static void print_result(const char *kernel, uint32_t block_size, uint32_t cycles)
+{
+    printf("%s,%s,%lu,%d,%lu\n", kernel, BENCH_VARIANT, (unsigned long)block_size,
+           BENCH_ITERATIONS, (unsigned long)(cycles / BENCH_ITERATIONS));
+}
+
+void dsp_benchmark_run(const float32_t *input, uint32_t block_size)
+{
+    uint32_t start, i, n;
+    float32_t result;
+
+    if (block_size > BENCH_MAX_BLOCKSIZE)
+    {
+        block_size = BENCH_MAX_BLOCKSIZE;
+    }
+    for (i = 0; i < block_size; i++)
+    {
+        bench_positive[i] = fabsf(input[i]);
+    }
+
+    printf("# DSP benchmark, SystemCoreClock = %lu Hz\n", (unsigned long)SystemCoreClock);
+    printf("kernel,variant,block_size,iterations,cycles_per_block\n");
+
+    /* scalar functions: one call per sample of the block */
+    start = cycle_counter_get();
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+        for (i = 0; i < block_size; i++)
+            bench_out[i] = arm_sin_f32(input[i]);
+    print_result("arm_sin_f32", block_size, cycle_counter_get() - start);
+
+    start = cycle_counter_get();
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+        for (i = 0; i < block_size; i++)
+            bench_out[i] = arm_cos_f32(input[i]);
+    print_result("arm_cos_f32", block_size, cycle_counter_get() - start);
+
+    start = cycle_counter_get();
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+        for (i = 0; i < block_size; i++)
+            arm_sqrt_f32(bench_positive[i], &bench_out[i]);
+    print_result("arm_sqrt_f32", block_size, cycle_counter_get() - start);
+
+    /* vector functions: one call per block */
+    start = cycle_counter_get();
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+        arm_mult_f32(input, bench_positive, bench_out, block_size);
+    print_result("arm_mult_f32", block_size, cycle_counter_get() - start);
+
+    start = cycle_counter_get();
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+        arm_add_f32(input, bench_positive, bench_out, block_size);
+    print_result("arm_add_f32", block_size, cycle_counter_get() - start);
+
+    start = cycle_counter_get();
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+        arm_dot_prod_f32(input, bench_positive, block_size, &result);
+    print_result("arm_dot_prod_f32", block_size, cycle_counter_get() - start);
+    bench_sink = result;
+
+    start = cycle_counter_get();
+    for (n = 0; n < BENCH_ITERATIONS; n++)
+        arm_rms_f32(input, block_size, &result);
+    print_result("arm_rms_f32", block_size, cycle_counter_get() - start);
+    bench_sink = result;
+
+    bench_sink = bench_out[0];
+}
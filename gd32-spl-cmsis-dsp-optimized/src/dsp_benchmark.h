@@ -0,0 +1,15 @@
+#ifndef DSP_BENCHMARK_H_
+#define DSP_BENCHMARK_H_
+
+#include <stdint.h>
+#include "arm_math.h"
+
+/* Measures the cycles needed by each benchmarked CMSIS-DSP kernel and prints
+ * the result as CSV lines over printf(), one line per kernel:
+ *   kernel,variant,block_size,iterations,cycles_per_block
+ * "variant" is "fast-math" if the firmware was compiled with -ffast-math,
+ * otherwise "precise". The output is meant to be captured from the serial
+ * monitor and fed into host/dsp_accuracy.py. */
+void dsp_benchmark_run(const float32_t *input, uint32_t block_size);
+
+#endif /* DSP_BENCHMARK_H_ */
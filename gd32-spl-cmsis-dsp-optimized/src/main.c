@@ -2,7 +2,12 @@
 #include <math.h>
 #include <gd32_include.h>
 #include <printf_over_x.h>
+#include <cycle_counter.h>
+#include <ramfunc.h>
 #include "arm_math.h"
+#ifdef DSP_BENCHMARK
+#include <dsp_benchmark.h>
+#endif
 
 /* ----------------------------------------------------------------------
  * Defines each of the tests performed
@@ -47,13 +52,20 @@ void delay_1ms(uint32_t count);
 
 int main(void)
 {
+    //copy the functions placed in SRAM (RAMFUNC, ldscripts/ramfunc_hot.ld)
+    ramfunc_init();
     systick_config();
+    cycle_counter_init();
     //configure printf() output via e.g. USART
     //see function for details
     init_printf_transport();
 
     delay_1ms(500);
     printf("ARM cos and sin example start!\n");
+#ifdef DSP_BENCHMARK
+    //print cycle counts of the used kernels once, as CSV
+    dsp_benchmark_run(testInput_f32, blockSize);
+#endif
     while (1)
     {
         float32_t diff;
@@ -169,5 +181,6 @@ void PendSV_Handler(void)
 
 void SysTick_Handler(void)
 {
+    cycle_counter_systick_increment();
     delay_decrement();
 }
@@ -0,0 +1,23 @@
+#include <ramfunc.h>
+#include <stdint.h>
+#include <gd32_include.h>
+
+/* defined by ldscripts/ramfunc.ld */
+extern uint32_t _siramfunc; /* load address in flash */
+extern uint32_t _sramfunc;  /* start in SRAM */
+extern uint32_t _eramfunc;  /* end in SRAM */
+
+void ramfunc_init(void)
+{
+    const uint32_t *src = &_siramfunc;
+    uint32_t *dst = &_sramfunc;
+
+    /* word-wise, the section is 4 byte aligned on both ends */
+    while (dst < &_eramfunc)
+    {
+        *dst++ = *src++;
+    }
+    /* make sure the copied code is visible before it gets fetched */
+    __DSB();
+    __ISB();
+}
@@ -0,0 +1,21 @@
+#ifndef RAMFUNC_H_
+#define RAMFUNC_H_
+
+/* Places a function into SRAM (section .ramfunc, see ldscripts/ramfunc.ld).
+ * Code in SRAM runs without flash wait states. Use it for small, hot
+ * functions. Calls between flash and SRAM are out of range of a direct
+ * branch, so the function is marked long_call and the linker inserts
+ * veneers for the other direction. noinline keeps it from being inlined
+ * back into flash code.
+ *
+ *   RAMFUNC void my_filter(const float *in, float *out, uint32_t n) { ... }
+ *
+ * Functions that cannot be annotated (e.g. CMSIS-DSP kernels) are placed via
+ * ldscripts/ramfunc_hot.ld instead. */
+#define RAMFUNC __attribute__((section(".ramfunc"), noinline, long_call))
+
+/* Copies the .ramfunc section from flash to SRAM.
+ * Must be called at startup before any of these functions is executed. */
+void ramfunc_init(void);
+
+#endif /* RAMFUNC_H_ */
@@ -0,0 +1,377 @@
+#include "cmsis_compiler.h"
+#include "coro.hpp"
+
+namespace coro
+{
+
+namespace
+{
+
+/* ---- frame arena ----
+ * First fit over an address sorted free list, blocks are merged with their
+ * neighbours when freed. The frame size is known at operator delete, so the
+ * blocks have no header; all sizes are rounded up to ARENA_ALIGN. */
+constexpr size_t ARENA_ALIGN = 8;
+
+struct FreeBlock
+{
+    size_t size;
+    FreeBlock *next;
+};
+
+alignas(ARENA_ALIGN) uint8_t arena[CORO_ARENA_SIZE];
+size_t arena_top;          /* never used above this offset */
+FreeBlock *arena_free_list;
+ArenaStats arena_stats = {CORO_ARENA_SIZE, 0, 0, 0};
+
+size_t arena_round(size_t size)
+{
+    /* a freed block must be able to hold the free list entry */
+    size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+    return size < sizeof(FreeBlock) ? (sizeof(FreeBlock) + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1) : size;
+}
+
+/* ---- scheduler state ---- */
+TaskControl *ready_head, *ready_tail;
+TaskControl *sleeping;    /* sorted by wake time */
+TaskControl *polling;
+TaskControl *all_tasks;
+Event *waiting_events;    /* events with a waiting task */
+
+volatile tick_t tick_count;
+volatile bool events_signaled;
+
+uint32_t (*cycle_counter)(void);
+uint32_t last_cycles;
+uint64_t total_cycles;
+uint64_t sleep_cycles;
+
+/* tick a is before tick b, also across the wrap */
+bool tick_before(tick_t a, tick_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+void wake_sleepers(tick_t ticks)
+{
+    while (sleeping != nullptr && !tick_before(ticks, sleeping->wake))
+    {
+        TaskControl *task = sleeping;
+        sleeping = task->next;
+        detail::make_ready(task);
+    }
+}
+
+void check_pollers()
+{
+    TaskControl **link = &polling;
+    while (*link != nullptr)
+    {
+        TaskControl *task = *link;
+        if (task->poll(task->poll_arg))
+        {
+            *link = task->next;
+            detail::make_ready(task);
+        }
+        else
+        {
+            link = &task->next;
+        }
+    }
+}
+
+void run_task(TaskControl *task)
+{
+    uint64_t start = cycles();
+    task->switches++;
+    task->handle.resume();
+    task->run_cycles += cycles() - start;
+
+    if (task->handle.done())
+    {
+        TaskControl **link = &all_tasks;
+        while (*link != task)
+            link = &(*link)->all_next;
+        *link = task->all_next;
+        /* frees the frame, which contains the task control */
+        task->handle.destroy();
+    }
+}
+
+} // namespace
+
+namespace detail
+{
+
+size_t last_frame_size;
+
+void *arena_alloc(size_t size) noexcept
+{
+    size = arena_round(size);
+    void *ptr = nullptr;
+    for (FreeBlock **link = &arena_free_list; *link != nullptr; link = &(*link)->next)
+    {
+        FreeBlock *block = *link;
+        if (block->size == size)
+        {
+            *link = block->next;
+            ptr = block;
+            break;
+        }
+        if (block->size >= size + arena_round(1))
+        {
+            /* take the front, the rest stays in the list */
+            FreeBlock *rest = (FreeBlock *)((uint8_t *)block + size);
+            rest->size = block->size - size;
+            rest->next = block->next;
+            *link = rest;
+            ptr = block;
+            break;
+        }
+    }
+    if (ptr == nullptr && CORO_ARENA_SIZE - arena_top >= size)
+    {
+        ptr = &arena[arena_top];
+        arena_top += size;
+    }
+    if (ptr == nullptr)
+    {
+        arena_stats.failed++;
+        return nullptr;
+    }
+    arena_stats.used += size;
+    if (arena_stats.used > arena_stats.peak)
+        arena_stats.peak = arena_stats.used;
+    last_frame_size = size;
+    return ptr;
+}
+
+void arena_free(void *ptr, size_t size) noexcept
+{
+    size = arena_round(size);
+    arena_stats.used -= size;
+    FreeBlock *block = (FreeBlock *)ptr;
+    block->size = size;
+
+    /* insert sorted by address and merge with the neighbours */
+    FreeBlock *prev = nullptr;
+    FreeBlock **link = &arena_free_list;
+    while (*link != nullptr && *link < block)
+    {
+        prev = *link;
+        link = &(*link)->next;
+    }
+    block->next = *link;
+    *link = block;
+    if (block->next != nullptr && (uint8_t *)block + block->size == (uint8_t *)block->next)
+    {
+        block->size += block->next->size;
+        block->next = block->next->next;
+    }
+    if (prev != nullptr && (uint8_t *)prev + prev->size == (uint8_t *)block)
+    {
+        prev->size += block->size;
+        prev->next = block->next;
+    }
+
+    /* the highest free block goes back to the unused top */
+    link = &arena_free_list;
+    while (*link != nullptr && (*link)->next != nullptr)
+        link = &(*link)->next;
+    if (*link != nullptr && (uint8_t *)*link + (*link)->size == &arena[arena_top])
+    {
+        arena_top -= (*link)->size;
+        *link = nullptr;
+    }
+}
+
+void make_ready(TaskControl *task) noexcept
+{
+    task->next = nullptr;
+    if (ready_tail != nullptr)
+        ready_tail->next = task;
+    else
+        ready_head = task;
+    ready_tail = task;
+}
+
+void sleep_for(TaskControl *task, tick_t ticks) noexcept
+{
+    if (ticks == 0)
+    {
+        make_ready(task);
+        return;
+    }
+    task->wake = tick_count + ticks;
+    TaskControl **link = &sleeping;
+    while (*link != nullptr && !tick_before(task->wake, (*link)->wake))
+        link = &(*link)->next;
+    task->next = *link;
+    *link = task;
+}
+
+void add_poller(TaskControl *task, bool (*poll)(void *arg), void *arg) noexcept
+{
+    task->poll = poll;
+    task->poll_arg = arg;
+    task->next = polling;
+    polling = task;
+}
+
+void deliver_events() noexcept
+{
+    /* cleared first, a signal from now on keeps the scheduler awake */
+    events_signaled = false;
+    Event **link = &waiting_events;
+    while (*link != nullptr)
+    {
+        Event *event = *link;
+        uint32_t count = event->take();
+        if (count != 0)
+        {
+            *link = event->next_waiting;
+            event->delivered = count;
+            TaskControl *task = event->waiter;
+            event->waiter = nullptr;
+            make_ready(task);
+        }
+        else
+        {
+            link = &event->next_waiting;
+        }
+    }
+}
+
+} // namespace detail
+
+/* ---- events ---- */
+
+void Event::signal_from_isr() noexcept
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    pending = pending + 1;
+    __set_PRIMASK(primask);
+    events_signaled = true;
+}
+
+uint32_t Event::take() noexcept
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t count = pending;
+    pending = 0;
+    __set_PRIMASK(primask);
+    return count;
+}
+
+void Event::wait(TaskControl *task) noexcept
+{
+    waiter = task;
+    next_waiting = waiting_events;
+    waiting_events = this;
+}
+
+/* ---- scheduler ---- */
+
+void init(uint32_t (*counter)(void)) noexcept
+{
+    cycle_counter = counter;
+    last_cycles = counter != nullptr ? counter() : 0;
+    total_cycles = 0;
+    sleep_cycles = 0;
+}
+
+bool spawn(Task &&task, const char *name) noexcept
+{
+    if (!task.handle)
+        return false;
+    TaskControl *control = &task.handle.promise().control;
+    control->handle = task.handle;
+    control->name = name;
+    control->all_next = all_tasks;
+    all_tasks = control;
+    task.handle = nullptr;
+    detail::make_ready(control);
+    return true;
+}
+
+void run() noexcept
+{
+    for (;;)
+    {
+        tick_t ticks = tick_count;
+        wake_sleepers(ticks);
+        detail::deliver_events();
+        check_pollers();
+
+        if (ready_head != nullptr)
+        {
+            /* only the tasks that are ready now, so that a task that yields
+             * lets the scheduler look at the timers and events again */
+            TaskControl *last = ready_tail;
+            TaskControl *task;
+            do
+            {
+                task = ready_head;
+                ready_head = task->next;
+                if (ready_head == nullptr)
+                    ready_tail = nullptr;
+                run_task(task);
+            } while (task != last && ready_head != nullptr);
+        }
+        else if (polling == nullptr)
+        {
+            /* WFI also wakes up with interrupts masked, the interrupt runs
+             * after __enable_irq(). Nothing may have happened since the
+             * checks above. */
+            __disable_irq();
+            uint64_t start = cycles();
+            if (!events_signaled && ticks == tick_count)
+                __WFI();
+            __enable_irq();
+            sleep_cycles += cycles() - start;
+        }
+    }
+}
+
+void tick_from_isr() noexcept
+{
+    tick_count = tick_count + 1;
+}
+
+tick_t now() noexcept
+{
+    return tick_count;
+}
+
+/* ---- statistics ---- */
+
+void get_arena_stats(ArenaStats *stats) noexcept
+{
+    *stats = arena_stats;
+}
+
+const TaskControl *tasks() noexcept
+{
+    return all_tasks;
+}
+
+uint64_t cycles() noexcept
+{
+    if (cycle_counter == nullptr)
+        return 0;
+    /* called at least once per tick by the scheduler, so the 32-bit counter
+     * wraps at most once in between */
+    uint32_t current = cycle_counter();
+    total_cycles += current - last_cycles;
+    last_cycles = current;
+    return total_cycles;
+}
+
+uint64_t idle_cycles() noexcept
+{
+    return sleep_cycles;
+}
+
+} // namespace coro
@@ -0,0 +1,390 @@
+/*
+ * Stackless cooperative scheduler on C++20 coroutines.
+ *
+ * Every task is a coroutine returning coro::Task. Its local variables live in
+ * the coroutine frame, which is allocated from a static arena of
+ * CORO_ARENA_SIZE bytes when the coroutine is created and freed when it
+ * returns; there is no heap and no stack per task. All tasks run on the main
+ * stack, one at a time, until they co_await one of:
+ *   - coro::delay(ms) / coro::yield(): time, based on the 1 ms tick that the
+ *     application drives with coro::tick_from_isr() from its SysTick handler
+ *   - coro::Event: signaled from an interrupt handler (GPIO / EXTI, UART,
+ *     the USB class callbacks, ...). Signals that happen while no task waits
+ *     are merged, co_await returns their number.
+ *   - coro::until(predicate): readiness of a peripheral that is polled, e.g.
+ *     the TBE flag of a USART. Keeps the CPU awake while a task waits.
+ *   - coro::Channel<T, N>: a queue of N items between tasks
+ * When no task is ready, the scheduler sleeps with WFI until the next
+ * interrupt.
+ *
+ *   coro::Task blinky()
+ *   {
+ *       for (;;)
+ *       {
+ *           gpio_bit_set(GPIOA, GPIO_PIN_1);
+ *           co_await coro::delay(500);
+ *           gpio_bit_reset(GPIOA, GPIO_PIN_1);
+ *           co_await coro::delay(500);
+ *       }
+ *   }
+ *
+ *   coro::init(cycle_counter_get);
+ *   coro::spawn(blinky(), "Blinky");
+ *   coro::run();
+ *
+ * Scheduling is cooperative: a task runs until its next co_await, so data
+ * shared between tasks needs no lock, but a long computation must yield.
+ * Interrupt handlers may only call Event::signal_from_isr() and
+ * coro::tick_from_isr(). The awaitables can only be used in coro::Task
+ * coroutines, not in functions called by them (those run to completion).
+ *
+ * For the statistics, coro::init() takes a function returning the CPU cycles
+ * (DWT cycle counter or SysTick based, may be nullptr).
+ */
+#ifndef CORO_HPP_
+#define CORO_HPP_
+
+#include <coroutine>
+#include <stddef.h>
+#include <stdint.h>
+
+/* size of the arena for the coroutine frames, in bytes */
+#ifndef CORO_ARENA_SIZE
+#define CORO_ARENA_SIZE 1024
+#endif
+
+namespace coro
+{
+
+/* 1 ms per tick */
+using tick_t = uint32_t;
+
+/* scheduler data of a task, part of its coroutine frame */
+struct TaskControl
+{
+    std::coroutine_handle<> handle;
+    TaskControl *next;     /* ready, sleeping or polling list */
+    TaskControl *all_next; /* all tasks, see coro::tasks() */
+    const char *name;
+    tick_t wake;
+    bool (*poll)(void *arg);
+    void *poll_arg;
+    uint32_t frame_size;   /* bytes of the arena */
+    uint32_t switches;     /* times the task was resumed */
+    uint64_t run_cycles;
+};
+
+namespace detail
+{
+void *arena_alloc(size_t size) noexcept;
+void arena_free(void *ptr, size_t size) noexcept;
+/* size of the last frame allocated, picked up by the promise constructor */
+extern size_t last_frame_size;
+void make_ready(TaskControl *task) noexcept;
+void sleep_for(TaskControl *task, tick_t ticks) noexcept;
+void add_poller(TaskControl *task, bool (*poll)(void *arg), void *arg) noexcept;
+void deliver_events() noexcept;
+} // namespace detail
+
+class Task
+{
+  public:
+    struct promise_type
+    {
+        TaskControl control{};
+
+        promise_type() noexcept
+        {
+            control.frame_size = (uint32_t)detail::last_frame_size;
+        }
+        static void *operator new(size_t size) noexcept
+        {
+            return detail::arena_alloc(size);
+        }
+        static void operator delete(void *ptr, size_t size) noexcept
+        {
+            detail::arena_free(ptr, size);
+        }
+        /* arena exhausted: the coroutine is not created, spawn() fails */
+        static Task get_return_object_on_allocation_failure() noexcept
+        {
+            return Task();
+        }
+        Task get_return_object() noexcept
+        {
+            return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        /* the task starts when the scheduler resumes it */
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        /* the scheduler frees the frame */
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept
+        {
+            for (;;)
+            {
+            }
+        }
+    };
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    Task() noexcept = default;
+    explicit Task(handle_type handle) noexcept : handle(handle) {}
+    Task(Task &&other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    Task &operator=(Task &&) = delete;
+    /* a task that was never spawned */
+    ~Task()
+    {
+        if (handle)
+            handle.destroy();
+    }
+    explicit operator bool() const noexcept { return (bool)handle; }
+
+  private:
+    friend bool spawn(Task &&task, const char *name) noexcept;
+    handle_type handle;
+};
+
+/* ---- scheduler ---- */
+
+/* cycle_counter: returns the CPU cycles for the statistics, may be nullptr */
+void init(uint32_t (*cycle_counter)(void)) noexcept;
+
+/* hands a task to the scheduler, false if the arena had no room for it */
+bool spawn(Task &&task, const char *name) noexcept;
+
+/* runs the tasks, never returns */
+[[noreturn]] void run() noexcept;
+
+/* call every 1 ms, e.g. from the SysTick handler */
+void tick_from_isr() noexcept;
+
+tick_t now() noexcept;
+
+/* ---- statistics ---- */
+
+struct ArenaStats
+{
+    size_t size;
+    size_t used;
+    size_t peak;
+    uint32_t failed; /* frames that did not fit */
+};
+
+void get_arena_stats(ArenaStats *stats) noexcept;
+
+/* all spawned tasks that did not return yet, follow all_next */
+const TaskControl *tasks() noexcept;
+
+/* cycles since coro::init(), extended to 64 bit, and the time asleep in WFI
+ * (including the interrupt handlers that ended the sleep) */
+uint64_t cycles() noexcept;
+uint64_t idle_cycles() noexcept;
+
+/* ---- awaitables ---- */
+
+/* continues after at least ms - 1 and at most ms milliseconds, like
+ * vTaskDelay(). delay(0) is the same as yield(). */
+struct Delay
+{
+    tick_t ticks;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Task::handle_type handle) noexcept
+    {
+        detail::sleep_for(&handle.promise().control, ticks);
+    }
+    void await_resume() const noexcept {}
+};
+
+inline Delay delay(tick_t ms) noexcept
+{
+    return Delay{ms};
+}
+
+/* lets the other ready tasks run first */
+inline Delay yield() noexcept
+{
+    return Delay{0};
+}
+
+/* continues as soon as predicate() returns true. The scheduler calls it on
+ * every pass and does not sleep while a task waits here, so use it for
+ * short waits (a USART transmit register) and an Event for long ones. */
+template <typename Predicate>
+struct Until
+{
+    Predicate predicate;
+
+    bool await_ready() noexcept { return predicate(); }
+    void await_suspend(Task::handle_type handle) noexcept
+    {
+        detail::add_poller(&handle.promise().control, &Until::check, this);
+    }
+    void await_resume() const noexcept {}
+
+    static bool check(void *self) { return static_cast<Until *>(self)->predicate(); }
+};
+
+template <typename Predicate>
+inline Until<Predicate> until(Predicate predicate) noexcept
+{
+    return Until<Predicate>{predicate};
+}
+
+/* set by an interrupt handler, awaited by one task at a time */
+class Event
+{
+  public:
+    struct Awaiter
+    {
+        Event &event;
+        uint32_t count;
+
+        bool await_ready() noexcept
+        {
+            count = event.take();
+            return count != 0;
+        }
+        void await_suspend(Task::handle_type handle) noexcept
+        {
+            event.wait(&handle.promise().control);
+        }
+        /* the signals since the last co_await, at least 1 */
+        uint32_t await_resume() noexcept
+        {
+            return count != 0 ? count : event.delivered;
+        }
+    };
+
+    /* from interrupt handlers and tasks */
+    void signal_from_isr() noexcept;
+
+    Awaiter operator co_await() noexcept { return Awaiter{*this, 0}; }
+
+    /* signals since the last co_await, and clears them */
+    uint32_t take() noexcept;
+
+  private:
+    friend void detail::deliver_events() noexcept;
+    void wait(TaskControl *task) noexcept;
+
+    volatile uint32_t pending = 0;
+    uint32_t delivered = 0;
+    TaskControl *waiter = nullptr;
+    Event *next_waiting = nullptr;
+};
+
+/* queue of N items between tasks (not for interrupt handlers, they signal an
+ * Event). send() waits while the queue is full, receive() while it is empty. */
+template <typename T, size_t N>
+class Channel
+{
+    static_assert(N > 0, "a channel needs room for at least one item");
+
+  public:
+    struct SendAwaiter
+    {
+        Channel &channel;
+        T value;
+        SendAwaiter *next = nullptr;
+        TaskControl *task = nullptr;
+
+        bool await_ready() noexcept { return channel.try_send(value); }
+        void await_suspend(Task::handle_type handle) noexcept
+        {
+            task = &handle.promise().control;
+            channel.append(channel.senders, this);
+        }
+        void await_resume() const noexcept {}
+    };
+
+    struct ReceiveAwaiter
+    {
+        Channel &channel;
+        T value{};
+        ReceiveAwaiter *next = nullptr;
+        TaskControl *task = nullptr;
+
+        bool await_ready() noexcept { return channel.try_receive(value); }
+        void await_suspend(Task::handle_type handle) noexcept
+        {
+            task = &handle.promise().control;
+            channel.append(channel.receivers, this);
+        }
+        T await_resume() noexcept { return value; }
+    };
+
+    SendAwaiter send(const T &value) noexcept { return SendAwaiter{*this, value}; }
+    ReceiveAwaiter receive() noexcept { return ReceiveAwaiter{*this}; }
+
+    /* without waiting, false if the channel is full */
+    bool try_send(const T &value) noexcept
+    {
+        if (receivers != nullptr)
+        {
+            /* a waiting receiver means the queue is empty, hand over directly */
+            ReceiveAwaiter *receiver = pop(receivers);
+            receiver->value = value;
+            detail::make_ready(receiver->task);
+            return true;
+        }
+        if (count == N)
+            return false;
+        items[(head + count) % N] = value;
+        count++;
+        return true;
+    }
+
+    /* without waiting, false if the channel is empty */
+    bool try_receive(T &value) noexcept
+    {
+        if (count == 0)
+            return false;
+        value = items[head];
+        head = (head + 1) % N;
+        count--;
+        if (senders != nullptr)
+        {
+            /* the oldest waiting sender takes the free slot */
+            SendAwaiter *sender = pop(senders);
+            items[(head + count) % N] = sender->value;
+            count++;
+            detail::make_ready(sender->task);
+        }
+        return true;
+    }
+
+    size_t size() const noexcept { return count; }
+
+  private:
+    template <typename Awaiter>
+    static void append(Awaiter *&list, Awaiter *awaiter) noexcept
+    {
+        Awaiter **link = &list;
+        while (*link != nullptr)
+            link = &(*link)->next;
+        awaiter->next = nullptr;
+        *link = awaiter;
+    }
+
+    template <typename Awaiter>
+    static Awaiter *pop(Awaiter *&list) noexcept
+    {
+        Awaiter *first = list;
+        list = first->next;
+        return first;
+    }
+
+    T items[N];
+    size_t head = 0;
+    size_t count = 0;
+    SendAwaiter *senders = nullptr;
+    ReceiveAwaiter *receivers = nullptr;
+};
+
+} // namespace coro
+
+#endif /* CORO_HPP_ */
@@ -0,0 +1,36 @@
+#include <gd32_include.h>
+#include <cycle_counter.h>
+
+/* number of SysTick reloads seen, only needed for the SysTick fallback */
+static volatile uint32_t systick_reloads = 0;
+
+void cycle_counter_init(void)
+{
+#if !defined(GD32E23x)
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint32_t cycle_counter_get(void)
+{
+#if !defined(GD32E23x)
+    return DWT->CYCCNT;
+#else
+    /* SysTick counts down from LOAD to 0, then reloads and fires an interrupt. */
+    uint32_t reloads, val;
+    do
+    {
+        reloads = systick_reloads;
+        val = SysTick->VAL;
+    } while (reloads != systick_reloads);
+    return reloads * (SysTick->LOAD + 1U) + (SysTick->LOAD - val);
+#endif
+}
+
+void cycle_counter_systick_increment(void)
+{
+    systick_reloads++;
+}
@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <gd32_include.h>
+#include <printf_over_x.h>
+#include <cycle_counter.h>
+#include <coro.hpp>
+
+/* same structure as the FreeRTOS example (Blinky and TaskManager tasks),
+ * plus a button, a serial console and a context switch benchmark */
+
+#define LEDPORT GPIOA
+#define LEDPIN GPIO_PIN_1
+#define LED_CLOCK RCU_GPIOA
+
+/* push button from PA0 to GND */
+#define BUTTON_PORT GPIOA
+#define BUTTON_PIN GPIO_PIN_0
+#define BUTTON_CLOCK RCU_GPIOA
+#if defined(GD32F3x0) || defined(GD32F1x0) || defined(GD32E23x)
+#define BUTTON_IRQn EXTI0_1_IRQn
+#define BUTTON_IRQHandler EXTI0_1_IRQHandler
+#else
+#define BUTTON_IRQn EXTI0_IRQn
+#define BUTTON_IRQHandler EXTI0_IRQHandler
+#endif
+
+/* the console reads from the USART that printf() writes to */
+#define CONSOLE_USART USART0
+#define CONSOLE_IRQn USART0_IRQn
+#define CONSOLE_IRQHandler USART0_IRQHandler
+#define CONSOLE_RX_SIZE 32
+
+#define SWITCH_BENCH_ITERATIONS 1000
+
+static coro::Event button_event;
+static coro::Event console_event;
+/* new blink half periods in ms, from the button to Blinky */
+static coro::Channel<uint32_t, 2> blink_channel;
+
+static volatile uint8_t console_rx[CONSOLE_RX_SIZE];
+static volatile uint32_t console_rx_head, console_rx_tail;
+
+void systick_config(void);
+
+void init_led()
+{
+    rcu_periph_clock_enable(LED_CLOCK);
+#if defined(GD32F3x0) || defined(GD32F1x0) || defined(GD32F4xx) || defined(GD32E23x)
+    gpio_mode_set(LEDPORT, GPIO_MODE_OUTPUT, GPIO_PUPD_NONE, LEDPIN);
+    gpio_output_options_set(LEDPORT, GPIO_OTYPE_PP, GPIO_OSPEED_50MHZ, LEDPIN);
+#else /* valid for GD32F10x, GD32E20x, GD32F30x, GD32F403, GD32E10X */
+    gpio_init(LEDPORT, GPIO_MODE_OUT_PP, GPIO_OSPEED_50MHZ, LEDPIN);
+#endif
+}
+
+void init_button()
+{
+    rcu_periph_clock_enable(BUTTON_CLOCK);
+#if defined(GD32F3x0) || defined(GD32F1x0) || defined(GD32E23x)
+    rcu_periph_clock_enable(RCU_CFGCMP);
+    gpio_mode_set(BUTTON_PORT, GPIO_MODE_INPUT, GPIO_PUPD_PULLUP, BUTTON_PIN);
+    syscfg_exti_line_config(EXTI_SOURCE_GPIOA, EXTI_SOURCE_PIN0);
+#elif defined(GD32F4xx)
+    rcu_periph_clock_enable(RCU_SYSCFG);
+    gpio_mode_set(BUTTON_PORT, GPIO_MODE_INPUT, GPIO_PUPD_PULLUP, BUTTON_PIN);
+    syscfg_exti_line_config(EXTI_SOURCE_GPIOA, EXTI_SOURCE_PIN0);
+#else /* valid for GD32F10x, GD32E20x, GD32F30x, GD32F403, GD32E10X */
+    rcu_periph_clock_enable(RCU_AF);
+    gpio_init(BUTTON_PORT, GPIO_MODE_IPU, GPIO_OSPEED_50MHZ, BUTTON_PIN);
+    gpio_exti_source_select(GPIO_PORT_SOURCE_GPIOA, GPIO_PIN_SOURCE_0);
+#endif
+    exti_init(EXTI_0, EXTI_INTERRUPT, EXTI_TRIG_FALLING);
+    exti_interrupt_flag_clear(EXTI_0);
+    NVIC_SetPriority(BUTTON_IRQn, 2U);
+    NVIC_EnableIRQ(BUTTON_IRQn);
+}
+
+/* the USART itself is set up by init_printf_transport() */
+void init_console()
+{
+    usart_interrupt_enable(CONSOLE_USART, USART_INT_RBNE);
+    NVIC_SetPriority(CONSOLE_IRQn, 2U);
+    NVIC_EnableIRQ(CONSOLE_IRQn);
+}
+
+extern "C" void BUTTON_IRQHandler(void)
+{
+    if (exti_interrupt_flag_get(EXTI_0) != RESET)
+    {
+        exti_interrupt_flag_clear(EXTI_0);
+        button_event.signal_from_isr();
+    }
+}
+
+extern "C" void CONSOLE_IRQHandler(void)
+{
+    if (usart_flag_get(CONSOLE_USART, USART_FLAG_RBNE) != RESET)
+    {
+        /* reading the data register also clears an overrun on GD32F10x / F30x */
+        uint8_t c = (uint8_t)usart_data_receive(CONSOLE_USART);
+        uint32_t head = console_rx_head;
+        if (head - console_rx_tail < CONSOLE_RX_SIZE)
+        {
+            console_rx[head % CONSOLE_RX_SIZE] = c;
+            console_rx_head = head + 1;
+        }
+        console_event.signal_from_isr();
+    }
+#if defined(GD32F3x0) || defined(GD32F1x0) || defined(GD32E23x)
+    if (usart_flag_get(CONSOLE_USART, USART_FLAG_ORERR) != RESET)
+    {
+        usart_flag_clear(CONSOLE_USART, USART_FLAG_ORERR);
+    }
+#endif
+}
+
+coro::Task blinky()
+{
+    uint32_t half_period = 500;
+    for (;;)
+    {
+        gpio_bit_set(LEDPORT, LEDPIN);
+        co_await coro::delay(half_period);
+        gpio_bit_reset(LEDPORT, LEDPIN);
+        co_await coro::delay(half_period);
+        printf("Blinky!\n");
+        /* a new period from the button, if there is one */
+        blink_channel.try_receive(half_period);
+    }
+}
+
+coro::Task button()
+{
+    static const uint32_t periods[] = {500, 250, 100};
+    uint32_t index = 0;
+    for (;;)
+    {
+        co_await button_event;
+        /* debounce: wait until the contact settled, drop the bounces */
+        co_await coro::delay(20);
+        button_event.take();
+        if (gpio_input_bit_get(BUTTON_PORT, BUTTON_PIN) != RESET)
+            continue;
+        index = (index + 1) % (sizeof(periods) / sizeof(periods[0]));
+        printf("Button: blink half period %lu ms\n", (unsigned long)periods[index]);
+        /* waits if Blinky did not pick up the previous periods yet */
+        co_await blink_channel.send(periods[index]);
+    }
+}
+
+static bool console_tx_ready()
+{
+    return usart_flag_get(CONSOLE_USART, USART_FLAG_TBE) != RESET;
+}
+
+/* echoes what is typed into the serial monitor */
+coro::Task console()
+{
+    for (;;)
+    {
+        co_await console_event;
+        while (console_rx_tail != console_rx_head)
+        {
+            uint8_t c = console_rx[console_rx_tail % CONSOLE_RX_SIZE];
+            console_rx_tail = console_rx_tail + 1;
+            co_await coro::until(console_tx_ready);
+            usart_data_transmit(CONSOLE_USART, c);
+        }
+    }
+}
+
+/* prints a fraction as percentage with 2 decimals, e.g. "12.34" */
+static void format_percent(char *buf, size_t len, uint64_t part, uint64_t total)
+{
+    unsigned long hundredths = total ? (unsigned long)(part * 10000ULL / total) : 0UL;
+    snprintf(buf, len, "%lu.%02lu", hundredths / 100UL, hundredths % 100UL);
+}
+
+static unsigned long cycles_to_us(uint64_t cycles)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    return (unsigned long)(cycles / (cycles_per_us ? cycles_per_us : 1U));
+}
+
+coro::Task task_manager()
+{
+    char total_pct[12];
+    for (;;)
+    {
+        co_await coro::delay(2000);
+        uint64_t now = coro::cycles();
+        printf("Uptime: %lu s\n", (unsigned long)(coro::now() / 1000U));
+        for (const coro::TaskControl *task = coro::tasks(); task != nullptr; task = task->all_next)
+        {
+            format_percent(total_pct, sizeof(total_pct), task->run_cycles, now);
+            printf("Task: \"%s\", Frame: %lu bytes, Switches: %lu, Runtime: %lu us, CPU Usage: %s%%\n",
+                   task->name, (unsigned long)task->frame_size, (unsigned long)task->switches,
+                   cycles_to_us(task->run_cycles), total_pct);
+        }
+        format_percent(total_pct, sizeof(total_pct), coro::idle_cycles(), now);
+        printf("Idle (WFI): %s%%\n", total_pct);
+        coro::ArenaStats arena;
+        coro::get_arena_stats(&arena);
+        printf("Arena: used %lu of %lu bytes, peak %lu, failed %lu\n", (unsigned long)arena.used,
+               (unsigned long)arena.size, (unsigned long)arena.peak, (unsigned long)arena.failed);
+    }
+}
+
+/* ---- context switch benchmark ----
+ * Two tasks hand the CPU to each other with co_await coro::yield(), the time
+ * from the yield of one task to the return from the yield in the other one
+ * is a switch (including a pass of the scheduler over the timers, events
+ * and polled tasks). Same measurement as "context switch (taskYIELD)" of the
+ * FreeRTOS benchmark. */
+static uint32_t switch_start;
+static bool switch_started;
+static uint32_t switch_count, switch_min = UINT32_MAX, switch_max;
+static uint64_t switch_sum;
+
+static void switch_record()
+{
+    uint32_t cycles = cycle_counter_get() - switch_start;
+    if (!switch_started)
+        return;
+    switch_count++;
+    switch_sum += cycles;
+    if (cycles < switch_min)
+        switch_min = cycles;
+    if (cycles > switch_max)
+        switch_max = cycles;
+}
+
+coro::Task switch_partner()
+{
+    for (uint32_t i = 0; i < SWITCH_BENCH_ITERATIONS; i++)
+    {
+        switch_start = cycle_counter_get();
+        co_await coro::yield();
+        switch_record();
+    }
+}
+
+coro::Task switch_bench()
+{
+    for (uint32_t i = 0; i < SWITCH_BENCH_ITERATIONS; i++)
+    {
+        switch_start = cycle_counter_get();
+        switch_started = true;
+        co_await coro::yield();
+        switch_record();
+    }
+    /* let the partner finish */
+    co_await coro::yield();
+    printf("context switch (co_await yield): n %lu, min %lu, avg %lu, max %lu cycles\n",
+           (unsigned long)switch_count, (unsigned long)switch_min,
+           (unsigned long)(switch_count ? switch_sum / switch_count : 0), (unsigned long)switch_max);
+
+    /* the benchmark tasks return and free their frames, then the demo starts */
+    bool ok = coro::spawn(blinky(), "Blinky");
+    ok &= coro::spawn(button(), "Button");
+    ok &= coro::spawn(console(), "Console");
+    ok &= coro::spawn(task_manager(), "TaskManager");
+    if (!ok)
+        printf("Not enough room for the tasks, increase CORO_ARENA_SIZE\n");
+}
+
+int main(void)
+{
+    systick_config();
+    cycle_counter_init();
+    //configure printf() output via e.g. USART
+    //see function for details
+    init_printf_transport();
+    init_led();
+    init_button();
+    init_console();
+
+    printf("Starting coroutine demo! Arena %u bytes, task control %u bytes\n",
+           (unsigned)CORO_ARENA_SIZE, (unsigned)sizeof(coro::TaskControl));
+    coro::init(cycle_counter_get);
+    coro::spawn(switch_bench(), "SwitchBench");
+    coro::spawn(switch_partner(), "SwitchPartner");
+    coro::run();
+}
+
+void systick_config(void)
+{
+    /* setup systick timer for 1000Hz interrupts */
+    if (SysTick_Config(SystemCoreClock / 1000U))
+    {
+        /* capture error */
+        while (1)
+        {
+        }
+    }
+    /* configure the systick handler priority */
+    NVIC_SetPriority(SysTick_IRQn, 0x00U);
+}
+
+extern "C" void SysTick_Handler(void)
+{
+    cycle_counter_systick_increment();
+    coro::tick_from_isr();
+}
@@ -0,0 +1,272 @@
+#ifndef CONSTEXPR_TABLES_HPP_
+#define CONSTEXPR_TABLES_HPP_
+
+/* Compile-time (C++17 constexpr) generation of sine/cosine, window and FFT
+ * twiddle tables, plus matching lookup kernels.
+ *
+ * All tables are computed by the compiler and end up as constant data in
+ * flash when declared as `constexpr` objects, e.g.
+ *
+ *   constexpr ctables::SineTable<256, ctables::Interpolation::Linear> sine;
+ *   float s = sine.sin(x);
+ *
+ * The table size and interpolation order can be chosen per application, so
+ * flash usage can be traded against accuracy and latency. Use
+ * ctables::table_size_for() to get the smallest table that reaches a given
+ * accuracy and ctables::max_error() to verify it in a static_assert. */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ctables
+{
+
+enum class Interpolation
+{
+    Nearest = 0, /* 1 table read per lookup */
+    Linear = 1,  /* 2 table reads, 1 multiply-add */
+    Cubic = 3,   /* 4 table reads, Catmull-Rom spline */
+};
+
+enum class Window
+{
+    Hann,
+    Hamming,
+    Blackman,
+};
+
+namespace detail
+{
+
+constexpr double pi = 3.14159265358979323846;
+
+constexpr double abs(double x) { return x < 0.0 ? -x : x; }
+
+/* reduces x to [-pi, pi] */
+constexpr double reduce(double x)
+{
+    double k = static_cast<double>(static_cast<long long>(x / (2.0 * pi)));
+    x -= k * 2.0 * pi;
+    if (x > pi)
+        x -= 2.0 * pi;
+    else if (x < -pi)
+        x += 2.0 * pi;
+    return x;
+}
+
+/* sine in double precision, usable at compile time.
+ * reduces to [-pi/2, pi/2] and evaluates the Taylor series there. */
+constexpr double sin(double x)
+{
+    x = reduce(x);
+    /* sin(pi - x) = sin(x) */
+    if (x > pi / 2.0)
+        x = pi - x;
+    else if (x < -pi / 2.0)
+        x = -pi - x;
+    double term = x, sum = x;
+    for (int n = 1; n < 14; n++)
+    {
+        term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+/* cosine in double precision, usable at compile time.
+ * exact for 0 and pi, so that e.g. window end points are exact. */
+constexpr double cos(double x)
+{
+    x = abs(reduce(x));
+    double sign = 1.0;
+    /* cos(pi - x) = -cos(x) */
+    if (x > pi / 2.0)
+    {
+        x = pi - x;
+        sign = -1.0;
+    }
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 14; n++)
+    {
+        term *= -x * x / ((2.0 * n - 1.0) * (2.0 * n));
+        sum += term;
+    }
+    return sign * sum;
+}
+
+constexpr bool is_power_of_two(std::size_t n) { return n != 0 && (n & (n - 1)) == 0; }
+
+} // namespace detail
+
+/* Periodic sine table of N entries per period with lookup functions.
+ * N must be a power of two so that wrapping the index is a simple mask.
+ * The table stores one guard entry in front and two behind the period so
+ * that every interpolation order reads contiguous memory without wrapping. */
+template <std::size_t N, Interpolation I = Interpolation::Linear>
+class SineTable
+{
+    static_assert(N >= 4 && detail::is_power_of_two(N), "table size must be a power of two >= 4");
+
+public:
+    static constexpr std::size_t size = N;
+    static constexpr Interpolation interpolation = I;
+    /* flash used by the table itself */
+    static constexpr std::size_t flash_bytes = (N + 3) * sizeof(float);
+
+    constexpr SineTable() : values_{}
+    {
+        for (std::size_t i = 0; i < N + 3; i++)
+            values_[i] = static_cast<float>(
+                detail::sin(2.0 * detail::pi * (static_cast<double>(i) - 1.0) / static_cast<double>(N)));
+    }
+
+    /* x in radians, any range that fits the int32_t phase (|x| < ~2^31 * 2pi / N) */
+    constexpr float sin(float x) const { return lookup(x * scale); }
+    constexpr float cos(float x) const { return lookup(x * scale + static_cast<float>(N / 4)); }
+
+    /* raw table access, index 0..N-1 is one period */
+    constexpr float operator[](std::size_t i) const { return values_[i + 1]; }
+
+private:
+    static constexpr float scale = static_cast<float>(static_cast<double>(N) / (2.0 * detail::pi));
+
+    /* phase is given in table entries, i.e. N per period */
+    constexpr float lookup(float phase) const
+    {
+        if constexpr (I == Interpolation::Nearest)
+            phase += 0.5f;
+        std::int32_t n = static_cast<std::int32_t>(phase);
+        if (phase < static_cast<float>(n))
+            n--; /* floor() for negative phases */
+        const float frac = phase - static_cast<float>(n);
+        const float *p = &values_[(static_cast<std::uint32_t>(n) & (N - 1)) + 1];
+        if constexpr (I == Interpolation::Nearest)
+        {
+            return p[0];
+        }
+        else if constexpr (I == Interpolation::Linear)
+        {
+            return p[0] + frac * (p[1] - p[0]);
+        }
+        else
+        {
+            /* Catmull-Rom spline through p[-1], p[0], p[1], p[2] */
+            const float a = p[-1], b = p[0], c = p[1], d = p[2];
+            return b + 0.5f * frac * (c - a + frac * (2.0f * a - 5.0f * b + 4.0f * c - d + frac * (3.0f * (b - c) + d - a)));
+        }
+    }
+
+    float values_[N + 3];
+};
+
+/* float rounding of the lookup itself, mostly of the phase computation
+ * x * N / (2*pi). Holds for |x| <= 2*pi, grows linearly for larger x. */
+constexpr double rounding_error = 1e-6;
+
+/* Upper bound of the interpolation error for a sine table of size n,
+ * not including rounding_error. */
+constexpr double error_bound(std::size_t n, Interpolation interp)
+{
+    const double h = 2.0 * detail::pi / static_cast<double>(n);
+    switch (interp)
+    {
+    case Interpolation::Nearest:
+        return h / 2.0; /* max|f'| * h / 2 */
+    case Interpolation::Linear:
+        return h * h / 8.0; /* max|f''| * h^2 / 8 */
+    default:
+        return h * h * h / 16.0; /* Catmull-Rom, O(h^3) */
+    }
+}
+
+/* smallest power-of-two table size whose interpolation error is below max_err */
+constexpr std::size_t table_size_for(double max_err, Interpolation interp)
+{
+    std::size_t n = 4;
+    while (n < (std::size_t(1) << 20) && error_bound(n, interp) + rounding_error > max_err)
+        n *= 2;
+    return n;
+}
+
+/* Measures the maximum absolute error of a table's sin() and cos() against
+ * the double precision reference, at `points` points over [-2pi, 2pi], each
+ * in the middle of its step. The default count is prime, so the points do not
+ * land on the table nodes (where the interpolation is exact) for any table
+ * size but fall at all fractions between them, including near the midpoints
+ * where the interpolation error peaks.
+ * Meant for static_assert(), keep `points` moderate to stay within the
+ * compiler's constexpr evaluation limits. */
+template <typename Table>
+constexpr double max_error(const Table &table, std::size_t points = 1021)
+{
+    double worst = 0.0;
+    for (std::size_t i = 0; i < points; i++)
+    {
+        const double x =
+            -2.0 * detail::pi + 4.0 * detail::pi * (static_cast<double>(i) + 0.5) / static_cast<double>(points);
+        const float xf = static_cast<float>(x);
+        const double es = detail::abs(static_cast<double>(table.sin(xf)) - detail::sin(static_cast<double>(xf)));
+        const double ec = detail::abs(static_cast<double>(table.cos(xf)) - detail::cos(static_cast<double>(xf)));
+        worst = es > worst ? es : worst;
+        worst = ec > worst ? ec : worst;
+    }
+    return worst;
+}
+
+/* Window of N points. Periodic (DFT-even) form as used for spectral analysis,
+ * pass symmetric = true for the symmetric form used in FIR filter design. */
+template <std::size_t N>
+constexpr std::array<float, N> make_window(Window type, bool symmetric = false)
+{
+    static_assert(N >= 2, "window needs at least 2 points");
+    std::array<float, N> w{};
+    const double m = symmetric ? static_cast<double>(N - 1) : static_cast<double>(N);
+    for (std::size_t i = 0; i < N; i++)
+    {
+        const double x = 2.0 * detail::pi * static_cast<double>(i) / m;
+        double v = 0.0;
+        switch (type)
+        {
+        case Window::Hann:
+            v = 0.5 - 0.5 * detail::cos(x);
+            break;
+        case Window::Hamming:
+            v = 0.54 - 0.46 * detail::cos(x);
+            break;
+        case Window::Blackman:
+            v = 0.42 - 0.5 * detail::cos(x) + 0.08 * detail::cos(2.0 * x);
+            break;
+        }
+        w[i] = static_cast<float>(v);
+    }
+    return w;
+}
+
+/* Twiddle factors of an N-point complex FFT in the interleaved layout of the
+ * CMSIS-DSP twiddleCoef_N tables: {cos(2*pi*k/N), sin(2*pi*k/N)} for k < N. */
+template <std::size_t N>
+constexpr std::array<float, 2 * N> make_twiddle()
+{
+    static_assert(detail::is_power_of_two(N), "FFT size must be a power of two");
+    std::array<float, 2 * N> t{};
+    for (std::size_t k = 0; k < N; k++)
+    {
+        const double x = 2.0 * detail::pi * static_cast<double>(k) / static_cast<double>(N);
+        t[2 * k] = static_cast<float>(detail::cos(x));
+        t[2 * k + 1] = static_cast<float>(detail::sin(x));
+    }
+    return t;
+}
+
+/* applies a window to a block of samples, in place */
+template <std::size_t N>
+inline void apply_window(const std::array<float, N> &window, float *samples)
+{
+    for (std::size_t i = 0; i < N; i++)
+        samples[i] *= window[i];
+}
+
+} // namespace ctables
+
+#endif /* CONSTEXPR_TABLES_HPP_ */
@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <math.h>
+#include <gd32_include.h>
+#include <printf_over_x.h>
+#include <cycle_counter.h>
+#include "arm_math.h"
+#include "arm_common_tables.h"
+#include <constexpr_tables.hpp>
+
+using ctables::Interpolation;
+
+/* ----------------------------------------------------------------------
+ * Same test as in the CMSIS-DSP example: cos²(a) + sin²(a) must be 1
+ * within DELTA for all test inputs.
+ * ------------------------------------------------------------------- */
+#define MAX_BLOCKSIZE 32
+#define DELTA (0.0001f)
+
+constexpr float testInput_f32[MAX_BLOCKSIZE] =
+    {
+        -1.244916875853235400, -4.793533929171324800, 0.360705030233248850, 0.827929644170887320, -3.299532218312426900, 3.427441903227623800, 3.422401784294607700, -0.108308165334010680,
+        0.941943896490312180, 0.502609575000365850, -0.537345278736373500, 2.088817392965764500, -1.693168684143455700, 6.283185307179590700, -0.392545884746175080, 0.327893095115825040,
+        3.070147440456292300, 0.170611405884662230, -0.275275082396073010, -2.395492805446796300, 0.847311163536506600, -3.845517018083148800, 2.055818378415868300, 4.672594161978930800,
+        -1.990923030266425800, 2.469305197656249500, 3.609002606064021000, -4.586736582331667500, -4.147080139136136300, 1.643756718868359500, -1.150866392366494800, 1.985805026477433800
+
+};
+
+/* ----------------------------------------------------------------------
+ * Tables, all generated at compile time and placed in flash.
+ * ------------------------------------------------------------------- */
+
+/* smallest tables that still pass the DELTA test, per interpolation order */
+constexpr ctables::SineTable<ctables::table_size_for(DELTA / 2, Interpolation::Linear), Interpolation::Linear> sine_linear;
+constexpr ctables::SineTable<ctables::table_size_for(DELTA / 2, Interpolation::Cubic), Interpolation::Cubic> sine_cubic;
+/* nearest neighbour lookup. fastest but coarse, fails the DELTA test */
+constexpr ctables::SineTable<256, Interpolation::Nearest> sine_nearest;
+
+constexpr auto hann_64 = ctables::make_window<64>(ctables::Window::Hann);
+constexpr auto twiddle_64 = ctables::make_twiddle<64>();
+
+/* the DELTA test, evaluated by the compiler */
+template <typename Table>
+constexpr bool passes_delta_test(const Table &table)
+{
+    for (float a : testInput_f32)
+    {
+        const float s = table.sin(a), c = table.cos(a);
+        const float diff = c * c + s * s - 1.0f;
+        if (diff > DELTA || diff < -DELTA)
+            return false;
+    }
+    return true;
+}
+
+static_assert(passes_delta_test(sine_linear), "linear table fails the DELTA test");
+static_assert(passes_delta_test(sine_cubic), "cubic table fails the DELTA test");
+/* stronger than the identity test: absolute error against the exact sine */
+static_assert(ctables::max_error(sine_linear) < DELTA / 2, "linear table misses its accuracy target");
+static_assert(ctables::max_error(sine_cubic) < DELTA / 2, "cubic table misses its accuracy target");
+static_assert(hann_64[0] == 0.0f && hann_64[32] == 1.0f, "hann window is off");
+static_assert(twiddle_64[0] == 1.0f && twiddle_64[1] == 0.0f, "twiddle table is off");
+
+void systick_config(void);
+void delay_1ms(uint32_t count);
+
+static volatile float32_t sink;
+
+template <typename Table>
+void run_table(const char *name, const Table &table)
+{
+    float32_t max_diff = 0.0f;
+    for (float a : testInput_f32)
+    {
+        const float32_t s = table.sin(a), c = table.cos(a);
+        const float32_t diff = fabsf(1.0f - (c * c + s * s));
+        max_diff = diff > max_diff ? diff : max_diff;
+    }
+
+    uint32_t start = cycle_counter_get();
+    for (float a : testInput_f32)
+    {
+        sink = table.sin(a);
+        sink = table.cos(a);
+    }
+    uint32_t cycles = cycle_counter_get() - start;
+
+    printf("%-22s size %4u, flash %5u bytes, max diff %f, %lu cycles per sin+cos -> %s\n",
+           name, (unsigned)Table::size, (unsigned)Table::flash_bytes, max_diff,
+           (unsigned long)(cycles / MAX_BLOCKSIZE), max_diff > DELTA ? "FAILURE" : "SUCCESS");
+}
+
+void run_cmsis()
+{
+    float32_t max_diff = 0.0f;
+    for (float a : testInput_f32)
+    {
+        const float32_t s = arm_sin_f32(a), c = arm_cos_f32(a);
+        const float32_t diff = fabsf(1.0f - (c * c + s * s));
+        max_diff = diff > max_diff ? diff : max_diff;
+    }
+
+    uint32_t start = cycle_counter_get();
+    for (float a : testInput_f32)
+    {
+        sink = arm_sin_f32(a);
+        sink = arm_cos_f32(a);
+    }
+    uint32_t cycles = cycle_counter_get() - start;
+
+    printf("%-22s size %4u, flash %5u bytes, max diff %f, %lu cycles per sin+cos -> %s\n",
+           "CMSIS-DSP", (unsigned)FAST_MATH_TABLE_SIZE, (unsigned)sizeof(sinTable_f32), max_diff,
+           (unsigned long)(cycles / MAX_BLOCKSIZE), max_diff > DELTA ? "FAILURE" : "SUCCESS");
+}
+
+int main(void)
+{
+    systick_config();
+    cycle_counter_init();
+    //configure printf() output via e.g. USART
+    //see function for details
+    init_printf_transport();
+
+    delay_1ms(500);
+    printf("constexpr sin/cos table example start!\n");
+
+    /* the generated twiddle factors must match the ones of CMSIS-DSP */
+    float32_t twiddle_diff = 0.0f;
+    for (size_t i = 0; i < twiddle_64.size(); i++)
+    {
+        twiddle_diff = fmaxf(twiddle_diff, fabsf(twiddle_64[i] - twiddleCoef_64[i]));
+    }
+    printf("max diff of twiddle table to CMSIS twiddleCoef_64: %f\n", twiddle_diff);
+
+    while (1)
+    {
+        run_cmsis();
+        run_table("constexpr linear", sine_linear);
+        run_table("constexpr cubic", sine_cubic);
+        run_table("constexpr nearest", sine_nearest);
+        //slightly delay
+        delay_1ms(1000);
+    }
+}
+
+volatile static uint32_t delay;
+
+void systick_config(void)
+{
+    /* setup systick timer for 1000Hz interrupts */
+    if (SysTick_Config(SystemCoreClock / 1000U))
+    {
+        /* capture error */
+        while (1)
+        {
+        }
+    }
+    /* configure the systick handler priority */
+    NVIC_SetPriority(SysTick_IRQn, 0x00U);
+}
+
+void delay_1ms(uint32_t count)
+{
+    delay = count;
+
+    while (0U != delay)
+    {
+    }
+}
+
+void delay_decrement(void)
+{
+    if (0U != delay)
+    {
+        delay--;
+    }
+}
+
+extern "C" void SysTick_Handler(void)
+{
+    cycle_counter_systick_increment();
+    delay_decrement();
+}
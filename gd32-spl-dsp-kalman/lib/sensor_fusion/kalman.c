@@ -0,0 +1,80 @@
+#include "kalman.h"
+
+/* returns early on the first failing CMSIS-DSP call */
+#define CHECK(call)                      \
+    do                                   \
+    {                                    \
+        arm_status _status = (call);     \
+        if (_status != ARM_MATH_SUCCESS) \
+            return _status;              \
+    } while (0)
+
+arm_status kalman_init(kalman_filter_t *kf, mat_arena_t *arena, uint16_t n, uint16_t m)
+{
+    kf->n = n;
+    kf->m = m;
+    CHECK(mat_arena_matrix(arena, &kf->x, n, 1));
+    CHECK(mat_arena_matrix(arena, &kf->P, n, n));
+    CHECK(mat_arena_matrix(arena, &kf->F, n, n));
+    CHECK(mat_arena_matrix(arena, &kf->Q, n, n));
+    CHECK(mat_arena_matrix(arena, &kf->H, m, n));
+    CHECK(mat_arena_matrix(arena, &kf->R, m, m));
+    CHECK(mat_arena_matrix(arena, &kf->Ft, n, n));
+    CHECK(mat_arena_matrix(arena, &kf->Ht, n, m));
+    CHECK(mat_arena_matrix(arena, &kf->tmp_n, n, 1));
+    CHECK(mat_arena_matrix(arena, &kf->tmp_nn, n, n));
+    CHECK(mat_arena_matrix(arena, &kf->KHP, n, n));
+    CHECK(mat_arena_matrix(arena, &kf->HP, m, n));
+    CHECK(mat_arena_matrix(arena, &kf->PHt, n, m));
+    CHECK(mat_arena_matrix(arena, &kf->K, n, m));
+    CHECK(mat_arena_matrix(arena, &kf->S, m, m));
+    CHECK(mat_arena_matrix(arena, &kf->S_inv, m, m));
+    CHECK(mat_arena_matrix(arena, &kf->y, m, 1));
+    CHECK(mat_arena_matrix(arena, &kf->Hx, m, 1));
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status kalman_set_model(kalman_filter_t *kf)
+{
+    CHECK(arm_mat_trans_f32(&kf->F, &kf->Ft));
+    CHECK(arm_mat_trans_f32(&kf->H, &kf->Ht));
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status kalman_predict(kalman_filter_t *kf)
+{
+    const uint32_t nn = (uint32_t)kf->n * kf->n;
+
+    /* x = F x */
+    CHECK(arm_mat_mult_f32(&kf->F, &kf->x, &kf->tmp_n));
+    arm_copy_f32(kf->tmp_n.pData, kf->x.pData, kf->n);
+    /* P = F P F' + Q */
+    CHECK(arm_mat_mult_f32(&kf->F, &kf->P, &kf->tmp_nn));
+    CHECK(arm_mat_mult_f32(&kf->tmp_nn, &kf->Ft, &kf->P));
+    arm_add_f32(kf->P.pData, kf->Q.pData, kf->P.pData, nn);
+    return ARM_MATH_SUCCESS;
+}
+
+arm_status kalman_update(kalman_filter_t *kf, const float32_t *z)
+{
+    /* innovation y = z - H x */
+    CHECK(arm_mat_mult_f32(&kf->H, &kf->x, &kf->Hx));
+    arm_sub_f32(z, kf->Hx.pData, kf->y.pData, kf->m);
+    /* P H', and H P as its transpose since P is symmetric */
+    CHECK(arm_mat_mult_f32(&kf->P, &kf->Ht, &kf->PHt));
+    CHECK(arm_mat_trans_f32(&kf->PHt, &kf->HP));
+    /* S = H P H' + R */
+    CHECK(arm_mat_mult_f32(&kf->H, &kf->PHt, &kf->S));
+    arm_add_f32(kf->S.pData, kf->R.pData, kf->S.pData, (uint32_t)kf->m * kf->m);
+    /* the inversion overwrites S, which is recomputed every step anyway */
+    CHECK(arm_mat_inverse_f32(&kf->S, &kf->S_inv));
+    /* K = P H' S^-1 */
+    CHECK(arm_mat_mult_f32(&kf->PHt, &kf->S_inv, &kf->K));
+    /* x = x + K y */
+    CHECK(arm_mat_mult_f32(&kf->K, &kf->y, &kf->tmp_n));
+    arm_add_f32(kf->x.pData, kf->tmp_n.pData, kf->x.pData, kf->n);
+    /* P = P - K H P */
+    CHECK(arm_mat_mult_f32(&kf->K, &kf->HP, &kf->KHP));
+    arm_sub_f32(kf->P.pData, kf->KHP.pData, kf->P.pData, (uint32_t)kf->n * kf->n);
+    return ARM_MATH_SUCCESS;
+}
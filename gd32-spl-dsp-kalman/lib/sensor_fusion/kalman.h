@@ -0,0 +1,74 @@
+#ifndef KALMAN_H_
+#define KALMAN_H_
+
+#include <stdint.h>
+#include "arm_math.h"
+#include "mat_arena.h"
+
+/* Linear Kalman filter on top of the CMSIS-DSP matrix functions.
+ *
+ * n = number of states, m = number of measurements. All matrices and the
+ * workspaces of one step are allocated from an arena in kalman_init(), so
+ * kalman_predict() and kalman_update() never allocate memory.
+ *
+ * Usage:
+ *   static float32_t buffer[KALMAN_ARENA_FLOATS(4, 2)];
+ *   mat_arena_init(&arena, buffer, KALMAN_ARENA_FLOATS(4, 2));
+ *   kalman_init(&kf, &arena, 4, 2);
+ *   ... fill kf.F, kf.H, kf.Q, kf.R and the initial kf.x, kf.P ...
+ *   kalman_set_model(&kf);
+ *   every step: kalman_predict(&kf); kalman_update(&kf, z);
+ */
+
+/* number of floats kalman_init() takes from the arena */
+#define KALMAN_ARENA_FLOATS(n, m) \
+    (2 * (n) + 6 * (n) * (n) + 5 * (n) * (m) + 3 * (m) * (m) + 2 * (m))
+
+typedef struct
+{
+    uint16_t n; /* states */
+    uint16_t m; /* measurements */
+
+    /* state estimate and covariance */
+    arm_matrix_instance_f32 x; /* n x 1 */
+    arm_matrix_instance_f32 P; /* n x n */
+
+    /* model, set by the user before kalman_set_model() */
+    arm_matrix_instance_f32 F; /* n x n, state transition */
+    arm_matrix_instance_f32 Q; /* n x n, process noise covariance */
+    arm_matrix_instance_f32 H; /* m x n, measurement matrix */
+    arm_matrix_instance_f32 R; /* m x m, measurement noise covariance */
+
+    /* transposed model, computed once by kalman_set_model() */
+    arm_matrix_instance_f32 Ft; /* n x n */
+    arm_matrix_instance_f32 Ht; /* n x m */
+
+    /* workspaces */
+    arm_matrix_instance_f32 tmp_n;   /* n x 1 */
+    arm_matrix_instance_f32 tmp_nn;  /* n x n */
+    arm_matrix_instance_f32 KHP;     /* n x n */
+    arm_matrix_instance_f32 HP;      /* m x n */
+    arm_matrix_instance_f32 PHt;     /* n x m */
+    arm_matrix_instance_f32 K;       /* n x m, Kalman gain */
+    arm_matrix_instance_f32 S;       /* m x m, innovation covariance */
+    arm_matrix_instance_f32 S_inv;   /* m x m */
+    arm_matrix_instance_f32 y;       /* m x 1, innovation */
+    arm_matrix_instance_f32 Hx;      /* m x 1 */
+} kalman_filter_t;
+
+/* Allocates all matrices from the arena, zero-filled.
+ * Returns ARM_MATH_SIZE_MISMATCH if the arena is too small. */
+arm_status kalman_init(kalman_filter_t *kf, mat_arena_t *arena, uint16_t n, uint16_t m);
+
+/* Must be called after F or H were changed. */
+arm_status kalman_set_model(kalman_filter_t *kf);
+
+/* x = F x, P = F P F' + Q */
+arm_status kalman_predict(kalman_filter_t *kf);
+
+/* Corrects the state with the measurement z (m values).
+ * Returns ARM_MATH_SINGULAR if the innovation covariance can't be inverted,
+ * the state is left unchanged then. */
+arm_status kalman_update(kalman_filter_t *kf, const float32_t *z);
+
+#endif /* KALMAN_H_ */
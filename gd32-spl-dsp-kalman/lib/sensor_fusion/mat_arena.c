@@ -0,0 +1,23 @@
+#include "mat_arena.h"
+#include <string.h>
+
+void mat_arena_init(mat_arena_t *arena, float32_t *buffer, size_t num_floats)
+{
+    arena->base = buffer;
+    arena->size = num_floats;
+    arena->used = 0;
+}
+
+arm_status mat_arena_matrix(mat_arena_t *arena, arm_matrix_instance_f32 *mat, uint16_t rows, uint16_t cols)
+{
+    size_t n = (size_t)rows * cols;
+    if (n > arena->size - arena->used)
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+    float32_t *data = arena->base + arena->used;
+    arena->used += n;
+    memset(data, 0, n * sizeof(float32_t));
+    arm_mat_init_f32(mat, rows, cols, data);
+    return ARM_MATH_SUCCESS;
+}
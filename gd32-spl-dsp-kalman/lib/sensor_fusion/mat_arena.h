@@ -0,0 +1,38 @@
+#ifndef MAT_ARENA_H_
+#define MAT_ARENA_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arm_math.h"
+
+/* Fixed-size memory arena for CMSIS-DSP matrices.
+ *
+ * All matrices and workspaces of a filter are carved out of one buffer once
+ * at init. There is no free(): the arena lives as long as the filter, so
+ * there is no allocation (and no heap) in the processing path at all.
+ *
+ *   static float32_t buffer[KALMAN_ARENA_FLOATS(4, 2)];
+ *   mat_arena_t arena;
+ *   mat_arena_init(&arena, buffer, sizeof(buffer) / sizeof(buffer[0]));
+ */
+typedef struct
+{
+    float32_t *base;
+    size_t size; /* in floats */
+    size_t used; /* in floats */
+} mat_arena_t;
+
+void mat_arena_init(mat_arena_t *arena, float32_t *buffer, size_t num_floats);
+
+/* Takes rows * cols floats from the arena and initializes the matrix
+ * instance to point to them, zero-filled.
+ * Returns ARM_MATH_SIZE_MISMATCH if the arena is too small. */
+arm_status mat_arena_matrix(mat_arena_t *arena, arm_matrix_instance_f32 *mat, uint16_t rows, uint16_t cols);
+
+/* floats in use, to size the buffer */
+static inline size_t mat_arena_used(const mat_arena_t *arena)
+{
+    return arena->used;
+}
+
+#endif /* MAT_ARENA_H_ */
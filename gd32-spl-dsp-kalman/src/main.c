@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <math.h>
+#include <gd32_include.h>
+#include <printf_over_x.h>
+#include <cycle_counter.h>
+#include "arm_math.h"
+#include <kalman.h>
+
+/* ----------------------------------------------------------------------
+ * Constant-velocity model: the state is [position, velocity] per axis,
+ * only the positions are measured. 2 axes give the 4x4 filter, 3 axes the
+ * 6x6 filter.
+ * ------------------------------------------------------------------- */
+#define DT (0.01f)           /* 100 Hz update rate */
+#define ACCEL_NOISE (0.5f)   /* process noise, m/s² */
+#define MEAS_NOISE (0.2f)    /* measurement noise, m */
+#define NUM_STEPS 200
+
+/* all matrices of both filters, allocated once */
+static float32_t arena_2d_buffer[KALMAN_ARENA_FLOATS(4, 2)];
+static float32_t arena_3d_buffer[KALMAN_ARENA_FLOATS(6, 3)];
+static mat_arena_t arena_2d, arena_3d;
+static kalman_filter_t kf_2d, kf_3d;
+
+void systick_config(void);
+void delay_1ms(uint32_t count);
+
+/* element access, row-major like CMSIS-DSP */
+#define MAT(mat, r, c) ((mat).pData[(r) * (mat).numCols + (c)])
+
+static void cv_model_setup(kalman_filter_t *kf, uint16_t axes)
+{
+    const float32_t q = ACCEL_NOISE * ACCEL_NOISE;
+    for (uint16_t i = 0; i < axes; i++)
+    {
+        const uint16_t p = i, v = axes + i;
+        /* position += velocity * dt */
+        MAT(kf->F, p, p) = 1.0f;
+        MAT(kf->F, v, v) = 1.0f;
+        MAT(kf->F, p, v) = DT;
+        /* white noise acceleration, discretized */
+        MAT(kf->Q, p, p) = q * DT * DT * DT * DT / 4.0f;
+        MAT(kf->Q, p, v) = q * DT * DT * DT / 2.0f;
+        MAT(kf->Q, v, p) = q * DT * DT * DT / 2.0f;
+        MAT(kf->Q, v, v) = q * DT * DT;
+        MAT(kf->H, i, p) = 1.0f;
+        MAT(kf->R, i, i) = MEAS_NOISE * MEAS_NOISE;
+        /* start at 0 with a large uncertainty */
+        MAT(kf->P, p, p) = 10.0f;
+        MAT(kf->P, v, v) = 10.0f;
+    }
+    kalman_set_model(kf);
+}
+
+/* measurement noise: sum of uniform values from a LCG, roughly gaussian */
+static uint32_t rng_state = 12345;
+
+static float32_t noise(float32_t sigma)
+{
+    float32_t sum = 0.0f;
+    for (int i = 0; i < 4; i++)
+    {
+        rng_state = rng_state * 1664525u + 1013904223u;
+        sum += (float32_t)(rng_state >> 8) / 16777216.0f - 0.5f;
+    }
+    /* variance of the sum of 4 uniform values in [-0.5, 0.5] is 1/3 */
+    return sum * sigma * 1.7320508f;
+}
+
+static void run_filter(const char *name, kalman_filter_t *kf, mat_arena_t *arena, uint16_t axes)
+{
+    float32_t z[3];
+    float32_t err_meas = 0.0f, err_filter = 0.0f;
+    uint32_t min = UINT32_MAX, max = 0, sum = 0, failed = 0;
+
+    cv_model_setup(kf, axes);
+    for (uint32_t step = 1; step <= NUM_STEPS; step++)
+    {
+        /* true motion: 1 m/s on every axis, with different offsets */
+        const float32_t t = step * DT;
+        for (uint16_t i = 0; i < axes; i++)
+        {
+            z[i] = (float32_t)i + t + noise(MEAS_NOISE);
+        }
+
+        uint32_t start = cycle_counter_get();
+        if (kalman_predict(kf) != ARM_MATH_SUCCESS || kalman_update(kf, z) != ARM_MATH_SUCCESS)
+        {
+            failed++;
+        }
+        uint32_t cycles = cycle_counter_get() - start;
+        min = cycles < min ? cycles : min;
+        max = cycles > max ? cycles : max;
+        sum += cycles;
+
+        /* errors over the second half, after the filter settled */
+        if (step > NUM_STEPS / 2)
+        {
+            for (uint16_t i = 0; i < axes; i++)
+            {
+                const float32_t truth = (float32_t)i + t;
+                err_meas += (z[i] - truth) * (z[i] - truth);
+                err_filter += (kf->x.pData[i] - truth) * (kf->x.pData[i] - truth);
+            }
+        }
+    }
+
+    printf("%s: %ux%u state, arena %u bytes, cycles per update min %lu avg %lu max %lu, %lu failed\n",
+           name, (unsigned)kf->n, (unsigned)kf->n, (unsigned)(mat_arena_used(arena) * sizeof(float32_t)),
+           (unsigned long)min, (unsigned long)(sum / NUM_STEPS), (unsigned long)max, (unsigned long)failed);
+    printf("  position RMS error: measured %f m, filtered %f m, velocity estimate %f m/s\n",
+           sqrtf(err_meas / (axes * NUM_STEPS / 2)), sqrtf(err_filter / (axes * NUM_STEPS / 2)),
+           kf->x.pData[axes]);
+}
+
+int main(void)
+{
+    systick_config();
+    cycle_counter_init();
+    //configure printf() output via e.g. USART
+    //see function for details
+    init_printf_transport();
+
+    delay_1ms(500);
+    printf("Kalman filter example start! SystemCoreClock = %lu Hz\n", (unsigned long)SystemCoreClock);
+
+    mat_arena_init(&arena_2d, arena_2d_buffer, sizeof(arena_2d_buffer) / sizeof(arena_2d_buffer[0]));
+    mat_arena_init(&arena_3d, arena_3d_buffer, sizeof(arena_3d_buffer) / sizeof(arena_3d_buffer[0]));
+    if (kalman_init(&kf_2d, &arena_2d, 4, 2) != ARM_MATH_SUCCESS ||
+        kalman_init(&kf_3d, &arena_3d, 6, 3) != ARM_MATH_SUCCESS)
+    {
+        printf("arena too small!\n");
+        while (1)
+        {
+        }
+    }
+
+    run_filter("2D constant velocity", &kf_2d, &arena_2d, 2);
+    run_filter("3D constant velocity", &kf_3d, &arena_3d, 3);
+
+    while (1)
+    {
+        delay_1ms(1000);
+    }
+}
+
+volatile static uint32_t delay;
+
+void systick_config(void)
+{
+    /* setup systick timer for 1000Hz interrupts */
+    if (SysTick_Config(SystemCoreClock / 1000U))
+    {
+        /* capture error */
+        while (1)
+        {
+        }
+    }
+    /* configure the systick handler priority */
+    NVIC_SetPriority(SysTick_IRQn, 0x00U);
+}
+
+void delay_1ms(uint32_t count)
+{
+    delay = count;
+
+    while (0U != delay)
+    {
+    }
+}
+
+void delay_decrement(void)
+{
+    if (0U != delay)
+    {
+        delay--;
+    }
+}
+
+void SysTick_Handler(void)
+{
+    cycle_counter_systick_increment();
+    delay_decrement();
+}
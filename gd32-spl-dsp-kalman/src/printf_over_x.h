@@ -0,0 +1,15 @@
+#ifndef PRINTF_OVER_X_H_
+#define PRINTF_OVER_X_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Initializes printf transport system, e.g., the UART of semihosting service. */
+void init_printf_transport();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PRINTF_OVER_X_H_ */
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "defer.h"
+
+static defer_source_t *defer_sources[DEFER_MAX_SOURCES];
+static uint32_t defer_num_sources;
+
+#if !DEFER_USE_TIMER_DAEMON
+static TaskHandle_t defer_task;
+static StaticTask_t defer_task_tcb;
+static StackType_t defer_task_stack[DEFER_TASK_STACK_SIZE];
+#endif
+
+#if defined(GD32E23x)
+/* The Cortex-M23 has no DWT cycle counter. The cycles are derived from the
+ * FreeRTOS tick count and the SysTick, which counts down from the CPU clock. */
+static uint32_t defer_now(void)
+{
+    uint32_t load = SysTick->LOAD;
+    uint32_t val = SysTick->VAL;
+    uint32_t ticks = (uint32_t)xTaskGetTickCountFromISR();
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* reloaded, but the tick interrupt did not run yet */
+        val = SysTick->VAL;
+        ticks++;
+    }
+    return ticks * (load + 1U) + (load - val);
+}
+
+static void defer_now_init(void)
+{
+}
+#else
+static uint32_t defer_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+static void defer_now_init(void)
+{
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#endif
+
+/* calls the handler for all pending raises of src, in task context */
+static void defer_run(defer_source_t *src)
+{
+    taskENTER_CRITICAL();
+    uint32_t count = src->pending;
+    uint32_t raised_at = src->raised_at;
+    src->pending = 0U;
+    taskEXIT_CRITICAL();
+    if (count == 0U)
+    {
+        return;
+    }
+
+    uint32_t start = defer_now();
+    src->handler(src->arg, count);
+    uint32_t end = defer_now();
+
+    uint32_t latency = start - raised_at;
+    uint32_t duration = end - start;
+    taskENTER_CRITICAL();
+    src->stats.runs++;
+    src->stats.latency_total_cycles += latency;
+    if (latency > src->stats.latency_max_cycles)
+    {
+        src->stats.latency_max_cycles = latency;
+    }
+    src->stats.handler_total_cycles += duration;
+    if (duration > src->stats.handler_max_cycles)
+    {
+        src->stats.handler_max_cycles = duration;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#if DEFER_USE_TIMER_DAEMON
+static void defer_pended(void *param, uint32_t unused)
+{
+    (void)unused;
+    defer_run((defer_source_t *)param);
+}
+#else
+static void defer_task_func(void *param)
+{
+    (void)param;
+    for (;;)
+    {
+        uint32_t bits = 0U;
+        xTaskNotifyWait(0U, UINT32_MAX, &bits, portMAX_DELAY);
+        for (uint32_t i = 0; i < defer_num_sources; i++)
+        {
+            if (bits & (1UL << i))
+            {
+                defer_run(defer_sources[i]);
+            }
+        }
+    }
+}
+#endif
+
+BaseType_t defer_init(void)
+{
+    defer_now_init();
+#if !DEFER_USE_TIMER_DAEMON
+    if (defer_task == NULL)
+    {
+        defer_task = xTaskCreateStatic(defer_task_func, "Defer", DEFER_TASK_STACK_SIZE, NULL,
+                                       DEFER_TASK_PRIORITY, defer_task_stack, &defer_task_tcb);
+    }
+    return defer_task != NULL ? pdPASS : pdFAIL;
+#else
+    return pdPASS;
+#endif
+}
+
+BaseType_t defer_register(defer_source_t *src, const char *name, defer_handler_t handler, void *arg)
+{
+    BaseType_t ret = pdFAIL;
+    taskENTER_CRITICAL();
+    if (defer_num_sources < DEFER_MAX_SOURCES)
+    {
+        src->name = name;
+        src->handler = handler;
+        src->arg = arg;
+        src->number = defer_num_sources;
+        src->pending = 0U;
+        src->stats = (defer_stats_t){0};
+        defer_sources[defer_num_sources++] = src;
+        ret = pdPASS;
+    }
+    taskEXIT_CRITICAL();
+    return ret;
+}
+
+void defer_isr_enter(defer_source_t *src)
+{
+    src->isr_start = defer_now();
+}
+
+void defer_isr_exit(defer_source_t *src, BaseType_t woken)
+{
+    uint32_t duration = defer_now() - src->isr_start;
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    src->stats.isr_count++;
+    src->stats.isr_total_cycles += duration;
+    if (duration > src->stats.isr_max_cycles)
+    {
+        src->stats.isr_max_cycles = duration;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    portYIELD_FROM_ISR(woken);
+}
+
+void defer_raise_from_isr(defer_source_t *src, BaseType_t *woken)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    uint32_t was_pending = src->pending;
+    if (was_pending == 0U)
+    {
+        src->raised_at = defer_now();
+    }
+    src->pending = was_pending + 1U;
+    src->stats.raised++;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+
+#if DEFER_USE_TIMER_DAEMON
+    /* one call in the timer queue per source is enough */
+    if (was_pending == 0U && xTimerPendFunctionCallFromISR(defer_pended, src, 0U, woken) != pdPASS)
+    {
+        /* timer queue full, without a call the source would stay pending */
+        mask = portSET_INTERRUPT_MASK_FROM_ISR();
+        src->stats.dropped += src->pending;
+        src->pending = 0U;
+        portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    }
+#else
+    xTaskNotifyFromISR(defer_task, 1UL << src->number, eSetBits, woken);
+#endif
+}
+
+void defer_get_stats(const defer_source_t *src, defer_stats_t *stats)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    *stats = src->stats;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+}
+
+uint32_t defer_cycles_to_us(uint32_t cycles)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    return cycles / (cycles_per_us ? cycles_per_us : 1U);
+}
+
+static uint32_t defer_avg_us(uint64_t total, uint32_t count)
+{
+    return count ? defer_cycles_to_us((uint32_t)(total / count)) : 0U;
+}
+
+void defer_print(void)
+{
+    for (uint32_t i = 0; i < defer_num_sources; i++)
+    {
+        defer_stats_t s;
+        defer_get_stats(defer_sources[i], &s);
+        printf("DEFER: \"%s\" raised %lu runs %lu dropped %lu isr avg %lu max %lu us latency avg %lu max %lu us "
+               "handler avg %lu max %lu us\n",
+               defer_sources[i]->name, (unsigned long)s.raised, (unsigned long)s.runs, (unsigned long)s.dropped,
+               (unsigned long)defer_avg_us(s.isr_total_cycles, s.isr_count),
+               (unsigned long)defer_cycles_to_us(s.isr_max_cycles),
+               (unsigned long)defer_avg_us(s.latency_total_cycles, s.runs),
+               (unsigned long)defer_cycles_to_us(s.latency_max_cycles),
+               (unsigned long)defer_avg_us(s.handler_total_cycles, s.runs),
+               (unsigned long)defer_cycles_to_us(s.handler_max_cycles));
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Deferred interrupt processing ("bottom halves") for FreeRTOS, included with
+ * PIO_FREERTOS_DEFER (see build_freertos.py).
+ *
+ * An interrupt handler only does what cannot wait (clear the flag, read the
+ * data register, mask a level triggered interrupt) and raises its source.
+ * The handler registered for the source then runs in a task:
+ *   - DEFER_USE_TIMER_DAEMON 0 (default): a dedicated task of priority
+ *     DEFER_TASK_PRIORITY, woken with a direct-to-task notification, one bit
+ *     per source. Lower source numbers (registered first) run first.
+ *   - DEFER_USE_TIMER_DAEMON 1: the FreeRTOS timer task, through
+ *     xTimerPendFunctionCallFromISR(). Needs configUSE_TIMERS and
+ *     INCLUDE_xTimerPendFunctionCall, saves the stack of the extra task.
+ * Raises that happen before the handler ran are merged, the handler gets
+ * their number. This bounds the memory and the time in the interrupt, but
+ * the handler must process everything that is pending, not one event.
+ *
+ * Per source, the ISR time (defer_isr_enter() to defer_isr_exit()), the
+ * deferral latency (first raise to the start of the handler) and the handler
+ * time are measured in CPU cycles: the DWT cycle counter, on the Cortex-M23
+ * the SysTick together with the tick count.
+ *
+ *   void TIMER2_IRQHandler(void)
+ *   {
+ *       BaseType_t woken = pdFALSE;
+ *       defer_isr_enter(&timer_source);
+ *       timer_interrupt_flag_clear(TIMER2, TIMER_INT_FLAG_UP);
+ *       defer_raise_from_isr(&timer_source, &woken);
+ *       defer_isr_exit(&timer_source, woken);
+ *   }
+ */
+#ifndef DEFER_H_
+#define DEFER_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef DEFER_USE_TIMER_DAEMON
+#define DEFER_USE_TIMER_DAEMON 0
+#endif
+
+/* one bit of the notification value per source */
+#ifndef DEFER_MAX_SOURCES
+#define DEFER_MAX_SOURCES 8
+#endif
+
+#ifndef DEFER_TASK_PRIORITY
+#define DEFER_TASK_PRIORITY (configMAX_PRIORITIES - 1)
+#endif
+#ifndef DEFER_TASK_STACK_SIZE
+#define DEFER_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE * 2)
+#endif
+
+#if DEFER_MAX_SOURCES > 32
+#error "DEFER_MAX_SOURCES must not be larger than 32"
+#endif
+
+/* runs in the deferral task with interrupts enabled, count is the number of
+ * raises since the last call (at least 1) */
+typedef void (*defer_handler_t)(void *arg, uint32_t count);
+
+typedef struct
+{
+    uint32_t raised;    /* defer_raise_from_isr() calls */
+    uint32_t runs;      /* handler calls, fewer than raised if raises were merged */
+    uint32_t dropped;   /* raises lost to a full timer queue (DEFER_USE_TIMER_DAEMON) */
+    uint32_t isr_count; /* defer_isr_exit() calls */
+    uint32_t isr_max_cycles;
+    uint64_t isr_total_cycles;
+    uint32_t latency_max_cycles;
+    uint64_t latency_total_cycles;
+    uint32_t handler_max_cycles;
+    uint64_t handler_total_cycles;
+} defer_stats_t;
+
+typedef struct defer_source
+{
+    const char *name;
+    defer_handler_t handler;
+    void *arg;
+    uint32_t number;
+    volatile uint32_t pending;   /* raises since the last handler call */
+    volatile uint32_t raised_at; /* time of the first of them */
+    uint32_t isr_start;
+    defer_stats_t stats;
+} defer_source_t;
+
+/* creates the deferral task, call before the scheduler starts. Does nothing
+ * with DEFER_USE_TIMER_DAEMON. */
+BaseType_t defer_init(void);
+
+/* registers a source, pdFAIL if there are DEFER_MAX_SOURCES already. The
+ * source must stay valid (static). */
+BaseType_t defer_register(defer_source_t *src, const char *name, defer_handler_t handler, void *arg);
+
+/* first and last call in the interrupt handler, for the ISR time. woken is
+ * the value set by defer_raise_from_isr() (or other FromISR calls), the exit
+ * switches to the deferral task if it has to run. */
+void defer_isr_enter(defer_source_t *src);
+void defer_isr_exit(defer_source_t *src, BaseType_t woken);
+
+/* has the handler of src called, sets *woken to pdTRUE if a context switch is
+ * needed. Also usable without defer_isr_enter() / defer_isr_exit(). */
+void defer_raise_from_isr(defer_source_t *src, BaseType_t *woken);
+
+/* copy of the statistics of src */
+void defer_get_stats(const defer_source_t *src, defer_stats_t *stats);
+
+/* prints one line per source:
+ * DEFER: "<name>" raised <n> runs <n> dropped <n> isr avg/max <us> latency avg/max <us> handler avg/max <us> */
+void defer_print(void);
+
+uint32_t defer_cycles_to_us(uint32_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEFER_H_ */
@@ -0,0 +1,71 @@
+/*
+ * Statistics of the TLSF heap (heap_tlsf.c), which replaces heap_4.c when
+ * PIO_FREERTOS_HEAP_TLSF is defined.
+ *
+ * Besides the values of vPortGetHeapStats(), the TLSF heap keeps
+ *   - per size class: the free blocks and bytes, the used blocks (current and
+ *     peak) and the number of allocations
+ *   - a fragmentation index: how much of the free memory is not part of the
+ *     largest free block
+ *   - per allocation site (the caller of pvPortMalloc()): the used bytes
+ *     (current and peak) and the number of allocations. The site addresses can
+ *     be resolved with arm-none-eabi-addr2line -f -e firmware.elf <address>.
+ */
+#ifndef HEAP_TLSF_H_
+#define HEAP_TLSF_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    size_t free_bytes;          /* sum of the free blocks, without headers */
+    size_t min_ever_free_bytes;
+    size_t largest_free_block;
+    size_t used_bytes;          /* sum of the used blocks, without headers */
+    size_t free_blocks;
+    size_t used_blocks;
+    size_t successful_allocs;
+    size_t successful_frees;
+    size_t failed_allocs;
+    /* 0: all free memory is in one block, 1000: the largest free block is
+     * negligible compared to the free memory */
+    uint32_t fragmentation_permille;
+} heap_tlsf_stats_t;
+
+/* one first-level size class: blocks from min_size up to 2 * min_size - 1
+ * bytes (the first class holds all small blocks, from 0 bytes) */
+typedef struct
+{
+    size_t min_size;
+    size_t free_blocks;
+    size_t free_bytes;
+    size_t used_blocks;
+    size_t peak_used_blocks;
+    size_t allocs;
+} heap_tlsf_class_stats_t;
+
+typedef struct
+{
+    const void *site; /* return address of the pvPortMalloc() call, NULL for "other sites" */
+    size_t used_bytes;
+    size_t peak_used_bytes;
+    size_t used_blocks;
+    size_t allocs;
+} heap_tlsf_site_stats_t;
+
+void heap_tlsf_get_stats(heap_tlsf_stats_t *stats);
+
+/* copy up to max_classes / max_sites entries, return the number copied */
+size_t heap_tlsf_get_class_stats(heap_tlsf_class_stats_t *classes, size_t max_classes);
+size_t heap_tlsf_get_site_stats(heap_tlsf_site_stats_t *sites, size_t max_sites);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_TLSF_H_ */
@@ -0,0 +1,142 @@
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "mpool.h"
+
+BaseType_t mpool_init(mpool_t *mp, void *mem, uint32_t mem_size, uint32_t block_count, uint32_t block_size,
+                      BaseType_t blocking)
+{
+    uint32_t size = MPOOL_BLOCK_SIZE(block_size);
+    if (mp == NULL || mem == NULL || block_count == 0U || block_size == 0U ||
+        ((uint32_t)mem & 3U) != 0U || mem_size < size * block_count)
+    {
+        return pdFAIL;
+    }
+    mp->mem = mem;
+    mp->block_size = size;
+    mp->block_count = block_count;
+    mp->waiters = 0U;
+    mp->sem = NULL;
+    if (blocking)
+    {
+#if (configUSE_COUNTING_SEMAPHORES == 1) && (configSUPPORT_STATIC_ALLOCATION == 1)
+        mp->sem = xSemaphoreCreateCountingStatic(block_count, 0, &mp->sem_buffer);
+#elif (configUSE_COUNTING_SEMAPHORES == 1) && (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        mp->sem = xSemaphoreCreateCounting(block_count, 0);
+#endif
+        if (mp->sem == NULL)
+        {
+            return pdFAIL;
+        }
+    }
+
+    /* link all blocks, the lowest address first */
+    mpool_block_t *next = NULL;
+    for (uint32_t i = block_count; i > 0U; i--)
+    {
+        mpool_block_t *block = (mpool_block_t *)(mp->mem + (i - 1U) * size);
+        block->next = next;
+        next = block;
+    }
+    mp->head = next;
+    return pdPASS;
+}
+
+void *mpool_alloc(mpool_t *mp)
+{
+    mpool_block_t *block;
+#if MPOOL_USE_EXCLUSIVES
+    do
+    {
+        block = (mpool_block_t *)mpool_ldrex((volatile uint32_t *)&mp->head);
+        if (block == NULL)
+        {
+            mpool_clrex();
+            return NULL;
+        }
+    } while (mpool_strex((uint32_t)block->next, (volatile uint32_t *)&mp->head) != 0U);
+#else
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    block = mp->head;
+    if (block != NULL)
+    {
+        mp->head = block->next;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+#endif
+    return block;
+}
+
+void *mpool_alloc_wait(mpool_t *mp, TickType_t timeout)
+{
+    void *block = mpool_alloc(mp);
+    if (block != NULL || timeout == 0U || mp->sem == NULL || xPortIsInsideInterrupt())
+    {
+        return block;
+    }
+
+    TimeOut_t time_out;
+    vTaskSetTimeOutState(&time_out);
+    /* announce the wait before checking again, so that a block freed in
+     * between is either found or signals the semaphore */
+    taskENTER_CRITICAL();
+    mp->waiters++;
+    taskEXIT_CRITICAL();
+    for (;;)
+    {
+        block = mpool_alloc(mp);
+        if (block != NULL || xTaskCheckForTimeOut(&time_out, &timeout) != pdFALSE)
+        {
+            break;
+        }
+        /* the semaphore may have been given for a block that another task
+         * took in the meantime, then the loop waits again */
+        xSemaphoreTake(mp->sem, timeout);
+    }
+    taskENTER_CRITICAL();
+    mp->waiters--;
+    taskEXIT_CRITICAL();
+    return block;
+}
+
+BaseType_t mpool_free(mpool_t *mp, void *block)
+{
+    uint32_t offset = (uint32_t)((uint8_t *)block - mp->mem);
+    if ((uint8_t *)block < mp->mem || offset >= mp->block_size * mp->block_count ||
+        (offset % mp->block_size) != 0U)
+    {
+        return pdFAIL;
+    }
+
+    mpool_block_t *b = block;
+#if MPOOL_USE_EXCLUSIVES
+    do
+    {
+        b->next = (mpool_block_t *)mpool_ldrex((volatile uint32_t *)&mp->head);
+    } while (mpool_strex((uint32_t)b, (volatile uint32_t *)&mp->head) != 0U);
+#else
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    b->next = mp->head;
+    mp->head = b;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+#endif
+
+    /* slow path, only if a task waits for a block */
+    if (mp->waiters != 0U && mp->sem != NULL)
+    {
+        if (xPortIsInsideInterrupt())
+        {
+            BaseType_t woken = pdFALSE;
+            xSemaphoreGiveFromISR(mp->sem, &woken);
+            portYIELD_FROM_ISR(woken);
+        }
+        else
+        {
+            xSemaphoreGive(mp->sem);
+        }
+    }
+    return pdPASS;
+}
@@ -0,0 +1,391 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "mutex_profiler.h"
+
+#define NO_OWNER UINT32_MAX
+
+typedef struct
+{
+    TaskHandle_t task; /* NULL if the mutex is not held */
+    uint32_t start;
+    TickType_t start_tick;
+} hold_t;
+
+typedef struct
+{
+    TaskHandle_t task; /* NULL if the entry is unused */
+    uint32_t mutex_index;
+    uint32_t owner_index;
+    uint32_t start;
+    TickType_t start_tick;
+} waiter_t;
+
+static mutex_profiler_stats_t mutexes[MUTEX_PROFILER_MAX_MUTEXES];
+static hold_t holds[MUTEX_PROFILER_MAX_MUTEXES];
+static uint32_t num_mutexes;
+static waiter_t waiters[MUTEX_PROFILER_MAX_WAITERS];
+
+#if defined(GD32E23x)
+/* The Cortex-M23 has no DWT cycle counter. The cycles are derived from the
+ * FreeRTOS tick count and the SysTick, which counts down from the CPU clock. */
+static uint32_t profiler_now(void)
+{
+    uint32_t load = SysTick->LOAD;
+    uint32_t val = SysTick->VAL;
+    uint32_t ticks = (uint32_t)xTaskGetTickCountFromISR();
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* reloaded, but the tick interrupt did not run yet */
+        val = SysTick->VAL;
+        ticks++;
+    }
+    return ticks * (load + 1U) + (load - val);
+}
+
+void mutex_profiler_init(void)
+{
+}
+#else
+static uint32_t profiler_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+void mutex_profiler_init(void)
+{
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#endif
+
+static uint32_t elapsed_us(uint32_t start, TickType_t start_tick)
+{
+    TickType_t ticks = xTaskGetTickCount() - start_tick;
+    if (ticks < MUTEX_PROFILER_CYCLES_MAX_TICKS)
+    {
+        uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+        return (profiler_now() - start) / (cycles_per_us ? cycles_per_us : 1U);
+    }
+    return (uint32_t)ticks * (1000000U / configTICK_RATE_HZ);
+}
+
+/* index of the mutex, -1 if it is not profiled (and can't be added) */
+static int32_t find_mutex(void *mutex, int add)
+{
+    for (uint32_t i = 0; i < num_mutexes; i++)
+    {
+        if (mutexes[i].mutex == mutex)
+        {
+            return (int32_t)i;
+        }
+    }
+    if (!add || num_mutexes == MUTEX_PROFILER_MAX_MUTEXES)
+    {
+        return -1;
+    }
+    memset(&mutexes[num_mutexes], 0, sizeof(mutexes[0]));
+    mutexes[num_mutexes].mutex = mutex;
+    holds[num_mutexes].task = NULL;
+    return (int32_t)num_mutexes++;
+}
+
+static void copy_name(char *dst, TaskHandle_t task)
+{
+    strncpy(dst, pcTaskGetName(task), configMAX_TASK_NAME_LEN - 1);
+    dst[configMAX_TASK_NAME_LEN - 1] = '\0';
+}
+
+/* tasks are told apart by their names, which survive their deletion */
+static uint32_t find_owner(mutex_profiler_stats_t *stats, TaskHandle_t task)
+{
+    const char *name = pcTaskGetName(task);
+    for (uint32_t i = 0; i < MUTEX_PROFILER_MAX_OWNERS; i++)
+    {
+        mutex_profiler_owner_t *owner = &stats->owners[i];
+        if (owner->name[0] == '\0')
+        {
+            copy_name(owner->name, task);
+            return i;
+        }
+        if (strncmp(owner->name, name, configMAX_TASK_NAME_LEN - 1) == 0)
+        {
+            return i;
+        }
+    }
+    return MUTEX_PROFILER_MAX_OWNERS - 1;
+}
+
+static waiter_t *find_waiter(TaskHandle_t task)
+{
+    for (uint32_t i = 0; i < MUTEX_PROFILER_MAX_WAITERS; i++)
+    {
+        if (waiters[i].task == task)
+        {
+            return &waiters[i];
+        }
+    }
+    return NULL;
+}
+
+/* ends the wait of the calling task, if it blocked on this mutex */
+static waiter_t *end_wait(int32_t index)
+{
+    waiter_t *waiter = find_waiter(xTaskGetCurrentTaskHandle());
+    if (waiter == NULL || waiter->mutex_index != (uint32_t)index)
+    {
+        return NULL;
+    }
+    mutex_profiler_stats_t *stats = &mutexes[index];
+    uint32_t us = elapsed_us(waiter->start, waiter->start_tick);
+    stats->wait_total_us += us;
+    if (us > stats->wait_max_us)
+    {
+        stats->wait_max_us = us;
+    }
+    uint32_t bucket = 0;
+    for (uint32_t limit = 10U; bucket < MUTEX_PROFILER_BUCKETS - 1U && us >= limit; limit *= 10U)
+    {
+        bucket++;
+    }
+    stats->wait_histogram[bucket]++;
+    if (waiter->owner_index != NO_OWNER)
+    {
+        mutex_profiler_owner_t *owner = &stats->owners[waiter->owner_index];
+        owner->wait_total_us += us;
+        if (us > owner->wait_max_us)
+        {
+            owner->wait_max_us = us;
+        }
+    }
+    waiter->task = NULL;
+    return waiter;
+}
+
+void mutex_profiler_blocking(void *mutex, void *holder)
+{
+    taskENTER_CRITICAL();
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    waiter_t *waiter = find_waiter(task);
+    int32_t index = find_mutex(mutex, 1);
+    /* blocks again after another task got the mutex first: the same wait */
+    if (index >= 0 && (waiter == NULL || waiter->mutex_index != (uint32_t)index))
+    {
+        mutex_profiler_stats_t *stats = &mutexes[index];
+        stats->contentions++;
+        uint32_t owner = NO_OWNER;
+        if (holder != NULL)
+        {
+            owner = find_owner(stats, (TaskHandle_t)holder);
+            stats->owners[owner].contentions++;
+            if (uxTaskPriorityGet(NULL) > uxTaskPriorityGet((TaskHandle_t)holder))
+            {
+                stats->inheritances++;
+            }
+        }
+        /* not measured if there is no free entry */
+        waiter = find_waiter(NULL);
+        if (waiter != NULL)
+        {
+            waiter->task = task;
+            waiter->mutex_index = (uint32_t)index;
+            waiter->owner_index = owner;
+            waiter->start_tick = xTaskGetTickCount();
+            waiter->start = profiler_now();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+void mutex_profiler_taken(void *mutex)
+{
+    taskENTER_CRITICAL();
+    int32_t index = find_mutex(mutex, 1);
+    if (index >= 0)
+    {
+        end_wait(index);
+        mutexes[index].takes++;
+        holds[index].task = xTaskGetCurrentTaskHandle();
+        holds[index].start_tick = xTaskGetTickCount();
+        holds[index].start = profiler_now();
+    }
+    taskEXIT_CRITICAL();
+}
+
+void mutex_profiler_take_failed(void *mutex)
+{
+    taskENTER_CRITICAL();
+    int32_t index = find_mutex(mutex, 0);
+    /* a take without block time fails without having waited */
+    if (index >= 0 && end_wait(index) != NULL)
+    {
+        mutexes[index].timeouts++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+void mutex_profiler_given(void *mutex)
+{
+    taskENTER_CRITICAL();
+    int32_t index = find_mutex(mutex, 0);
+    /* the give at the creation of the mutex has no holder */
+    if (index >= 0 && holds[index].task != NULL)
+    {
+        mutex_profiler_stats_t *stats = &mutexes[index];
+        uint32_t us = elapsed_us(holds[index].start, holds[index].start_tick);
+        stats->holds++;
+        stats->hold_total_us += us;
+        if (us > stats->hold_max_us)
+        {
+            stats->hold_max_us = us;
+            copy_name(stats->hold_max_owner, holds[index].task);
+        }
+        holds[index].task = NULL;
+    }
+    taskEXIT_CRITICAL();
+}
+
+void mutex_profiler_deleted(void *mutex)
+{
+    taskENTER_CRITICAL();
+    int32_t index = find_mutex(mutex, 0);
+    /* nobody can wait for a mutex that is deleted, the last one moves into
+     * the free entry */
+    if (index >= 0)
+    {
+        num_mutexes--;
+        mutexes[index] = mutexes[num_mutexes];
+        holds[index] = holds[num_mutexes];
+        for (uint32_t i = 0; i < MUTEX_PROFILER_MAX_WAITERS; i++)
+        {
+            if (waiters[i].task != NULL && waiters[i].mutex_index == num_mutexes)
+            {
+                waiters[i].mutex_index = (uint32_t)index;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+int mutex_profiler_get(uint32_t index, mutex_profiler_stats_t *stats)
+{
+    int found = 0;
+    taskENTER_CRITICAL();
+    if (index < num_mutexes)
+    {
+        *stats = mutexes[index];
+        found = 1;
+    }
+    taskEXIT_CRITICAL();
+    return found;
+}
+
+void mutex_profiler_reset(void)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t i = 0; i < num_mutexes; i++)
+    {
+        void *mutex = mutexes[i].mutex;
+        memset(&mutexes[i], 0, sizeof(mutexes[0]));
+        mutexes[i].mutex = mutex;
+    }
+    taskEXIT_CRITICAL();
+}
+
+static uint32_t avg_us(uint64_t total, uint32_t count)
+{
+    return count ? (uint32_t)(total / count) : 0U;
+}
+
+static const char *mutex_name(void *mutex, char *buf, size_t len)
+{
+    const char *name = NULL;
+#if (configQUEUE_REGISTRY_SIZE > 0)
+    name = pcQueueGetName((QueueHandle_t)mutex);
+#endif
+    if (name == NULL)
+    {
+        snprintf(buf, len, "%p", mutex);
+        name = buf;
+    }
+    return name;
+}
+
+void mutex_profiler_print(uint32_t max_owners)
+{
+    /* static, the report runs in a task with a small stack */
+    static mutex_profiler_stats_t s;
+    static const char *const bucket_names[MUTEX_PROFILER_BUCKETS] = {"<10us",  "<100us", "<1ms", "<10ms",
+                                                                     "<100ms", "<1s",    ">=1s"};
+    uint8_t order[MUTEX_PROFILER_MAX_MUTEXES];
+    uint32_t count = 0;
+    char buf[20];
+
+    /* sorted by total wait, from a snapshot that may be slightly off */
+    taskENTER_CRITICAL();
+    count = num_mutexes;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t j = i;
+        for (; j > 0 && mutexes[order[j - 1]].wait_total_us < mutexes[i].wait_total_us; j--)
+        {
+            order[j] = order[j - 1];
+        }
+        order[j] = (uint8_t)i;
+    }
+    taskEXIT_CRITICAL();
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!mutex_profiler_get(order[i], &s))
+        {
+            continue;
+        }
+        const char *name = mutex_name(s.mutex, buf, sizeof(buf));
+        printf("MUTEX: \"%s\" takes %lu contentions %lu timeouts %lu inheritances %lu "
+               "wait avg %lu max %lu us hold avg %lu max %lu us by \"%s\"\n",
+               name, (unsigned long)s.takes, (unsigned long)s.contentions, (unsigned long)s.timeouts,
+               (unsigned long)s.inheritances, (unsigned long)avg_us(s.wait_total_us, s.contentions),
+               (unsigned long)s.wait_max_us, (unsigned long)avg_us(s.hold_total_us, s.holds),
+               (unsigned long)s.hold_max_us, s.hold_max_owner);
+        if (s.contentions == 0)
+        {
+            continue;
+        }
+        printf("MUTEX: \"%s\" wait histogram", name);
+        for (uint32_t b = 0; b < MUTEX_PROFILER_BUCKETS; b++)
+        {
+            printf(" %s %lu", bucket_names[b], (unsigned long)s.wait_histogram[b]);
+        }
+        printf("\n");
+        /* worst offenders: the owners that caused the longest total wait */
+        for (uint32_t n = 0; n < max_owners; n++)
+        {
+            mutex_profiler_owner_t *worst = NULL;
+            for (uint32_t o = 0; o < MUTEX_PROFILER_MAX_OWNERS; o++)
+            {
+                mutex_profiler_owner_t *owner = &s.owners[o];
+                if (owner->contentions != 0 && (worst == NULL || owner->wait_total_us > worst->wait_total_us))
+                {
+                    worst = owner;
+                }
+            }
+            if (worst == NULL)
+            {
+                break;
+            }
+            printf("MUTEX: \"%s\" owner \"%s\" contentions %lu wait total %lu max %lu us\n", name, worst->name,
+                   (unsigned long)worst->contentions, (unsigned long)worst->wait_total_us,
+                   (unsigned long)worst->wait_max_us);
+            worst->contentions = 0;
+        }
+    }
+}
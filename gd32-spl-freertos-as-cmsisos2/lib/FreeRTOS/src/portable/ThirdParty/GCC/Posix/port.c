@@ -0,0 +1,383 @@
+/*
+ * FreeRTOS port for POSIX hosts (Linux), see portmacro.h.
+ *
+ * Every task runs in its own pthread. Each thread waits on its own event
+ * until the scheduler selects its task, so exactly one task thread runs at a
+ * time. A switch resumes the thread of the next task and suspends the
+ * calling one.
+ *
+ * The tick is a SIGALRM from an interval timer. All signals are blocked in
+ * every thread except in the thread of the running task outside of critical
+ * sections, so the signal handler always runs on the running task and can
+ * switch to another one (preemption).
+ *
+ * The threads get stacks of the default size from the C library, the stack
+ * arrays given to FreeRTOS only hold the thread data at their top. The stack
+ * high water marks are therefore meaningless in the simulator.
+ */
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "utils/wait_for_event.h"
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 )
+    #error "the POSIX port needs xTaskGetCurrentTaskHandle(), set INCLUDE_xTaskGetCurrentTaskHandle to 1"
+#endif
+
+/* wakes up the main thread when the scheduler ends */
+#define SIG_RESUME    SIGUSR1
+
+typedef struct THREAD
+{
+    pthread_t pthread;
+    TaskFunction_t pxCode;
+    void * pvParams;
+    BaseType_t xDying;
+    struct event * ev;
+} Thread_t;
+
+static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
+static sigset_t xAllSignals;
+static pthread_t hMainThread;
+static volatile UBaseType_t uxCriticalNesting;
+static volatile BaseType_t xSchedulerEnd = pdFALSE;
+/* set while the tick handler runs on this thread */
+static __thread BaseType_t xInsideInterrupt = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char * pcCall, int iErrno )
+{
+    fprintf( stderr, "%s: %s\n", pcCall, strerror( iErrno ) );
+    abort();
+}
+
+/* the thread data is kept at the top of the task's stack, the first member of
+ * the TCB points right below it */
+static inline Thread_t * prvGetThreadFromTask( TaskHandle_t xTask )
+{
+    StackType_t * pxTopOfStack = *( StackType_t ** ) xTask;
+
+    return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+
+static void prvSuspendSelf( Thread_t * pxThread )
+{
+    event_wait( pxThread->ev );
+}
+
+static void prvResumeThread( Thread_t * pxThread )
+{
+    if( !pthread_equal( pthread_self(), pxThread->pthread ) )
+    {
+        event_signal( pxThread->ev );
+    }
+}
+
+static void prvSwitchThread( Thread_t * pxThreadToResume,
+                             Thread_t * pxThreadToSuspend )
+{
+    UBaseType_t uxSavedCriticalNesting;
+
+    if( pxThreadToSuspend != pxThreadToResume )
+    {
+        /* the nesting count belongs to the task, not to the port */
+        uxSavedCriticalNesting = uxCriticalNesting;
+
+        prvResumeThread( pxThreadToResume );
+
+        if( pxThreadToSuspend->xDying != pdFALSE )
+        {
+            pthread_exit( NULL );
+        }
+
+        prvSuspendSelf( pxThreadToSuspend );
+
+        uxCriticalNesting = uxSavedCriticalNesting;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void vPortSystemTickHandler( int sig )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+
+    ( void ) sig;
+
+    /* all signals are blocked while the handler runs */
+    uxCriticalNesting++;
+    xInsideInterrupt = pdTRUE;
+
+    if( xTaskIncrementTick() != pdFALSE )
+    {
+        #if ( configUSE_PREEMPTION == 1 )
+            pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+            vTaskSwitchContext();
+            pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+            prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+        #endif
+    }
+
+    xInsideInterrupt = pdFALSE;
+    uxCriticalNesting--;
+}
+
+static void prvSetupSignals( void )
+{
+    struct sigaction sigresume, sigtick;
+
+    hMainThread = pthread_self();
+
+    sigfillset( &xAllSignals );
+    /* keep SIGINT, so that Ctrl+C ends the simulation in any state */
+    sigdelset( &xAllSignals, SIGINT );
+
+    /* all threads are created with all signals blocked, the first resume of
+     * a task unblocks them */
+    pthread_sigmask( SIG_SETMASK, &xAllSignals, NULL );
+
+    /* SIG_RESUME is only used with sigwait() */
+    memset( &sigresume, 0, sizeof( sigresume ) );
+    sigresume.sa_handler = SIG_IGN;
+    sigfillset( &sigresume.sa_mask );
+
+    memset( &sigtick, 0, sizeof( sigtick ) );
+    sigtick.sa_handler = vPortSystemTickHandler;
+    sigfillset( &sigtick.sa_mask );
+
+    if( sigaction( SIG_RESUME, &sigresume, NULL ) != 0 )
+    {
+        prvFatalError( "sigaction", errno );
+    }
+
+    if( sigaction( SIGALRM, &sigtick, NULL ) != 0 )
+    {
+        prvFatalError( "sigaction", errno );
+    }
+}
+
+static void * prvWaitForStart( void * pvParams )
+{
+    Thread_t * pxThread = pvParams;
+
+    prvSuspendSelf( pxThread );
+
+    /* resumed for the first time */
+    uxCriticalNesting = 0;
+    vPortEnableInterrupts();
+
+    pxThread->pxCode( pxThread->pvParams );
+
+    /* a task function must not return */
+    #if ( INCLUDE_vTaskDelete == 1 )
+        vTaskDelete( NULL );
+    #else
+        configASSERT( 0 );
+    #endif
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     StackType_t * pxEndOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    Thread_t * pxThread;
+    int iRet;
+
+    ( void ) pxEndOfStack;
+    ( void ) pthread_once( &hSigSetupThread, prvSetupSignals );
+
+    /* the thread data at the top of the stack */
+    pxThread = ( Thread_t * ) ( pxTopOfStack + 1 ) - 1;
+    pxTopOfStack = ( StackType_t * ) pxThread - 1;
+
+    pxThread->pxCode = pxCode;
+    pxThread->pvParams = pvParameters;
+    pxThread->xDying = pdFALSE;
+    pxThread->ev = event_create();
+
+    if( pxThread->ev == NULL )
+    {
+        prvFatalError( "event_create", ENOMEM );
+    }
+
+    /* the new thread inherits the blocked signals */
+    vPortEnterCritical();
+
+    iRet = pthread_create( &pxThread->pthread, NULL, prvWaitForStart, pxThread );
+
+    if( iRet != 0 )
+    {
+        prvFatalError( "pthread_create", iRet );
+    }
+
+    vPortExitCritical();
+
+    return pxTopOfStack;
+}
+
+BaseType_t xPortStartScheduler( void )
+{
+    struct itimerval itimer;
+    sigset_t xSignals;
+    int iSignal;
+
+    ( void ) pthread_once( &hSigSetupThread, prvSetupSignals );
+
+    /* the main thread must never take the tick, critical sections before the
+     * start may have unblocked the signals */
+    pthread_sigmask( SIG_SETMASK, &xAllSignals, NULL );
+
+    itimer.it_interval.tv_sec = 0;
+    itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+    itimer.it_value = itimer.it_interval;
+
+    if( setitimer( ITIMER_REAL, &itimer, NULL ) != 0 )
+    {
+        prvFatalError( "setitimer", errno );
+    }
+
+    prvResumeThread( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+
+    /* wait until vPortEndScheduler() */
+    sigemptyset( &xSignals );
+    sigaddset( &xSignals, SIG_RESUME );
+
+    while( xSchedulerEnd == pdFALSE )
+    {
+        sigwait( &xSignals, &iSignal );
+    }
+
+    return 0;
+}
+
+void vPortEndScheduler( void )
+{
+    struct itimerval itimer;
+    struct sigaction sigtick;
+
+    /* stop the tick and drop pending ones */
+    memset( &itimer, 0, sizeof( itimer ) );
+    setitimer( ITIMER_REAL, &itimer, NULL );
+
+    memset( &sigtick, 0, sizeof( sigtick ) );
+    sigtick.sa_handler = SIG_IGN;
+    sigemptyset( &sigtick.sa_mask );
+    sigaction( SIGALRM, &sigtick, NULL );
+
+    xSchedulerEnd = pdTRUE;
+    pthread_kill( hMainThread, SIG_RESUME );
+
+    prvSuspendSelf( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+}
+
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+
+    pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    vTaskSwitchContext();
+    pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+}
+
+void vPortYield( void )
+{
+    vPortEnterCritical();
+    vPortYieldFromISR();
+    vPortExitCritical();
+}
+
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+    pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+}
+
+void vPortEnableInterrupts( void )
+{
+    pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
+}
+
+void vPortEnterCritical( void )
+{
+    if( uxCriticalNesting == 0 )
+    {
+        vPortDisableInterrupts();
+    }
+
+    uxCriticalNesting++;
+}
+
+void vPortExitCritical( void )
+{
+    uxCriticalNesting--;
+
+    if( uxCriticalNesting == 0 )
+    {
+        vPortEnableInterrupts();
+    }
+}
+
+/* returns 1 if the signals were blocked already */
+UBaseType_t xPortSetInterruptMask( void )
+{
+    sigset_t xOld;
+
+    pthread_sigmask( SIG_BLOCK, &xAllSignals, &xOld );
+    return sigismember( &xOld, SIGALRM ) == 1 ? 1 : 0;
+}
+
+void vPortClearInterruptMask( UBaseType_t uxMask )
+{
+    if( uxMask == 0 )
+    {
+        vPortEnableInterrupts();
+    }
+}
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+    return xInsideInterrupt;
+}
+
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void * pxTaskToDelete,
+                       volatile BaseType_t * pxPendYield )
+{
+    ( void ) pxPendYield;
+    prvGetThreadFromTask( pxTaskToDelete )->xDying = pdTRUE;
+}
+
+void vPortCancelThread( void * pxTaskToDelete )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+    /* a task that deleted itself has ended its thread already, the thread of
+     * a task deleted by another one waits for its event */
+    if( pxThread->xDying == pdFALSE )
+    {
+        pthread_cancel( pxThread->pthread );
+    }
+
+    pthread_join( pxThread->pthread, NULL );
+    event_delete( pxThread->ev );
+}
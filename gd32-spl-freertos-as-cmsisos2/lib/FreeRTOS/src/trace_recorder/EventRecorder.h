@@ -0,0 +1,49 @@
+/*
+ * Subset of the Keil Event Recorder API (EventRecorder.h), as used by
+ * cmsis_os2/freertos_evr.c. The Keil implementation is only available for the
+ * Arm compiler, this one records into the RAM buffer of trace_recorder.c.
+ *
+ * Only EventRecord2(), EventRecord4() and the initialization / filter
+ * functions are implemented.
+ */
+#ifndef EVENT_RECORDER_H_
+#define EVENT_RECORDER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* event levels, part of the event ID */
+#define EventLevelError  0x00000U
+#define EventLevelAPI    0x10000U
+#define EventLevelOp     0x20000U
+#define EventLevelDetail 0x30000U
+#define EventLevelMask   0x30000U
+
+/* level masks for EventRecorderInitialize() and EventRecorderEnable() */
+#define EventRecordNone   0x00U
+#define EventRecordError  0x01U
+#define EventRecordAPI    0x02U
+#define EventRecordOp     0x04U
+#define EventRecordDetail 0x08U
+#define EventRecordAll    0x0FU
+
+/* event ID: level, component number (0..0xFF) and message number (0..0xFF) */
+#define EventID(level, comp_no, msg_no) (((level) & EventLevelMask) | (((comp_no) & 0xFFU) << 8) | ((msg_no) & 0xFFU))
+
+uint32_t EventRecorderInitialize(uint32_t recording, uint32_t start);
+uint32_t EventRecorderEnable(uint32_t recording, uint32_t comp_start, uint32_t comp_end);
+uint32_t EventRecorderDisable(uint32_t recording, uint32_t comp_start, uint32_t comp_end);
+uint32_t EventRecorderStart(void);
+uint32_t EventRecorderStop(void);
+
+uint32_t EventRecord2(uint32_t id, uint32_t val1, uint32_t val2);
+uint32_t EventRecord4(uint32_t id, uint32_t val1, uint32_t val2, uint32_t val3, uint32_t val4);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_RECORDER_H_ */
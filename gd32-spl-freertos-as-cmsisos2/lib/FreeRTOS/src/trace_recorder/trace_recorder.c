@@ -0,0 +1,280 @@
+#include <string.h>
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "EventRecorder.h"
+#include "trace_recorder.h"
+
+/* IDs of the FreeRTOS events that carry names (see cmsis_os2/freertos_evr.c) */
+#define TRACE_ID_TASK_CREATE EventID(EventLevelOp, 0xF0U, 0x00U)
+#define TRACE_ID_QUEUE_REGISTRY_ADD EventID(EventLevelOp, 0xF1U, 0x16U)
+
+/* event level bit of an ID, as used in the filter masks */
+#define TRACE_LEVEL_BIT(id) (1U << (((id) & EventLevelMask) >> 16))
+
+trace_recorder_t trace_recorder;
+
+/* enabled levels per component number */
+static uint8_t trace_filter[256];
+
+#if defined(GD32E23x)
+/* The Cortex-M23 has no DWT cycle counter. The cycles are derived from the
+ * FreeRTOS tick count and the SysTick, which counts down from the CPU clock.
+ * Events recorded inside the tick interrupt may be off by one tick period. */
+static uint32_t trace_timestamp(void)
+{
+    uint32_t load = SysTick->LOAD;
+    uint32_t val = SysTick->VAL;
+    uint32_t ticks = (uint32_t)xTaskGetTickCountFromISR();
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* reloaded, but the tick interrupt did not run yet */
+        val = SysTick->VAL;
+        ticks++;
+    }
+    return ticks * (load + 1U) + (load - val);
+}
+
+static void trace_timestamp_init(void)
+{
+}
+#else
+static uint32_t trace_timestamp(void)
+{
+    return DWT->CYCCNT;
+}
+
+static void trace_timestamp_init(void)
+{
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+#endif
+
+/* writes one record, interrupts must be disabled */
+static void trace_write(uint32_t timestamp, uint32_t id, uint32_t val1, uint32_t val2)
+{
+    uint32_t index = trace_recorder.write_index;
+    trace_record_t *rec = &trace_recorder.records[index % TRACE_RECORDER_SIZE];
+    rec->timestamp = timestamp;
+    rec->id = id;
+    rec->val1 = val1;
+    rec->val2 = val2;
+    trace_recorder.write_index = index + 1U;
+}
+
+/* checks if the event is recorded and if there is space for the given number
+ * of records, interrupts must be disabled */
+static int trace_accept(uint32_t id, uint32_t num_records)
+{
+    if (!trace_recorder.running || !(trace_filter[(id >> 8) & 0xFFU] & TRACE_LEVEL_BIT(id)))
+    {
+        return 0;
+    }
+#if TRACE_RECORDER_STOP_WHEN_FULL
+    if (trace_recorder.write_index + num_records > TRACE_RECORDER_SIZE)
+    {
+        trace_recorder.running = 0;
+        return 0;
+    }
+#else
+    (void)num_records;
+#endif
+    return 1;
+}
+
+static void trace_name_locked(uint32_t object, const char *name)
+{
+    trace_name_t *entry = NULL;
+    for (uint32_t i = 0; i < TRACE_RECORDER_MAX_NAMES; i++)
+    {
+        if (trace_recorder.names[i].object == object)
+        {
+            entry = &trace_recorder.names[i];
+            break;
+        }
+        if (entry == NULL && trace_recorder.names[i].name[0] == '\0')
+        {
+            entry = &trace_recorder.names[i];
+        }
+    }
+    if (entry == NULL)
+    {
+        /* table full, the converter shows the handle instead */
+        return;
+    }
+    entry->object = object;
+    strncpy(entry->name, name, TRACE_RECORDER_NAME_LEN - 1);
+    entry->name[TRACE_RECORDER_NAME_LEN - 1] = '\0';
+}
+
+void trace_recorder_name(uint32_t object, const char *name)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    trace_name_locked(object, name != NULL ? name : "?");
+    __set_PRIMASK(primask);
+}
+
+uint32_t EventRecorderInitialize(uint32_t recording, uint32_t start)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&trace_recorder, 0, sizeof(trace_recorder));
+    memset(trace_filter, (int)(recording & EventRecordAll), sizeof(trace_filter));
+    /* the events of this module are always enabled */
+    trace_filter[TRACE_RECORDER_COMPONENT] = EventRecordAll;
+    trace_recorder.magic = TRACE_RECORDER_MAGIC;
+    trace_recorder.version = TRACE_RECORDER_VERSION;
+    trace_recorder.num_records = TRACE_RECORDER_SIZE;
+    trace_recorder.num_names = TRACE_RECORDER_MAX_NAMES;
+    trace_recorder.name_len = TRACE_RECORDER_NAME_LEN;
+    trace_recorder.timestamp_freq = SystemCoreClock;
+    trace_timestamp_init();
+    trace_recorder.running = start ? 1U : 0U;
+    __set_PRIMASK(primask);
+    return 1U;
+}
+
+static uint32_t trace_filter_set(uint32_t recording, uint32_t comp_start, uint32_t comp_end, int enable)
+{
+    if (comp_start > comp_end || comp_end > 0xFFU)
+    {
+        return 0U;
+    }
+    for (uint32_t comp = comp_start; comp <= comp_end; comp++)
+    {
+        if (enable)
+        {
+            trace_filter[comp] |= (uint8_t)(recording & EventRecordAll);
+        }
+        else
+        {
+            trace_filter[comp] &= (uint8_t)~(recording & EventRecordAll);
+        }
+    }
+    return 1U;
+}
+
+uint32_t EventRecorderEnable(uint32_t recording, uint32_t comp_start, uint32_t comp_end)
+{
+    return trace_filter_set(recording, comp_start, comp_end, 1);
+}
+
+uint32_t EventRecorderDisable(uint32_t recording, uint32_t comp_start, uint32_t comp_end)
+{
+    return trace_filter_set(recording, comp_start, comp_end, 0);
+}
+
+uint32_t EventRecorderStart(void)
+{
+    trace_recorder.running = 1U;
+    return 1U;
+}
+
+uint32_t EventRecorderStop(void)
+{
+    trace_recorder.running = 0U;
+    return 1U;
+}
+
+uint32_t EventRecord2(uint32_t id, uint32_t val1, uint32_t val2)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!trace_accept(id, 1U))
+    {
+        __set_PRIMASK(primask);
+        return 0U;
+    }
+    trace_write(trace_timestamp(), id, val1, val2);
+    /* remember the names, the handles alone are hard to read */
+    if (id == TRACE_ID_TASK_CREATE)
+    {
+        trace_name_locked(val1, pcTaskGetName((TaskHandle_t)val1));
+    }
+    else if (id == TRACE_ID_QUEUE_REGISTRY_ADD && val2 != 0U)
+    {
+        trace_name_locked(val1, (const char *)val2);
+    }
+    __set_PRIMASK(primask);
+    return 1U;
+}
+
+uint32_t EventRecord4(uint32_t id, uint32_t val1, uint32_t val2, uint32_t val3, uint32_t val4)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (!trace_accept(id, 2U))
+    {
+        __set_PRIMASK(primask);
+        return 0U;
+    }
+    uint32_t timestamp = trace_timestamp();
+    trace_write(timestamp, id, val1, val2);
+    trace_write(timestamp, id | TRACE_RECORDER_CONTINUATION, val3, val4);
+    __set_PRIMASK(primask);
+    return 1U;
+}
+
+void trace_recorder_isr_enter(void)
+{
+    EventRecord2(EventID(EventLevelOp, TRACE_RECORDER_COMPONENT, TRACE_RECORDER_ISR_ENTER), __get_IPSR(), 0U);
+}
+
+void trace_recorder_isr_exit(void)
+{
+    EventRecord2(EventID(EventLevelOp, TRACE_RECORDER_COMPONENT, TRACE_RECORDER_ISR_EXIT), __get_IPSR(), 0U);
+}
+
+void trace_recorder_mark(uint32_t marker, uint32_t value)
+{
+    EventRecord2(EventID(EventLevelOp, TRACE_RECORDER_COMPONENT, TRACE_RECORDER_MARK), marker, value);
+}
+
+void trace_recorder_begin(uint32_t marker, uint32_t value)
+{
+    EventRecord2(EventID(EventLevelOp, TRACE_RECORDER_COMPONENT, TRACE_RECORDER_BEGIN), marker, value);
+}
+
+void trace_recorder_end(uint32_t marker, uint32_t value)
+{
+    EventRecord2(EventID(EventLevelOp, TRACE_RECORDER_COMPONENT, TRACE_RECORDER_END), marker, value);
+}
+
+void trace_recorder_dump(int restart)
+{
+    trace_recorder.running = 0U;
+    /* the clock may have been changed after the initialization */
+    trace_recorder.timestamp_freq = SystemCoreClock;
+
+    /* the whole structure as little endian words, 8 per line */
+    const uint32_t *words = (const uint32_t *)&trace_recorder;
+    const uint32_t num_words = sizeof(trace_recorder) / sizeof(uint32_t);
+    printf("TRACE BEGIN %lu\n", (unsigned long)num_words);
+    for (uint32_t i = 0; i < num_words; i += 8)
+    {
+        printf("TRACE:");
+        for (uint32_t j = i; j < i + 8 && j < num_words; j++)
+        {
+            printf(" %08lx", (unsigned long)words[j]);
+        }
+        printf("\n");
+    }
+    printf("TRACE END\n");
+
+    if (restart)
+    {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        trace_recorder.write_index = 0U;
+        trace_recorder.running = 1U;
+        __set_PRIMASK(primask);
+    }
+}
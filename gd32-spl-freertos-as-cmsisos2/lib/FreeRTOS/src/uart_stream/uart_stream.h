@@ -0,0 +1,134 @@
+/*
+ * UART driver on FreeRTOS stream buffers, included with
+ * PIO_FREERTOS_UART_STREAM (see build_freertos.py).
+ *
+ * Every port has a receive and a transmit stream buffer. Tasks block in
+ * uart_stream_read() and uart_stream_write() with a timeout instead of
+ * polling the USART:
+ *   - receive: the DMA writes into a small ring in circular mode. Its half
+ *     and full transfer interrupts and the idle line interrupt of the USART
+ *     move the new bytes into the receive stream buffer, which wakes a
+ *     reader once its trigger level is reached.
+ *   - transmit: the DMA sends a block of up to UART_STREAM_TX_DMA_SIZE bytes
+ *     taken from the transmit stream buffer, its full transfer interrupt
+ *     takes the next block. A write starts the DMA if it is idle.
+ * With UART_STREAM_USE_DMA 0 the same stream buffers are served by the
+ * receive and transmit interrupts of the USART, one interrupt per byte, for
+ * comparing the interrupt load.
+ *
+ * A stream buffer allows only one reader and one writer at a time: tasks
+ * that share a port must serialize their reads or writes, e.g. with a mutex.
+ *
+ * The USART and its pins are configured by the application (baud rate,
+ * 8N1, receive and transmit enabled) before uart_stream_open(). The
+ * interrupts get UART_STREAM_IRQ_PRIORITY, which must be numerically at or
+ * above configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * Supported on the series with the DMA of the GD32F10x (GD32F10x, F20x, F30x,
+ * F403, E10x): USART0 on DMA0 channel 3 (TX) and 4 (RX), USART1 on DMA0
+ * channel 6 (TX) and 5 (RX).
+ */
+#ifndef UART_STREAM_H_
+#define UART_STREAM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef UART_STREAM_USE_DMA
+#define UART_STREAM_USE_DMA 1
+#endif
+
+/* the ports whose interrupt handlers are defined here. Disable a port whose
+ * handlers are needed elsewhere. */
+#ifndef UART_STREAM_USE_USART0
+#define UART_STREAM_USE_USART0 1
+#endif
+#ifndef UART_STREAM_USE_USART1
+#define UART_STREAM_USE_USART1 1
+#endif
+
+#ifndef UART_STREAM_RX_BUFFER_SIZE
+#define UART_STREAM_RX_BUFFER_SIZE 256
+#endif
+#ifndef UART_STREAM_TX_BUFFER_SIZE
+#define UART_STREAM_TX_BUFFER_SIZE 256
+#endif
+/* receive ring of the DMA: the received bytes are moved into the stream
+ * buffer every half ring, 32 bytes are 320 us at 1 Mbaud */
+#ifndef UART_STREAM_RX_DMA_SIZE
+#define UART_STREAM_RX_DMA_SIZE 64
+#endif
+/* largest block that is sent with one DMA transfer */
+#ifndef UART_STREAM_TX_DMA_SIZE
+#define UART_STREAM_TX_DMA_SIZE 64
+#endif
+
+#ifndef UART_STREAM_IRQ_PRIORITY
+#define UART_STREAM_IRQ_PRIORITY (configMAX_SYSCALL_INTERRUPT_PRIORITY >> (8U - __NVIC_PRIO_BITS))
+#endif
+
+/* called at the start and the end of the interrupt handlers, e.g. for the
+ * run time statistics of the interrupts */
+#ifndef UART_STREAM_ISR_ENTER
+#define UART_STREAM_ISR_ENTER()
+#endif
+#ifndef UART_STREAM_ISR_EXIT
+#define UART_STREAM_ISR_EXIT()
+#endif
+
+typedef enum
+{
+    UART_STREAM_USART0,
+    UART_STREAM_USART1,
+    UART_STREAM_PORTS
+} uart_stream_port_t;
+
+typedef struct
+{
+    uint32_t rx_bytes;       /* moved into the receive stream buffer */
+    uint32_t rx_dropped;     /* lost because the receive stream buffer was full */
+    uint32_t hw_overruns;    /* overrun errors of the USART */
+    uint32_t framing_errors; /* framing errors of the USART (break, wrong baud rate) */
+    uint32_t noise_errors;   /* noise errors of the USART */
+    uint32_t tx_bytes;       /* handed to the USART */
+    uint32_t rx_interrupts;  /* interrupts that moved received bytes */
+    uint32_t tx_interrupts;  /* interrupts that started a transmission */
+} uart_stream_stats_t;
+
+/* creates the stream buffers and starts the reception. A reader is woken
+ * when rx_trigger_level bytes are buffered (at least 1) or its timeout ends. */
+void uart_stream_open(uart_stream_port_t port, size_t rx_trigger_level);
+
+/* waits up to timeout ticks for the trigger level, then copies up to len
+ * received bytes to data. Returns their number, 0 on a timeout. */
+size_t uart_stream_read(uart_stream_port_t port, void *data, size_t len, TickType_t timeout);
+
+/* queues len bytes for transmission, waits up to timeout ticks for space.
+ * Returns the number of queued bytes. Before the scheduler was started,
+ * only what fits is queued. */
+size_t uart_stream_write(uart_stream_port_t port, const void *data, size_t len, TickType_t timeout);
+
+/* changes the trigger level of the receive stream buffer, returns pdFALSE if
+ * it is larger than the buffer */
+BaseType_t uart_stream_set_rx_trigger(uart_stream_port_t port, size_t rx_trigger_level);
+
+/* returns 1 if everything that was written has left the USART */
+int uart_stream_tx_idle(uart_stream_port_t port);
+
+void uart_stream_get_stats(uart_stream_port_t port, uart_stream_stats_t *stats);
+
+/* prints the stats of the opened ports:
+ *   UART: "USART1" rx <n> dropped <n> overruns <n> tx <n> rx irqs <n> tx irqs <n> */
+void uart_stream_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_STREAM_H_ */
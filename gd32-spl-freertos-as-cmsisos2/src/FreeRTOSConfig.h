@@ -25,6 +25,8 @@ extern void vAssertCalled( void );
 
 #define configUSE_PREEMPTION                             1
 #define configUSE_TIME_SLICING                           0
+/* the CLZ based task selection of the Cortex-M3, M4 and M33 ports only
+ * handles 32 priorities, CMSIS-OS2 needs 56 */
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION          0
 
 #define configUSE_IDLE_HOOK                              1
@@ -105,8 +107,6 @@ uint32_t ulGetRunTimeCounterValue( void );
 #define INCLUDE_xTaskAbortDelay                   1
 #define INCLUDE_xTaskGetCurrentTaskHandle         1
 
-unsigned long ulGetRunTimeCounterValue( void ); /* Prototype of function that returns run time counter. */
-
 #define projCOVERAGE_TEST                       0
 
 #define configKERNEL_INTERRUPT_PRIORITY         255
@@ -127,4 +127,55 @@ extern void vLoggingPrintf( const char * pcFormatString,
     #define xPortGetFreeHeapSize               ( x )
 #endif
 
+/* stack usage monitoring and overflow guard (lib/FreeRTOS/src/stack_monitor) */
+#ifdef PIO_FREERTOS_STACK_MONITOR
+/* the stack sizes are read from the task control blocks */
+#define configRECORD_STACK_HIGH_ADDRESS           1
+/* checks the end of the stack on every context switch, on all cores */
+#define configCHECK_FOR_STACK_OVERFLOW            2
+#if defined(__ARM_ARCH_8M_BASE__) && !defined(PIO_FREERTOS_TRACE_RECORDER)
+/* the Cortex-M23 guard is an MPU region that follows the running task. The
+ * trace recorder uses the same hook, together with it only the check of
+ * configCHECK_FOR_STACK_OVERFLOW is left. */
+void stack_monitor_task_switched_in( void * stack );
+#define traceTASK_SWITCHED_IN() stack_monitor_task_switched_in( pxCurrentTCB->pxStack )
+#endif
+#endif
+
+/* mutex contention profiler (lib/FreeRTOS/src/mutex_profiler). only expanded
+ * inside queue.c, where the queue type and the mutex holder are visible. */
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+void mutex_profiler_blocking( void * mutex, void * holder );
+void mutex_profiler_taken( void * mutex );
+void mutex_profiler_take_failed( void * mutex );
+void mutex_profiler_given( void * mutex );
+void mutex_profiler_deleted( void * mutex );
+#ifdef PIO_FREERTOS_TRACE_RECORDER
+/* freertos_evr.h leaves these macros to the profiler, which calls the event
+ * functions of the trace recorder itself */
+#define traceBLOCKING_ON_QUEUE_RECEIVE_DISABLE
+#define traceQUEUE_RECEIVE_DISABLE
+#define traceQUEUE_RECEIVE_FAILED_DISABLE
+#define traceQUEUE_SEND_DISABLE
+#define traceQUEUE_DELETE_DISABLE
+#define MUTEX_PROFILER_EVR( call ) call;
+#else
+#define MUTEX_PROFILER_EVR( call )
+#endif
+#define MUTEX_PROFILER_IS_MUTEX( pxQueue ) ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) do { MUTEX_PROFILER_EVR( EvrFreeRTOSQueue_BlockingOnQueueReceive( pxQueue ) ) if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_blocking( ( pxQueue ), ( pxQueue )->u.xSemaphore.xMutexHolder ); } while( 0 )
+#define traceQUEUE_RECEIVE( pxQueue )             do { MUTEX_PROFILER_EVR( EvrFreeRTOSQueue_QueueReceive( pxQueue ) ) if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_taken( pxQueue ); } while( 0 )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )      do { MUTEX_PROFILER_EVR( EvrFreeRTOSQueue_QueueReceiveFailed( pxQueue ) ) if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_take_failed( pxQueue ); } while( 0 )
+#define traceQUEUE_SEND( pxQueue )                do { MUTEX_PROFILER_EVR( EvrFreeRTOSQueue_QueueSend( pxQueue ) ) if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_given( pxQueue ); } while( 0 )
+#define traceQUEUE_DELETE( pxQueue )              do { MUTEX_PROFILER_EVR( EvrFreeRTOSQueue_QueueDelete( pxQueue ) ) if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_deleted( pxQueue ); } while( 0 )
+#endif
+
+#ifdef PIO_FREERTOS_TRACE_RECORDER
+/* map the FreeRTOS trace macros to the event functions of freertos_evr.c,
+ * which record into the RAM buffer of the trace recorder. Only the error and
+ * operation events are recorded, see the configEVR_LEVEL_* defaults in
+ * freertos_evr.c. */
+#include "freertos_evr.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
\ No newline at end of file
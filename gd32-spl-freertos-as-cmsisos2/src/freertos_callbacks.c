@@ -1,10 +1,24 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <FreeRTOSConfig.h>
+#ifdef PIO_FREERTOS_STACK_MONITOR
+#include <stack_monitor.h>
+#endif
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
 
+#ifdef PIO_FREERTOS_STACK_MONITOR
+/* replaces the weak default of cmsis_os2.c, which only asserts */
+void vApplicationStackOverflowHook( TaskHandle_t xTask,
+                                    char * pcTaskName )
+{
+    ( void ) xTask;
+    stack_monitor_overflow( pcTaskName );
+}
+/*-----------------------------------------------------------*/
+#endif
+
 void vAssertCalled( void )
 {
     volatile unsigned long looping = 0;
@@ -23,10 +37,18 @@ void vAssertCalled( void )
 
 /* runtime stats */
 #if configGENERATE_RUN_TIME_STATS == 1
+#ifdef FREERTOS_SIM
+/* the host simulator emulates the cycle counter (scripts/freertos_sim) */
+#include <gd32_include.h>
+#define rtsDWT_CYCCNT 			( DWT->CYCCNT )
+#define rtsDWT_CONTROL 			( DWT->CTRL )
+#define rtsSCB_DEMCR 			( CoreDebug->DEMCR )
+#else
 /* Addresses of registers in the Cortex-M debug hardware. */
 #define rtsDWT_CYCCNT 			( *( ( unsigned long * ) 0xE0001004 ) )
 #define rtsDWT_CONTROL 			( *( ( unsigned long * ) 0xE0001000 ) )
 #define rtsSCB_DEMCR 			( *( ( unsigned long * ) 0xE000EDFC ) )
+#endif
 #define rtsTRCENA_BIT			( 0x01000000UL )
 #define rtsCOUNTER_ENABLE_BIT	( 0x01UL )
 
@@ -3,6 +3,42 @@
 #include <stdio.h>
 #include <stdarg.h>
 #include <cmsis_os2.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#ifdef PIO_FREERTOS_TRACE_RECORDER
+#include <trace_recorder.h>
+
+/* application markers in the trace */
+enum
+{
+    TRACE_MARK_BLINKY_PRINT = 1,
+    TRACE_MARK_PRINTER_LOOP = 2,
+};
+/* the trace is printed once after this many loops of the printer thread */
+#define TRACE_DUMP_AFTER_LOOPS 5
+#endif
+#ifdef MPOOL_BENCHMARK
+#include <mpool_bench.h>
+#endif
+#ifdef OS2_FAST_BENCHMARK
+#include <os2_fast_bench.h>
+#endif
+#ifdef CMSIS_OS2_FAST_REMAP
+/* the printf mutex below goes through the inlined fast paths */
+#include <cmsis_os2_fast.h>
+#endif
+#ifdef PIO_FREERTOS_STACK_MONITOR
+#include <stack_monitor.h>
+/* the stack usage is printed every this many loops of the printer thread */
+#define STACK_REPORT_LOOPS 15
+#endif
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+#include <mutex_profiler.h>
+/* the mutex contention is printed every this many loops of the printer thread */
+#define MUTEX_REPORT_LOOPS 5
+/* owners listed per mutex */
+#define MUTEX_REPORT_OWNERS 3
+#endif
 
 #define LEDPORT GPIOA
 #define LEDPIN GPIO_PIN_1
@@ -10,11 +46,16 @@
 
 #define STACK_SIZE (256 * 4)
 uint8_t blinky_thread_stack[STACK_SIZE];
-uint8_t blinky_control_block[100]; //must be >= sizeof(StaticTask_t)
+StaticTask_t blinky_control_block;
 osThreadId_t blinky_thread;
 uint8_t print_thread_stack[STACK_SIZE];
-uint8_t print_control_block[100]; //must be >= sizeof(StaticTask_t)
+StaticTask_t print_control_block;
 osThreadId_t print_thread;
+#if defined(MPOOL_BENCHMARK) || defined(OS2_FAST_BENCHMARK)
+uint8_t bench_thread_stack[STACK_SIZE];
+StaticTask_t bench_control_block;
+osThreadId_t bench_thread;
+#endif
 
 void init_led()
 {
@@ -61,22 +102,87 @@ void vBlinkyTask(void *pvParameters)
         osDelay(500);
         gpio_bit_reset(LEDPORT, LEDPIN);
         osDelay(500);
+#ifdef PIO_FREERTOS_TRACE_RECORDER
+        /* shows the time spent waiting for the printf mutex and printing */
+        trace_recorder_begin(TRACE_MARK_BLINKY_PRINT, 0);
         threadsafe_printf("Blinky!\n");
+        trace_recorder_end(TRACE_MARK_BLINKY_PRINT, 0);
+#else
+        threadsafe_printf("Blinky!\n");
+#endif
     }
 }
 
 void vPrintTask(void *pvParameters)
 {
+#ifdef PIO_FREERTOS_TRACE_RECORDER
+    uint32_t loops = 0;
+#endif
+#ifdef PIO_FREERTOS_STACK_MONITOR
+    uint32_t stack_loops = 0;
+#endif
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+    uint32_t mutex_loops = 0;
+#endif
     for (;;)
     {
         osDelay(2000);
         threadsafe_printf("Hello from thread \"%s\" (Thread ID %p)!\n",
                           osThreadGetName(osThreadGetId()), osThreadGetId());
+#ifdef PIO_FREERTOS_TRACE_RECORDER
+        trace_recorder_mark(TRACE_MARK_PRINTER_LOOP, ++loops);
+        if (loops == TRACE_DUMP_AFTER_LOOPS)
+        {
+            /* hold the printf mutex so that the dump is not interrupted */
+            threadsafe_printf_lock();
+            trace_recorder_dump(1);
+            threadsafe_printf_unlock();
+        }
+#endif
+#ifdef PIO_FREERTOS_STACK_MONITOR
+        if (++stack_loops % STACK_REPORT_LOOPS == 0)
+        {
+            threadsafe_printf_lock();
+            stack_monitor_print();
+            threadsafe_printf_unlock();
+        }
+#endif
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+        if (++mutex_loops % MUTEX_REPORT_LOOPS == 0)
+        {
+            threadsafe_printf_lock();
+            mutex_profiler_print(MUTEX_REPORT_OWNERS);
+            threadsafe_printf_unlock();
+        }
+#endif
     }
 }
 
+#if defined(MPOOL_BENCHMARK) || defined(OS2_FAST_BENCHMARK)
+void vBenchTask(void *pvParameters)
+{
+    /* hold the printf mutex so that the results are not interrupted */
+    threadsafe_printf_lock();
+#ifdef MPOOL_BENCHMARK
+    mpool_bench_run();
+#endif
+#ifdef OS2_FAST_BENCHMARK
+    os2_fast_bench_run();
+#endif
+    threadsafe_printf_unlock();
+    osThreadExit();
+}
+#endif
+
 int main(void)
 {
+#ifdef PIO_FREERTOS_STACK_MONITOR
+    /* before anything uses the interrupt stack or the C library heap */
+    stack_monitor_init();
+#endif
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+    mutex_profiler_init();
+#endif
     init_printf_transport();
     threadsafe_printf_init();
     init_led();
@@ -88,9 +194,14 @@ int main(void)
 
     /* Initialize CMSIS-RTOS */
     osKernelInitialize();
+#ifdef PIO_FREERTOS_TRACE_RECORDER
+    /* the recorder is initialized by osKernelInitialize() */
+    trace_recorder_name(TRACE_MARK_BLINKY_PRINT, "BlinkyPrint");
+    trace_recorder_name(TRACE_MARK_PRINTER_LOOP, "PrinterLoop");
+#endif
     /* create threads with a pre-allocated stacks */
     const osThreadAttr_t blinkyThreadAttr = {
-        .cb_mem = blinky_control_block,
+        .cb_mem = &blinky_control_block,
         .cb_size = sizeof(blinky_control_block),
         .name = "Blinky",
         .stack_mem = blinky_thread_stack,
@@ -99,7 +210,7 @@ int main(void)
     blinky_thread = osThreadNew(vBlinkyTask, NULL, &blinkyThreadAttr);
 
     const osThreadAttr_t printThreadAttr = {
-        .cb_mem = print_control_block,
+        .cb_mem = &print_control_block,
         .cb_size = sizeof(print_control_block),
         .name = "Printer",
         .stack_mem = print_thread_stack,
@@ -107,6 +218,17 @@ int main(void)
     };
     print_thread = osThreadNew(vPrintTask, NULL, &printThreadAttr);
 
+#if defined(MPOOL_BENCHMARK) || defined(OS2_FAST_BENCHMARK)
+    const osThreadAttr_t benchThreadAttr = {
+        .cb_mem = &bench_control_block,
+        .cb_size = sizeof(bench_control_block),
+        .name = "Bench",
+        .stack_mem = bench_thread_stack,
+        .stack_size = sizeof(bench_thread_stack)
+    };
+    bench_thread = osThreadNew(vBenchTask, NULL, &benchThreadAttr);
+#endif
+
     /* Start the scheduler itself. */
     if (osKernelGetState() == osKernelReady)
     {
@@ -0,0 +1,239 @@
+#include <gd32_include.h>
+#include <stdio.h>
+#include <cmsis_os2.h>
+#include <freertos_mpool.h>
+#include <mpool.h>
+#include <mpool_bench.h>
+
+#ifdef MPOOL_BENCHMARK
+#define BENCH_ITERATIONS 1000
+#define BENCH_BLOCKS 16
+#define BENCH_BLOCK_SIZE 32
+/* blocks taken in a row, so that the free list is neither empty nor full */
+#define BENCH_BATCH (BENCH_BLOCKS / 2)
+
+/* interrupt used for the measurements from an interrupt handler. The EXTI
+ * line itself is never configured, the interrupt is only set pending. */
+#if defined(GD32F1x0) || defined(GD32F3x0) || defined(GD32E23x)
+#define BENCH_IRQn EXTI0_1_IRQn
+#define BENCH_IRQHandler EXTI0_1_IRQHandler
+#else
+#define BENCH_IRQn EXTI0_IRQn
+#define BENCH_IRQHandler EXTI0_IRQHandler
+#endif
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} bench_result_t;
+
+typedef struct
+{
+    bench_result_t alloc;
+    bench_result_t free;
+} bench_pair_t;
+
+static uint8_t os_pool_cb[MEMPOOL_CB_SIZE] __attribute__((aligned(4)));
+static uint8_t os_pool_mem[MEMPOOL_ARR_SIZE(BENCH_BLOCKS, BENCH_BLOCK_SIZE)] __attribute__((aligned(4)));
+static osMemoryPoolId_t os_pool;
+
+static mpool_t mp_pool;
+static uint8_t mp_pool_mem[MPOOL_MEM_SIZE(BENCH_BLOCKS, BENCH_BLOCK_SIZE)] __attribute__((aligned(4)));
+
+static bench_pair_t os_thread, os_isr, mp_thread, mp_isr;
+static volatile int isr_done;
+
+#if defined(GD32E23x)
+/* The Cortex-M23 has no DWT cycle counter. The SysTick counts down from the
+ * CPU clock, which is good enough for intervals shorter than one tick. */
+static inline uint32_t bench_now(void)
+{
+    return SysTick->VAL;
+}
+
+static inline uint32_t bench_elapsed(uint32_t start, uint32_t end)
+{
+    return start >= end ? start - end : start + SysTick->LOAD + 1U - end;
+}
+#else
+static inline uint32_t bench_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t bench_elapsed(uint32_t start, uint32_t end)
+{
+    return end - start;
+}
+#endif
+
+static void result_reset(bench_result_t *r)
+{
+    r->count = 0;
+    r->min = UINT32_MAX;
+    r->max = 0;
+    r->sum = 0;
+}
+
+static void result_add(bench_result_t *r, uint32_t cycles)
+{
+    r->count++;
+    r->sum += cycles;
+    if (cycles < r->min)
+        r->min = cycles;
+    if (cycles > r->max)
+        r->max = cycles;
+}
+
+static void result_print(const char *name, const bench_result_t *r)
+{
+    if (r->count == 0)
+    {
+        printf("%-34s no samples\n", name);
+        return;
+    }
+    printf("%-34s %6lu %6lu %6lu\n", name, (unsigned long)r->min,
+           (unsigned long)(r->sum / r->count), (unsigned long)r->max);
+}
+
+/* the timed calls are kept in the same shape for both pools, so that the
+ * measurement overhead is the same */
+static void bench_os_pool(bench_pair_t *res)
+{
+    void *blocks[BENCH_BATCH];
+    result_reset(&res->alloc);
+    result_reset(&res->free);
+    for (uint32_t i = 0; i < BENCH_ITERATIONS / BENCH_BATCH; i++)
+    {
+        for (uint32_t j = 0; j < BENCH_BATCH; j++)
+        {
+            uint32_t start = bench_now();
+            blocks[j] = osMemoryPoolAlloc(os_pool, 0);
+            result_add(&res->alloc, bench_elapsed(start, bench_now()));
+        }
+        for (uint32_t j = 0; j < BENCH_BATCH; j++)
+        {
+            uint32_t start = bench_now();
+            osMemoryPoolFree(os_pool, blocks[j]);
+            result_add(&res->free, bench_elapsed(start, bench_now()));
+        }
+    }
+}
+
+static void bench_mpool(bench_pair_t *res)
+{
+    void *blocks[BENCH_BATCH];
+    result_reset(&res->alloc);
+    result_reset(&res->free);
+    for (uint32_t i = 0; i < BENCH_ITERATIONS / BENCH_BATCH; i++)
+    {
+        for (uint32_t j = 0; j < BENCH_BATCH; j++)
+        {
+            uint32_t start = bench_now();
+            blocks[j] = mpool_alloc(&mp_pool);
+            result_add(&res->alloc, bench_elapsed(start, bench_now()));
+        }
+        for (uint32_t j = 0; j < BENCH_BATCH; j++)
+        {
+            uint32_t start = bench_now();
+            mpool_free(&mp_pool, blocks[j]);
+            result_add(&res->free, bench_elapsed(start, bench_now()));
+        }
+    }
+}
+
+void BENCH_IRQHandler(void)
+{
+    bench_os_pool(&os_isr);
+    bench_mpool(&mp_isr);
+    isr_done = 1;
+}
+
+/* takes all blocks, checks that the pool is then empty and gives them back */
+static int self_test(void)
+{
+    void *blocks[BENCH_BLOCKS];
+    int ok = 1;
+    for (uint32_t i = 0; i < BENCH_BLOCKS; i++)
+    {
+        blocks[i] = mpool_alloc(&mp_pool);
+        ok &= blocks[i] != NULL;
+        for (uint32_t j = 0; j < i && ok; j++)
+        {
+            ok &= blocks[j] != blocks[i];
+        }
+    }
+    ok &= mpool_alloc(&mp_pool) == NULL;
+    ok &= mpool_alloc_wait(&mp_pool, 2) == NULL;
+    ok &= mpool_free(&mp_pool, (uint8_t *)blocks[0] + 1) == pdFAIL;
+    for (uint32_t i = 0; i < BENCH_BLOCKS; i++)
+    {
+        ok &= blocks[i] == NULL || mpool_free(&mp_pool, blocks[i]) == pdPASS;
+    }
+    return ok;
+}
+
+void mpool_bench_run(void)
+{
+    const osMemoryPoolAttr_t attr = {
+        .name = "bench",
+        .cb_mem = os_pool_cb,
+        .cb_size = sizeof(os_pool_cb),
+        .mp_mem = os_pool_mem,
+        .mp_size = sizeof(os_pool_mem),
+    };
+    os_pool = osMemoryPoolNew(BENCH_BLOCKS, BENCH_BLOCK_SIZE, &attr);
+    if (os_pool == NULL || mpool_init(&mp_pool, mp_pool_mem, sizeof(mp_pool_mem), BENCH_BLOCKS,
+                                      BENCH_BLOCK_SIZE, 1) != pdPASS)
+    {
+        printf("mpool benchmark: pool creation failed\n");
+        return;
+    }
+#if !defined(GD32E23x)
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    printf("mpool benchmark: %u blocks of %u bytes, %s, SystemCoreClock = %lu Hz\n",
+           BENCH_BLOCKS, BENCH_BLOCK_SIZE,
+           MPOOL_USE_EXCLUSIVES ? "LDREX/STREX" : "interrupts masked", (unsigned long)SystemCoreClock);
+    printf("mpool self test: %s\n", self_test() ? "ok" : "FAILED");
+
+    /* the first blocks of the CMSIS-OS2 pool are created on the fly, take
+     * them all once so that only the free list is measured */
+    bench_os_pool(&os_thread);
+    bench_os_pool(&os_thread);
+    bench_mpool(&mp_thread);
+
+    /* lowest priority, always allowed to call FreeRTOS API functions */
+    isr_done = 0;
+    NVIC_SetPriority(BENCH_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+    NVIC_ClearPendingIRQ(BENCH_IRQn);
+    NVIC_EnableIRQ(BENCH_IRQn);
+    NVIC_SetPendingIRQ(BENCH_IRQn);
+    while (!isr_done)
+    {
+        osDelay(1);
+    }
+    NVIC_DisableIRQ(BENCH_IRQn);
+
+    uint32_t start = bench_now();
+    uint32_t overhead = bench_elapsed(start, bench_now());
+    printf("cycles per call (timestamp overhead of %lu cycles included)\n", (unsigned long)overhead);
+    printf("%-34s %6s %6s %6s\n", "", "min", "avg", "max");
+    result_print("osMemoryPoolAlloc, thread", &os_thread.alloc);
+    result_print("mpool_alloc, thread", &mp_thread.alloc);
+    result_print("osMemoryPoolFree, thread", &os_thread.free);
+    result_print("mpool_free, thread", &mp_thread.free);
+    result_print("osMemoryPoolAlloc, ISR", &os_isr.alloc);
+    result_print("mpool_alloc, ISR", &mp_isr.alloc);
+    result_print("osMemoryPoolFree, ISR", &os_isr.free);
+    result_print("mpool_free, ISR", &mp_isr.free);
+
+    osMemoryPoolDelete(os_pool);
+}
+#endif
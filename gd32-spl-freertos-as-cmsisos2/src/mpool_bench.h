@@ -0,0 +1,9 @@
+#ifndef MPOOL_BENCH_H_
+#define MPOOL_BENCH_H_
+
+/* compares the cycles of osMemoryPoolAlloc() / osMemoryPoolFree() with
+ * mpool_alloc() / mpool_free(), from a thread and from an interrupt handler,
+ * and prints the results. Call from a thread after the kernel was started. */
+void mpool_bench_run(void);
+
+#endif /* MPOOL_BENCH_H_ */
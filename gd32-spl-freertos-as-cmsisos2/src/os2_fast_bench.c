@@ -0,0 +1,304 @@
+#include <gd32_include.h>
+#include <stdio.h>
+#include <cmsis_os2.h>
+#include <cmsis_os2_fast.h>
+#include <os2_fast_bench.h>
+
+#ifdef OS2_FAST_BENCHMARK
+#define BENCH_ITERATIONS 1000
+#define BENCH_MSG_COUNT 4
+#define BENCH_FLAG 0x0001U
+
+/* interrupt used for the measurements from an interrupt handler. The EXTI
+ * line itself is never configured, the interrupt is only set pending. */
+#if defined(GD32F1x0) || defined(GD32F3x0) || defined(GD32E23x)
+#define BENCH_IRQn EXTI0_1_IRQn
+#define BENCH_IRQHandler EXTI0_1_IRQHandler
+#else
+#define BENCH_IRQn EXTI0_IRQn
+#define BENCH_IRQHandler EXTI0_IRQHandler
+#endif
+
+/* the measured calls, each one through cmsis_os2.c and through the header */
+enum
+{
+    CALL_TICK_COUNT,
+    CALL_SEMAPHORE_RELEASE,
+    CALL_SEMAPHORE_ACQUIRE,
+    CALL_MUTEX_ACQUIRE,
+    CALL_MUTEX_RELEASE,
+    CALL_THREAD_FLAGS_SET,
+    CALL_QUEUE_PUT,
+    CALL_QUEUE_GET,
+    CALL_COUNT
+};
+
+static const char *const call_names[CALL_COUNT] = {
+    "osKernelGetTickCount",
+    "osSemaphoreRelease",
+    "osSemaphoreAcquire",
+    "osMutexAcquire",
+    "osMutexRelease",
+    "osThreadFlagsSet",
+    "osMessageQueuePut",
+    "osMessageQueueGet",
+};
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+} bench_result_t;
+
+typedef struct
+{
+    bench_result_t regular;
+    bench_result_t fast;
+} bench_pair_t;
+
+static StaticSemaphore_t sem_cb;
+static osSemaphoreId_t sem;
+static StaticSemaphore_t mutex_cb;
+static osMutexId_t mutex;
+static StaticQueue_t queue_cb;
+static uint32_t queue_mem[BENCH_MSG_COUNT];
+static osMessageQueueId_t queue;
+static osThreadId_t bench_thread;
+
+static bench_pair_t thread_res[CALL_COUNT], isr_res[CALL_COUNT];
+static volatile int isr_done;
+static volatile int isr_self_test_ok;
+
+#if defined(GD32E23x)
+/* The Cortex-M23 has no DWT cycle counter. The SysTick counts down from the
+ * CPU clock, which is good enough for intervals shorter than one tick. */
+static inline uint32_t bench_now(void)
+{
+    return SysTick->VAL;
+}
+
+static inline uint32_t bench_elapsed(uint32_t start, uint32_t end)
+{
+    return start >= end ? start - end : start + SysTick->LOAD + 1U - end;
+}
+#else
+static inline uint32_t bench_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+static inline uint32_t bench_elapsed(uint32_t start, uint32_t end)
+{
+    return end - start;
+}
+#endif
+
+static void result_reset(bench_result_t *r)
+{
+    r->count = 0;
+    r->min = UINT32_MAX;
+    r->max = 0;
+    r->sum = 0;
+}
+
+static void result_add(bench_result_t *r, uint32_t cycles)
+{
+    r->count++;
+    r->sum += cycles;
+    if (cycles < r->min)
+        r->min = cycles;
+    if (cycles > r->max)
+        r->max = cycles;
+}
+
+static void result_print(const char *name, const char *suffix, const char *context, const bench_result_t *r)
+{
+    char label[40];
+    snprintf(label, sizeof(label), "%s%s, %s", name, suffix, context);
+    if (r->count == 0)
+    {
+        printf("%-34s no samples\n", label);
+        return;
+    }
+    printf("%-34s %6lu %6lu %6lu\n", label, (unsigned long)r->min,
+           (unsigned long)(r->sum / r->count), (unsigned long)r->max);
+}
+
+#define BENCH_TIME(result, call)                              \
+    do                                                        \
+    {                                                         \
+        uint32_t start = bench_now();                         \
+        (void)(call);                                         \
+        result_add((result), bench_elapsed(start, bench_now())); \
+    } while (0)
+
+/* every call is timed right after its counterpart, so that both see the
+ * same state of the objects and of the flash cache */
+static void bench_calls(bench_pair_t *res, int in_isr)
+{
+    uint32_t msg = 0x5a5a5a5aU;
+    for (uint32_t i = 0; i < CALL_COUNT; i++)
+    {
+        result_reset(&res[i].regular);
+        result_reset(&res[i].fast);
+    }
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        BENCH_TIME(&res[CALL_TICK_COUNT].regular, osKernelGetTickCount());
+        BENCH_TIME(&res[CALL_TICK_COUNT].fast, osKernelGetTickCountFast());
+
+        BENCH_TIME(&res[CALL_SEMAPHORE_RELEASE].regular, osSemaphoreRelease(sem));
+        BENCH_TIME(&res[CALL_SEMAPHORE_ACQUIRE].regular, osSemaphoreAcquire(sem, 0));
+        BENCH_TIME(&res[CALL_SEMAPHORE_RELEASE].fast, osSemaphoreReleaseFast(sem));
+        BENCH_TIME(&res[CALL_SEMAPHORE_ACQUIRE].fast, osSemaphoreAcquireFast(sem, 0));
+
+        /* mutexes cannot be used from an interrupt handler */
+        if (!in_isr)
+        {
+            BENCH_TIME(&res[CALL_MUTEX_ACQUIRE].regular, osMutexAcquire(mutex, 0));
+            BENCH_TIME(&res[CALL_MUTEX_RELEASE].regular, osMutexRelease(mutex));
+            BENCH_TIME(&res[CALL_MUTEX_ACQUIRE].fast, osMutexAcquireFast(mutex, 0));
+            BENCH_TIME(&res[CALL_MUTEX_RELEASE].fast, osMutexReleaseFast(mutex));
+        }
+
+        /* the flags of the benchmark thread, which does not wait for them */
+        BENCH_TIME(&res[CALL_THREAD_FLAGS_SET].regular, osThreadFlagsSet(bench_thread, BENCH_FLAG));
+        BENCH_TIME(&res[CALL_THREAD_FLAGS_SET].fast, osThreadFlagsSetFast(bench_thread, BENCH_FLAG));
+
+        BENCH_TIME(&res[CALL_QUEUE_PUT].regular, osMessageQueuePut(queue, &msg, 0, 0));
+        BENCH_TIME(&res[CALL_QUEUE_GET].regular, osMessageQueueGet(queue, &msg, NULL, 0));
+        BENCH_TIME(&res[CALL_QUEUE_PUT].fast, osMessageQueuePutFast(queue, &msg, 0, 0));
+        BENCH_TIME(&res[CALL_QUEUE_GET].fast, osMessageQueueGetFast(queue, &msg, NULL, 0));
+    }
+}
+
+/* both versions must return the same, also for the error cases */
+static int self_test_isr(void)
+{
+    uint32_t msg = 0;
+    int ok = 1;
+    ok &= osMutexAcquire(mutex, 0) == osErrorISR && osMutexAcquireFast(mutex, 0) == osErrorISR;
+    ok &= osMutexRelease(mutex) == osErrorISR && osMutexReleaseFast(mutex) == osErrorISR;
+    ok &= osSemaphoreAcquire(sem, 1) == osErrorParameter && osSemaphoreAcquireFast(sem, 1) == osErrorParameter;
+    ok &= osSemaphoreAcquire(sem, 0) == osErrorResource && osSemaphoreAcquireFast(sem, 0) == osErrorResource;
+    ok &= osMessageQueueGet(queue, &msg, NULL, 1) == osErrorParameter &&
+          osMessageQueueGetFast(queue, &msg, NULL, 1) == osErrorParameter;
+    ok &= osMessageQueueGet(queue, &msg, NULL, 0) == osErrorResource &&
+          osMessageQueueGetFast(queue, &msg, NULL, 0) == osErrorResource;
+    return ok;
+}
+
+static int self_test_thread(void)
+{
+    uint32_t msg = 0;
+    int ok = 1;
+    ok &= osSemaphoreAcquire(NULL, 0) == osErrorParameter && osSemaphoreAcquireFast(NULL, 0) == osErrorParameter;
+    ok &= osSemaphoreAcquire(sem, 0) == osErrorResource && osSemaphoreAcquireFast(sem, 0) == osErrorResource;
+    ok &= osSemaphoreAcquire(sem, 1) == osErrorTimeout && osSemaphoreAcquireFast(sem, 1) == osErrorTimeout;
+    ok &= osMutexAcquire(NULL, 0) == osErrorParameter && osMutexAcquireFast(NULL, 0) == osErrorParameter;
+    ok &= osMutexRelease(mutex) == osErrorResource && osMutexReleaseFast(mutex) == osErrorResource;
+    ok &= osThreadFlagsSet(bench_thread, 0x80000000U) == (uint32_t)osErrorParameter &&
+          osThreadFlagsSetFast(bench_thread, 0x80000000U) == (uint32_t)osErrorParameter;
+    ok &= osThreadFlagsSet(bench_thread, BENCH_FLAG) == osThreadFlagsSetFast(bench_thread, BENCH_FLAG);
+    osThreadFlagsClear(BENCH_FLAG);
+    ok &= osMessageQueueGet(queue, &msg, NULL, 0) == osErrorResource &&
+          osMessageQueueGetFast(queue, &msg, NULL, 0) == osErrorResource;
+    ok &= osMessageQueuePut(queue, NULL, 0, 0) == osErrorParameter &&
+          osMessageQueuePutFast(queue, NULL, 0, 0) == osErrorParameter;
+
+    /* with interrupts masked, the header goes through cmsis_os2.c */
+    __disable_irq();
+    ok &= osSemaphoreRelease(sem) == osOK && osSemaphoreAcquireFast(sem, 0) == osOK;
+    ok &= osSemaphoreReleaseFast(sem) == osOK && osSemaphoreAcquire(sem, 0) == osOK;
+    __enable_irq();
+    return ok;
+}
+
+void BENCH_IRQHandler(void)
+{
+    isr_self_test_ok = self_test_isr();
+    bench_calls(isr_res, 1);
+    isr_done = 1;
+}
+
+void os2_fast_bench_run(void)
+{
+    const osSemaphoreAttr_t sem_attr = {
+        .name = "bench",
+        .cb_mem = &sem_cb,
+        .cb_size = sizeof(sem_cb),
+    };
+    const osMutexAttr_t mutex_attr = {
+        .name = "bench",
+        .cb_mem = &mutex_cb,
+        .cb_size = sizeof(mutex_cb),
+    };
+    const osMessageQueueAttr_t queue_attr = {
+        .name = "bench",
+        .cb_mem = &queue_cb,
+        .cb_size = sizeof(queue_cb),
+        .mq_mem = queue_mem,
+        .mq_size = sizeof(queue_mem),
+    };
+    sem = osSemaphoreNew(1, 0, &sem_attr);
+    mutex = osMutexNew(&mutex_attr);
+    queue = osMessageQueueNew(BENCH_MSG_COUNT, sizeof(queue_mem[0]), &queue_attr);
+    bench_thread = osThreadGetId();
+    if (sem == NULL || mutex == NULL || queue == NULL)
+    {
+        printf("CMSIS-OS2 fast path benchmark: object creation failed\n");
+        return;
+    }
+#if !defined(GD32E23x)
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    printf("CMSIS-OS2 fast path benchmark: %u calls each, SystemCoreClock = %lu Hz\n",
+           BENCH_ITERATIONS, (unsigned long)SystemCoreClock);
+    int thread_ok = self_test_thread();
+
+    bench_calls(thread_res, 0);
+    osThreadFlagsClear(BENCH_FLAG);
+
+    /* lowest priority, always allowed to call FreeRTOS API functions */
+    isr_done = 0;
+    NVIC_SetPriority(BENCH_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+    NVIC_ClearPendingIRQ(BENCH_IRQn);
+    NVIC_EnableIRQ(BENCH_IRQn);
+    NVIC_SetPendingIRQ(BENCH_IRQn);
+    while (!isr_done)
+    {
+        osDelay(1);
+    }
+    NVIC_DisableIRQ(BENCH_IRQn);
+    osThreadFlagsClear(BENCH_FLAG);
+    printf("CMSIS-OS2 fast path self test: %s\n", thread_ok && isr_self_test_ok ? "ok" : "FAILED");
+
+    uint32_t start = bench_now();
+    uint32_t overhead = bench_elapsed(start, bench_now());
+    printf("cycles per call (timestamp overhead of %lu cycles included)\n", (unsigned long)overhead);
+    printf("%-34s %6s %6s %6s\n", "", "min", "avg", "max");
+    for (uint32_t i = 0; i < CALL_COUNT; i++)
+    {
+        result_print(call_names[i], "", "thread", &thread_res[i].regular);
+        result_print(call_names[i], "Fast", "thread", &thread_res[i].fast);
+    }
+    for (uint32_t i = 0; i < CALL_COUNT; i++)
+    {
+        if (i == CALL_MUTEX_ACQUIRE || i == CALL_MUTEX_RELEASE)
+        {
+            continue;
+        }
+        result_print(call_names[i], "", "ISR", &isr_res[i].regular);
+        result_print(call_names[i], "Fast", "ISR", &isr_res[i].fast);
+    }
+
+    osMessageQueueDelete(queue);
+    osMutexDelete(mutex);
+    osSemaphoreDelete(sem);
+}
+#endif
@@ -0,0 +1,10 @@
+#ifndef OS2_FAST_BENCH_H_
+#define OS2_FAST_BENCH_H_
+
+/* compares the cycles of the hot CMSIS-OS2 calls of cmsis_os2.c with their
+ * inlined versions of cmsis_os2_fast.h, from a thread and from an interrupt
+ * handler, checks that both return the same and prints the results. Call
+ * from a thread after the kernel was started. */
+void os2_fast_bench_run(void);
+
+#endif /* OS2_FAST_BENCH_H_ */
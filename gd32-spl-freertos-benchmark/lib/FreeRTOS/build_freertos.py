@@ -0,0 +1,129 @@
+from os.path import join, realpath
+Import('env')
+global_env = DefaultEnvironment()
+
+board = env.BoardConfig()
+cpu = board.get("build.cpu", "")
+
+port_to_use = None
+cpu_to_port_map = {
+    "cortex-m3": "ARM_CM3",
+    "cortex-m4": "ARM_CM4F", # all GD32 Cortex-M4 based MCUs have a FPU
+    "cortex-m23": join("ARM_CM23_NTZ", "non_secure"), # no trust zone 
+    "cortex-m33": join("ARM_CM33_NTZ", "non_secure"), # no trust zone 
+    # the MPU (memory protection unit) and trust zone port versions are unused 
+}
+if cpu in cpu_to_port_map.keys():
+    port_to_use = cpu_to_port_map[cpu]
+else:
+    print("ERROR: FreeRTOS library can't determine which port to use!")
+
+# check if we should include the CMSIS-OS2 compatibility layer
+cpp_defines = env.Flatten(env.get("CPPDEFINES", []))
+include_cmsisos2 = "PIO_FREERTOS_WITH_CMSISOS2" in cpp_defines
+print("Included CMSIS-OS2 layer: " + str(include_cmsisos2))
+
+# check if the FreeRTOS events should be recorded into the RAM trace buffer.
+# uses the event functions of the CMSIS-OS2 layer (freertos_evr.c).
+include_trace_recorder = "PIO_FREERTOS_TRACE_RECORDER" in cpp_defines
+print("Included trace recorder: " + str(include_trace_recorder))
+
+# check if the TLSF heap (heap_tlsf.c) should replace heap_4.c
+use_heap_tlsf = "PIO_FREERTOS_HEAP_TLSF" in cpp_defines
+print("Heap implementation: " + ("TLSF" if use_heap_tlsf else "heap_4"))
+
+# check if the stack usage monitor and overflow guard should be included
+include_stack_monitor = "PIO_FREERTOS_STACK_MONITOR" in cpp_defines
+print("Included stack monitor: " + str(include_stack_monitor))
+
+# check if the deferred interrupt processing (bottom halves) should be included
+include_defer = "PIO_FREERTOS_DEFER" in cpp_defines
+print("Included deferred interrupt processing: " + str(include_defer))
+
+# check if the tickless idle (vPortSuppressTicksAndSleep() with deep-sleep) should be included
+include_tickless = "PIO_FREERTOS_TICKLESS" in cpp_defines
+print("Included tickless idle: " + str(include_tickless))
+
+# check if the mutex contention profiler should be included
+include_mutex_profiler = "PIO_FREERTOS_MUTEX_PROFILER" in cpp_defines
+print("Included mutex profiler: " + str(include_mutex_profiler))
+
+# check if the UART driver on stream buffers should be included
+include_uart_stream = "PIO_FREERTOS_UART_STREAM" in cpp_defines
+print("Included UART stream driver: " + str(include_uart_stream))
+
+# build one source filter expression
+src_filter_default = [
+    "+<*>",
+    "-<%s>" %join("portable", "*"), # exclude the entire "portable" folder default
+    "+<%s>" % join("portable", port_to_use),
+    "-<mpu_wrappers.c>" # we never compile the port with MPU support so we also shouldn't compile that file.
+    "%s<cmsis_os2>" % ("+" if include_cmsisos2 else "-"),
+    "%s<trace_recorder>" % ("+" if include_trace_recorder else "-"),
+    "%s<stack_monitor>" % ("+" if include_stack_monitor else "-"),
+    "%s<defer>" % ("+" if include_defer else "-"),
+    "%s<tickless>" % ("+" if include_tickless else "-"),
+    "%s<mutex_profiler>" % ("+" if include_mutex_profiler else "-"),
+    "%s<uart_stream>" % ("+" if include_uart_stream else "-"),
+    "-<%s>" % join("heap", "heap_4.c" if use_heap_tlsf else "heap_tlsf.c")
+]
+if include_trace_recorder and not include_cmsisos2:
+    src_filter_default += ["+<%s>" % join("cmsis_os2", "freertos_evr.c")]
+
+include_parts = [
+    join("src", "portable", port_to_use),
+    join("src", "mpool"), # fixed-block memory pool, usable with and without CMSIS-OS2
+    join("src", "heap") # heap_tlsf.h
+]
+
+# the trace recorder, the stack monitor, the deferred interrupt processing,
+# the tickless idle, the mutex profiler and the UART driver find the device
+# header through RTE_Components.h of the CMSIS-OS2 layer
+if include_cmsisos2 or include_trace_recorder or include_stack_monitor or include_defer or include_tickless \
+        or include_mutex_profiler or include_uart_stream:
+    include_parts += [join("src","cmsis_os2")]
+
+if include_stack_monitor:
+    include_parts += [join("src","stack_monitor")]
+
+if include_defer:
+    include_parts += [join("src","defer")]
+
+if include_tickless:
+    include_parts += [join("src","tickless")]
+
+if include_mutex_profiler:
+    include_parts += [join("src","mutex_profiler")]
+
+if include_uart_stream:
+    include_parts += [join("src","uart_stream")]
+
+if include_trace_recorder:
+    include_parts += [join("src","trace_recorder")]
+    # activates the event functions in freertos_evr.c and the call of
+    # EvrFreeRTOSSetup() in osKernelInitialize()
+    global_env.Append(CPPDEFINES=["RTE_Compiler_EventRecorder"])
+    env.Append(CPPDEFINES=["RTE_Compiler_EventRecorder"])
+
+env.Replace(SRC_FILTER=src_filter_default)
+
+for inc in include_parts:
+    env.Append(CPPPATH=[realpath(inc)])
+    global_env.Append(CPPPATH=[realpath(inc)])
+
+# for Cortex-M4F, we need the floating point compiler flags
+if cpu == "cortex-m4":
+    env.Append(
+        CCFLAGS=["-mfpu=fpv4-sp-d16", "-mfloat-abi=softfp"],
+        LINKFLAGS=["-mfpu=fpv4-sp-d16", "-mfloat-abi=softfp"],
+    )
+# fixup assembly errors by assuming thumb2..
+if cpu in ["cortex-m23", "cortex-m33"]:
+    env.Append(
+        CCFLAGS=["-masm-syntax-unified"]
+    )
+if cpu == "cortex-m33":
+    env.Append(
+        CCFLAGS=["-mfpu=fp-armv8", "-mfloat-abi=softfp"],
+        LINKFLAGS=["-mfpu=fp-armv8", "-mfloat-abi=softfp"],
+    )
@@ -0,0 +1,659 @@
+/*
+ * TLSF (two-level segregated fit) heap, a replacement for heap_4.c that is
+ * selected with PIO_FREERTOS_HEAP_TLSF (see build_freertos.py).
+ *
+ * heap_4 keeps one free list sorted by address and walks it on every
+ * allocation, so the time of pvPortMalloc() grows with the number of free
+ * blocks. This heap keeps one free list per size class: the first level
+ * splits the sizes into powers of two, the second level splits each power of
+ * two into 2^configHEAP_TLSF_SL_LOG2 ranges. Two bitmaps mark the non-empty
+ * lists, so a fitting block is found with two bit scans, and freed blocks are
+ * merged with their physical neighbours right away. Allocating and freeing
+ * take a constant time, independent of the heap contents. The one exception
+ * is a request that only fits a block of its own list (e.g. the largest free
+ * block), it walks that list.
+ *
+ * The bit scans compile to CLZ on Cortex-M3, M4 and M33. The Cortex-M23 has
+ * no CLZ instruction, there __builtin_clz() is a short libgcc routine, which
+ * is still independent of the heap contents.
+ *
+ * Every block starts with a header of two words (the same size as the header
+ * of heap_4): the address of the physically previous block and the size of
+ * the block. Bit 0 of the size marks a free block, bits 24 to 31 hold the
+ * index of the allocation site, so the heap can be up to 16 MB large. Free
+ * blocks also hold the links of their free list in the (unused) payload.
+ *
+ * Statistics (heap_tlsf.h): per first-level size class, per allocation site
+ * (up to configHEAP_TLSF_SITES callers of pvPortMalloc(), 0 disables the
+ * table) and a fragmentation index.
+ */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "heap_tlsf.h"
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+#ifndef configHEAP_TLSF_SL_LOG2
+#define configHEAP_TLSF_SL_LOG2 4
+#endif
+
+#ifndef configHEAP_TLSF_SITES
+#define configHEAP_TLSF_SITES 16
+#endif
+
+#if (configHEAP_TLSF_SL_LOG2 < 1) || (configHEAP_TLSF_SL_LOG2 > 5)
+#error "configHEAP_TLSF_SL_LOG2 must be between 1 and 5"
+#endif
+
+#if (configHEAP_TLSF_SITES > 254)
+#error "configHEAP_TLSF_SITES must be at most 254"
+#endif
+
+/* floor(log2(x)) as a constant expression, for array sizes. configTOTAL_HEAP_SIZE
+ * contains a cast, so the preprocessor can't evaluate it. */
+#define TLSF_LOG2_CONST(x)                                                                                      \
+    ((x) >= (1UL << 23) ? 23 : (x) >= (1UL << 22) ? 22 : (x) >= (1UL << 21) ? 21 : (x) >= (1UL << 20) ? 20     \
+     : (x) >= (1UL << 19) ? 19 : (x) >= (1UL << 18) ? 18 : (x) >= (1UL << 17) ? 17 : (x) >= (1UL << 16) ? 16   \
+     : (x) >= (1UL << 15) ? 15 : (x) >= (1UL << 14) ? 14 : (x) >= (1UL << 13) ? 13 : (x) >= (1UL << 12) ? 12   \
+     : (x) >= (1UL << 11) ? 11 : (x) >= (1UL << 10) ? 10 : (x) >= (1UL << 9) ? 9 : (x) >= (1UL << 8) ? 8       \
+     : (x) >= (1UL << 7) ? 7 : (x) >= (1UL << 6) ? 6 : (x) >= (1UL << 5) ? 5 : (x) >= (1UL << 4) ? 4           \
+     : (x) >= (1UL << 3) ? 3 : (x) >= (1UL << 2) ? 2 : (x) >= (1UL << 1) ? 1 : 0)
+
+#define TLSF_ALIGN ((size_t)portBYTE_ALIGNMENT)
+#define TLSF_ALIGN_LOG2 TLSF_LOG2_CONST(portBYTE_ALIGNMENT)
+#define TLSF_SL_COUNT (1U << configHEAP_TLSF_SL_LOG2)
+/* blocks below TLSF_SMALL_SIZE are all in the first class, one list per
+ * TLSF_ALIGN bytes */
+#define TLSF_FL_SHIFT (configHEAP_TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_SIZE ((size_t)1 << TLSF_FL_SHIFT)
+/* no block can be larger than the heap */
+#define TLSF_FL_MAX                                                                                             \
+    (TLSF_LOG2_CONST(configTOTAL_HEAP_SIZE) > TLSF_FL_SHIFT ? TLSF_LOG2_CONST(configTOTAL_HEAP_SIZE)            \
+                                                            : TLSF_FL_SHIFT)
+#define TLSF_FL_COUNT (TLSF_FL_MAX - TLSF_FL_SHIFT + 2)
+
+#define TLSF_FREE_BIT ((size_t)1)
+#define TLSF_SITE_SHIFT 24
+#define TLSF_SIZE_MASK ((((size_t)1 << TLSF_SITE_SHIFT) - 1U) & ~(TLSF_ALIGN - 1U))
+/* index of the "other sites" entry */
+#define TLSF_SITE_OTHER configHEAP_TLSF_SITES
+
+typedef struct tlsf_block
+{
+    struct tlsf_block *prev_phys; /* physically previous block, NULL for the first block */
+    size_t size;                  /* payload size, free bit and site index */
+    /* only valid in free blocks, they are in the payload */
+    struct tlsf_block *next_free;
+    struct tlsf_block *prev_free;
+} tlsf_block_t;
+
+/* the header of a used block, rounded up to the alignment */
+#define TLSF_HEADER_SIZE \
+    ((offsetof(tlsf_block_t, next_free) + TLSF_ALIGN - 1U) & ~(TLSF_ALIGN - 1U))
+/* a free block must have room for the list links */
+#define TLSF_MIN_PAYLOAD \
+    (((sizeof(tlsf_block_t) - TLSF_HEADER_SIZE) + TLSF_ALIGN - 1U) & ~(TLSF_ALIGN - 1U))
+
+typedef struct
+{
+    size_t free_blocks;
+    size_t free_bytes;
+    size_t used_blocks;
+    size_t peak_used_blocks;
+    size_t allocs;
+} tlsf_class_t;
+
+#if (configAPPLICATION_ALLOCATED_HEAP == 1)
+/* The application writer has already defined the array used for the RTOS
+ * heap - probably so it can be placed in a special segment or address. */
+extern uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+#else
+PRIVILEGED_DATA static uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+#endif
+
+PRIVILEGED_DATA static uint32_t fl_bitmap;
+PRIVILEGED_DATA static uint32_t sl_bitmap[TLSF_FL_COUNT];
+PRIVILEGED_DATA static tlsf_block_t *free_lists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+
+/* first block and the sentinel block at the end of the heap, a zero-sized
+ * used block that stops the merging */
+PRIVILEGED_DATA static tlsf_block_t *heap_start;
+PRIVILEGED_DATA static tlsf_block_t *heap_end;
+
+PRIVILEGED_DATA static tlsf_class_t classes[TLSF_FL_COUNT];
+PRIVILEGED_DATA static size_t free_bytes;
+PRIVILEGED_DATA static size_t used_bytes;
+PRIVILEGED_DATA static size_t min_ever_free_bytes;
+PRIVILEGED_DATA static size_t successful_allocs;
+PRIVILEGED_DATA static size_t successful_frees;
+PRIVILEGED_DATA static size_t failed_allocs;
+
+#if (configHEAP_TLSF_SITES > 0)
+PRIVILEGED_DATA static heap_tlsf_site_stats_t sites[configHEAP_TLSF_SITES + 1];
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* index of the highest set bit, x must not be 0 */
+static inline uint32_t tlsf_fls(size_t x)
+{
+    return 31U - (uint32_t)__builtin_clz((uint32_t)x);
+}
+
+/* index of the lowest set bit, x must not be 0 */
+static inline uint32_t tlsf_ffs(uint32_t x)
+{
+    return (uint32_t)__builtin_ctz(x);
+}
+
+static inline size_t block_size(const tlsf_block_t *block)
+{
+    return block->size & TLSF_SIZE_MASK;
+}
+
+static inline int block_is_free(const tlsf_block_t *block)
+{
+    return (block->size & TLSF_FREE_BIT) != 0U;
+}
+
+static inline uint8_t *block_payload(tlsf_block_t *block)
+{
+    return (uint8_t *)block + TLSF_HEADER_SIZE;
+}
+
+static inline tlsf_block_t *block_from_payload(void *pv)
+{
+    return (tlsf_block_t *)((uint8_t *)pv - TLSF_HEADER_SIZE);
+}
+
+static inline tlsf_block_t *block_next_phys(tlsf_block_t *block)
+{
+    return (tlsf_block_t *)(block_payload(block) + block_size(block));
+}
+
+/* list of a block of this size */
+static inline void mapping_insert(size_t size, uint32_t *fl, uint32_t *sl)
+{
+    if (size < TLSF_SMALL_SIZE)
+    {
+        *fl = 0;
+        *sl = (uint32_t)(size >> TLSF_ALIGN_LOG2);
+    }
+    else
+    {
+        uint32_t t = tlsf_fls(size);
+        *sl = (uint32_t)(size >> (t - configHEAP_TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+        *fl = t - TLSF_FL_SHIFT + 1U;
+    }
+}
+
+/* first list whose blocks are all at least size large. Returns 0 if the size
+ * is larger than any list. */
+static inline int mapping_search(size_t size, uint32_t *fl, uint32_t *sl)
+{
+    if (size >= TLSF_SMALL_SIZE)
+    {
+        size += ((size_t)1 << (tlsf_fls(size) - configHEAP_TLSF_SL_LOG2)) - 1U;
+    }
+    mapping_insert(size, fl, sl);
+    return *fl < TLSF_FL_COUNT;
+}
+
+/* first non-empty list at or above fl / sl */
+static tlsf_block_t *search_suitable_block(uint32_t *fl, uint32_t *sl)
+{
+    uint32_t sl_map = sl_bitmap[*fl] & (~0UL << *sl);
+    if (sl_map == 0U)
+    {
+        uint32_t fl_map = (*fl + 1U < 32U) ? fl_bitmap & (~0UL << (*fl + 1U)) : 0U;
+        if (fl_map == 0U)
+        {
+            return NULL;
+        }
+        *fl = tlsf_ffs(fl_map);
+        sl_map = sl_bitmap[*fl];
+    }
+    *sl = tlsf_ffs(sl_map);
+    return free_lists[*fl][*sl];
+}
+
+/* first block of at least size bytes in the list of the size itself.
+ * mapping_search() skips this list, as it also holds smaller blocks, so
+ * without it the largest free block could only be allocated up to the lower
+ * bound of its list. Only used when search_suitable_block() found nothing,
+ * it walks a single list. */
+static tlsf_block_t *search_exact_list(size_t size)
+{
+    uint32_t fl, sl;
+    mapping_insert(size, &fl, &sl);
+    if (fl >= TLSF_FL_COUNT)
+    {
+        return NULL;
+    }
+    tlsf_block_t *block = free_lists[fl][sl];
+    while (block != NULL && block_size(block) < size)
+    {
+        block = block->next_free;
+    }
+    return block;
+}
+
+static void insert_free_block(tlsf_block_t *block)
+{
+    uint32_t fl, sl;
+    size_t size = block_size(block);
+    mapping_insert(size, &fl, &sl);
+    block->size = size | TLSF_FREE_BIT;
+    block->prev_free = NULL;
+    block->next_free = free_lists[fl][sl];
+    if (block->next_free != NULL)
+    {
+        block->next_free->prev_free = block;
+    }
+    free_lists[fl][sl] = block;
+    fl_bitmap |= 1UL << fl;
+    sl_bitmap[fl] |= 1UL << sl;
+
+    classes[fl].free_blocks++;
+    classes[fl].free_bytes += size;
+    free_bytes += size;
+}
+
+static void remove_free_block(tlsf_block_t *block)
+{
+    uint32_t fl, sl;
+    size_t size = block_size(block);
+    mapping_insert(size, &fl, &sl);
+    if (block->prev_free != NULL)
+    {
+        block->prev_free->next_free = block->next_free;
+    }
+    else
+    {
+        free_lists[fl][sl] = block->next_free;
+        if (block->next_free == NULL)
+        {
+            sl_bitmap[fl] &= ~(1UL << sl);
+            if (sl_bitmap[fl] == 0U)
+            {
+                fl_bitmap &= ~(1UL << fl);
+            }
+        }
+    }
+    if (block->next_free != NULL)
+    {
+        block->next_free->prev_free = block->prev_free;
+    }
+    block->size = size;
+
+    classes[fl].free_blocks--;
+    classes[fl].free_bytes -= size;
+    free_bytes -= size;
+}
+
+/* splits off the end of a block that is no longer needed and puts it into the
+ * free lists. The block must not be in a free list. */
+static void trim_block(tlsf_block_t *block, size_t size)
+{
+    size_t remaining = block_size(block) - size;
+    if (remaining >= TLSF_HEADER_SIZE + TLSF_MIN_PAYLOAD)
+    {
+        tlsf_block_t *rest = (tlsf_block_t *)(block_payload(block) + size);
+        rest->prev_phys = block;
+        rest->size = remaining - TLSF_HEADER_SIZE;
+        block->size = size | (block->size & ~TLSF_SIZE_MASK);
+        block_next_phys(rest)->prev_phys = rest;
+        insert_free_block(rest);
+    }
+}
+
+/* merges a free block, which is not in a free list, with the free neighbours */
+static tlsf_block_t *merge_block(tlsf_block_t *block)
+{
+    tlsf_block_t *prev = block->prev_phys;
+    if (prev != NULL && block_is_free(prev))
+    {
+        remove_free_block(prev);
+        prev->size += TLSF_HEADER_SIZE + block_size(block);
+        block = prev;
+        block_next_phys(block)->prev_phys = block;
+    }
+    tlsf_block_t *next = block_next_phys(block);
+    if (block_is_free(next))
+    {
+        remove_free_block(next);
+        block->size += TLSF_HEADER_SIZE + block_size(next);
+        block_next_phys(block)->prev_phys = block;
+    }
+    return block;
+}
+
+#if (configHEAP_TLSF_SITES > 0)
+/* index of the table entry of a caller, TLSF_SITE_OTHER if the table is full */
+static uint32_t site_index(const void *site)
+{
+    for (uint32_t i = 0; i < configHEAP_TLSF_SITES; i++)
+    {
+        if (sites[i].site == site)
+        {
+            return i;
+        }
+        if (sites[i].site == NULL)
+        {
+            sites[i].site = site;
+            return i;
+        }
+    }
+    return TLSF_SITE_OTHER;
+}
+#endif
+
+static void heap_init(void)
+{
+    uint8_t *start = ucHeap;
+    size_t total = configTOTAL_HEAP_SIZE;
+
+    /* ensure the heap starts on a correctly aligned boundary */
+    if (((portPOINTER_SIZE_TYPE)start & portBYTE_ALIGNMENT_MASK) != 0U)
+    {
+        size_t skip = TLSF_ALIGN - ((portPOINTER_SIZE_TYPE)start & portBYTE_ALIGNMENT_MASK);
+        start += skip;
+        total -= skip;
+    }
+    total &= ~(TLSF_ALIGN - 1U);
+    /* the size field has 24 bits */
+    configASSERT(total - 2U * TLSF_HEADER_SIZE <= TLSF_SIZE_MASK);
+
+    heap_start = (tlsf_block_t *)start;
+    heap_start->prev_phys = NULL;
+    heap_start->size = total - 2U * TLSF_HEADER_SIZE;
+
+    heap_end = block_next_phys(heap_start);
+    heap_end->prev_phys = heap_start;
+    heap_end->size = 0;
+
+    insert_free_block(heap_start);
+    min_ever_free_bytes = free_bytes;
+}
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+    void *pvReturn = NULL;
+#if (configHEAP_TLSF_SITES > 0)
+    const void *site = __builtin_return_address(0);
+#endif
+
+    vTaskSuspendAll();
+    {
+        if (heap_end == NULL)
+        {
+            heap_init();
+        }
+
+        if (xWantedSize > 0U && xWantedSize <= TLSF_SIZE_MASK)
+        {
+            size_t size = (xWantedSize + TLSF_ALIGN - 1U) & ~(TLSF_ALIGN - 1U);
+            uint32_t fl, sl;
+            tlsf_block_t *block = NULL;
+
+            if (size < TLSF_MIN_PAYLOAD)
+            {
+                size = TLSF_MIN_PAYLOAD;
+            }
+            if (mapping_search(size, &fl, &sl))
+            {
+                block = search_suitable_block(&fl, &sl);
+            }
+            if (block == NULL)
+            {
+                block = search_exact_list(size);
+            }
+            if (block != NULL)
+            {
+                remove_free_block(block);
+                trim_block(block, size);
+                size = block_size(block);
+                mapping_insert(size, &fl, &sl);
+                classes[fl].allocs++;
+                classes[fl].used_blocks++;
+                if (classes[fl].used_blocks > classes[fl].peak_used_blocks)
+                {
+                    classes[fl].peak_used_blocks = classes[fl].used_blocks;
+                }
+#if (configHEAP_TLSF_SITES > 0)
+                uint32_t index = site_index(site);
+                block->size |= (size_t)index << TLSF_SITE_SHIFT;
+                sites[index].used_bytes += size;
+                sites[index].used_blocks++;
+                sites[index].allocs++;
+                if (sites[index].used_bytes > sites[index].peak_used_bytes)
+                {
+                    sites[index].peak_used_bytes = sites[index].used_bytes;
+                }
+#endif
+                used_bytes += size;
+                if (free_bytes < min_ever_free_bytes)
+                {
+                    min_ever_free_bytes = free_bytes;
+                }
+                successful_allocs++;
+                pvReturn = block_payload(block);
+            }
+        }
+
+        if (pvReturn == NULL)
+        {
+            failed_allocs++;
+        }
+
+        traceMALLOC(pvReturn, xWantedSize);
+    }
+    (void)xTaskResumeAll();
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+    {
+        if (pvReturn == NULL)
+        {
+            extern void vApplicationMallocFailedHook(void);
+            vApplicationMallocFailedHook();
+        }
+    }
+#endif
+
+    configASSERT((((portPOINTER_SIZE_TYPE)pvReturn) & (portPOINTER_SIZE_TYPE)portBYTE_ALIGNMENT_MASK) == 0);
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree(void *pv)
+{
+    if (pv == NULL)
+    {
+        return;
+    }
+
+    tlsf_block_t *block = block_from_payload(pv);
+    /* the block must be in the heap and in use */
+    configASSERT(block >= heap_start && block < heap_end);
+    configASSERT(!block_is_free(block));
+
+    vTaskSuspendAll();
+    {
+        size_t size = block_size(block);
+        uint32_t fl, sl;
+        mapping_insert(size, &fl, &sl);
+        classes[fl].used_blocks--;
+        used_bytes -= size;
+#if (configHEAP_TLSF_SITES > 0)
+        uint32_t index = (uint32_t)(block->size >> TLSF_SITE_SHIFT);
+        sites[index].used_bytes -= size;
+        sites[index].used_blocks--;
+#endif
+        traceFREE(pv, size);
+        block->size = size;
+        insert_free_block(merge_block(block));
+        successful_frees++;
+    }
+    (void)xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return free_bytes;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    return min_ever_free_bytes;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks(void)
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+/* smallest and largest free block. Only the lowest and the highest non-empty
+ * class are walked, so this is not part of the constant time path. */
+static void free_block_extremes(size_t *smallest, size_t *largest)
+{
+    *smallest = 0;
+    *largest = 0;
+    if (fl_bitmap == 0U)
+    {
+        return;
+    }
+    uint32_t fl = tlsf_ffs(fl_bitmap);
+    tlsf_block_t *block = free_lists[fl][tlsf_ffs(sl_bitmap[fl])];
+    *smallest = block_size(block);
+    for (; block != NULL; block = block->next_free)
+    {
+        if (block_size(block) < *smallest)
+        {
+            *smallest = block_size(block);
+        }
+    }
+    fl = tlsf_fls(fl_bitmap);
+    for (block = free_lists[fl][tlsf_fls(sl_bitmap[fl])]; block != NULL; block = block->next_free)
+    {
+        if (block_size(block) > *largest)
+        {
+            *largest = block_size(block);
+        }
+    }
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+    vTaskSuspendAll();
+    {
+        if (heap_end == NULL)
+        {
+            heap_init();
+        }
+        free_block_extremes(&pxHeapStats->xSizeOfSmallestFreeBlockInBytes,
+                            &pxHeapStats->xSizeOfLargestFreeBlockInBytes);
+        pxHeapStats->xNumberOfFreeBlocks = 0;
+        for (uint32_t fl = 0; fl < TLSF_FL_COUNT; fl++)
+        {
+            pxHeapStats->xNumberOfFreeBlocks += classes[fl].free_blocks;
+        }
+        pxHeapStats->xAvailableHeapSpaceInBytes = free_bytes;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = min_ever_free_bytes;
+        pxHeapStats->xNumberOfSuccessfulAllocations = successful_allocs;
+        pxHeapStats->xNumberOfSuccessfulFrees = successful_frees;
+    }
+    (void)xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void heap_tlsf_get_stats(heap_tlsf_stats_t *stats)
+{
+    size_t smallest;
+    vTaskSuspendAll();
+    {
+        if (heap_end == NULL)
+        {
+            heap_init();
+        }
+        memset(stats, 0, sizeof(*stats));
+        free_block_extremes(&smallest, &stats->largest_free_block);
+        for (uint32_t fl = 0; fl < TLSF_FL_COUNT; fl++)
+        {
+            stats->free_blocks += classes[fl].free_blocks;
+            stats->used_blocks += classes[fl].used_blocks;
+        }
+        stats->free_bytes = free_bytes;
+        stats->min_ever_free_bytes = min_ever_free_bytes;
+        stats->used_bytes = used_bytes;
+        stats->successful_allocs = successful_allocs;
+        stats->successful_frees = successful_frees;
+        stats->failed_allocs = failed_allocs;
+        if (free_bytes > 0U)
+        {
+            stats->fragmentation_permille =
+                (uint32_t)(1000U - (uint32_t)((uint64_t)stats->largest_free_block * 1000U / free_bytes));
+        }
+    }
+    (void)xTaskResumeAll();
+}
+
+size_t heap_tlsf_get_class_stats(heap_tlsf_class_stats_t *out, size_t max_classes)
+{
+    size_t count = max_classes < TLSF_FL_COUNT ? max_classes : TLSF_FL_COUNT;
+    vTaskSuspendAll();
+    {
+        for (size_t fl = 0; fl < count; fl++)
+        {
+            out[fl].min_size = fl == 0U ? 0U : TLSF_SMALL_SIZE << (fl - 1U);
+            out[fl].free_blocks = classes[fl].free_blocks;
+            out[fl].free_bytes = classes[fl].free_bytes;
+            out[fl].used_blocks = classes[fl].used_blocks;
+            out[fl].peak_used_blocks = classes[fl].peak_used_blocks;
+            out[fl].allocs = classes[fl].allocs;
+        }
+    }
+    (void)xTaskResumeAll();
+    return count;
+}
+
+size_t heap_tlsf_get_site_stats(heap_tlsf_site_stats_t *out, size_t max_sites)
+{
+    size_t count = 0;
+#if (configHEAP_TLSF_SITES > 0)
+    vTaskSuspendAll();
+    {
+        for (uint32_t i = 0; i <= configHEAP_TLSF_SITES && count < max_sites; i++)
+        {
+            if (sites[i].allocs != 0U)
+            {
+                out[count++] = sites[i];
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+#else
+    (void)out;
+    (void)max_sites;
+#endif
+    return count;
+}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION == 1 */
@@ -0,0 +1,97 @@
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#include "bufpool.h"
+
+/* adds delta (which may be negative) to the reference count, returns the new
+ * count */
+static uint32_t bufpool_refs_add(bufpool_buf_t *buf, int32_t delta)
+{
+    uint32_t refs;
+#if MPOOL_USE_EXCLUSIVES
+    do
+    {
+        refs = mpool_ldrex(&buf->refs) + (uint32_t)delta;
+    } while (mpool_strex(refs, &buf->refs) != 0U);
+#else
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    refs = buf->refs + (uint32_t)delta;
+    buf->refs = refs;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+#endif
+    return refs;
+}
+
+BaseType_t bufpool_init(bufpool_t *bp, void *mem, uint32_t mem_size, uint32_t count, uint32_t capacity,
+                        BaseType_t blocking)
+{
+    if (bp == NULL || capacity == 0U)
+    {
+        return pdFAIL;
+    }
+    bp->capacity = MPOOL_BLOCK_SIZE(capacity);
+    return mpool_init(&bp->mp, mem, mem_size, count, sizeof(bufpool_buf_t) + capacity, blocking);
+}
+
+/* the block is owned by the caller only, no atomic update needed */
+static bufpool_buf_t *bufpool_take(bufpool_t *bp, bufpool_buf_t *buf)
+{
+    if (buf != NULL)
+    {
+        buf->pool = bp;
+        buf->refs = 1U;
+        buf->len = 0U;
+    }
+    return buf;
+}
+
+bufpool_buf_t *bufpool_alloc(bufpool_t *bp)
+{
+    return bufpool_take(bp, mpool_alloc(&bp->mp));
+}
+
+bufpool_buf_t *bufpool_alloc_wait(bufpool_t *bp, TickType_t timeout)
+{
+    return bufpool_take(bp, mpool_alloc_wait(&bp->mp, timeout));
+}
+
+void bufpool_ref(bufpool_buf_t *buf, uint32_t count)
+{
+    configASSERT(buf->refs != 0U);
+    bufpool_refs_add(buf, (int32_t)count);
+}
+
+void bufpool_release(bufpool_buf_t *buf)
+{
+    /* releasing a buffer that is back in the pool corrupts the pool */
+    configASSERT(buf->refs != 0U);
+    if (bufpool_refs_add(buf, -1) == 0U)
+    {
+        mpool_free(&buf->pool->mp, buf);
+    }
+}
+
+uint32_t bufpool_fanout(QueueHandle_t *queues, uint32_t count, bufpool_buf_t *buf, TickType_t timeout)
+{
+    uint32_t sent = 0U;
+    if (count == 0U)
+    {
+        bufpool_release(buf);
+        return 0U;
+    }
+    /* take all references before the first send, a receiver may release its
+     * reference before the next send */
+    bufpool_ref(buf, count - 1U);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (xQueueSend(queues[i], &buf, timeout) == pdPASS)
+        {
+            sent++;
+        }
+        else
+        {
+            bufpool_release(buf);
+        }
+    }
+    return sent;
+}
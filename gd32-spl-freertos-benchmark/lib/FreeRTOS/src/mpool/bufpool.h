@@ -0,0 +1,129 @@
+/*
+ * Pooled buffers that are passed between tasks by pointer (zero-copy).
+ *
+ * A queue of data items copies every item twice, into the queue storage on
+ * xQueueSend() and out of it on xQueueReceive(). With a buffer pool, the
+ * producer fills a buffer from the pool in place and sends only the pointer,
+ * the consumer works on the same memory and returns the buffer when it is
+ * done. Sending a buffer hands the ownership over: after a successful send,
+ * the producer must not touch the buffer anymore.
+ *
+ * Every buffer has a reference count, so the same buffer can be sent to more
+ * than one consumer (bufpool_fanout()). It goes back to the pool when the last
+ * owner calls bufpool_release(). Consumers of a shared buffer must only read
+ * from it.
+ *
+ * The buffers come from an mpool (mpool.h), allocating and releasing works
+ * from tasks and interrupts, with the same rules as mpool_alloc() /
+ * mpool_free(). The reference counts are updated with LDREX / STREX, or with
+ * interrupts masked (MPOOL_USE_EXCLUSIVES).
+ */
+#ifndef BUFPOOL_H_
+#define BUFPOOL_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "message_buffer.h"
+#include "mpool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct bufpool bufpool_t;
+
+/* header in front of the data of every buffer */
+typedef struct
+{
+    bufpool_t *pool;
+    volatile uint32_t refs; /* 0 while the buffer is in the pool */
+    uint32_t len;           /* bytes of data used, set by the producer */
+} bufpool_buf_t;
+
+struct bufpool
+{
+    mpool_t mp;
+    uint32_t capacity; /* bytes of data per buffer */
+};
+
+/* size of the memory array for count buffers of capacity bytes */
+#define BUFPOOL_MEM_SIZE(count, capacity) MPOOL_MEM_SIZE(count, sizeof(bufpool_buf_t) + (capacity))
+
+/* the data of a buffer, 4-byte aligned */
+static inline uint8_t *bufpool_data(bufpool_buf_t *buf)
+{
+    return (uint8_t *)(buf + 1);
+}
+
+/* initializes the pool with count buffers of capacity bytes in mem, which
+ * must be 4-byte aligned and at least BUFPOOL_MEM_SIZE() bytes large.
+ * blocking = 1 allows waiting in bufpool_alloc_wait(). Returns pdPASS or
+ * pdFAIL. */
+BaseType_t bufpool_init(bufpool_t *bp, void *mem, uint32_t mem_size, uint32_t count, uint32_t capacity,
+                        BaseType_t blocking);
+
+/* takes a buffer from the pool with one reference and len = 0, NULL if the
+ * pool is empty. Never blocks. */
+bufpool_buf_t *bufpool_alloc(bufpool_t *bp);
+
+/* like bufpool_alloc(), but waits up to timeout ticks for a buffer */
+bufpool_buf_t *bufpool_alloc_wait(bufpool_t *bp, TickType_t timeout);
+
+/* adds count references, for sending the buffer to count more owners */
+void bufpool_ref(bufpool_buf_t *buf, uint32_t count);
+
+/* drops one reference, the last one returns the buffer to the pool */
+void bufpool_release(bufpool_buf_t *buf);
+
+/* Sends the pointer through a queue created with an item size of
+ * sizeof(bufpool_buf_t *). On pdPASS the reference of the caller now belongs
+ * to the receiver, on errQUEUE_FULL it stays with the caller. */
+static inline BaseType_t bufpool_send(QueueHandle_t queue, bufpool_buf_t *buf, TickType_t timeout)
+{
+    return xQueueSend(queue, &buf, timeout);
+}
+
+static inline BaseType_t bufpool_send_from_isr(QueueHandle_t queue, bufpool_buf_t *buf, BaseType_t *woken)
+{
+    return xQueueSendFromISR(queue, &buf, woken);
+}
+
+/* receives a buffer (and its reference), NULL on timeout */
+static inline bufpool_buf_t *bufpool_receive(QueueHandle_t queue, TickType_t timeout)
+{
+    bufpool_buf_t *buf;
+    return xQueueReceive(queue, &buf, timeout) == pdPASS ? buf : NULL;
+}
+
+/* Sends the buffer to all count queues, with one reference per queue. The
+ * reference of the caller is used up in any case, also if some of the sends
+ * time out. Returns the number of queues the buffer was sent to. */
+uint32_t bufpool_fanout(QueueHandle_t *queues, uint32_t count, bufpool_buf_t *buf, TickType_t timeout);
+
+/* The same for message buffers (a stream buffer that keeps the pointers
+ * whole). The message buffer needs sizeof(bufpool_buf_t *) +
+ * sizeof(size_t) bytes per buffer in flight. Like all stream buffers, only
+ * one task or interrupt may send and one may receive. */
+static inline BaseType_t bufpool_message_send(MessageBufferHandle_t mb, bufpool_buf_t *buf, TickType_t timeout)
+{
+    return xMessageBufferSend(mb, &buf, sizeof(buf), timeout) == sizeof(buf) ? pdPASS : pdFAIL;
+}
+
+static inline BaseType_t bufpool_message_send_from_isr(MessageBufferHandle_t mb, bufpool_buf_t *buf,
+                                                       BaseType_t *woken)
+{
+    return xMessageBufferSendFromISR(mb, &buf, sizeof(buf), woken) == sizeof(buf) ? pdPASS : pdFAIL;
+}
+
+static inline bufpool_buf_t *bufpool_message_receive(MessageBufferHandle_t mb, TickType_t timeout)
+{
+    bufpool_buf_t *buf;
+    return xMessageBufferReceive(mb, &buf, sizeof(buf), timeout) == sizeof(buf) ? buf : NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BUFPOOL_H_ */
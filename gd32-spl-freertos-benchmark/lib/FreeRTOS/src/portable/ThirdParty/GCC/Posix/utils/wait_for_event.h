@@ -0,0 +1,13 @@
+#ifndef WAIT_FOR_EVENT_H
+#define WAIT_FOR_EVENT_H
+
+/* A binary event on which one thread waits. Signalling an event that nobody
+ * waits for is remembered, the next wait returns at once. */
+struct event;
+
+struct event * event_create( void );
+void event_delete( struct event * ev );
+void event_wait( struct event * ev );
+void event_signal( struct event * ev );
+
+#endif /* WAIT_FOR_EVENT_H */
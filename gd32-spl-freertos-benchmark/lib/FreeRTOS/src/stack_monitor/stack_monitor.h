@@ -0,0 +1,109 @@
+/*
+ * Stack usage monitoring for the FreeRTOS tasks and the interrupt stack,
+ * included with PIO_FREERTOS_STACK_MONITOR (see build_freertos.py).
+ *
+ * FreeRTOS fills every task stack with tskSTACK_FILL_BYTE when the task is
+ * created. stack_monitor_init() does the same for the interrupt (main) stack,
+ * which is used by main() before the scheduler starts and by all interrupt
+ * handlers afterwards. The peak use is the part of a stack that no longer
+ * holds the fill pattern.
+ *
+ * stack_monitor_print() prints, per task and for the interrupt stack, the
+ * size, the peak use and a recommended size: the peak use plus
+ * STACK_MONITOR_MARGIN_PERCENT (at least STACK_MONITOR_MIN_MARGIN_WORDS),
+ * rounded up to 8 words. Print it after a soak run that exercised all code
+ * paths, scripts/stack_recommend.py collects the values from the serial log.
+ *
+ * With STACK_MONITOR_GUARD (default 1), a stack overflow is reported with the
+ * name of the task instead of silently corrupting the memory below the stack:
+ *   - Cortex-M33: the FreeRTOS port loads PSPLIM with the bottom of the
+ *     running task's stack. stack_monitor_init() also sets MSPLIM for the
+ *     interrupt stack and enables the UsageFault, whose handler reports the
+ *     overflow (STKOF).
+ *   - Cortex-M23: there are no stack limit registers in the non-secure state.
+ *     A read-only MPU region covers the lowest 32 bytes of the running task's
+ *     stack, it is moved on every context switch (STACK_MONITOR_SWITCHED_IN()
+ *     in FreeRTOSConfig.h). A write into it ends in the HardFault handler.
+ *   - other cores: only the check of configCHECK_FOR_STACK_OVERFLOW 2 on every
+ *     context switch, which calls stack_monitor_overflow() from
+ *     vApplicationStackOverflowHook().
+ *
+ * FreeRTOSConfig.h must set configRECORD_STACK_HIGH_ADDRESS to 1, the stack
+ * sizes are read from the task control blocks.
+ */
+#ifndef STACK_MONITOR_H_
+#define STACK_MONITOR_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (configRECORD_STACK_HIGH_ADDRESS != 1)
+#error "the stack monitor needs configRECORD_STACK_HIGH_ADDRESS 1"
+#endif
+
+#ifndef STACK_MONITOR_GUARD
+#define STACK_MONITOR_GUARD 1
+#endif
+
+/* margin of the recommended stack sizes */
+#ifndef STACK_MONITOR_MARGIN_PERCENT
+#define STACK_MONITOR_MARGIN_PERCENT 25
+#endif
+/* at least room for one more exception frame with FPU state and a few calls */
+#ifndef STACK_MONITOR_MIN_MARGIN_WORDS
+#define STACK_MONITOR_MIN_MARGIN_WORDS 48
+#endif
+
+/* size of the interrupt stack, as reserved by the linker script of the SPL
+ * package (_Min_Stack_Size). The painted area never reaches below the end of
+ * .bss, so a wrong value only makes the reported size smaller. */
+#ifndef STACK_MONITOR_MSP_SIZE
+#define STACK_MONITOR_MSP_SIZE 1024
+#endif
+
+/* maximum number of tasks in stack_monitor_print() */
+#ifndef STACK_MONITOR_MAX_TASKS
+#define STACK_MONITOR_MAX_TASKS 8
+#endif
+
+typedef struct
+{
+    uint32_t size_words;
+    uint32_t peak_words;
+    uint32_t recommended_words;
+} stack_monitor_usage_t;
+
+/* paints the interrupt stack and sets up the overflow guard. Call first thing
+ * in main(), before anything is allocated from the C library heap. */
+void stack_monitor_init(void);
+
+/* usage of a task stack, returns 0 if the task handle is NULL */
+int stack_monitor_get_task(TaskHandle_t task, stack_monitor_usage_t *usage);
+
+/* usage of the interrupt stack */
+void stack_monitor_get_isr(stack_monitor_usage_t *usage);
+
+/* recommended stack size in words for a peak use in words */
+uint32_t stack_monitor_recommend(uint32_t peak_words);
+
+/* prints one line per task and one for the interrupt stack:
+ *   STACK: "<name>" size <words> peak <words> recommended <words> */
+void stack_monitor_print(void);
+
+/* reports an overflow of the task stack and stops. Called by the fault
+ * handlers and from vApplicationStackOverflowHook(). */
+void stack_monitor_overflow(const char *task_name);
+
+/* moves the MPU guard to the stack of the task that is switched in */
+void stack_monitor_task_switched_in(void *stack);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_MONITOR_H_ */
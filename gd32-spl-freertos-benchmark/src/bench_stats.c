@@ -0,0 +1,52 @@
+#include <bench_stats.h>
+#include <stdio.h>
+#include <string.h>
+
+void bench_stats_reset(bench_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->min = UINT32_MAX;
+}
+
+static uint32_t bucket_of(uint32_t cycles)
+{
+    uint32_t bucket = 0;
+    while (cycles > 1U && bucket < BENCH_HIST_BUCKETS - 1U)
+    {
+        cycles >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void bench_stats_add(bench_stats_t *stats, uint32_t cycles)
+{
+    stats->count++;
+    stats->sum += cycles;
+    stats->min = cycles < stats->min ? cycles : stats->min;
+    stats->max = cycles > stats->max ? cycles : stats->max;
+    stats->hist[bucket_of(cycles)]++;
+}
+
+void bench_stats_print(const char *name, const bench_stats_t *stats)
+{
+    if (stats->count == 0)
+    {
+        printf("%s: no samples\n", name);
+        return;
+    }
+    printf("%s: n %lu, min %lu, avg %lu, max %lu cycles\n", name,
+           (unsigned long)stats->count, (unsigned long)stats->min,
+           (unsigned long)(stats->sum / stats->count), (unsigned long)stats->max);
+    printf("    histogram:");
+    for (uint32_t i = 0; i < BENCH_HIST_BUCKETS; i++)
+    {
+        if (stats->hist[i] == 0)
+            continue;
+        if (i == BENCH_HIST_BUCKETS - 1U)
+            printf(" >=%lu: %lu", 1UL << i, (unsigned long)stats->hist[i]);
+        else
+            printf(" %lu-%lu: %lu", i ? 1UL << i : 0UL, (2UL << i) - 1UL, (unsigned long)stats->hist[i]);
+    }
+    printf("\n");
+}
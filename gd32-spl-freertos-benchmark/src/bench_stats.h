@@ -0,0 +1,26 @@
+#ifndef BENCH_STATS_H_
+#define BENCH_STATS_H_
+
+#include <stdint.h>
+
+/* histogram with power-of-two buckets: bucket i counts the samples in
+ * [2^i, 2^(i+1)) cycles, the last bucket also counts everything above. */
+#define BENCH_HIST_BUCKETS 16
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[BENCH_HIST_BUCKETS];
+} bench_stats_t;
+
+void bench_stats_reset(bench_stats_t *stats);
+void bench_stats_add(bench_stats_t *stats, uint32_t cycles);
+
+/* prints one line with count / min / avg / max and one line with the
+ * non-empty histogram buckets */
+void bench_stats_print(const char *name, const bench_stats_t *stats);
+
+#endif /* BENCH_STATS_H_ */
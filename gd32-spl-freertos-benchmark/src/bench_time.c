@@ -0,0 +1,54 @@
+#include <bench_time.h>
+
+#if BENCH_TIME_SYSTICK
+/* cycles at the last SysTick reload, advanced by the tick hook */
+static volatile uint32_t systick_base;
+#endif
+
+void bench_time_init(void)
+{
+#if BENCH_TIME_SYSTICK
+    systick_base = 0;
+#else
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+void bench_time_tick(void)
+{
+#if BENCH_TIME_SYSTICK
+    systick_base += SysTick->LOAD + 1U;
+#endif
+}
+
+const char *bench_time_source(void)
+{
+#if BENCH_TIME_SYSTICK
+    return "SysTick";
+#else
+    return "DWT cycle counter";
+#endif
+}
+
+#if BENCH_TIME_SYSTICK
+uint32_t bench_time_now(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t base = systick_base;
+    uint32_t load = SysTick->LOAD;
+    uint32_t val = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* reloaded, but the tick interrupt did not run yet */
+        val = SysTick->VAL;
+        base += load + 1U;
+    }
+    __set_PRIMASK(primask);
+    /* SysTick counts down from LOAD to 0 */
+    return base + (load - val);
+}
+#endif
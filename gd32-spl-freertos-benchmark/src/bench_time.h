@@ -0,0 +1,41 @@
+#ifndef BENCH_TIME_H_
+#define BENCH_TIME_H_
+
+#include <stdint.h>
+#include <gd32_include.h>
+
+/* Timestamps for the benchmarks, in CPU cycles.
+ *
+ * Uses the DWT cycle counter where there is one. The Cortex-M23 (GD32E23x)
+ * has no DWT cycle counter and QEMU does not emulate it, there the count is
+ * derived from the SysTick that drives the FreeRTOS tick (it runs from the
+ * CPU clock, so the resolution is the same). The SysTick variant only works
+ * while the scheduler is running and must not be called from interrupts with
+ * a higher priority than the SysTick.
+ *
+ * The values wrap around at 32 bit, only take differences of timestamps that
+ * are less than 2^32 cycles apart. */
+#if defined(GD32E23x) || defined(BENCH_QEMU)
+#define BENCH_TIME_SYSTICK 1
+#else
+#define BENCH_TIME_SYSTICK 0
+#endif
+
+void bench_time_init(void);
+
+/* called from the FreeRTOS tick hook */
+void bench_time_tick(void);
+
+/* name of the timestamp source, for the output */
+const char *bench_time_source(void);
+
+#if BENCH_TIME_SYSTICK
+uint32_t bench_time_now(void);
+#else
+static inline uint32_t bench_time_now(void)
+{
+    return DWT->CYCCNT;
+}
+#endif
+
+#endif /* BENCH_TIME_H_ */
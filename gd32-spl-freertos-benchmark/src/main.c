@@ -0,0 +1,562 @@
+#include <gd32_include.h>
+#include <printf_over_x.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+#include <queue.h>
+#include <stream_buffer.h>
+#include <bufpool.h>
+#include <bench_time.h>
+#include <bench_stats.h>
+
+#define BENCH_ITERATIONS 1000
+
+/* the benchmark task starts two worker tasks per benchmark and waits until
+ * they are done, so it must have a higher priority than both. */
+#define CONTROL_PRIO (configMAX_PRIORITIES - 2)
+#define HIGH_PRIO (configMAX_PRIORITIES - 3)
+#define LOW_PRIO (configMAX_PRIORITIES - 4)
+
+#define CONTROL_STACK_SIZE 384
+#define WORKER_STACK_SIZE 160
+
+/* interrupt used for the ISR -> task benchmark. The EXTI line itself is never
+ * configured, the interrupt is only set pending in the NVIC. */
+#if defined(GD32F1x0) || defined(GD32F3x0) || defined(GD32E23x)
+#define BENCH_IRQn EXTI0_1_IRQn
+#define BENCH_IRQHandler EXTI0_1_IRQHandler
+#else
+#define BENCH_IRQn EXTI0_IRQn
+#define BENCH_IRQHandler EXTI0_IRQHandler
+#endif
+
+#define QUEUE_LENGTH 4
+#define QUEUE_MAX_ITEM_SIZE 64
+#define STREAM_BUFFER_SIZE 256
+#define STREAM_TOTAL_BYTES 16384
+#define STREAM_MAX_CHUNK_SIZE 64
+
+/* pipeline: the payloads go through queues of PIPE_QUEUE_LENGTH items, either
+ * copied or as pointers to pooled buffers. The GD32F1x0 and GD32E23x have
+ * only 8 kB RAM. */
+#if defined(GD32F1x0) || defined(GD32E23x)
+#define PIPE_MAX_PAYLOAD 64
+#else
+#define PIPE_MAX_PAYLOAD 256
+#endif
+#define PIPE_QUEUE_LENGTH 4
+#define PIPE_MAX_CONSUMERS 2
+/* buffers in flight: a full queue, one in every consumer and the one the
+ * producer fills */
+#define PIPE_POOL_BUFFERS (PIPE_QUEUE_LENGTH + PIPE_MAX_CONSUMERS + 1)
+
+StaticTask_t xControlTaskBuffer;
+StackType_t xControlStack[CONTROL_STACK_SIZE];
+TaskHandle_t controlTaskHandle;
+
+static StaticTask_t worker_a_tcb, worker_b_tcb;
+static StackType_t worker_a_stack[WORKER_STACK_SIZE], worker_b_stack[WORKER_STACK_SIZE];
+static TaskHandle_t worker_a, worker_b;
+
+/* timestamps handed from one task (or the ISR) to the other */
+static volatile uint32_t t_start;
+static volatile uint32_t t_isr;
+
+static bench_stats_t stats_a, stats_b;
+
+static SemaphoreHandle_t sem;
+static StaticSemaphore_t sem_buffer;
+
+static QueueHandle_t queue;
+static StaticQueue_t queue_buffer;
+static uint8_t queue_storage[QUEUE_LENGTH * QUEUE_MAX_ITEM_SIZE];
+static uint32_t queue_item_size;
+
+static StreamBufferHandle_t stream;
+static StaticStreamBuffer_t stream_buffer;
+static uint8_t stream_storage[STREAM_BUFFER_SIZE + 1];
+static uint8_t stream_rx[STREAM_BUFFER_SIZE];
+static uint32_t stream_chunk_size;
+static volatile uint32_t stream_end;
+static volatile uint32_t stream_errors;
+
+static QueueHandle_t pipe_queues[PIPE_MAX_CONSUMERS];
+static StaticQueue_t pipe_queue_buffers[PIPE_MAX_CONSUMERS];
+static uint32_t pipe_queue_storage[PIPE_MAX_CONSUMERS][PIPE_QUEUE_LENGTH * PIPE_MAX_PAYLOAD / 4];
+static uint8_t pipe_tx[PIPE_MAX_PAYLOAD];
+static uint8_t pipe_rx[PIPE_MAX_CONSUMERS][PIPE_MAX_PAYLOAD];
+static bufpool_t pipe_pool;
+static uint32_t pipe_pool_mem[BUFPOOL_MEM_SIZE(PIPE_POOL_BUFFERS, PIPE_MAX_PAYLOAD) / 4];
+static uint32_t pipe_payload_size;
+static volatile uint32_t pipe_errors;
+
+/* called by the worker that finishes a benchmark, wakes up the benchmark
+ * task, which deletes both workers. */
+static void bench_finish(void)
+{
+    xTaskNotifyGive(controlTaskHandle);
+    vTaskSuspend(NULL);
+}
+
+/* worker a is created first. With equal priorities it also runs first. */
+static void run_workers(TaskFunction_t a, UBaseType_t a_prio, TaskFunction_t b, UBaseType_t b_prio)
+{
+    bench_stats_reset(&stats_a);
+    bench_stats_reset(&stats_b);
+    worker_a = xTaskCreateStatic(a, "WorkerA", WORKER_STACK_SIZE, NULL, a_prio, worker_a_stack, &worker_a_tcb);
+    worker_b = xTaskCreateStatic(b, "WorkerB", WORKER_STACK_SIZE, NULL, b_prio, worker_b_stack, &worker_b_tcb);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    vTaskDelete(worker_a);
+    vTaskDelete(worker_b);
+}
+
+/* ---------------------------------------------------------------------- */
+/* context switch: two tasks with the same priority yield to each other   */
+
+static void yield_stamp_task(void *pvParameters)
+{
+    for (;;)
+    {
+        t_start = bench_time_now();
+        taskYIELD();
+    }
+}
+
+static void yield_measure_task(void *pvParameters)
+{
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        /* the other task takes the timestamp and yields back */
+        taskYIELD();
+        bench_stats_add(&stats_a, bench_time_now() - t_start);
+    }
+    bench_finish();
+}
+
+/* ---------------------------------------------------------------------- */
+/* semaphore: give in the low priority task wakes the high priority task   */
+
+static void sem_take_task(void *pvParameters)
+{
+    for (;;)
+    {
+        xSemaphoreTake(sem, portMAX_DELAY);
+        bench_stats_add(&stats_a, bench_time_now() - t_start);
+    }
+}
+
+static void sem_give_task(void *pvParameters)
+{
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        t_start = bench_time_now();
+        xSemaphoreGive(sem);
+    }
+    bench_finish();
+}
+
+/* ---------------------------------------------------------------------- */
+/* queue: send in the low priority task wakes the high priority task       */
+
+static void queue_receive_task(void *pvParameters)
+{
+    uint8_t item[QUEUE_MAX_ITEM_SIZE];
+    for (;;)
+    {
+        xQueueReceive(queue, item, portMAX_DELAY);
+        bench_stats_add(&stats_a, bench_time_now() - t_start);
+    }
+}
+
+static void queue_send_task(void *pvParameters)
+{
+    uint8_t item[QUEUE_MAX_ITEM_SIZE];
+    memset(item, 0x55, sizeof(item));
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        t_start = bench_time_now();
+        xQueueSend(queue, item, portMAX_DELAY);
+    }
+    bench_finish();
+}
+
+/* ---------------------------------------------------------------------- */
+/* stream buffer: both tasks have the same priority, so the sender fills   */
+/* the buffer before the receiver runs and empties it again               */
+
+static void stream_send_task(void *pvParameters)
+{
+    uint8_t chunk[STREAM_MAX_CHUNK_SIZE];
+    t_start = bench_time_now();
+    for (uint32_t sent = 0; sent < STREAM_TOTAL_BYTES; sent += stream_chunk_size)
+    {
+        for (uint32_t i = 0; i < stream_chunk_size; i++)
+        {
+            chunk[i] = (uint8_t)(sent + i);
+        }
+        uint32_t start = bench_time_now();
+        xStreamBufferSend(stream, chunk, stream_chunk_size, portMAX_DELAY);
+        bench_stats_add(&stats_a, bench_time_now() - start);
+    }
+    vTaskSuspend(NULL);
+}
+
+static void stream_receive_task(void *pvParameters)
+{
+    uint32_t received = 0;
+    while (received < STREAM_TOTAL_BYTES)
+    {
+        size_t len = xStreamBufferReceive(stream, stream_rx, sizeof(stream_rx), portMAX_DELAY);
+        for (size_t i = 0; i < len; i++)
+        {
+            if (stream_rx[i] != (uint8_t)(received + i))
+            {
+                stream_errors++;
+            }
+        }
+        received += len;
+    }
+    stream_end = bench_time_now();
+    bench_finish();
+}
+
+/* ---------------------------------------------------------------------- */
+/* task notification: give in the low priority task wakes the high one     */
+
+static void notify_take_task(void *pvParameters)
+{
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        bench_stats_add(&stats_a, bench_time_now() - t_start);
+    }
+}
+
+static void notify_give_task(void *pvParameters)
+{
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        t_start = bench_time_now();
+        xTaskNotifyGive(worker_a);
+    }
+    bench_finish();
+}
+
+/* ---------------------------------------------------------------------- */
+/* ISR -> task: the low priority task pends an interrupt, which notifies   */
+/* the high priority task                                                  */
+
+void BENCH_IRQHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    t_isr = bench_time_now();
+    vTaskNotifyGiveFromISR(worker_a, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+static void isr_wait_task(void *pvParameters)
+{
+    for (;;)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t now = bench_time_now();
+        bench_stats_add(&stats_a, t_isr - t_start);
+        bench_stats_add(&stats_b, now - t_isr);
+    }
+}
+
+static void isr_trigger_task(void *pvParameters)
+{
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        t_start = bench_time_now();
+        NVIC_SetPendingIRQ(BENCH_IRQn);
+    }
+    bench_finish();
+}
+
+/* ---------------------------------------------------------------------- */
+/* pipeline: the benchmark task produces messages for one or two low      */
+/* priority consumers, which check every byte                             */
+
+static void pipe_check(const uint8_t *data, uint32_t len, uint8_t value)
+{
+    for (uint32_t i = 0; i < len; i++)
+    {
+        if (data[i] != value)
+        {
+            pipe_errors++;
+            break;
+        }
+    }
+}
+
+static void pipe_copy_consumer_task(void *pvParameters)
+{
+    uint32_t index = (uint32_t)pvParameters;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        xQueueReceive(pipe_queues[index], pipe_rx[index], portMAX_DELAY);
+        pipe_check(pipe_rx[index], pipe_payload_size, (uint8_t)i);
+    }
+    bench_finish();
+}
+
+static void pipe_zero_copy_consumer_task(void *pvParameters)
+{
+    uint32_t index = (uint32_t)pvParameters;
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        bufpool_buf_t *buf = bufpool_receive(pipe_queues[index], portMAX_DELAY);
+        pipe_check(bufpool_data(buf), buf->len, (uint8_t)i);
+        bufpool_release(buf);
+    }
+    bench_finish();
+}
+
+/* returns the cycles for all messages, until the last consumer is done */
+static uint32_t pipe_run(int zero_copy, uint32_t consumers)
+{
+    UBaseType_t item_size = zero_copy ? sizeof(bufpool_buf_t *) : pipe_payload_size;
+    TaskFunction_t consumer = zero_copy ? pipe_zero_copy_consumer_task : pipe_copy_consumer_task;
+    for (uint32_t c = 0; c < consumers; c++)
+    {
+        pipe_queues[c] = xQueueCreateStatic(PIPE_QUEUE_LENGTH, item_size, (uint8_t *)pipe_queue_storage[c],
+                                            &pipe_queue_buffers[c]);
+    }
+    worker_a = xTaskCreateStatic(consumer, "WorkerA", WORKER_STACK_SIZE, (void *)0, LOW_PRIO, worker_a_stack,
+                                 &worker_a_tcb);
+    if (consumers > 1)
+    {
+        worker_b = xTaskCreateStatic(consumer, "WorkerB", WORKER_STACK_SIZE, (void *)1, LOW_PRIO, worker_b_stack,
+                                     &worker_b_tcb);
+    }
+
+    uint32_t start = bench_time_now();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        if (zero_copy)
+        {
+            /* filled in place, only the pointer is queued */
+            bufpool_buf_t *buf = bufpool_alloc_wait(&pipe_pool, portMAX_DELAY);
+            memset(bufpool_data(buf), (uint8_t)i, pipe_payload_size);
+            buf->len = pipe_payload_size;
+            if (consumers > 1)
+            {
+                bufpool_fanout(pipe_queues, consumers, buf, portMAX_DELAY);
+            }
+            else
+            {
+                bufpool_send(pipe_queues[0], buf, portMAX_DELAY);
+            }
+        }
+        else
+        {
+            memset(pipe_tx, (uint8_t)i, pipe_payload_size);
+            for (uint32_t c = 0; c < consumers; c++)
+            {
+                xQueueSend(pipe_queues[c], pipe_tx, portMAX_DELAY);
+            }
+        }
+    }
+    for (uint32_t done = 0; done < consumers;)
+    {
+        done += ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    uint32_t cycles = bench_time_now() - start;
+
+    vTaskDelete(worker_a);
+    if (consumers > 1)
+    {
+        vTaskDelete(worker_b);
+    }
+    for (uint32_t c = 0; c < consumers; c++)
+    {
+        vQueueDelete(pipe_queues[c]);
+    }
+    return cycles;
+}
+
+/* ---------------------------------------------------------------------- */
+
+static void bench_timestamp_overhead(void)
+{
+    bench_stats_reset(&stats_a);
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        uint32_t start = bench_time_now();
+        bench_stats_add(&stats_a, bench_time_now() - start);
+    }
+    bench_stats_print("timestamp overhead (not subtracted)", &stats_a);
+}
+
+static void bench_queues(void)
+{
+    static const uint32_t item_sizes[] = {4, 16, 64};
+    uint8_t item[QUEUE_MAX_ITEM_SIZE];
+    char name[48];
+    memset(item, 0x55, sizeof(item));
+    for (uint32_t s = 0; s < sizeof(item_sizes) / sizeof(item_sizes[0]); s++)
+    {
+        queue_item_size = item_sizes[s];
+        queue = xQueueCreateStatic(QUEUE_LENGTH, queue_item_size, queue_storage, &queue_buffer);
+
+        /* copy in and out without a task switch */
+        bench_stats_reset(&stats_a);
+        for (uint32_t i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            uint32_t start = bench_time_now();
+            xQueueSend(queue, item, 0);
+            xQueueReceive(queue, item, 0);
+            bench_stats_add(&stats_a, bench_time_now() - start);
+        }
+        snprintf(name, sizeof(name), "queue %lu byte send + receive, same task", (unsigned long)queue_item_size);
+        bench_stats_print(name, &stats_a);
+
+        run_workers(queue_receive_task, HIGH_PRIO, queue_send_task, LOW_PRIO);
+        snprintf(name, sizeof(name), "queue %lu byte send -> receive wakeup", (unsigned long)queue_item_size);
+        bench_stats_print(name, &stats_a);
+        vQueueDelete(queue);
+    }
+}
+
+static void bench_stream_buffer(void)
+{
+    static const uint32_t chunk_sizes[] = {16, 64};
+    char name[48];
+    for (uint32_t s = 0; s < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); s++)
+    {
+        stream_chunk_size = chunk_sizes[s];
+        stream_errors = 0;
+        stream = xStreamBufferCreateStatic(STREAM_BUFFER_SIZE, 1, stream_storage, &stream_buffer);
+        run_workers(stream_send_task, LOW_PRIO, stream_receive_task, LOW_PRIO);
+        vStreamBufferDelete(stream);
+
+        uint32_t cycles = stream_end - t_start;
+        uint64_t bytes_per_s = cycles ? (uint64_t)STREAM_TOTAL_BYTES * SystemCoreClock / cycles : 0;
+        snprintf(name, sizeof(name), "stream buffer %lu byte send", (unsigned long)stream_chunk_size);
+        bench_stats_print(name, &stats_a);
+        printf("    throughput: %lu bytes in %lu cycles, %lu kB/s, %lu errors\n",
+               (unsigned long)STREAM_TOTAL_BYTES, (unsigned long)cycles,
+               (unsigned long)(bytes_per_s / 1024U), (unsigned long)stream_errors);
+    }
+}
+
+static void bench_isr(void)
+{
+    /* lowest priority, always allowed to call FreeRTOS API functions */
+    NVIC_SetPriority(BENCH_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+    NVIC_ClearPendingIRQ(BENCH_IRQn);
+    NVIC_EnableIRQ(BENCH_IRQn);
+    run_workers(isr_wait_task, HIGH_PRIO, isr_trigger_task, LOW_PRIO);
+    NVIC_DisableIRQ(BENCH_IRQn);
+    bench_stats_print("IRQ pend -> ISR entry", &stats_a);
+    bench_stats_print("ISR -> task (notify from ISR)", &stats_b);
+}
+
+static uint32_t pipe_kb_per_s(uint32_t cycles)
+{
+    uint64_t bytes = (uint64_t)pipe_payload_size * BENCH_ITERATIONS;
+    return cycles ? (uint32_t)(bytes * SystemCoreClock / cycles / 1024U) : 0;
+}
+
+static void bench_pipeline(void)
+{
+    static const uint32_t payload_sizes[] = {4, 16, 64, 256};
+    for (uint32_t consumers = 1; consumers <= PIPE_MAX_CONSUMERS; consumers++)
+    {
+        for (uint32_t s = 0; s < sizeof(payload_sizes) / sizeof(payload_sizes[0]); s++)
+        {
+            if (payload_sizes[s] > PIPE_MAX_PAYLOAD)
+            {
+                break;
+            }
+            pipe_payload_size = payload_sizes[s];
+            pipe_errors = 0;
+            uint32_t copy = pipe_run(0, consumers);
+            uint32_t zero_copy = pipe_run(1, consumers);
+            printf("pipeline %lu byte, %lu consumer(s): copy %lu cycles/message (%lu kB/s), "
+                   "zero-copy %lu cycles/message (%lu kB/s), %lu errors\n",
+                   (unsigned long)pipe_payload_size, (unsigned long)consumers,
+                   (unsigned long)(copy / BENCH_ITERATIONS), (unsigned long)pipe_kb_per_s(copy),
+                   (unsigned long)(zero_copy / BENCH_ITERATIONS), (unsigned long)pipe_kb_per_s(zero_copy),
+                   (unsigned long)pipe_errors);
+        }
+    }
+}
+
+void vBenchmarkTask(void *pvParameters)
+{
+    for (;;)
+    {
+        printf("FreeRTOS %s benchmark on Cortex-M%d, SystemCoreClock = %lu Hz, timestamps: %s, task selection: %s, "
+               "%d iterations\n",
+               tskKERNEL_VERSION_NUMBER, (int)__CORTEX_M, (unsigned long)SystemCoreClock,
+               bench_time_source(), configUSE_PORT_OPTIMISED_TASK_SELECTION ? "CLZ" : "generic", BENCH_ITERATIONS);
+        bench_timestamp_overhead();
+
+        run_workers(yield_stamp_task, HIGH_PRIO, yield_measure_task, HIGH_PRIO);
+        bench_stats_print("context switch (taskYIELD)", &stats_a);
+
+        sem = xSemaphoreCreateBinaryStatic(&sem_buffer);
+        run_workers(sem_take_task, HIGH_PRIO, sem_give_task, LOW_PRIO);
+        vSemaphoreDelete(sem);
+        bench_stats_print("semaphore give -> take wakeup", &stats_a);
+
+        bench_queues();
+        bench_stream_buffer();
+
+        run_workers(notify_take_task, HIGH_PRIO, notify_give_task, LOW_PRIO);
+        bench_stats_print("task notification give -> take wakeup", &stats_a);
+
+        bench_isr();
+        bench_pipeline();
+        printf("Benchmark done.\n");
+#ifdef BENCH_QEMU
+        /* ends the QEMU process via semihosting */
+        exit(0);
+#endif
+        vTaskDelay(pdMS_TO_TICKS(10000));
+    }
+}
+
+int main(void)
+{
+    init_printf_transport();
+    bench_time_init();
+    bufpool_init(&pipe_pool, pipe_pool_mem, sizeof(pipe_pool_mem), PIPE_POOL_BUFFERS, PIPE_MAX_PAYLOAD, pdTRUE);
+
+    printf("Starting FreeRTOS benchmark!\n");
+
+    controlTaskHandle = xTaskCreateStatic(
+        vBenchmarkTask,     /* Function that implements the task. */
+        "Benchmark",        /* Text name for the task. */
+        CONTROL_STACK_SIZE, /* Number of indexes in the xControlStack array. */
+        (void *)0,          /* Parameter passed into the task. */
+        CONTROL_PRIO,       /* Priority at which the task is created. */
+        xControlStack,      /* Array to use as the task's stack. */
+        &xControlTaskBuffer); /* Variable to hold the task's data structure. */
+
+    /* Start the scheduler itself. */
+    vTaskStartScheduler();
+    /* never reached */
+    return 0;
+}
+
+/* service FreeRTOS timer interrupts (except for ports which do it automatically) */
+#if !defined(GD32E23x) && !defined(GD32E50X)
+extern void xPortSysTickHandler(void);
+void SysTick_Handler(void)
+{
+    /* Clear overflow flag */
+    SysTick->CTRL;
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    {
+        /* Call tick handler */
+        xPortSysTickHandler();
+    }
+}
+#endif
@@ -0,0 +1,7 @@
+#ifndef PRINTF_OVER_X_H_
+#define PRINTF_OVER_X_H_
+
+/* Initializes printf transport system, e.g., the UART of semihosting service. */
+void init_printf_transport();
+
+#endif /* PRINTF_OVER_X_H_ */
\ No newline at end of file
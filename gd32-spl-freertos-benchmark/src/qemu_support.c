@@ -0,0 +1,21 @@
+#include <gd32_include.h>
+
+#ifdef BENCH_QEMU
+/* QEMU's ARM MPS2 boards (mps2-an385: Cortex-M3, mps2-an386: Cortex-M4F) have
+ * the same core as the GD32 chips, but none of the GD32 peripherals. The
+ * clock setup of the regular SystemInit() would wait forever for the RCU, so
+ * the startup code calls this function instead (linked with
+ * -Wl,--wrap=SystemInit, see platformio.ini). */
+
+/* the MPS2 boards clock the CPU and the SysTick with 25 MHz */
+#define QEMU_MPS2_SYSCLK 25000000U
+
+void __wrap_SystemInit(void)
+{
+#if (__FPU_PRESENT == 1U) && (__FPU_USED == 1U)
+    /* full access to CP10 and CP11, as the regular SystemInit() does */
+    SCB->CPACR |= ((3UL << 10 * 2) | (3UL << 11 * 2));
+#endif
+    SystemCoreClock = QEMU_MPS2_SYSCLK;
+}
+#endif
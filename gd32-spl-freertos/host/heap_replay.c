@@ -0,0 +1,174 @@
+/* Host-side replay of an allocation trace against one FreeRTOS heap
+ * implementation (heap_4.c or heap_tlsf.c, linked in by heap_replay.py).
+ *
+ * The trace has one operation per line:
+ *   a <id> <size>   pvPortMalloc(size), the block is known as id from now on
+ *   f <id>          vPortFree() of the block id
+ * Frees of ids whose allocation failed are skipped.
+ *
+ * Prints a CSV header and one line with the time per call (ns), the failed
+ * allocations, the minimum free heap and the fragmentation index
+ * (1000 * (1 - largest free block / free bytes)) sampled after every call. */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+
+typedef struct
+{
+    uint64_t *ns;
+    size_t count;
+    size_t capacity;
+} samples_t;
+
+static void samples_add(samples_t *s, uint64_t ns)
+{
+    if (s->count == s->capacity)
+    {
+        s->capacity = s->capacity ? 2 * s->capacity : 4096;
+        s->ns = realloc(s->ns, s->capacity * sizeof(*s->ns));
+        if (s->ns == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    s->ns[s->count++] = ns;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* average, 99th percentile and maximum */
+static void samples_summary(samples_t *s, double *avg, uint64_t *p99, uint64_t *max)
+{
+    *avg = 0.0;
+    *p99 = 0;
+    *max = 0;
+    if (s->count == 0)
+        return;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < s->count; i++)
+        sum += s->ns[i];
+    qsort(s->ns, s->count, sizeof(*s->ns), cmp_u64);
+    *avg = (double)sum / (double)s->count;
+    *p99 = s->ns[(s->count * 99) / 100];
+    *max = s->ns[s->count - 1];
+}
+
+static inline uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <name> <trace file>\n", argv[0]);
+        return 2;
+    }
+    FILE *f = fopen(argv[2], "r");
+    if (f == NULL)
+    {
+        perror(argv[2]);
+        return 2;
+    }
+
+    void **blocks = NULL;
+    size_t num_ids = 0;
+    samples_t alloc_ns = {0}, free_ns = {0};
+    size_t failed = 0, frag_samples = 0;
+    uint64_t frag_sum = 0, frag_max = 0, overhead = UINT64_MAX;
+    char line[128];
+
+    /* the time stamps take longer than some of the calls, subtract them */
+    for (int i = 0; i < 1000; i++)
+    {
+        uint64_t start = now_ns();
+        uint64_t d = now_ns() - start;
+        if (d < overhead)
+            overhead = d;
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        char op;
+        unsigned long id, size = 0;
+        if (line[0] == '#' || line[0] == '\n')
+            continue;
+        if (sscanf(line, " %c %lu %lu", &op, &id, &size) < 2 || (op != 'a' && op != 'f'))
+        {
+            fprintf(stderr, "invalid trace line: %s", line);
+            return 2;
+        }
+        if (id >= num_ids)
+        {
+            size_t n = num_ids ? num_ids : 1024;
+            while (n <= id)
+                n *= 2;
+            blocks = realloc(blocks, n * sizeof(*blocks));
+            if (blocks == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                return 1;
+            }
+            memset(blocks + num_ids, 0, (n - num_ids) * sizeof(*blocks));
+            num_ids = n;
+        }
+
+        if (op == 'a')
+        {
+            uint64_t start = now_ns();
+            blocks[id] = pvPortMalloc(size);
+            uint64_t d = now_ns() - start;
+            samples_add(&alloc_ns, d > overhead ? d - overhead : 0);
+            if (blocks[id] == NULL)
+                failed++;
+            else /* touch the memory like a real user would */
+                memset(blocks[id], 0xa5, size);
+        }
+        else if (blocks[id] != NULL)
+        {
+            uint64_t start = now_ns();
+            vPortFree(blocks[id]);
+            uint64_t d = now_ns() - start;
+            samples_add(&free_ns, d > overhead ? d - overhead : 0);
+            blocks[id] = NULL;
+        }
+
+        /* vPortGetHeapStats() of heap_4 (V10.4.4) runs past the end of the
+         * free list if there is no free block left */
+        uint64_t frag = 0;
+        if (xPortGetFreeHeapSize() > 0)
+        {
+            HeapStats_t stats;
+            vPortGetHeapStats(&stats);
+            frag = 1000 - (uint64_t)stats.xSizeOfLargestFreeBlockInBytes * 1000 / stats.xAvailableHeapSpaceInBytes;
+        }
+        frag_sum += frag;
+        frag_samples++;
+        if (frag > frag_max)
+            frag_max = frag;
+    }
+    fclose(f);
+
+    double alloc_avg, free_avg;
+    uint64_t alloc_p99, alloc_max, free_p99, free_max;
+    samples_summary(&alloc_ns, &alloc_avg, &alloc_p99, &alloc_max);
+    samples_summary(&free_ns, &free_avg, &free_p99, &free_max);
+    printf("heap,allocs,failed_allocs,frees,alloc_ns_avg,alloc_ns_p99,alloc_ns_max,free_ns_avg,free_ns_p99,"
+           "free_ns_max,min_ever_free,frag_permille_avg,frag_permille_max\n");
+    printf("%s,%zu,%zu,%zu,%.1f,%llu,%llu,%.1f,%llu,%llu,%zu,%.1f,%llu\n", argv[1], alloc_ns.count, failed,
+           free_ns.count, alloc_avg, (unsigned long long)alloc_p99, (unsigned long long)alloc_max, free_avg,
+           (unsigned long long)free_p99, (unsigned long long)free_max, xPortGetMinimumEverFreeHeapSize(),
+           frag_samples ? (double)frag_sum / (double)frag_samples : 0.0, (unsigned long long)frag_max);
+    return 0;
+}
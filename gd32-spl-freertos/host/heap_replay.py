@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Replays an allocation trace against heap_4.c and heap_tlsf.c on the host.
+
+Compiles heap_replay.c once with each heap of lib/FreeRTOS/src/heap (with the
+minimal FreeRTOS headers in heap_stub/), replays the same trace with both and
+prints the time per call, the failed allocations, the minimum free heap and
+the fragmentation index side by side.
+
+Without --trace, a seeded synthetic trace is generated that looks like a small
+RTOS application: long-lived objects created at startup (task stacks, queues),
+short-lived message buffers of random sizes and lifetimes, and tasks that are
+created and deleted now and then. A trace has one operation per line,
+"a <id> <size>" for an allocation and "f <id>" for a free.
+
+The times are host times: they show how the call time depends on the heap
+contents (heap_4 walks its free list, TLSF does not), not the cycles on the
+target. The block headers are twice as large on a 64-bit host, so the free
+heap values are somewhat lower than on the target.
+
+Example:
+    python3 host/heap_replay.py --heap-size 16384 --ops 200000
+"""
+import argparse
+import csv
+import io
+import os
+import random
+import shutil
+import subprocess
+import sys
+from os.path import abspath, dirname, isfile, join
+
+HOST_DIR = dirname(abspath(__file__))
+HEAP_DIR = join(HOST_DIR, "..", "lib", "FreeRTOS", "src", "heap")
+HEAPS = {
+    "heap_4": "heap_4.c",
+    "tlsf": "heap_tlsf.c",
+}
+
+
+def run(cmd):
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("error: command failed: %s\n%s" % (" ".join(cmd), result.stdout))
+    return result.stdout
+
+
+def build(args, heap):
+    build_dir = join(args.build_dir, heap)
+    os.makedirs(build_dir, exist_ok=True)
+    exe = join(build_dir, "heap_replay")
+    run([args.cc, "-O2", "-std=gnu11", "-o", exe,
+         "-DconfigTOTAL_HEAP_SIZE=((size_t)(%d))" % args.heap_size,
+         "-I" + join(HOST_DIR, "heap_stub"), "-I" + HEAP_DIR,
+         join(HOST_DIR, "heap_replay.c"), join(HEAP_DIR, HEAPS[heap])] + args.cflags)
+    return exe
+
+
+def generate_trace(path, args):
+    """writes the synthetic trace, returns the number of operations"""
+    rnd = random.Random(args.seed)
+    next_id = 0
+    ops = []
+    live = []      # (free at step, id) of the short-lived blocks
+    tasks = []     # (delete at step, stack id, tcb id)
+
+    def alloc(size):
+        nonlocal next_id
+        ops.append("a %d %d" % (next_id, size))
+        next_id += 1
+        return next_id - 1
+
+    # startup: task stacks, TCBs, queues and driver buffers that are never freed
+    for _ in range(6):
+        alloc(rnd.choice([512, 768, 1024]))
+        alloc(96)
+    for _ in range(8):
+        alloc(rnd.randint(2, 16) * 16 + 80)
+
+    step = 0
+    while len(ops) < args.ops:
+        step += 1
+        # message buffers: mostly small, sometimes large, short lifetimes
+        size = rnd.randint(8, 64) if rnd.random() < 0.7 else rnd.randint(64, 600)
+        lifetime = int(rnd.expovariate(1.0 / args.mean_lifetime)) + 1
+        live.append((step + lifetime, alloc(size)))
+        # a transient worker task
+        if rnd.random() < 0.01:
+            tasks.append((step + rnd.randint(50, 500), alloc(rnd.choice([384, 512])), alloc(96)))
+        for entry in [e for e in live if e[0] <= step]:
+            ops.append("f %d" % entry[1])
+            live.remove(entry)
+        for entry in [e for e in tasks if e[0] <= step]:
+            ops.append("f %d" % entry[2])
+            ops.append("f %d" % entry[1])
+            tasks.remove(entry)
+
+    with open(path, "w") as f:
+        f.write("# synthetic RTOS allocation trace, seed %s\n" % args.seed)
+        f.write("\n".join(ops) + "\n")
+    return len(ops)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--cc", default=os.environ.get("CC", "gcc"), help="host C compiler")
+    parser.add_argument("--cflags", action="append", default=[],
+                        help="additional compiler flags for both heaps")
+    parser.add_argument("--build-dir", default=join(HOST_DIR, ".build"))
+    parser.add_argument("--heap-size", type=int, default=16384, help="configTOTAL_HEAP_SIZE")
+    parser.add_argument("--trace", help="allocation trace to replay instead of the synthetic one")
+    parser.add_argument("--ops", type=int, default=100000,
+                        help="operations of the synthetic trace")
+    parser.add_argument("--mean-lifetime", type=float, default=20.0,
+                        help="mean lifetime of the synthetic message buffers, in allocations")
+    parser.add_argument("--seed", default="1")
+    parser.add_argument("--runs", type=int, default=5,
+                        help="runs per heap, the one with the lowest average alloc time is shown")
+    args = parser.parse_args()
+
+    if shutil.which(args.cc) is None:
+        sys.exit("error: host compiler %s not found" % args.cc)
+    trace = args.trace
+    if trace is None:
+        os.makedirs(args.build_dir, exist_ok=True)
+        trace = join(args.build_dir, "synthetic_trace.txt")
+        n = generate_trace(trace, args)
+        print("synthetic trace: %d operations, seed %s, heap %d bytes\n" % (n, args.seed, args.heap_size))
+    elif not isfile(trace):
+        sys.exit("error: trace %s not found" % trace)
+
+    rows = []
+    for heap in HEAPS:
+        exe = build(args, heap)
+        best = None
+        for _ in range(args.runs):
+            row = next(csv.DictReader(io.StringIO(run([exe, heap, trace]))))
+            if best is None or float(row["alloc_ns_avg"]) < float(best["alloc_ns_avg"]):
+                best = row
+        rows.append(best)
+
+    header = list(rows[0].keys())
+    widths = [max(len(h), max(len(r[h]) for r in rows)) for h in header]
+    print("  ".join(h.ljust(w) for h, w in zip(header, widths)).rstrip())
+    for r in rows:
+        print("  ".join(r[h].ljust(w) for h, w in zip(header, widths)).rstrip())
+
+
+if __name__ == "__main__":
+    main()
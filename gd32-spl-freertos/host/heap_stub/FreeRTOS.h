@@ -0,0 +1,49 @@
+/* Minimal FreeRTOS.h to compile heap_4.c and heap_tlsf.c for the host, see
+ * heap_replay.py. The heap size comes from the command line. */
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE ((size_t)(16384))
+#endif
+#define configAPPLICATION_ALLOCATED_HEAP 0
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configASSERT(x) assert(x)
+
+/* the same alignment as the Cortex-M ports */
+#define portBYTE_ALIGNMENT 8
+#define portBYTE_ALIGNMENT_MASK (0x0007)
+#define portPOINTER_SIZE_TYPE uintptr_t
+#define portMAX_DELAY ((uint32_t)0xffffffffUL)
+
+#define PRIVILEGED_DATA
+#define PRIVILEGED_FUNCTION
+#define mtCOVERAGE_TEST_MARKER()
+#define traceMALLOC(pvAddress, uiSize)
+#define traceFREE(pvAddress, uiSize)
+
+typedef long BaseType_t;
+
+typedef struct xHeapStats
+{
+    size_t xAvailableHeapSpaceInBytes;
+    size_t xSizeOfLargestFreeBlockInBytes;
+    size_t xSizeOfSmallestFreeBlockInBytes;
+    size_t xNumberOfFreeBlocks;
+    size_t xMinimumEverFreeBytesRemaining;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+} HeapStats_t;
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats);
+void *pvPortMalloc(size_t xSize);
+void vPortFree(void *pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+
+#endif /* INC_FREERTOS_H */
@@ -0,0 +1,10 @@
+/* single-threaded host replay, the scheduler is never suspended */
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#define vTaskSuspendAll()
+#define xTaskResumeAll() ((BaseType_t)0)
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+#endif /* INC_TASK_H */
@@ -0,0 +1,278 @@
+/*
+ * Header-only fast paths for the most frequent CMSIS-OS2 calls, available
+ * with PIO_FREERTOS_WITH_CMSISOS2 (see build_freertos.py).
+ *
+ * Every function of cmsis_os2.c first finds out whether it runs in an
+ * interrupt handler: a call of xTaskGetSchedulerState() and a read of IPSR,
+ * PRIMASK and BASEPRI. The functions here are inlined into the caller, read
+ * IPSR once and go directly to the matching FreeRTOS primitive, with the same
+ * parameter checks and return values as cmsis_os2.c:
+ *   - interrupt handler (IPSR != 0): the FromISR primitive, as cmsis_os2.c
+ *   - thread with interrupts enabled: the task primitive, as cmsis_os2.c
+ *   - thread with interrupts masked (PRIMASK / BASEPRI): the function of
+ *     cmsis_os2.c, which also treats this case differently before and after
+ *     the scheduler was started. This is the rare path.
+ * Calls that are not allowed in an interrupt handler (mutexes) take the
+ * function of cmsis_os2.c there, which returns osErrorISR.
+ *
+ * The fast functions carry the suffix Fast (osMutexAcquireFast(), ...).
+ * Define CMSIS_OS2_FAST_REMAP before including this header (or as build flag)
+ * to redirect the regular names in that file to them:
+ *
+ *   #define CMSIS_OS2_FAST_REMAP
+ *   #include <cmsis_os2_fast.h>
+ *   ...
+ *   osMutexAcquire(mutex, osWaitForever);  // calls osMutexAcquireFast()
+ *
+ * Each call site grows by the inlined code (a few dozen bytes), so the remap
+ * is best used in the files that contain the hot loops.
+ */
+#ifndef CMSIS_OS2_FAST_H_
+#define CMSIS_OS2_FAST_H_
+
+#include <stdint.h>
+#include "cmsis_os2.h"
+#include "cmsis_compiler.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "queue.h"
+#include "freertos_os2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define OS2_FAST_IRQ_MASKED() ((__get_PRIMASK() != 0U) || (__get_BASEPRI() != 0U))
+#else
+#define OS2_FAST_IRQ_MASKED() (__get_PRIMASK() != 0U)
+#endif
+#define OS2_FAST_IRQ_MODE() (__get_IPSR() != 0U)
+
+/* same limit as in cmsis_os2.c, bit 31 of the notification value is reserved */
+#define OS2_FAST_THREAD_FLAGS_INVALID_BITS (~((1UL << 31U) - 1U))
+
+__STATIC_FORCEINLINE osStatus_t os2_fast_status(BaseType_t ret, uint32_t timeout)
+{
+    if (ret == pdPASS)
+    {
+        return osOK;
+    }
+    return timeout != 0U ? osErrorTimeout : osErrorResource;
+}
+
+__STATIC_FORCEINLINE uint32_t osKernelGetTickCountFast(void)
+{
+    if (OS2_FAST_IRQ_MODE())
+    {
+        return (uint32_t)xTaskGetTickCountFromISR();
+    }
+    if (OS2_FAST_IRQ_MASKED())
+    {
+        return osKernelGetTickCount();
+    }
+    return (uint32_t)xTaskGetTickCount();
+}
+
+__STATIC_FORCEINLINE osStatus_t osMutexAcquireFast(osMutexId_t mutex_id, uint32_t timeout)
+{
+    /* bit 0 of the id marks a recursive mutex, see osMutexNew() */
+    SemaphoreHandle_t hMutex = (SemaphoreHandle_t)((uintptr_t)mutex_id & ~(uintptr_t)1U);
+    if (OS2_FAST_IRQ_MODE() || OS2_FAST_IRQ_MASKED())
+    {
+        return osMutexAcquire(mutex_id, timeout);
+    }
+    if (hMutex == NULL)
+    {
+        return osErrorParameter;
+    }
+#if (configUSE_RECURSIVE_MUTEXES == 1)
+    if (((uintptr_t)mutex_id & 1U) != 0U)
+    {
+        return os2_fast_status(xSemaphoreTakeRecursive(hMutex, timeout), timeout);
+    }
+#endif
+    return os2_fast_status(xSemaphoreTake(hMutex, timeout), timeout);
+}
+
+__STATIC_FORCEINLINE osStatus_t osMutexReleaseFast(osMutexId_t mutex_id)
+{
+    SemaphoreHandle_t hMutex = (SemaphoreHandle_t)((uintptr_t)mutex_id & ~(uintptr_t)1U);
+    if (OS2_FAST_IRQ_MODE() || OS2_FAST_IRQ_MASKED())
+    {
+        return osMutexRelease(mutex_id);
+    }
+    if (hMutex == NULL)
+    {
+        return osErrorParameter;
+    }
+#if (configUSE_RECURSIVE_MUTEXES == 1)
+    if (((uintptr_t)mutex_id & 1U) != 0U)
+    {
+        return xSemaphoreGiveRecursive(hMutex) == pdPASS ? osOK : osErrorResource;
+    }
+#endif
+    return xSemaphoreGive(hMutex) == pdPASS ? osOK : osErrorResource;
+}
+
+__STATIC_FORCEINLINE osStatus_t osSemaphoreAcquireFast(osSemaphoreId_t semaphore_id, uint32_t timeout)
+{
+    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
+    if (hSemaphore == NULL)
+    {
+        return osErrorParameter;
+    }
+    if (OS2_FAST_IRQ_MODE())
+    {
+        BaseType_t yield = pdFALSE;
+        if (timeout != 0U)
+        {
+            return osErrorParameter;
+        }
+        if (xSemaphoreTakeFromISR(hSemaphore, &yield) != pdPASS)
+        {
+            return osErrorResource;
+        }
+        portYIELD_FROM_ISR(yield);
+        return osOK;
+    }
+    if (OS2_FAST_IRQ_MASKED())
+    {
+        return osSemaphoreAcquire(semaphore_id, timeout);
+    }
+    return os2_fast_status(xSemaphoreTake(hSemaphore, (TickType_t)timeout), timeout);
+}
+
+__STATIC_FORCEINLINE osStatus_t osSemaphoreReleaseFast(osSemaphoreId_t semaphore_id)
+{
+    SemaphoreHandle_t hSemaphore = (SemaphoreHandle_t)semaphore_id;
+    if (hSemaphore == NULL)
+    {
+        return osErrorParameter;
+    }
+    if (OS2_FAST_IRQ_MODE())
+    {
+        BaseType_t yield = pdFALSE;
+        if (xSemaphoreGiveFromISR(hSemaphore, &yield) != pdTRUE)
+        {
+            return osErrorResource;
+        }
+        portYIELD_FROM_ISR(yield);
+        return osOK;
+    }
+    if (OS2_FAST_IRQ_MASKED())
+    {
+        return osSemaphoreRelease(semaphore_id);
+    }
+    return xSemaphoreGive(hSemaphore) == pdPASS ? osOK : osErrorResource;
+}
+
+#if (configUSE_OS2_THREAD_FLAGS == 1)
+/* like cmsis_os2.c, the flags are read back after setting them, so a woken
+ * thread of higher priority may already have cleared them */
+__STATIC_FORCEINLINE uint32_t osThreadFlagsSetFast(osThreadId_t thread_id, uint32_t flags)
+{
+    TaskHandle_t hTask = (TaskHandle_t)thread_id;
+    uint32_t rflags = (uint32_t)osError;
+    if ((hTask == NULL) || ((flags & OS2_FAST_THREAD_FLAGS_INVALID_BITS) != 0U))
+    {
+        return (uint32_t)osErrorParameter;
+    }
+    if (OS2_FAST_IRQ_MODE())
+    {
+        BaseType_t yield = pdFALSE;
+        (void)xTaskNotifyFromISR(hTask, flags, eSetBits, &yield);
+        (void)xTaskNotifyAndQueryFromISR(hTask, 0, eNoAction, &rflags, NULL);
+        portYIELD_FROM_ISR(yield);
+        return rflags;
+    }
+    if (OS2_FAST_IRQ_MASKED())
+    {
+        return osThreadFlagsSet(thread_id, flags);
+    }
+    (void)xTaskNotify(hTask, flags, eSetBits);
+    (void)xTaskNotifyAndQuery(hTask, 0, eNoAction, &rflags);
+    return rflags;
+}
+#endif
+
+/* the message priority is ignored, as in cmsis_os2.c */
+__STATIC_FORCEINLINE osStatus_t osMessageQueuePutFast(osMessageQueueId_t mq_id, const void *msg_ptr, uint8_t msg_prio,
+                                                      uint32_t timeout)
+{
+    QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+    (void)msg_prio;
+    if ((hQueue == NULL) || (msg_ptr == NULL))
+    {
+        return osErrorParameter;
+    }
+    if (OS2_FAST_IRQ_MODE())
+    {
+        BaseType_t yield = pdFALSE;
+        if (timeout != 0U)
+        {
+            return osErrorParameter;
+        }
+        if (xQueueSendToBackFromISR(hQueue, msg_ptr, &yield) != pdTRUE)
+        {
+            return osErrorResource;
+        }
+        portYIELD_FROM_ISR(yield);
+        return osOK;
+    }
+    if (OS2_FAST_IRQ_MASKED())
+    {
+        return osMessageQueuePut(mq_id, msg_ptr, msg_prio, timeout);
+    }
+    return os2_fast_status(xQueueSendToBack(hQueue, msg_ptr, (TickType_t)timeout), timeout);
+}
+
+__STATIC_FORCEINLINE osStatus_t osMessageQueueGetFast(osMessageQueueId_t mq_id, void *msg_ptr, uint8_t *msg_prio,
+                                                      uint32_t timeout)
+{
+    QueueHandle_t hQueue = (QueueHandle_t)mq_id;
+    if ((hQueue == NULL) || (msg_ptr == NULL))
+    {
+        return osErrorParameter;
+    }
+    if (OS2_FAST_IRQ_MODE())
+    {
+        BaseType_t yield = pdFALSE;
+        if (timeout != 0U)
+        {
+            return osErrorParameter;
+        }
+        if (xQueueReceiveFromISR(hQueue, msg_ptr, &yield) != pdPASS)
+        {
+            return osErrorResource;
+        }
+        portYIELD_FROM_ISR(yield);
+        return osOK;
+    }
+    if (OS2_FAST_IRQ_MASKED())
+    {
+        return osMessageQueueGet(mq_id, msg_ptr, msg_prio, timeout);
+    }
+    return os2_fast_status(xQueueReceive(hQueue, msg_ptr, (TickType_t)timeout), timeout);
+}
+
+/* after the definitions, so that the fallbacks above still reach cmsis_os2.c */
+#ifdef CMSIS_OS2_FAST_REMAP
+#define osKernelGetTickCount() osKernelGetTickCountFast()
+#define osMutexAcquire(mutex_id, timeout) osMutexAcquireFast(mutex_id, timeout)
+#define osMutexRelease(mutex_id) osMutexReleaseFast(mutex_id)
+#define osSemaphoreAcquire(semaphore_id, timeout) osSemaphoreAcquireFast(semaphore_id, timeout)
+#define osSemaphoreRelease(semaphore_id) osSemaphoreReleaseFast(semaphore_id)
+#if (configUSE_OS2_THREAD_FLAGS == 1)
+#define osThreadFlagsSet(thread_id, flags) osThreadFlagsSetFast(thread_id, flags)
+#endif
+#define osMessageQueuePut(mq_id, msg_ptr, msg_prio, timeout) osMessageQueuePutFast(mq_id, msg_ptr, msg_prio, timeout)
+#define osMessageQueueGet(mq_id, msg_ptr, msg_prio, timeout) osMessageQueueGetFast(mq_id, msg_ptr, msg_prio, timeout)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMSIS_OS2_FAST_H_ */
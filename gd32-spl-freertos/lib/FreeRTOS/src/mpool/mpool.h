@@ -0,0 +1,114 @@
+/*
+ * Fixed-block memory pool for allocations from tasks and interrupts.
+ *
+ * osMemoryPoolAlloc() / osMemoryPoolFree() of the CMSIS-OS2 layer take a
+ * counting semaphore and enter a critical section for every block. This pool
+ * keeps the free blocks in a singly linked list that is updated with a single
+ * LDREX / STREX pair on cores that have them (Cortex-M3, M4, M33), so
+ * allocating and freeing never masks interrupts there. On the other cores
+ * (Cortex-M23, Cortex-M0) the list is updated with interrupts masked for a few
+ * instructions.
+ *
+ * Waiting for a free block is optional: a pool initialized with blocking = 1
+ * gets a counting semaphore that is only given when a task waits in
+ * mpool_alloc_wait(), so the fast path stays the same.
+ *
+ * mpool_alloc() and mpool_free() can be called from tasks and interrupts.
+ * With interrupt masking (MPOOL_USE_EXCLUSIVES 0) or on a blocking pool, the
+ * interrupt priority must allow calling FreeRTOS API functions
+ * (configMAX_SYSCALL_INTERRUPT_PRIORITY).
+ */
+#ifndef MPOOL_H_
+#define MPOOL_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 1: update the free list with LDREX / STREX, 0: with interrupts masked.
+ * ARMv8-M Baseline (Cortex-M23) has LDREX / STREX too, but the masked section
+ * is just as short there. */
+#ifndef MPOOL_USE_EXCLUSIVES
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define MPOOL_USE_EXCLUSIVES 1
+#else
+#define MPOOL_USE_EXCLUSIVES 0
+#endif
+#endif
+
+#if MPOOL_USE_EXCLUSIVES
+/* also used by bufpool.c for the reference counts. The exclusive monitor is
+ * cleared on every exception entry and return, so the STREX fails if an
+ * interrupt or a context switch came in between, even if the head points to
+ * the same block again (no ABA problem on one core). */
+static inline uint32_t mpool_ldrex(volatile uint32_t *addr)
+{
+    uint32_t value;
+    __asm volatile("ldrex %0, %1" : "=r"(value) : "Q"(*addr) : "memory");
+    return value;
+}
+
+/* returns 0 if the value was stored */
+static inline uint32_t mpool_strex(uint32_t value, volatile uint32_t *addr)
+{
+    uint32_t failed;
+    __asm volatile("strex %0, %2, %1" : "=&r"(failed), "=Q"(*addr) : "r"(value) : "memory");
+    return failed;
+}
+
+static inline void mpool_clrex(void)
+{
+    __asm volatile("clrex" ::: "memory");
+}
+#endif
+
+/* size of a block in the memory array, rounded up to 4 bytes */
+#define MPOOL_BLOCK_SIZE(block_size) ((((block_size) + 3U) / 4U) * 4U)
+/* size of the memory array for block_count blocks of block_size bytes */
+#define MPOOL_MEM_SIZE(block_count, block_size) (MPOOL_BLOCK_SIZE(block_size) * (block_count))
+
+typedef struct mpool_block
+{
+    struct mpool_block *next;
+} mpool_block_t;
+
+typedef struct
+{
+    mpool_block_t *volatile head; /* first free block */
+    uint8_t *mem;                 /* memory array */
+    uint32_t block_size;          /* rounded up to 4 bytes */
+    uint32_t block_count;
+    volatile uint32_t waiters;    /* tasks waiting in mpool_alloc_wait() */
+    SemaphoreHandle_t sem;        /* NULL if the pool is not blocking */
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    StaticSemaphore_t sem_buffer;
+#endif
+} mpool_t;
+
+/* initializes the pool with block_count blocks of block_size bytes in mem,
+ * which must be 4-byte aligned and at least MPOOL_MEM_SIZE() bytes large.
+ * blocking = 1 creates the semaphore for mpool_alloc_wait().
+ * Returns pdPASS or pdFAIL. */
+BaseType_t mpool_init(mpool_t *mp, void *mem, uint32_t mem_size, uint32_t block_count, uint32_t block_size,
+                      BaseType_t blocking);
+
+/* takes a block from the pool, NULL if the pool is empty. Never blocks. */
+void *mpool_alloc(mpool_t *mp);
+
+/* like mpool_alloc(), but waits up to timeout ticks for a block to be freed.
+ * Only blocks on a blocking pool and when called from a task. */
+void *mpool_alloc_wait(mpool_t *mp, TickType_t timeout);
+
+/* returns a block to the pool. Returns pdFAIL if the pointer is not the start
+ * of a block of this pool. Freeing a block twice is not detected. */
+BaseType_t mpool_free(mpool_t *mp, void *block);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MPOOL_H_ */
@@ -0,0 +1,122 @@
+/*
+ * Contention profiler for FreeRTOS mutexes, included with
+ * PIO_FREERTOS_MUTEX_PROFILER (see build_freertos.py).
+ *
+ * The trace macros of queue.c (mapped in FreeRTOSConfig.h) report every take
+ * that had to block, every successful take and every give of a mutex, so
+ * the raw FreeRTOS mutexes (xSemaphoreCreateMutex(), ...Recursive()) and the
+ * CMSIS-OS2 ones (osMutexNew(), also through cmsis_os2_fast.h) are covered.
+ * Counting semaphores and queues are ignored. Per mutex it records:
+ *   - takes: successful takes, a recursive mutex only counts the outermost
+ *   - contentions: takes that had to block, and timeouts among them
+ *   - inheritances: contentions where the waiting task had a higher priority
+ *     than the owner, so that the owner inherited it
+ *   - the wait time of the contentions, with a histogram in decades of us
+ *   - the hold time from the take to the give, and the longest holder
+ *   - the owners at the time of contention: how often and how long each of
+ *     them blocked other tasks. A wait is charged to the owner that held
+ *     the mutex when the task blocked.
+ * Times are measured in CPU cycles (the DWT cycle counter, on the Cortex-M23
+ * the SysTick together with the tick count) and in ticks for waits longer
+ * than MUTEX_PROFILER_CYCLES_MAX_TICKS, and kept in us.
+ *
+ * mutex_profiler_print() lists the mutexes with the longest total wait first,
+ * with their worst offending owners. The names come from the queue registry:
+ * osMutexNew() registers the name of its attributes, raw FreeRTOS mutexes
+ * need vQueueAddToRegistry().
+ *
+ * The hooks take a critical section, they are meant for finding the
+ * contention, not for production builds.
+ */
+#ifndef MUTEX_PROFILER_H_
+#define MUTEX_PROFILER_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (configUSE_MUTEXES != 1) || (configUSE_TRACE_FACILITY != 1)
+#error "the mutex profiler needs configUSE_MUTEXES and configUSE_TRACE_FACILITY"
+#endif
+
+/* number of mutexes that are profiled, further mutexes are not recorded */
+#ifndef MUTEX_PROFILER_MAX_MUTEXES
+#define MUTEX_PROFILER_MAX_MUTEXES 8
+#endif
+/* owners remembered per mutex, further owners share the last entry */
+#ifndef MUTEX_PROFILER_MAX_OWNERS
+#define MUTEX_PROFILER_MAX_OWNERS 4
+#endif
+/* tasks that can wait for a mutex at the same time */
+#ifndef MUTEX_PROFILER_MAX_WAITERS
+#define MUTEX_PROFILER_MAX_WAITERS 8
+#endif
+/* longer waits and holds are measured with the tick count, the 32-bit cycle
+ * counter wraps after 21 s at 200 MHz */
+#ifndef MUTEX_PROFILER_CYCLES_MAX_TICKS
+#define MUTEX_PROFILER_CYCLES_MAX_TICKS (10U * configTICK_RATE_HZ)
+#endif
+
+/* wait time histogram: < 10 us, < 100 us, < 1 ms, < 10 ms, < 100 ms, < 1 s, longer */
+#define MUTEX_PROFILER_BUCKETS 7
+
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN]; /* empty if unused */
+    uint32_t contentions;               /* times other tasks blocked on it */
+    uint64_t wait_total_us;             /* time they waited */
+    uint32_t wait_max_us;
+} mutex_profiler_owner_t;
+
+typedef struct
+{
+    void *mutex; /* SemaphoreHandle_t / osMutexId_t */
+    uint32_t takes;
+    uint32_t contentions;
+    uint32_t timeouts;
+    uint32_t inheritances;
+    uint64_t wait_total_us;
+    uint32_t wait_max_us;
+    uint32_t wait_histogram[MUTEX_PROFILER_BUCKETS];
+    uint32_t holds; /* gives with a measured hold time */
+    uint64_t hold_total_us;
+    uint32_t hold_max_us;
+    char hold_max_owner[configMAX_TASK_NAME_LEN];
+    mutex_profiler_owner_t owners[MUTEX_PROFILER_MAX_OWNERS];
+} mutex_profiler_stats_t;
+
+/* enables the cycle counter. Call in main() before the first mutex is used. */
+void mutex_profiler_init(void);
+
+/* copies the stats of the index-th profiled mutex, returns 0 if there is no
+ * such mutex */
+int mutex_profiler_get(uint32_t index, mutex_profiler_stats_t *stats);
+
+/* clears the stats of all mutexes, e.g. after the startup */
+void mutex_profiler_reset(void);
+
+/* prints the mutexes with the longest total wait first, up to max_owners of
+ * their owners each, with the longest caused wait first:
+ *   MUTEX: "<name>" takes <n> contentions <n> timeouts <n> inheritances <n>
+ *          wait avg <us> max <us> us hold avg <us> max <us> us by "<task>"
+ *   MUTEX: "<name>" wait histogram <10us <n> <100us <n> ... >=1s <n>
+ *   MUTEX: "<name>" owner "<task>" contentions <n> wait total <us> max <us> us */
+void mutex_profiler_print(uint32_t max_owners);
+
+/* the hooks, called by the trace macros in FreeRTOSConfig.h with the mutex
+ * and, for a blocking take, its holder */
+void mutex_profiler_blocking(void *mutex, void *holder);
+void mutex_profiler_taken(void *mutex);
+void mutex_profiler_take_failed(void *mutex);
+void mutex_profiler_given(void *mutex);
+void mutex_profiler_deleted(void *mutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MUTEX_PROFILER_H_ */
@@ -0,0 +1,93 @@
+/*
+ * FreeRTOS port for POSIX hosts (Linux), used by the host simulator of the
+ * examples (scripts/freertos_sim.py). Follows the design of the FreeRTOS
+ * POSIX port (FreeRTOS/Source/portable/ThirdParty/GCC/Posix, MIT license):
+ * every task is a pthread, only the thread of the running task is allowed to
+ * run, and the tick is a SIGALRM of an interval timer. Masking interrupts is
+ * blocking the signals of the calling thread.
+ */
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <limits.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Type definitions. */
+#define portCHAR          char
+#define portFLOAT         float
+#define portDOUBLE        double
+#define portLONG          long
+#define portSHORT         short
+#define portSTACK_TYPE    unsigned long
+#define portBASE_TYPE     long
+#define portPOINTER_SIZE_TYPE size_t
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if ( configUSE_16_BIT_TICKS == 1 )
+    typedef uint16_t TickType_t;
+    #define portMAX_DELAY    ( TickType_t ) 0xffff
+#else
+    typedef unsigned long TickType_t;
+    #define portMAX_DELAY    ( TickType_t ) ULONG_MAX
+#endif
+
+/* ticks are only changed by the tick signal handler, with all other tasks
+ * stopped */
+#define portTICK_TYPE_IS_ATOMIC    1
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH                   ( -1 )
+#define portHAS_STACK_OVERFLOW_CHECKING    ( 1 )
+#define portTICK_PERIOD_MS                 ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portTICK_RATE_MICROSECONDS         ( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT                 8
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+extern void vPortYieldFromISR( void );
+
+#define portYIELD()                                 vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )    do { if( xSwitchRequired ) vPortYieldFromISR(); } while( 0 )
+#define portYIELD_FROM_ISR( x )                     portEND_SWITCHING_ISR( x )
+
+/* Critical section management. */
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern UBaseType_t xPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxMask );
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()         xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortClearInterruptMask( x )
+#define portDISABLE_INTERRUPTS()                  vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()                   vPortEnableInterrupts()
+#define portENTER_CRITICAL()                      vPortEnterCritical()
+#define portEXIT_CRITICAL()                       vPortExitCritical()
+
+/* Task deletion: a task that deletes itself ends its thread on the next
+ * switch, the thread of a task deleted by another one is cancelled when the
+ * TCB is freed. */
+extern void vPortThreadDying( void * pxTaskToDelete, volatile BaseType_t * pxPendYield );
+extern void vPortCancelThread( void * pxTaskToDelete );
+#define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield )    vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
+#define portCLEAN_UP_TCB( pxTCB )                                  vPortCancelThread( pxTCB )
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )    void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
+
+#define portNOP()    __asm volatile ( "nop" )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
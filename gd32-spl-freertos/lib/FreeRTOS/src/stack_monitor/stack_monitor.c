@@ -0,0 +1,237 @@
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "stack_monitor.h"
+
+/* tskSTACK_FILL_BYTE of tasks.c, as a word */
+#define STACK_MONITOR_FILL 0xa5a5a5a5UL
+/* the recommended sizes are multiples of this, which also keeps the MPU and
+ * stack limit alignment */
+#define STACK_MONITOR_ROUND_WORDS 8U
+
+#if STACK_MONITOR_GUARD && defined(__ARM_ARCH_8M_MAIN__)
+#define STACK_MONITOR_GUARD_STKOF 1
+/* MSPLIM is set this far above the bottom of the interrupt stack, the fault
+ * handler lowers it to have room for the report */
+#define STACK_MONITOR_MSP_RESERVE 256U
+#elif STACK_MONITOR_GUARD && defined(__ARM_ARCH_8M_BASE__) && defined(__MPU_PRESENT) && (__MPU_PRESENT == 1U)
+#define STACK_MONITOR_GUARD_MPU 1
+/* MPU region number of the guard, the port does not use the MPU */
+#define STACK_MONITOR_MPU_REGION 0U
+/* size of the guard region, the ARMv8-M MPU has a granularity of 32 bytes */
+#define STACK_MONITOR_GUARD_SIZE 32U
+#endif
+
+#ifdef STACK_MONITOR_GUARD_MPU
+/* the guard starts at the first 32-byte boundary in the stack, so up to
+ * 63 bytes at the bottom of every stack can't be used */
+#define STACK_MONITOR_GUARD_WORDS ((2U * STACK_MONITOR_GUARD_SIZE - 1U) / sizeof(StackType_t))
+#else
+#define STACK_MONITOR_GUARD_WORDS 0U
+#endif
+
+/* end of .bss, start of the C library heap. Provided by the linker script. */
+extern uint8_t end;
+
+/* bottom and top of the painted interrupt stack */
+static uint32_t *msp_bottom;
+static uint32_t *msp_top;
+
+#ifdef STACK_MONITOR_GUARD_MPU
+/* 0 if the MPU has no regions */
+static int guard_enabled;
+/* the guard region that is currently set up */
+static uint32_t guard_base;
+#endif
+
+void stack_monitor_init(void)
+{
+    /* the initial stack pointer is the first entry of the vector table */
+    msp_top = (uint32_t *)(*(volatile uint32_t *)SCB->VTOR);
+    uintptr_t bottom = (uintptr_t)msp_top - STACK_MONITOR_MSP_SIZE;
+    uintptr_t bss_end = ((uintptr_t)&end + 7U) & ~(uintptr_t)7U;
+    if (bottom < bss_end)
+    {
+        bottom = bss_end;
+    }
+    msp_bottom = (uint32_t *)bottom;
+
+    /* paint up to a bit below the current stack pointer, the rest is in use */
+    uint32_t *sp = (uint32_t *)(__get_MSP() - 16U);
+    for (uint32_t *p = msp_bottom; p < sp; p++)
+    {
+        *p = STACK_MONITOR_FILL;
+    }
+
+#ifdef STACK_MONITOR_GUARD_STKOF
+    __set_MSPLIM(bottom + STACK_MONITOR_MSP_RESERVE);
+    /* the task limits are loaded by the port. Stack limit violations raise a
+     * UsageFault, which is escalated to a HardFault unless it is enabled. */
+    SCB->SHCSR |= SCB_SHCSR_USGFAULTENA_Msk;
+#endif
+#ifdef STACK_MONITOR_GUARD_MPU
+    if (((MPU->TYPE & MPU_TYPE_DREGION_Msk) >> MPU_TYPE_DREGION_Pos) > STACK_MONITOR_MPU_REGION)
+    {
+        /* attribute 0: normal memory, write-back. PRIVDEFENA keeps the
+         * default memory map for everything outside of the guard. */
+        MPU->MAIR0 = 0xffU;
+        MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+        __DSB();
+        __ISB();
+        guard_enabled = 1;
+    }
+#endif
+}
+
+uint32_t stack_monitor_recommend(uint32_t peak_words)
+{
+    uint32_t margin = peak_words * STACK_MONITOR_MARGIN_PERCENT / 100U;
+    if (margin < STACK_MONITOR_MIN_MARGIN_WORDS)
+    {
+        margin = STACK_MONITOR_MIN_MARGIN_WORDS;
+    }
+    uint32_t words = peak_words + margin + STACK_MONITOR_GUARD_WORDS;
+    return (words + STACK_MONITOR_ROUND_WORDS - 1U) / STACK_MONITOR_ROUND_WORDS * STACK_MONITOR_ROUND_WORDS;
+}
+
+int stack_monitor_get_task(TaskHandle_t task, stack_monitor_usage_t *usage)
+{
+    if (task == NULL)
+    {
+        return 0;
+    }
+    /* StaticTask_t mirrors the private TCB_t, also for dynamically created
+     * tasks: pxDummy6 is pxStack, pxDummy8 is pxEndOfStack (the highest
+     * usable word, configRECORD_STACK_HIGH_ADDRESS) */
+    const StaticTask_t *tcb = (const StaticTask_t *)task;
+    const StackType_t *stack = tcb->pxDummy6;
+    const StackType_t *end_of_stack = tcb->pxDummy8;
+    usage->size_words = (uint32_t)(end_of_stack - stack) + 1U;
+    usage->peak_words = usage->size_words - (uint32_t)uxTaskGetStackHighWaterMark(task);
+    usage->recommended_words = stack_monitor_recommend(usage->peak_words);
+    return 1;
+}
+
+void stack_monitor_get_isr(stack_monitor_usage_t *usage)
+{
+    const uint32_t *p = msp_bottom;
+    while (p < msp_top && *p == STACK_MONITOR_FILL)
+    {
+        p++;
+    }
+    usage->size_words = (uint32_t)(msp_top - msp_bottom);
+    usage->peak_words = (uint32_t)(msp_top - p);
+    usage->recommended_words = stack_monitor_recommend(usage->peak_words);
+}
+
+static void print_usage(const char *name, const stack_monitor_usage_t *usage)
+{
+    printf("STACK: \"%s\" size %lu peak %lu recommended %lu\n", name, (unsigned long)usage->size_words,
+           (unsigned long)usage->peak_words, (unsigned long)usage->recommended_words);
+}
+
+void stack_monitor_print(void)
+{
+    static TaskStatus_t tasks[STACK_MONITOR_MAX_TASKS];
+    stack_monitor_usage_t usage;
+    UBaseType_t count = uxTaskGetSystemState(tasks, STACK_MONITOR_MAX_TASKS, NULL);
+    for (UBaseType_t i = 0; i < count; i++)
+    {
+        if (stack_monitor_get_task(tasks[i].xHandle, &usage))
+        {
+            print_usage(tasks[i].pcTaskName, &usage);
+        }
+    }
+    stack_monitor_get_isr(&usage);
+    print_usage("ISR", &usage);
+}
+
+void stack_monitor_overflow(const char *task_name)
+{
+    taskDISABLE_INTERRUPTS();
+    printf("STACK OVERFLOW: \"%s\"\n", task_name != NULL ? task_name : "?");
+    for (;;)
+    {
+    }
+}
+
+void stack_monitor_task_switched_in(void *stack)
+{
+#ifdef STACK_MONITOR_GUARD_MPU
+    uint32_t base = ((uint32_t)stack + STACK_MONITOR_GUARD_SIZE - 1U) & ~(STACK_MONITOR_GUARD_SIZE - 1U);
+    if (guard_enabled && base != guard_base)
+    {
+        guard_base = base;
+        /* read-only for all privilege levels (AP = 0b11), never executable.
+         * Reads stay allowed, uxTaskGetStackHighWaterMark() scans the guard. */
+        MPU->RNR = STACK_MONITOR_MPU_REGION;
+        MPU->RBAR = base | (3U << MPU_RBAR_AP_Pos) | MPU_RBAR_XN_Msk;
+        MPU->RLAR = ((base + STACK_MONITOR_GUARD_SIZE - 1U) & MPU_RLAR_LIMIT_Msk) | MPU_RLAR_EN_Msk;
+        /* the context switch returns from PendSV, which is a barrier too */
+        __DSB();
+    }
+#else
+    (void)stack;
+#endif
+}
+
+#ifdef STACK_MONITOR_GUARD_STKOF
+/* called with the EXC_RETURN value of the fault */
+void stack_monitor_usage_fault(uint32_t exc_return)
+{
+    if (SCB->CFSR & SCB_CFSR_STKOF_Msk)
+    {
+        /* bit 2 of EXC_RETURN: the fault came from the process (task) stack */
+        if (exc_return & 4U)
+        {
+            stack_monitor_overflow(pcTaskGetName(NULL));
+        }
+        stack_monitor_overflow("ISR");
+    }
+    taskDISABLE_INTERRUPTS();
+    printf("UsageFault: CFSR 0x%08lx\n", (unsigned long)SCB->CFSR);
+    for (;;)
+    {
+    }
+}
+
+/* lowers the limit of the interrupt stack first, the fault may have hit it */
+__attribute__((naked)) void UsageFault_Handler(void)
+{
+    __asm volatile("movs r0, #0           \n"
+                   "msr  msplim, r0       \n"
+                   "mov  r0, lr           \n"
+                   "b    stack_monitor_usage_fault \n");
+}
+#endif
+
+#ifdef STACK_MONITOR_GUARD_MPU
+/* The Cortex-M23 has no fault status registers. A fault from a task whose
+ * stack pointer reached the guard region is reported as stack overflow. */
+void stack_monitor_hard_fault(uint32_t exc_return)
+{
+    if ((exc_return & 4U) && guard_base != 0U &&
+        __get_PSP() < guard_base + STACK_MONITOR_GUARD_SIZE + 64U)
+    {
+        stack_monitor_overflow(pcTaskGetName(NULL));
+    }
+    taskDISABLE_INTERRUPTS();
+    printf("HardFault\n");
+    for (;;)
+    {
+    }
+}
+
+/* the handler runs on the interrupt stack, the guarded task stack is not
+ * touched */
+__attribute__((naked)) void HardFault_Handler(void)
+{
+    __asm volatile("mov  r0, lr           \n"
+                   "b    stack_monitor_hard_fault \n");
+}
+#endif
@@ -0,0 +1,367 @@
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "tickless.h"
+
+/* SysTick cycles lost while the SysTick is stopped, as portMISSED_COUNTS_FACTOR of the ports */
+#define TICKLESS_MISSED_COUNTS 45UL
+
+#define TICKLESS_SYSTICK_CTRL (SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk)
+
+static tickless_stats_t tickless_stats;
+
+#if TICKLESS_HAS_DEEPSLEEP
+#define TICKLESS_RTC_HZ ((TICKLESS_RTC_LXTAL ? 32768UL : 40000UL) / (TICKLESS_RTC_PRESCALER + 1UL))
+/* the PLL is started again from the internal 8 MHz oscillator */
+#define TICKLESS_IRC8M_HZ 8000000UL
+
+static int tickless_rtc_ready;
+/* measured wakeup latency of the last deep-sleep in RTC counts, the next
+ * alarm is set that much earlier */
+static uint32_t tickless_rtc_latency;
+#endif
+
+#if defined(GD32E23x)
+/* no DWT cycle counter on the Cortex-M23, the overhead is not measured */
+static uint32_t tickless_now(void)
+{
+    return 0U;
+}
+#else
+static uint32_t tickless_now(void)
+{
+    return DWT->CYCCNT;
+}
+#endif
+
+static void tickless_account(uint32_t *max, uint64_t *total, uint32_t value)
+{
+    *total += value;
+    if (value > *max)
+    {
+        *max = value;
+    }
+}
+
+__attribute__((weak)) int tickless_deepsleep_allowed(void)
+{
+    return 1;
+}
+
+/* sleep mode, the SysTick is reloaded with the whole idle time. Same as
+ * vPortSuppressTicksAndSleep() of the ports, plus the measurements. */
+static void tickless_wfi(TickType_t idle, uint32_t entry_start)
+{
+    const uint32_t counts_per_tick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+    const TickType_t max_ticks = SysTick_LOAD_RELOAD_Msk / counts_per_tick;
+    uint32_t complete_ticks;
+
+    if (idle > max_ticks)
+    {
+        idle = max_ticks;
+    }
+
+    /* stop the SysTick, the time it is stopped is compensated for */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    uint32_t reload = SysTick->VAL + counts_per_tick * (idle - 1UL);
+    if (reload > TICKLESS_MISSED_COUNTS)
+    {
+        reload -= TICKLESS_MISSED_COUNTS;
+    }
+
+    /* not taskENTER_CRITICAL(), which would mask the interrupts that end the sleep */
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        /* finish the current tick period */
+        SysTick->LOAD = SysTick->VAL;
+        SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+        SysTick->LOAD = counts_per_tick - 1UL;
+        tickless_stats.aborted++;
+        __enable_irq();
+        return;
+    }
+
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0UL;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+    uint32_t entry = tickless_now() - entry_start;
+    __DSB();
+    __WFI();
+    __ISB();
+    uint32_t exit_start = tickless_now();
+
+    /* the SysTick interrupt is pending (masked) if it ended the sleep, the
+     * count since the reload is the time it took to get here */
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        tickless_stats.wfi_wakeups++;
+        tickless_account(&tickless_stats.wfi_latency_max_cycles, &tickless_stats.wfi_latency_total_cycles,
+                         reload - SysTick->VAL);
+    }
+    uint32_t exit = tickless_now() - exit_start;
+
+    /* let the interrupt that ended the sleep run */
+    __enable_irq();
+    __DSB();
+    __ISB();
+    __disable_irq();
+    __DSB();
+    __ISB();
+    exit_start = tickless_now();
+
+    /* stop the SysTick without reading CTRL, which would clear COUNTFLAG */
+    SysTick->CTRL = TICKLESS_SYSTICK_CTRL;
+    if (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk)
+    {
+        /* the tick interrupt is pending, finish the current tick period */
+        uint32_t load = (counts_per_tick - 1UL) - (reload - SysTick->VAL);
+        if (load < TICKLESS_MISSED_COUNTS || load > counts_per_tick)
+        {
+            load = counts_per_tick - 1UL;
+        }
+        SysTick->LOAD = load;
+        /* the pending tick interrupt adds the last one */
+        complete_ticks = idle - 1UL;
+        tickless_stats.wfi_ticks += idle;
+    }
+    else
+    {
+        /* another interrupt ended the sleep */
+        uint32_t decrements = (idle * counts_per_tick) - SysTick->VAL;
+        complete_ticks = decrements / counts_per_tick;
+        SysTick->LOAD = ((complete_ticks + 1UL) * counts_per_tick) - decrements;
+        tickless_stats.early_wakeups++;
+        tickless_stats.wfi_ticks += complete_ticks;
+    }
+
+    SysTick->VAL = 0UL;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    vTaskStepTick(complete_ticks);
+    SysTick->LOAD = counts_per_tick - 1UL;
+
+    tickless_stats.wfi_sleeps++;
+    tickless_account(&tickless_stats.entry_max_cycles, &tickless_stats.entry_total_cycles, entry);
+    tickless_account(&tickless_stats.exit_max_cycles, &tickless_stats.exit_total_cycles,
+                     exit + (tickless_now() - exit_start));
+    __enable_irq();
+}
+
+#if TICKLESS_HAS_DEEPSLEEP
+static uint32_t tickless_ticks_to_rtc(TickType_t ticks)
+{
+    return (uint32_t)(((uint64_t)ticks * TICKLESS_RTC_HZ) / configTICK_RATE_HZ);
+}
+
+static TickType_t tickless_rtc_to_ticks(uint32_t counts)
+{
+    return (TickType_t)(((uint64_t)counts * configTICK_RATE_HZ) / TICKLESS_RTC_HZ);
+}
+
+/* deep-sleep until the RTC alarm or another EXTI interrupt */
+static void tickless_deepsleep(TickType_t idle, uint32_t entry_start)
+{
+    const uint32_t counts_per_tick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+
+    __disable_irq();
+    __DSB();
+    __ISB();
+
+    if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+    {
+        tickless_stats.aborted++;
+        __enable_irq();
+        return;
+    }
+
+    /* the SysTick stops in deep-sleep anyway, the RTC counts the time */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    rtc_lwoff_wait();
+    uint32_t start = rtc_counter_get();
+    uint32_t counts = tickless_ticks_to_rtc(idle);
+    /* wake up early by the last measured latency, at most by half the time */
+    counts -= (tickless_rtc_latency < counts / 2U) ? tickless_rtc_latency : counts / 2U;
+    uint32_t alarm = start + counts;
+    rtc_alarm_config(alarm);
+    rtc_lwoff_wait();
+    rtc_flag_clear(RTC_FLAG_ALARM);
+    exti_interrupt_flag_clear(EXTI_17);
+    NVIC_ClearPendingIRQ(RTC_Alarm_IRQn);
+
+    PMU_CTL &= ~PMU_CTL_STBMOD;
+    PMU_CTL |= PMU_CTL_LDOLP;
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    uint32_t entry = tickless_now() - entry_start;
+    __DSB();
+    __WFI();
+    __ISB();
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    uint32_t exit_start = tickless_now();
+
+    /* the chip runs from IRC8M after deep-sleep, start HXTAL and PLL again */
+    SystemInit();
+    uint32_t restore = tickless_now() - exit_start;
+    exit_start = tickless_now();
+
+    /* the RTC registers are only valid again after a synchronisation */
+    rtc_register_sync_wait();
+    uint32_t end = rtc_counter_get();
+    uint32_t slept = end - start;
+    TickType_t ticks = tickless_rtc_to_ticks(slept);
+    if (rtc_flag_get(RTC_FLAG_ALARM) == SET)
+    {
+        /* the alarm ended the sleep, from the alarm to the running PLL */
+        tickless_rtc_latency = end - alarm;
+        tickless_stats.deep_wakeups++;
+        tickless_account(&tickless_stats.deep_latency_max_us, &tickless_stats.deep_latency_total_us,
+                         (uint32_t)(((uint64_t)tickless_rtc_latency * 1000000ULL) / TICKLESS_RTC_HZ));
+    }
+    else
+    {
+        tickless_stats.early_wakeups++;
+    }
+    rtc_flag_clear(RTC_FLAG_ALARM);
+    exti_interrupt_flag_clear(EXTI_17);
+    NVIC_ClearPendingIRQ(RTC_Alarm_IRQn);
+
+    if (ticks >= idle)
+    {
+        /* the pending tick interrupt adds the last one */
+        ticks = idle - 1U;
+        SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+        tickless_stats.deep_ticks += idle;
+    }
+    else
+    {
+        tickless_stats.deep_ticks += ticks;
+    }
+    SysTick->LOAD = counts_per_tick - 1UL;
+    SysTick->VAL = 0UL;
+    SysTick->CTRL = TICKLESS_SYSTICK_CTRL | SysTick_CTRL_ENABLE_Msk;
+    vTaskStepTick(ticks);
+
+    tickless_stats.deep_sleeps++;
+    tickless_account(&tickless_stats.entry_max_cycles, &tickless_stats.entry_total_cycles, entry);
+    /* the SystemInit() part ran from IRC8M, in CPU cycles it took the time of the CPU clock */
+    tickless_account(&tickless_stats.exit_max_cycles, &tickless_stats.exit_total_cycles,
+                     (uint32_t)(((uint64_t)restore * (configCPU_CLOCK_HZ / 1000000UL)) /
+                                (TICKLESS_IRC8M_HZ / 1000000UL)) +
+                         (tickless_now() - exit_start));
+    __enable_irq();
+}
+
+/* the wakeup from deep-sleep, the flags are cleared afterwards */
+void RTC_Alarm_IRQHandler(void)
+{
+    rtc_flag_clear(RTC_FLAG_ALARM);
+    exti_interrupt_flag_clear(EXTI_17);
+}
+#endif
+
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    uint32_t entry_start = tickless_now();
+#if TICKLESS_HAS_DEEPSLEEP
+    if (tickless_rtc_ready && xExpectedIdleTime >= TICKLESS_DEEPSLEEP_MIN_TICKS && tickless_deepsleep_allowed())
+    {
+        tickless_deepsleep(xExpectedIdleTime, entry_start);
+        return;
+    }
+#endif
+    tickless_wfi(xExpectedIdleTime, entry_start);
+}
+
+void tickless_init(void)
+{
+#if !defined(GD32E23x)
+    /* enable trace and debug blocks (TRCENA), needed for the DWT to run */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+#if TICKLESS_HAS_DEEPSLEEP
+    rcu_periph_clock_enable(RCU_PMU);
+    rcu_periph_clock_enable(RCU_BKPI);
+    pmu_backup_write_enable();
+    /* the RTC clock source can only be changed after a backup domain reset */
+#if TICKLESS_RTC_LXTAL
+    rcu_osci_on(RCU_LXTAL);
+    if (rcu_osci_stab_wait(RCU_LXTAL) != SUCCESS)
+    {
+        return;
+    }
+    rcu_rtc_clock_config(RCU_RTCSRC_LXTAL);
+#else
+    rcu_osci_on(RCU_IRC40K);
+    if (rcu_osci_stab_wait(RCU_IRC40K) != SUCCESS)
+    {
+        return;
+    }
+    rcu_rtc_clock_config(RCU_RTCSRC_IRC40K);
+#endif
+    rcu_periph_clock_enable(RCU_RTC);
+    rtc_register_sync_wait();
+    rtc_lwoff_wait();
+    rtc_prescaler_set(TICKLESS_RTC_PRESCALER);
+    rtc_lwoff_wait();
+    rtc_interrupt_enable(RTC_INT_ALARM);
+    rtc_lwoff_wait();
+
+    /* the RTC alarm wakes the chip from deep-sleep through EXTI line 17 */
+    exti_init(EXTI_17, EXTI_INTERRUPT, EXTI_TRIG_RISING);
+    exti_interrupt_flag_clear(EXTI_17);
+    NVIC_SetPriority(RTC_Alarm_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+    NVIC_EnableIRQ(RTC_Alarm_IRQn);
+    tickless_rtc_ready = 1;
+#endif
+    tickless_stats = (tickless_stats_t){0};
+    tickless_stats.since = xTaskGetTickCount();
+}
+
+void tickless_get_stats(tickless_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = tickless_stats;
+    taskEXIT_CRITICAL();
+}
+
+/* a fraction as percentage with 2 decimals, e.g. "12.34" */
+static void tickless_format_percent(char *buf, size_t len, uint64_t part, uint64_t total)
+{
+    unsigned long hundredths = total ? (unsigned long)(part * 10000ULL / total) : 0UL;
+    snprintf(buf, len, "%lu.%02lu", hundredths / 100UL, hundredths % 100UL);
+}
+
+static unsigned long tickless_avg(uint64_t total, uint32_t count)
+{
+    return count ? (unsigned long)(total / count) : 0UL;
+}
+
+void tickless_print(void)
+{
+    tickless_stats_t s;
+    char asleep[12], wfi[12], deep[12];
+    tickless_get_stats(&s);
+    uint64_t elapsed = (TickType_t)(xTaskGetTickCount() - s.since);
+    tickless_format_percent(asleep, sizeof(asleep), s.wfi_ticks + s.deep_ticks, elapsed);
+    tickless_format_percent(wfi, sizeof(wfi), s.wfi_ticks, elapsed);
+    tickless_format_percent(deep, sizeof(deep), s.deep_ticks, elapsed);
+    uint32_t sleeps = s.wfi_sleeps + s.deep_sleeps;
+    printf("TICKLESS: asleep %s%% (wfi %s%% deepsleep %s%%), sleeps wfi %lu deepsleep %lu aborted %lu early %lu\n",
+           asleep, wfi, deep, (unsigned long)s.wfi_sleeps, (unsigned long)s.deep_sleeps,
+           (unsigned long)s.aborted, (unsigned long)s.early_wakeups);
+    printf("TICKLESS: entry avg %lu max %lu exit avg %lu max %lu cycles, wakeup wfi avg %lu max %lu cycles "
+           "deepsleep avg %lu max %lu us\n",
+           tickless_avg(s.entry_total_cycles, sleeps), (unsigned long)s.entry_max_cycles,
+           tickless_avg(s.exit_total_cycles, sleeps), (unsigned long)s.exit_max_cycles,
+           tickless_avg(s.wfi_latency_total_cycles, s.wfi_wakeups), (unsigned long)s.wfi_latency_max_cycles,
+           tickless_avg(s.deep_latency_total_us, s.deep_wakeups), (unsigned long)s.deep_latency_max_us);
+}
@@ -0,0 +1,110 @@
+/*
+ * Tickless idle for FreeRTOS, included with PIO_FREERTOS_TICKLESS (see
+ * build_freertos.py). FreeRTOSConfig.h must set configUSE_TICKLESS_IDLE to 2,
+ * this library provides vPortSuppressTicksAndSleep() instead of the port.
+ *
+ * When all tasks are blocked for at least configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+ * ticks, the idle task stops the periodic tick and sleeps until the next task
+ * is due (or an interrupt comes in). Depending on the expected idle time:
+ *   - WFI (sleep mode, all families): the SysTick keeps running from the CPU
+ *     clock and is reloaded with the whole idle time, as the port would do.
+ *     At most 2^24 CPU cycles, e.g. 139 ticks at 120 MHz.
+ *   - deep-sleep (GD32F10x, F20x, F30x, F403, E10x, E50x): at least
+ *     TICKLESS_DEEPSLEEP_MIN_TICKS. The core and the PLL are stopped, the RTC
+ *     alarm (EXTI line 17) wakes the chip. Afterwards SystemInit() starts the
+ *     PLL again and the tick count is advanced by the RTC counter. The
+ *     families with a calendar RTC (GD32F1x0, F3x0, E23x, F4xx) only use WFI.
+ * The RTC belongs to this library, tickless_init() sets it up. Without the
+ * call, or while tickless_deepsleep_allowed() returns 0, only WFI is used.
+ *
+ * Statistics (tickless_print()):
+ *   - the ticks spent in WFI and in deep-sleep, as share of the time since
+ *     tickless_init(): a proxy for the idle current
+ *   - entry / exit: CPU cycles from the idle task to the WFI instruction and
+ *     from the wakeup back to the idle task, without the interrupt that woke
+ *     the chip (DWT cycle counter, not measured on the Cortex-M23)
+ *   - wakeup latency: WFI: SysTick cycles from the end of the idle time to
+ *     the first instruction after WFI. Deep-sleep: RTC time from the alarm to
+ *     the running PLL.
+ */
+#ifndef TICKLESS_H_
+#define TICKLESS_H_
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if (configUSE_TICKLESS_IDLE != 2)
+#error "the tickless library needs configUSE_TICKLESS_IDLE 2"
+#endif
+
+#if defined(GD32F10x) || defined(GD32F20x) || defined(GD32F30x) || defined(GD32F403) || defined(GD32E10X) || \
+    defined(GD32E50X)
+#define TICKLESS_HAS_DEEPSLEEP 1
+#else
+#define TICKLESS_HAS_DEEPSLEEP 0
+#endif
+
+/* deep-sleep only pays off if the chip sleeps much longer than the start of
+ * the HXTAL and the PLL takes */
+#ifndef TICKLESS_DEEPSLEEP_MIN_TICKS
+#define TICKLESS_DEEPSLEEP_MIN_TICKS pdMS_TO_TICKS(10)
+#endif
+
+/* RTC clock: 1 = 32.768 kHz crystal (LXTAL), 0 = internal 40 kHz RC oscillator
+ * (IRC40K), which is available on every board but off by up to +-25 %, the
+ * tick count drifts by as much during deep-sleep */
+#ifndef TICKLESS_RTC_LXTAL
+#define TICKLESS_RTC_LXTAL 0
+#endif
+/* the RTC counter runs with the RTC clock / (TICKLESS_RTC_PRESCALER + 1) */
+#ifndef TICKLESS_RTC_PRESCALER
+#define TICKLESS_RTC_PRESCALER 3
+#endif
+
+typedef struct
+{
+    TickType_t since;        /* tick count at tickless_init() */
+    uint32_t wfi_sleeps;
+    uint32_t deep_sleeps;
+    uint32_t aborted;        /* a task became ready before the sleep */
+    uint32_t early_wakeups;  /* an interrupt ended the sleep before the expected time */
+    uint64_t wfi_ticks;      /* time asleep */
+    uint64_t deep_ticks;
+    uint32_t entry_max_cycles;
+    uint64_t entry_total_cycles;
+    uint32_t exit_max_cycles;
+    uint64_t exit_total_cycles;
+    uint32_t wfi_wakeups;    /* sleeps ended by the SysTick, with a measured latency */
+    uint32_t wfi_latency_max_cycles;
+    uint64_t wfi_latency_total_cycles;
+    uint32_t deep_wakeups;   /* sleeps ended by the RTC alarm */
+    uint32_t deep_latency_max_us;
+    uint64_t deep_latency_total_us;
+} tickless_stats_t;
+
+/* sets up the RTC for deep-sleep (if the family has one) and starts the
+ * statistics, call before the scheduler starts. Waits for the RTC clock. */
+void tickless_init(void);
+
+/* called with interrupts disabled before every deep-sleep, the application
+ * can return 0 to use WFI instead, e.g. while a peripheral is still busy. The
+ * default always returns 1. */
+int tickless_deepsleep_allowed(void);
+
+/* copy of the statistics */
+void tickless_get_stats(tickless_stats_t *stats);
+
+/* prints the statistics in two lines:
+ * TICKLESS: asleep <%> (wfi <%> deepsleep <%>), sleeps wfi <n> deepsleep <n> aborted <n> early <n>
+ * TICKLESS: entry avg/max <cycles> exit avg/max <cycles>, wakeup wfi avg/max <cycles> deepsleep avg/max <us> */
+void tickless_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TICKLESS_H_ */
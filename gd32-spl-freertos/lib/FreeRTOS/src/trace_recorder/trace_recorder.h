@@ -0,0 +1,117 @@
+/*
+ * Lightweight RAM trace recorder for FreeRTOS.
+ *
+ * Implements the Event Recorder functions used by cmsis_os2/freertos_evr.c
+ * (see EventRecorder.h), so all FreeRTOS trace hooks mapped there (task
+ * switches, queue / semaphore / mutex operations, notifications, timers,
+ * event groups, stream buffers) end up as timestamped 16-byte records in a
+ * ring buffer in RAM. Interrupts and application events can be added with the
+ * functions below.
+ *
+ * Enabled with -DPIO_FREERTOS_TRACE_RECORDER in the build_flags. The
+ * FreeRTOSConfig.h must then include "freertos_evr.h" to map the trace
+ * macros, and EvrFreeRTOSSetup(0) must be called before the first task is
+ * created (osKernelInitialize() does that when using CMSIS-OS2).
+ *
+ * The buffer can be read with the debugger (the trace_recorder variable,
+ * e.g. "dump binary value trace.bin trace_recorder" in GDB) or printed as hex
+ * with trace_recorder_dump(). scripts/freertos_trace_to_chrome.py converts
+ * both into the Chrome trace format, which can be viewed in Perfetto
+ * (https://ui.perfetto.dev) or chrome://tracing.
+ */
+#ifndef TRACE_RECORDER_H_
+#define TRACE_RECORDER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of records in the ring buffer (16 bytes each), can be set in the
+ * FreeRTOSConfig.h or the build_flags */
+#ifndef TRACE_RECORDER_SIZE
+#define TRACE_RECORDER_SIZE 256
+#endif
+/* number of task, queue and marker names that are remembered */
+#ifndef TRACE_RECORDER_MAX_NAMES
+#define TRACE_RECORDER_MAX_NAMES 16
+#endif
+/* 1: stop recording when the buffer is full, 0: overwrite the oldest records */
+#ifndef TRACE_RECORDER_STOP_WHEN_FULL
+#define TRACE_RECORDER_STOP_WHEN_FULL 0
+#endif
+
+#define TRACE_RECORDER_MAGIC 0x31435254U /* "TRC1" */
+#define TRACE_RECORDER_VERSION 1U
+#define TRACE_RECORDER_NAME_LEN 12
+
+/* component number of the events recorded by this module */
+#define TRACE_RECORDER_COMPONENT 0xEEU
+#define TRACE_RECORDER_ISR_ENTER 0x00U
+#define TRACE_RECORDER_ISR_EXIT 0x01U
+#define TRACE_RECORDER_MARK 0x02U
+#define TRACE_RECORDER_BEGIN 0x03U
+#define TRACE_RECORDER_END 0x04U
+
+/* set in the ID of the second record of EventRecord4() */
+#define TRACE_RECORDER_CONTINUATION 0x80000000U
+
+typedef struct
+{
+    uint32_t timestamp; /* CPU cycles, wraps around at 32 bit */
+    uint32_t id;        /* EventID() */
+    uint32_t val1;
+    uint32_t val2;
+} trace_record_t;
+
+typedef struct
+{
+    uint32_t object; /* task or queue handle, or marker number */
+    char name[TRACE_RECORDER_NAME_LEN];
+} trace_name_t;
+
+/* the layout is read by the converter, only append new fields */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t num_records;
+    uint32_t num_names;
+    uint32_t name_len;
+    uint32_t timestamp_freq; /* Hz */
+    volatile uint32_t write_index; /* number of records written since start */
+    volatile uint32_t running;
+    trace_name_t names[TRACE_RECORDER_MAX_NAMES];
+    trace_record_t records[TRACE_RECORDER_SIZE];
+} trace_recorder_t;
+
+extern trace_recorder_t trace_recorder;
+
+/* call at the beginning and the end of an interrupt handler to see it in
+ * the trace. Records the exception number (IPSR). */
+void trace_recorder_isr_enter(void);
+void trace_recorder_isr_exit(void);
+
+/* names a task, queue or marker in the trace. Tasks and registered queues
+ * (vQueueAddToRegistry()) are named automatically. */
+void trace_recorder_name(uint32_t object, const char *name);
+
+/* application events. A marker is a small number, e.g. from an enum, which
+ * can be given a name with trace_recorder_name(). mark() is an instant event,
+ * begin() / end() enclose a duration on the current task. */
+void trace_recorder_mark(uint32_t marker, uint32_t value);
+void trace_recorder_begin(uint32_t marker, uint32_t value);
+void trace_recorder_end(uint32_t marker, uint32_t value);
+
+/* stops the recording and prints the buffer as hex lines ("TRACE:...") with
+ * printf(), for the converter. If restart is non-zero, the buffer is emptied
+ * and the recording restarted afterwards. Call from a task, not from an
+ * interrupt. */
+void trace_recorder_dump(int restart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H_ */
@@ -0,0 +1,415 @@
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#include "RTE_Components.h"
+#include CMSIS_device_header
+
+#include "uart_stream.h"
+
+#if !defined(GD32F10x) && !defined(GD32F20x) && !defined(GD32F30x) && !defined(GD32F403) && !defined(GD32E10X)
+#error "the UART stream driver supports the GD32F10x, F20x, F30x, F403 and E10x series"
+#endif
+
+typedef struct
+{
+    const char *name;
+    uint32_t usart;
+    IRQn_Type usart_irqn;
+#if UART_STREAM_USE_DMA
+    dma_channel_enum rx_channel;
+    IRQn_Type rx_irqn;
+    dma_channel_enum tx_channel;
+    IRQn_Type tx_irqn;
+#endif
+} uart_stream_hw_t;
+
+static const uart_stream_hw_t uart_stream_hw[UART_STREAM_PORTS] = {
+#if UART_STREAM_USE_DMA
+    {"USART0", USART0, USART0_IRQn, DMA_CH4, DMA0_Channel4_IRQn, DMA_CH3, DMA0_Channel3_IRQn},
+    {"USART1", USART1, USART1_IRQn, DMA_CH5, DMA0_Channel5_IRQn, DMA_CH6, DMA0_Channel6_IRQn},
+#else
+    {"USART0", USART0, USART0_IRQn},
+    {"USART1", USART1, USART1_IRQn},
+#endif
+};
+
+typedef struct
+{
+    StreamBufferHandle_t rx; /* NULL if the port was not opened */
+    StreamBufferHandle_t tx;
+    StaticStreamBuffer_t rx_buffer;
+    StaticStreamBuffer_t tx_buffer;
+    /* a stream buffer needs one byte more than it can hold */
+    uint8_t rx_storage[UART_STREAM_RX_BUFFER_SIZE + 1];
+    uint8_t tx_storage[UART_STREAM_TX_BUFFER_SIZE + 1];
+#if UART_STREAM_USE_DMA
+    uint8_t rx_ring[UART_STREAM_RX_DMA_SIZE];
+    uint32_t rx_last_pos; /* position of the DMA in rx_ring at the last move */
+    uint8_t tx_block[UART_STREAM_TX_DMA_SIZE];
+#endif
+    volatile uint32_t tx_busy; /* only changed by the interrupts, except at the start in byte mode */
+    uart_stream_stats_t stats;
+} uart_stream_t;
+
+static uart_stream_t uart_stream_ports[UART_STREAM_PORTS];
+
+#if UART_STREAM_USE_DMA
+/* moves the bytes the DMA wrote since the last call into the stream buffer */
+static void uart_stream_rx_move(uart_stream_t *p, const uart_stream_hw_t *hw, BaseType_t *woken)
+{
+    /* the counter counts down from the ring size, it is reloaded to the ring
+     * size after the last byte */
+    uint32_t pos = (UART_STREAM_RX_DMA_SIZE - dma_transfer_number_get(DMA0, hw->rx_channel)) %
+                   UART_STREAM_RX_DMA_SIZE;
+    if (pos == p->rx_last_pos)
+    {
+        return;
+    }
+    while (p->rx_last_pos != pos)
+    {
+        /* up to the DMA position or the end of the ring */
+        uint32_t end = pos > p->rx_last_pos ? pos : UART_STREAM_RX_DMA_SIZE;
+        size_t len = end - p->rx_last_pos;
+        size_t sent = xStreamBufferSendFromISR(p->rx, &p->rx_ring[p->rx_last_pos], len, woken);
+        p->stats.rx_bytes += sent;
+        p->stats.rx_dropped += len - sent;
+        p->rx_last_pos = end % UART_STREAM_RX_DMA_SIZE;
+    }
+    p->stats.rx_interrupts++;
+}
+
+/* starts the DMA with the next block of the transmit stream buffer, if any */
+static void uart_stream_tx_next(uart_stream_t *p, const uart_stream_hw_t *hw, BaseType_t *woken)
+{
+    size_t len = xStreamBufferReceiveFromISR(p->tx, p->tx_block, sizeof(p->tx_block), woken);
+    if (len == 0)
+    {
+        p->tx_busy = 0;
+        return;
+    }
+    dma_channel_disable(DMA0, hw->tx_channel);
+    dma_memory_address_config(DMA0, hw->tx_channel, (uint32_t)p->tx_block);
+    dma_transfer_number_config(DMA0, hw->tx_channel, len);
+    dma_channel_enable(DMA0, hw->tx_channel);
+    p->tx_busy = 1;
+    p->stats.tx_bytes += len;
+    p->stats.tx_interrupts++;
+}
+
+static void uart_stream_rx_dma_isr(uart_stream_port_t port)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    const uart_stream_hw_t *hw = &uart_stream_hw[port];
+    BaseType_t woken = pdFALSE;
+    UART_STREAM_ISR_ENTER();
+    /* half and full transfer: the DMA passed the middle or the end of the ring */
+    dma_interrupt_flag_clear(DMA0, hw->rx_channel, DMA_INT_FLAG_G);
+    uart_stream_rx_move(p, hw, &woken);
+    portYIELD_FROM_ISR(woken);
+    UART_STREAM_ISR_EXIT();
+}
+
+static void uart_stream_tx_dma_isr(uart_stream_port_t port)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    const uart_stream_hw_t *hw = &uart_stream_hw[port];
+    BaseType_t woken = pdFALSE;
+    UART_STREAM_ISR_ENTER();
+    if (dma_interrupt_flag_get(DMA0, hw->tx_channel, DMA_INT_FLAG_FTF) != RESET)
+    {
+        dma_interrupt_flag_clear(DMA0, hw->tx_channel, DMA_INT_FLAG_G);
+        p->tx_busy = 0;
+    }
+    /* also entered through NVIC_SetPendingIRQ() by a write to an idle port */
+    if (!p->tx_busy)
+    {
+        uart_stream_tx_next(p, hw, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+    UART_STREAM_ISR_EXIT();
+}
+
+static void uart_stream_usart_isr(uart_stream_port_t port)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    const uart_stream_hw_t *hw = &uart_stream_hw[port];
+    BaseType_t woken = pdFALSE;
+    UART_STREAM_ISR_ENTER();
+    int idle = usart_flag_get(hw->usart, USART_FLAG_IDLE) != RESET;
+    int overrun = usart_flag_get(hw->usart, USART_FLAG_ORERR) != RESET;
+    /* a break, a wrong baud rate or an unplugged adapter; the error interrupt
+     * fires again until they are cleared */
+    int framing = usart_flag_get(hw->usart, USART_FLAG_FERR) != RESET;
+    int noise = usart_flag_get(hw->usart, USART_FLAG_NERR) != RESET;
+    if (idle || overrun || framing || noise)
+    {
+        /* reading the status and then the data register clears all of them.
+         * The DMA already fetched the data, RBNE is not set. */
+        (void)usart_data_receive(hw->usart);
+    }
+    if (idle)
+    {
+        /* end of a frame: pass on the bytes before the half ring is full */
+        uart_stream_rx_move(p, hw, &woken);
+    }
+    if (overrun)
+    {
+        p->stats.hw_overruns++;
+    }
+    if (framing)
+    {
+        p->stats.framing_errors++;
+    }
+    if (noise)
+    {
+        p->stats.noise_errors++;
+    }
+    portYIELD_FROM_ISR(woken);
+    UART_STREAM_ISR_EXIT();
+}
+#else
+static void uart_stream_usart_isr(uart_stream_port_t port)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    const uart_stream_hw_t *hw = &uart_stream_hw[port];
+    BaseType_t woken = pdFALSE;
+    UART_STREAM_ISR_ENTER();
+    if (usart_flag_get(hw->usart, USART_FLAG_RBNE) != RESET)
+    {
+        if (usart_flag_get(hw->usart, USART_FLAG_ORERR) != RESET)
+        {
+            p->stats.hw_overruns++;
+        }
+        if (usart_flag_get(hw->usart, USART_FLAG_FERR) != RESET)
+        {
+            p->stats.framing_errors++;
+        }
+        if (usart_flag_get(hw->usart, USART_FLAG_NERR) != RESET)
+        {
+            p->stats.noise_errors++;
+        }
+        /* clears RBNE, ORERR, FERR and NERR */
+        uint8_t data = (uint8_t)usart_data_receive(hw->usart);
+        if (xStreamBufferSendFromISR(p->rx, &data, 1, &woken) == 1)
+        {
+            p->stats.rx_bytes++;
+        }
+        else
+        {
+            p->stats.rx_dropped++;
+        }
+        p->stats.rx_interrupts++;
+    }
+    if (usart_interrupt_flag_get(hw->usart, USART_INT_FLAG_TBE) != RESET)
+    {
+        uint8_t data;
+        if (xStreamBufferReceiveFromISR(p->tx, &data, 1, &woken) == 1)
+        {
+            usart_data_transmit(hw->usart, data);
+            p->stats.tx_bytes++;
+            p->stats.tx_interrupts++;
+        }
+        else
+        {
+            usart_interrupt_disable(hw->usart, USART_INT_TBE);
+            p->tx_busy = 0;
+        }
+    }
+    portYIELD_FROM_ISR(woken);
+    UART_STREAM_ISR_EXIT();
+}
+#endif
+
+/* starts the transmission if the port is idle. The data must already be in
+ * the stream buffer: an interrupt that ends the transmission before it
+ * would have sent it. */
+static void uart_stream_tx_kick(uart_stream_port_t port)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    if (p->tx_busy)
+    {
+        return;
+    }
+#if UART_STREAM_USE_DMA
+    NVIC_SetPendingIRQ(uart_stream_hw[port].tx_irqn);
+#else
+    taskENTER_CRITICAL();
+    p->tx_busy = 1;
+    usart_interrupt_enable(uart_stream_hw[port].usart, USART_INT_TBE);
+    taskEXIT_CRITICAL();
+#endif
+}
+
+void uart_stream_open(uart_stream_port_t port, size_t rx_trigger_level)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    const uart_stream_hw_t *hw = &uart_stream_hw[port];
+
+    configASSERT(p->rx == NULL);
+    configASSERT(rx_trigger_level <= UART_STREAM_RX_BUFFER_SIZE);
+    p->rx = xStreamBufferCreateStatic(UART_STREAM_RX_BUFFER_SIZE, rx_trigger_level, p->rx_storage,
+                                      &p->rx_buffer);
+    p->tx = xStreamBufferCreateStatic(UART_STREAM_TX_BUFFER_SIZE, 1, p->tx_storage, &p->tx_buffer);
+
+#if UART_STREAM_USE_DMA
+    dma_parameter_struct dma_init_struct;
+
+    rcu_periph_clock_enable(RCU_DMA0);
+    /* receive: circular into rx_ring */
+    dma_deinit(DMA0, hw->rx_channel);
+    dma_init_struct.direction = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.memory_addr = (uint32_t)p->rx_ring;
+    dma_init_struct.memory_inc = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+    dma_init_struct.number = UART_STREAM_RX_DMA_SIZE;
+    dma_init_struct.periph_addr = (uint32_t)&USART_DATA(hw->usart);
+    dma_init_struct.periph_inc = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+    dma_init_struct.priority = DMA_PRIORITY_ULTRA_HIGH;
+    dma_init(DMA0, hw->rx_channel, &dma_init_struct);
+    dma_circulation_enable(DMA0, hw->rx_channel);
+    dma_memory_to_memory_disable(DMA0, hw->rx_channel);
+    dma_interrupt_enable(DMA0, hw->rx_channel, DMA_INT_HTF | DMA_INT_FTF);
+    dma_channel_enable(DMA0, hw->rx_channel);
+
+    /* transmit: one block from tx_block at a time, started by uart_stream_tx_next() */
+    dma_deinit(DMA0, hw->tx_channel);
+    dma_init_struct.direction = DMA_MEMORY_TO_PERIPHERAL;
+    dma_init_struct.memory_addr = (uint32_t)p->tx_block;
+    dma_init_struct.number = 0;
+    dma_init_struct.priority = DMA_PRIORITY_HIGH;
+    dma_init(DMA0, hw->tx_channel, &dma_init_struct);
+    dma_circulation_disable(DMA0, hw->tx_channel);
+    dma_memory_to_memory_disable(DMA0, hw->tx_channel);
+    dma_interrupt_enable(DMA0, hw->tx_channel, DMA_INT_FTF);
+
+    /* the error interrupt reports overruns while the DMA is used */
+    usart_interrupt_enable(hw->usart, USART_INT_IDLE);
+    usart_interrupt_enable(hw->usart, USART_INT_ERR);
+    usart_dma_receive_config(hw->usart, USART_DENR_ENABLE);
+    usart_dma_transmit_config(hw->usart, USART_DENT_ENABLE);
+
+    NVIC_SetPriority(hw->rx_irqn, UART_STREAM_IRQ_PRIORITY);
+    NVIC_EnableIRQ(hw->rx_irqn);
+    NVIC_SetPriority(hw->tx_irqn, UART_STREAM_IRQ_PRIORITY);
+    NVIC_EnableIRQ(hw->tx_irqn);
+#else
+    usart_interrupt_enable(hw->usart, USART_INT_RBNE);
+#endif
+    NVIC_SetPriority(hw->usart_irqn, UART_STREAM_IRQ_PRIORITY);
+    NVIC_EnableIRQ(hw->usart_irqn);
+}
+
+size_t uart_stream_read(uart_stream_port_t port, void *data, size_t len, TickType_t timeout)
+{
+    return xStreamBufferReceive(uart_stream_ports[port].rx, data, len, timeout);
+}
+
+size_t uart_stream_write(uart_stream_port_t port, const void *data, size_t len, TickType_t timeout)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    const uint8_t *bytes = (const uint8_t *)data;
+    size_t sent = 0;
+    TimeOut_t time_out;
+
+    if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+    {
+        /* the interrupts only run once the scheduler started */
+        timeout = 0;
+    }
+    vTaskSetTimeOutState(&time_out);
+    for (;;)
+    {
+        sent += xStreamBufferSend(p->tx, bytes + sent, len - sent, 0);
+        /* before blocking, otherwise nothing frees the space */
+        uart_stream_tx_kick(port);
+        if (sent == len || timeout == 0 || xTaskCheckForTimeOut(&time_out, &timeout) != pdFALSE)
+        {
+            break;
+        }
+        /* wait until the interrupts took a part of the buffer, at most half
+         * of it, so that the wait ends while the transmission goes on */
+        size_t part = len - sent;
+        if (part > UART_STREAM_TX_BUFFER_SIZE / 2)
+        {
+            part = UART_STREAM_TX_BUFFER_SIZE / 2;
+        }
+        sent += xStreamBufferSend(p->tx, bytes + sent, part, timeout);
+    }
+    return sent;
+}
+
+BaseType_t uart_stream_set_rx_trigger(uart_stream_port_t port, size_t rx_trigger_level)
+{
+    return xStreamBufferSetTriggerLevel(uart_stream_ports[port].rx, rx_trigger_level);
+}
+
+int uart_stream_tx_idle(uart_stream_port_t port)
+{
+    uart_stream_t *p = &uart_stream_ports[port];
+    return !p->tx_busy && xStreamBufferIsEmpty(p->tx) == pdTRUE &&
+           usart_flag_get(uart_stream_hw[port].usart, USART_FLAG_TC) == SET;
+}
+
+void uart_stream_get_stats(uart_stream_port_t port, uart_stream_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = uart_stream_ports[port].stats;
+    taskEXIT_CRITICAL();
+}
+
+void uart_stream_print(void)
+{
+    for (uint32_t i = 0; i < UART_STREAM_PORTS; i++)
+    {
+        uart_stream_stats_t s;
+        if (uart_stream_ports[i].rx == NULL)
+        {
+            continue;
+        }
+        uart_stream_get_stats((uart_stream_port_t)i, &s);
+        printf("UART: \"%s\" rx %lu dropped %lu overruns %lu framing %lu noise %lu tx %lu rx irqs %lu tx irqs %lu\n",
+               uart_stream_hw[i].name, (unsigned long)s.rx_bytes, (unsigned long)s.rx_dropped,
+               (unsigned long)s.hw_overruns, (unsigned long)s.framing_errors, (unsigned long)s.noise_errors,
+               (unsigned long)s.tx_bytes, (unsigned long)s.rx_interrupts, (unsigned long)s.tx_interrupts);
+    }
+}
+
+#if UART_STREAM_USE_USART0
+void USART0_IRQHandler(void)
+{
+    uart_stream_usart_isr(UART_STREAM_USART0);
+}
+#if UART_STREAM_USE_DMA
+void DMA0_Channel4_IRQHandler(void)
+{
+    uart_stream_rx_dma_isr(UART_STREAM_USART0);
+}
+
+void DMA0_Channel3_IRQHandler(void)
+{
+    uart_stream_tx_dma_isr(UART_STREAM_USART0);
+}
+#endif
+#endif
+
+#if UART_STREAM_USE_USART1
+void USART1_IRQHandler(void)
+{
+    uart_stream_usart_isr(UART_STREAM_USART1);
+}
+#if UART_STREAM_USE_DMA
+void DMA0_Channel5_IRQHandler(void)
+{
+    uart_stream_rx_dma_isr(UART_STREAM_USART1);
+}
+
+void DMA0_Channel6_IRQHandler(void)
+{
+    uart_stream_tx_dma_isr(UART_STREAM_USART1);
+}
+#endif
+#endif
@@ -25,16 +25,35 @@ extern void vAssertCalled( void );
 
 #define configUSE_PREEMPTION                             1
 #define configUSE_TIME_SLICING                           0
+/* the Cortex-M3, M4 and M33 ports pick the next task with the CLZ instruction
+ * on a bitmap of the ready priorities, the others search the ready lists.
+ * -DconfigUSE_PORT_OPTIMISED_TASK_SELECTION=0 forces the generic search. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION          1
+#else
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION          0
+#endif
+#endif
 
 #define configUSE_IDLE_HOOK                              1
+#ifdef PIO_FREERTOS_TICKLESS
+/* tickless idle with WFI and deep-sleep, vPortSuppressTicksAndSleep() comes
+ * from lib/FreeRTOS/src/tickless instead of the port */
+#define configUSE_TICKLESS_IDLE                          2
+#endif
 #define configUSE_TICK_HOOK                              1
 #define configUSE_DAEMON_TASK_STARTUP_HOOK               0
 extern uint32_t SystemCoreClock;
 #define configCPU_CLOCK_HZ                               ( ( unsigned long ) SystemCoreClock )
 #define configTICK_RATE_HZ                               ( ( TickType_t ) 1000 )
 #define configMINIMAL_STACK_SIZE                         ( ( unsigned short ) 128 )
+#ifdef PIO_FREERTOS_HEAP_TLSF
+/* the TLSF heap (heap_tlsf.c) replaces heap_4.c, see the README */
+#define configTOTAL_HEAP_SIZE                            ( ( size_t ) ( 4096 ) )
+#else
 #define configTOTAL_HEAP_SIZE                            ( ( size_t ) ( 512 ) )
+#endif
 #define configMAX_TASK_NAME_LEN                          ( 10 )
 #define configUSE_TRACE_FACILITY                         1
 #define configUSE_16_BIT_TICKS                           0
@@ -46,7 +65,11 @@ extern uint32_t SystemCoreClock;
 #define configTIMER_QUEUE_LENGTH                         3
 #define configTIMER_TASK_PRIORITY                        ( configMAX_PRIORITIES - 1 )
 #define configUSE_COUNTING_SEMAPHORES                    1
+#ifdef PIO_FREERTOS_HEAP_TLSF
+#define configSUPPORT_DYNAMIC_ALLOCATION                 1
+#else
 #define configSUPPORT_DYNAMIC_ALLOCATION                 0
+#endif
 #define configSUPPORT_STATIC_ALLOCATION                  1
 #define configNUM_TX_DESCRIPTORS                         3
 #define configSTREAM_BUFFER_TRIGGER_LEVEL_TEST_MARGIN    2
@@ -64,12 +87,61 @@ extern uint32_t SystemCoreClock;
 /* runtime stats generation. can be turned off to save space. */
 #define configGENERATE_RUN_TIME_STATS	1
 #if configGENERATE_RUN_TIME_STATS == 1
-/* Constants related to the generation of run time stats.  Run time stats
-are gathered in the full demo, not the blinky demo. */
+/* The run time counter is the 64-bit cycle counter of runtime_stats.c.
+ * FreeRTOS itself gets it divided by 2^RUNTIME_STATS_KERNEL_SHIFT, the exact
+ * per task values are kept by the trace hooks below. */
 void vConfigureTimerForRunTimeStats( void );
 uint32_t ulGetRunTimeCounterValue( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vConfigureTimerForRunTimeStats()
 #define portGET_RUN_TIME_COUNTER_VALUE() ulGetRunTimeCounterValue()
+
+/* per task run time and context switch counts. only expanded inside tasks.c,
+ * where pxCurrentTCB is visible. */
+void runtime_stats_task_switched_out( uint32_t task_number );
+void runtime_stats_task_switched_in( uint32_t task_number );
+#define traceTASK_SWITCHED_OUT() runtime_stats_task_switched_out( pxCurrentTCB->uxTCBNumber )
+#define traceTASK_SWITCHED_IN()  do { runtime_stats_task_switched_in( pxCurrentTCB->uxTCBNumber ); STACK_MONITOR_SWITCHED_IN(); } while( 0 )
+#endif
+
+/* stack usage monitoring and overflow guard (lib/FreeRTOS/src/stack_monitor) */
+#ifdef PIO_FREERTOS_STACK_MONITOR
+/* the stack sizes are read from the task control blocks */
+#define configRECORD_STACK_HIGH_ADDRESS           1
+/* checks the end of the stack on every context switch, on all cores */
+#define configCHECK_FOR_STACK_OVERFLOW            2
+#if defined(__ARM_ARCH_8M_BASE__)
+/* the Cortex-M23 guard is an MPU region that follows the running task */
+void stack_monitor_task_switched_in( void * stack );
+#define STACK_MONITOR_SWITCHED_IN() stack_monitor_task_switched_in( pxCurrentTCB->pxStack )
+#endif
+#endif
+#ifndef STACK_MONITOR_SWITCHED_IN
+#define STACK_MONITOR_SWITCHED_IN()
+#endif
+
+/* UART driver on stream buffers (lib/FreeRTOS/src/uart_stream): its
+ * interrupts are accounted in the run time statistics */
+#ifdef PIO_FREERTOS_UART_STREAM
+void runtime_stats_isr_enter( void );
+void runtime_stats_isr_exit( void );
+#define UART_STREAM_ISR_ENTER() runtime_stats_isr_enter()
+#define UART_STREAM_ISR_EXIT()  runtime_stats_isr_exit()
+#endif
+
+/* mutex contention profiler (lib/FreeRTOS/src/mutex_profiler). only expanded
+ * inside queue.c, where the queue type and the mutex holder are visible. */
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+void mutex_profiler_blocking( void * mutex, void * holder );
+void mutex_profiler_taken( void * mutex );
+void mutex_profiler_take_failed( void * mutex );
+void mutex_profiler_given( void * mutex );
+void mutex_profiler_deleted( void * mutex );
+#define MUTEX_PROFILER_IS_MUTEX( pxQueue ) ( ( pxQueue )->uxQueueType == queueQUEUE_IS_MUTEX )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) do { if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_blocking( ( pxQueue ), ( pxQueue )->u.xSemaphore.xMutexHolder ); } while( 0 )
+#define traceQUEUE_RECEIVE( pxQueue )             do { if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_taken( pxQueue ); } while( 0 )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )      do { if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_take_failed( pxQueue ); } while( 0 )
+#define traceQUEUE_SEND( pxQueue )                do { if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_given( pxQueue ); } while( 0 )
+#define traceQUEUE_DELETE( pxQueue )              do { if( MUTEX_PROFILER_IS_MUTEX( pxQueue ) ) mutex_profiler_deleted( pxQueue ); } while( 0 )
 #endif
 
 /* Set the following definitions to 1 to include the API function, or zero
@@ -100,8 +172,6 @@ uint32_t ulGetRunTimeCounterValue( void );
 #define INCLUDE_xTaskAbortDelay                   1
 //#define INCLUDE_xTaskGetCurrentTaskHandle         1
 
-unsigned long ulGetRunTimeCounterValue( void ); /* Prototype of function that returns run time counter. */
-
 #define projCOVERAGE_TEST                       0
 
 #define configKERNEL_INTERRUPT_PRIORITY         255
@@ -2,6 +2,10 @@
 #include <task.h>
 
 #include <FreeRTOSConfig.h>
+#include <runtime_stats.h>
+#ifdef PIO_FREERTOS_STACK_MONITOR
+#include <stack_monitor.h>
+#endif
 
 #include <string.h>
 #include <stdarg.h>
@@ -36,6 +40,9 @@ void vApplicationStackOverflowHook( TaskHandle_t pxTask,
     /* Run time stack overflow checking is performed if
      * configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook
      * function is called if a stack overflow is detected. */
+#ifdef PIO_FREERTOS_STACK_MONITOR
+    stack_monitor_overflow( pcTaskName );
+#endif
     taskDISABLE_INTERRUPTS();
 
     for( ; ; )
@@ -65,6 +72,11 @@ void vApplicationIdleHook( void )
 
 void vApplicationTickHook( void )
 {
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            runtime_stats_tick();
+        }
+    #endif
     #if ( mainCREATE_FULL_DEMO_ONLY == 1 )
         {
             vFullDemoTickHookFunction();
@@ -151,51 +163,15 @@ void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
 
 /* runtime stats */
 #if configGENERATE_RUN_TIME_STATS == 1
-/* Addresses of registers in the Cortex-M debug hardware. */
-#define rtsDWT_CYCCNT 			( *( ( unsigned long * ) 0xE0001004 ) )
-#define rtsDWT_CONTROL 			( *( ( unsigned long * ) 0xE0001000 ) )
-#define rtsSCB_DEMCR 			( *( ( unsigned long * ) 0xE000EDFC ) )
-#define rtsTRCENA_BIT			( 0x01000000UL )
-#define rtsCOUNTER_ENABLE_BIT	( 0x01UL )
-
-/* Simple shift divide for scaling to avoid an overflow occurring too soon. */
-#define runtimeSHIFT_13				13
-#define runtimeOVERFLOW_BIT_13		( 1UL << ( 32UL - runtimeSHIFT_13 ) )
-static const uint32_t ulPrescaleBits = runtimeSHIFT_13;
-static const uint32_t ulOverflowBit = runtimeOVERFLOW_BIT_13;
-
-/*-----------------------------------------------------------*/
-
 void vConfigureTimerForRunTimeStats( void )
 {
-	/* Enable TRCENA. */
-	rtsSCB_DEMCR = rtsSCB_DEMCR | rtsTRCENA_BIT;
-
-	/* Reset counter. */
-	rtsDWT_CYCCNT = 0;
-
-	/* Enable counter. */
-	rtsDWT_CONTROL = rtsDWT_CONTROL | rtsCOUNTER_ENABLE_BIT;
+    runtime_stats_init();
 }
 /*-----------------------------------------------------------*/
 
 uint32_t ulGetRunTimeCounterValue( void )
 {
-static unsigned long ulLastCounterValue = 0UL, ulOverflows = 0;
-unsigned long ulValueNow;
-
-	ulValueNow = rtsDWT_CYCCNT;
-
-	/* Has the value overflowed since it was last read. */
-	if( ulValueNow < ulLastCounterValue )
-	{
-		ulOverflows += ulOverflowBit;
-	}
-	ulLastCounterValue = ulValueNow;
-
-	/* There is no prescale on the counter, so simulate in software. */
-	ulValueNow = ( ulValueNow >> ulPrescaleBits ) + ulOverflows;
-
-	return ulValueNow;
+    /* the kernel only keeps 32 bit, see runtime_stats.h for the exact values */
+    return ( uint32_t ) ( runtime_stats_now() >> RUNTIME_STATS_KERNEL_SHIFT );
 }
 #endif
\ No newline at end of file
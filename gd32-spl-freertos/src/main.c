@@ -5,6 +5,35 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <semphr.h>
+#include <runtime_stats.h>
+#ifdef PIO_FREERTOS_HEAP_TLSF
+#include <heap_tlsf.h>
+#endif
+#ifdef PIO_FREERTOS_STACK_MONITOR
+#include <stack_monitor.h>
+/* the recommended stack sizes are printed every this many reports */
+#define STACK_REPORT_INTERVAL 15
+#endif
+#ifdef PIO_FREERTOS_TICKLESS
+#include <tickless.h>
+#endif
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+#include <mutex_profiler.h>
+/* the mutex contention is printed every this many reports */
+#define MUTEX_REPORT_INTERVAL 5
+/* owners listed per mutex */
+#define MUTEX_REPORT_OWNERS 3
+#endif
+#ifdef PIO_FREERTOS_UART_STREAM
+#include <uart_stream.h>
+/* USART1 (TX = PA2, RX = PA3) sends to itself, connect PA2 to PA3 */
+#ifndef LOOPBACK_BAUDRATE
+#define LOOPBACK_BAUDRATE 1000000U
+#endif
+/* bytes per write and read, and the receive trigger level */
+#define LOOPBACK_BLOCK_SIZE 64
+#define LOOPBACK_TRIGGER_LEVEL 32
+#endif
 
 #define LEDPORT GPIOA
 #define LEDPIN GPIO_PIN_1
@@ -36,6 +65,8 @@ StaticSemaphore_t xPrintfMutexBuffer;
 void threadsafe_printf_init()
 {
     xPrintfSemaphore = xSemaphoreCreateMutexStatic(&xPrintfMutexBuffer);
+    /* names the mutex for the debugger and the mutex profiler */
+    vQueueAddToRegistry(xPrintfSemaphore, "printf");
 }
 
 void threadsafe_printf_lock() {  xSemaphoreTake(xPrintfSemaphore, portMAX_DELAY); }
@@ -59,55 +90,262 @@ void vBlinkyTask(void *pvParameters)
         vTaskDelay(pdMS_TO_TICKS(500));
         gpio_bit_reset(LEDPORT, LEDPIN);
         vTaskDelay(pdMS_TO_TICKS(500));
+#ifdef PIO_FREERTOS_HEAP_TLSF
+        /* some heap traffic with changing sizes for the heap statistics */
+        static uint32_t count;
+        size_t len = 16 + (count++ % 8) * 24;
+        char *msg = pvPortMalloc(len);
+        if (msg != NULL)
+        {
+            snprintf(msg, len, "Blinky %lu!\n", (unsigned long)count);
+            threadsafe_printf("%s", msg);
+            vPortFree(msg);
+        }
+#else
         threadsafe_printf("Blinky!\n");
+#endif
+    }
+}
+
+#ifdef PIO_FREERTOS_HEAP_TLSF
+/* prints the heap statistics, call with the printf lock taken */
+static void print_heap_stats(void)
+{
+    static heap_tlsf_class_stats_t classes[16];
+    static heap_tlsf_site_stats_t sites[8];
+    heap_tlsf_stats_t stats;
+    heap_tlsf_get_stats(&stats);
+    printf("Heap: free %lu (min %lu), used %lu in %lu blocks, largest free %lu, fragmentation %lu.%lu%%, failed %lu\n",
+           (unsigned long)stats.free_bytes, (unsigned long)stats.min_ever_free_bytes,
+           (unsigned long)stats.used_bytes, (unsigned long)stats.used_blocks,
+           (unsigned long)stats.largest_free_block, (unsigned long)stats.fragmentation_permille / 10UL,
+           (unsigned long)stats.fragmentation_permille % 10UL, (unsigned long)stats.failed_allocs);
+    size_t num_classes = heap_tlsf_get_class_stats(classes, 16);
+    for (size_t i = 0; i < num_classes; i++)
+    {
+        if (classes[i].allocs == 0 && classes[i].free_blocks == 0)
+            continue;
+        printf("Heap class >= %lu: free %lu blocks / %lu bytes, used %lu blocks (peak %lu), allocs %lu\n",
+               (unsigned long)classes[i].min_size, (unsigned long)classes[i].free_blocks,
+               (unsigned long)classes[i].free_bytes, (unsigned long)classes[i].used_blocks,
+               (unsigned long)classes[i].peak_used_blocks, (unsigned long)classes[i].allocs);
+    }
+    size_t num_sites = heap_tlsf_get_site_stats(sites, 8);
+    for (size_t i = 0; i < num_sites; i++)
+    {
+        printf("Heap site %p: used %lu bytes (peak %lu) in %lu blocks, allocs %lu\n", sites[i].site,
+               (unsigned long)sites[i].used_bytes, (unsigned long)sites[i].peak_used_bytes,
+               (unsigned long)sites[i].used_blocks, (unsigned long)sites[i].allocs);
+    }
+}
+#endif
+
+/* prints a fraction as percentage with 2 decimals, e.g. "12.34" */
+static void format_percent(char *buf, size_t len, uint64_t part, uint64_t total)
+{
+    unsigned long hundredths = total ? (unsigned long)(part * 10000ULL / total) : 0UL;
+    snprintf(buf, len, "%lu.%02lu", hundredths / 100UL, hundredths % 100UL);
+}
+
+#define MAX_REPORTED_TASKS 6
+
+#ifdef PIO_FREERTOS_UART_STREAM
+StaticTask_t xUartTxTaskBuffer;
+StackType_t xUartTxStack[STACK_SIZE];
+StaticTask_t xUartRxTaskBuffer;
+StackType_t xUartRxStack[STACK_SIZE];
+
+static volatile uint32_t loopback_received;
+static volatile uint32_t loopback_errors;
+
+void init_loopback_usart()
+{
+    rcu_periph_clock_enable(RCU_GPIOA);
+    rcu_periph_clock_enable(RCU_USART1);
+    gpio_init(GPIOA, GPIO_MODE_AF_PP, GPIO_OSPEED_50MHZ, GPIO_PIN_2);
+    gpio_init(GPIOA, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, GPIO_PIN_3);
+
+    usart_deinit(USART1);
+    usart_word_length_set(USART1, USART_WL_8BIT);
+    usart_stop_bit_set(USART1, USART_STB_1BIT);
+    usart_parity_config(USART1, USART_PM_NONE);
+    usart_baudrate_set(USART1, LOOPBACK_BAUDRATE);
+    usart_receive_config(USART1, USART_RECEIVE_ENABLE);
+    usart_transmit_config(USART1, USART_TRANSMIT_ENABLE);
+    usart_enable(USART1);
+    uart_stream_open(UART_STREAM_USART1, LOOPBACK_TRIGGER_LEVEL);
+}
+
+/* sends a counting byte pattern without pauses */
+void vUartTxTask(void *pvParameters)
+{
+    static uint8_t block[LOOPBACK_BLOCK_SIZE];
+    uint8_t next = 0;
+    for (;;)
+    {
+        for (uint32_t i = 0; i < LOOPBACK_BLOCK_SIZE; i++)
+            block[i] = next++;
+        uart_stream_write(UART_STREAM_USART1, block, LOOPBACK_BLOCK_SIZE, portMAX_DELAY);
+    }
+}
+
+/* checks that the pattern comes back complete and in order */
+void vUartRxTask(void *pvParameters)
+{
+    static uint8_t block[LOOPBACK_BLOCK_SIZE];
+    uint8_t expected = 0;
+    int synced = 0;
+    for (;;)
+    {
+        size_t len = uart_stream_read(UART_STREAM_USART1, block, LOOPBACK_BLOCK_SIZE, pdMS_TO_TICKS(100));
+        for (size_t i = 0; i < len; i++)
+        {
+            if (synced && block[i] != expected)
+                loopback_errors++;
+            expected = block[i] + 1;
+            synced = 1;
+        }
+        loopback_received += len;
     }
 }
+#endif
 
 void vTaskManagerTask(void *pvParameters)
 {
-    static TaskStatus_t pxTaskStatusArray[4];
-    unsigned long ulTotalRunTime, ulStatsAsPercentage;
-    UBaseType_t uxArraySize = sizeof(pxTaskStatusArray) / sizeof(pxTaskStatusArray[0]);
+    static TaskStatus_t pxTaskStatusArray[MAX_REPORTED_TASKS];
+    /* values at the previous report, indexed by task number */
+    static uint64_t last_run_cycles[RUNTIME_STATS_MAX_TASKS];
+    static runtime_stats_isr_t isr_stats[RUNTIME_STATS_MAX_ISRS];
+    uint64_t last_now = 0;
+    char interval_pct[12], total_pct[12];
+#if defined(PIO_FREERTOS_STACK_MONITOR) || defined(PIO_FREERTOS_MUTEX_PROFILER)
+    uint32_t reports = 0;
+#endif
+#ifdef PIO_FREERTOS_UART_STREAM
+    uint32_t last_received = 0;
+#endif
     for (;;)
     {
         vTaskDelay(pdMS_TO_TICKS(2000));
-        uxArraySize = uxTaskGetSystemState(pxTaskStatusArray,
-                                           uxArraySize,
-                                           &ulTotalRunTime);
-        printf("Total runtime: %lu ticks\n", ulTotalRunTime);
-        ulTotalRunTime /= 100UL;
+        UBaseType_t uxArraySize = uxTaskGetSystemState(pxTaskStatusArray,
+                                                       MAX_REPORTED_TASKS,
+                                                       NULL);
+        uint64_t now = runtime_stats_now();
+        uint64_t interval = now - last_now;
+        last_now = now;
+
+        threadsafe_printf_lock();
+        printf("Uptime: %lu s, interval: %lu us\n",
+               (unsigned long)(runtime_stats_cycles_to_us(now) / 1000000ULL),
+               (unsigned long)runtime_stats_cycles_to_us(interval));
         for (UBaseType_t x = 0; x < uxArraySize; x++)
         {
-            ulStatsAsPercentage =
-                  pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalRunTime;
-            if( ulStatsAsPercentage > 0UL )
-            {
-               threadsafe_printf( "Task: \"%s\", Prio: %lu, Runtime: %lu, CPU Usage: %lu%%\n",
-                                 pxTaskStatusArray[ x ].pcTaskName,
-                                 pxTaskStatusArray[ x ].uxCurrentPriority,
-                                 pxTaskStatusArray[ x ].ulRunTimeCounter,
-                                 ulStatsAsPercentage );
-            }
-            else
+            runtime_stats_task_t stats;
+            uint32_t number = pxTaskStatusArray[x].xTaskNumber;
+            uint32_t slot = number < RUNTIME_STATS_MAX_TASKS ? number : RUNTIME_STATS_MAX_TASKS - 1;
+            if (!runtime_stats_get_task(number, &stats))
             {
-               /* If the percentage is zero here then the task has
-               consumed less than 1% of the total run time. */
-               threadsafe_printf( "Task: \"%s\", Prio: %lu, Runtime: %lu, CPU Usage:<1%%\n",
-                                 pxTaskStatusArray[ x ].pcTaskName,
-                                 pxTaskStatusArray[ x ].uxCurrentPriority,
-                                 pxTaskStatusArray[ x ].ulRunTimeCounter);
+                stats.run_cycles = 0;
+                stats.switches = 0;
             }
+            uint64_t run = stats.run_cycles - last_run_cycles[slot];
+            last_run_cycles[slot] = stats.run_cycles;
+            format_percent(interval_pct, sizeof(interval_pct), run, interval);
+            format_percent(total_pct, sizeof(total_pct), stats.run_cycles, now);
+            printf("Task: \"%s\", Prio: %lu, Switches: %lu, Runtime: %lu us, CPU Usage: %s%% (since start: %s%%)",
+                   pxTaskStatusArray[x].pcTaskName,
+                   (unsigned long)pxTaskStatusArray[x].uxCurrentPriority,
+                   (unsigned long)stats.switches,
+                   (unsigned long)runtime_stats_cycles_to_us(run),
+                   interval_pct, total_pct);
+#ifdef PIO_FREERTOS_STACK_MONITOR
+            stack_monitor_usage_t stack;
+            if (stack_monitor_get_task(pxTaskStatusArray[x].xHandle, &stack))
+                printf(", Stack peak: %lu of %lu words", (unsigned long)stack.peak_words,
+                       (unsigned long)stack.size_words);
+#endif
+            printf("\n");
+        }
+        uint32_t num_isrs = runtime_stats_get_isrs(isr_stats, RUNTIME_STATS_MAX_ISRS);
+        for (uint32_t i = 0; i < num_isrs; i++)
+        {
+            format_percent(total_pct, sizeof(total_pct), isr_stats[i].cycles, now);
+            if (isr_stats[i].irqn < 0)
+                printf("ISR: other");
+            else /* same numbering as IRQn_Type, e.g. SysTick_IRQn = -1 */
+                printf("ISR: IRQn %ld", (long)isr_stats[i].irqn - 16L);
+            printf(", Count: %lu, Max: %lu cycles, CPU Usage since start: %s%%\n",
+                   (unsigned long)isr_stats[i].count, (unsigned long)isr_stats[i].max_cycles, total_pct);
         }
+#ifdef PIO_FREERTOS_HEAP_TLSF
+        print_heap_stats();
+#endif
+#ifdef PIO_FREERTOS_TICKLESS
+        tickless_print();
+#endif
+#ifdef PIO_FREERTOS_UART_STREAM
+        uint32_t received = loopback_received;
+        uint64_t interval_us = runtime_stats_cycles_to_us(interval);
+        printf("Loopback: %lu bytes/s, errors %lu\n",
+               (unsigned long)(interval_us ? (uint64_t)(received - last_received) * 1000000ULL / interval_us : 0),
+               (unsigned long)loopback_errors);
+        last_received = received;
+        uart_stream_print();
+#endif
+#ifdef PIO_FREERTOS_STACK_MONITOR
+        stack_monitor_usage_t isr_stack;
+        stack_monitor_get_isr(&isr_stack);
+        printf("Interrupt stack peak: %lu of %lu words\n", (unsigned long)isr_stack.peak_words,
+               (unsigned long)isr_stack.size_words);
+#endif
+#if defined(PIO_FREERTOS_STACK_MONITOR) || defined(PIO_FREERTOS_MUTEX_PROFILER)
+        reports++;
+#endif
+#ifdef PIO_FREERTOS_STACK_MONITOR
+        if (reports % STACK_REPORT_INTERVAL == 0)
+            stack_monitor_print();
+#endif
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+        if (reports % MUTEX_REPORT_INTERVAL == 0)
+            mutex_profiler_print(MUTEX_REPORT_OWNERS);
+#endif
+        threadsafe_printf_unlock();
     }
 }
 
+#ifdef PIO_FREERTOS_TICKLESS
+/* no deep-sleep before the last character of a printf() left the USART,
+ * the clock of the USART stops (see printf_over_x.c) */
+int tickless_deepsleep_allowed(void)
+{
+#ifdef PIO_FREERTOS_UART_STREAM
+    return uart_stream_tx_idle(UART_STREAM_USART0);
+#else
+    return usart_flag_get(USART0, USART_FLAG_TC) == SET;
+#endif
+}
+#endif
+
 int main(void)
 {
+#ifdef PIO_FREERTOS_STACK_MONITOR
+    /* before anything uses the interrupt stack or the C library heap */
+    stack_monitor_init();
+#endif
+#ifdef PIO_FREERTOS_MUTEX_PROFILER
+    mutex_profiler_init();
+#endif
     init_printf_transport();
     threadsafe_printf_init();
     init_led();
 
     printf("Starting FreeRTOS demo!\n");
+#ifdef PIO_FREERTOS_UART_STREAM
+    init_loopback_usart();
+#endif
+#ifdef PIO_FREERTOS_TICKLESS
+    tickless_init();
+#endif
 
     /* Create the task without using any dynamic memory allocation. */
     blinkyTaskHandle = xTaskCreateStatic(
@@ -128,6 +366,14 @@ int main(void)
         xPrintStack,      /* Array to use as the task's stack. */
         &xPrintTaskBuffer);    /* Variable to hold the task's data structure. */
 
+#ifdef PIO_FREERTOS_UART_STREAM
+    /* the receiver above the sender, both above the printing tasks */
+    xTaskCreateStatic(vUartRxTask, "UartRx", STACK_SIZE, (void *)0, tskIDLE_PRIORITY + 2,
+                      xUartRxStack, &xUartRxTaskBuffer);
+    xTaskCreateStatic(vUartTxTask, "UartTx", STACK_SIZE, (void *)0, tskIDLE_PRIORITY + 1,
+                      xUartTxStack, &xUartTxTaskBuffer);
+#endif
+
     /* Start the scheduler itself. */
     vTaskStartScheduler();
     /* never reached */
@@ -139,6 +385,8 @@ int main(void)
 extern void xPortSysTickHandler(void);
 void SysTick_Handler(void)
 {
+    /* account the tick interrupt separately from the tasks */
+    runtime_stats_isr_enter();
     /* Clear overflow flag */
     SysTick->CTRL;
     if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
@@ -146,5 +394,6 @@ void SysTick_Handler(void)
         /* Call tick handler */
         xPortSysTickHandler();
     }
+    runtime_stats_isr_exit();
 }
 #endif
\ No newline at end of file
@@ -1,5 +1,16 @@
 #include <gd32_include.h>
 #include <stdio.h>
+#ifdef PIO_FREERTOS_UART_STREAM
+#include <uart_stream.h>
+#endif
+#ifdef PRINTF_AUTOBAUD
+#include "usart_baud.h"
+#endif
+#ifdef PRINTF_FRAMED
+#include <frame_link.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#endif
 
 #ifndef USE_ALTERNATE_USART0_PINS
 /* settings for used USART (UASRT0) and pins, TX = PA9, RX = PA10 */
@@ -31,6 +42,29 @@
 #endif
 #endif 
 
+/* baud rate, e.g. -DPRINTF_BAUDRATE=921600U in the build_flags */
+#ifndef PRINTF_BAUDRATE
+#define PRINTF_BAUDRATE 115200U
+#endif
+/* with PRINTF_AUTOBAUD: how long to wait for the sync characters of the host
+ * before PRINTF_BAUDRATE is kept */
+#ifndef PRINTF_AUTOBAUD_TIMEOUT_MS
+#define PRINTF_AUTOBAUD_TIMEOUT_MS 2000U
+#endif
+
+#ifdef PRINTF_FRAMED
+#ifdef PRINTF_VIA_SEMIHOSTING
+#error "PRINTF_FRAMED needs the USART"
+#endif
+/* printf() in COBS frames on the text channel of an unreliable link
+ * (gd32-spl-usart/lib/frame_link), so that binary frames can share the
+ * USART. Decoded by scripts/frame_link.py monitor --no-ack. */
+static void usart_transport_write(const uint8_t *data, size_t len);
+static uint32_t frame_millis(void) { return (uint32_t)xTaskGetTickCount() * portTICK_PERIOD_MS; }
+static const frame_link_io_t printf_link_io = {usart_transport_write, frame_millis, NULL, NULL};
+static frame_link_t printf_link;
+#endif
+
 /* for printf() via semihosting */
 #ifdef PRINTF_VIA_SEMIHOSTING
 extern void initialise_monitor_handles(void);
@@ -60,15 +94,33 @@ void init_printf_transport() {
     gpio_init(UART_TX_RX_GPIO, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, UART_RX_GPIO_PIN);
 #endif
 
-    /* USART configure 115200 8N1 */
+    /* USART configure 8N1, 115200 baud by default */
     usart_deinit(USART);
     usart_word_length_set(USART, USART_WL_8BIT);
     usart_stop_bit_set(USART, USART_STB_1BIT);
     usart_parity_config(USART, USART_PM_NONE);
-    usart_baudrate_set(USART, 115200U);
+    usart_baudrate_set(USART, PRINTF_BAUDRATE);
     usart_receive_config(USART, USART_RECEIVE_ENABLE);
     usart_transmit_config(USART, USART_TRANSMIT_ENABLE);
     usart_enable(USART);
+#ifdef PRINTF_AUTOBAUD
+    /* take over the baud rate of the host, which may then raise it, see usart_baud.h */
+    uint32_t baud = usart_autobaud_measure(PRINTF_AUTOBAUD_TIMEOUT_MS);
+    if (baud != 0)
+    {
+        usart_disable(USART);
+        usart_baudrate_set(USART, baud);
+        usart_enable(USART);
+        usart_baud_negotiate(USART, baud);
+    }
+#endif
+#ifdef PIO_FREERTOS_UART_STREAM
+    /* printf() is sent by the DMA from a stream buffer */
+    uart_stream_open(UART_STREAM_USART0, 1);
+#endif
+#ifdef PRINTF_FRAMED
+    frame_link_init(&printf_link, &printf_link_io, 0);
+#endif
 #endif
 }
 
@@ -77,6 +129,25 @@ void init_printf_transport() {
 /* retarget the gcc's C library printf function to the USART */
 #include <errno.h>
 #include <sys/unistd.h> // STDOUT_FILENO, STDERR_FILENO
+static void usart_transport_write(const uint8_t *data, size_t len)
+{
+#ifdef PIO_FREERTOS_UART_STREAM
+    /* from an interrupt or with the interrupts masked (before the scheduler
+     * runs, in a fault handler) the stream buffer would not be emptied */
+    if (__get_IPSR() == 0U && __get_PRIMASK() == 0U && __get_BASEPRI() == 0U)
+    {
+        uart_stream_write(UART_STREAM_USART0, data, len, portMAX_DELAY);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < len; i++)
+    {
+        usart_data_transmit(USART, data[i]);
+        while (RESET == usart_flag_get(USART, USART_FLAG_TBE))
+            ;
+    }
+}
+
 int _write(int file, char *data, int len)
 {
     if ((file != STDOUT_FILENO) && (file != STDERR_FILENO))
@@ -85,12 +156,17 @@ int _write(int file, char *data, int len)
         return -1;
     }
 
-    for (int i = 0; i < len; i++)
+#ifdef PRINTF_FRAMED
+    /* one frame per FRAME_LINK_MTU bytes, the tasks share the link
+     * through threadsafe_printf() */
+    for (int i = 0; i < len; i += FRAME_LINK_MTU)
     {
-        usart_data_transmit(USART, (uint8_t)data[i]);
-        while (RESET == usart_flag_get(USART, USART_FLAG_TBE))
-            ;
+        size_t n = (size_t)(len - i) < FRAME_LINK_MTU ? (size_t)(len - i) : FRAME_LINK_MTU;
+        frame_link_send(&printf_link, FRAME_LINK_CHANNEL_TEXT, &data[i], n);
     }
+#else
+    usart_transport_write((const uint8_t *)data, (size_t)len);
+#endif
 
     // return # of bytes written - as best we can tell
     return len;
@@ -0,0 +1,238 @@
+#include <runtime_stats.h>
+#include <gd32_include.h>
+#include <string.h>
+
+static runtime_stats_task_t task_stats[RUNTIME_STATS_MAX_TASKS];
+static runtime_stats_isr_t isr_stats[RUNTIME_STATS_MAX_ISRS];
+
+/* the time slice of the task that is currently running */
+static uint32_t current_slot;
+static uint64_t slice_start;
+static uint64_t slice_isr_cycles; /* accounted interrupt time within the slice */
+
+/* accounted interrupts that are currently executing */
+static struct
+{
+    uint64_t start;
+    uint64_t nested_cycles;
+} isr_stack[RUNTIME_STATS_MAX_NESTING];
+static uint32_t isr_depth;
+
+#if !defined(GD32E23x)
+/* upper 32 bit of the DWT cycle counter */
+static uint32_t cyccnt_high;
+static uint32_t cyccnt_last;
+#else
+/* cycles at the last SysTick wrap, advanced by the tick hook */
+static uint64_t systick_base;
+static uint64_t systick_last;
+#endif
+
+static inline uint32_t irq_save(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void irq_restore(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+static inline uint32_t task_slot(uint32_t task_number)
+{
+    return task_number < RUNTIME_STATS_MAX_TASKS ? task_number : RUNTIME_STATS_MAX_TASKS - 1;
+}
+
+void runtime_stats_init(void)
+{
+#if !defined(GD32E23x)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cyccnt_high = 0;
+    cyccnt_last = 0;
+#else
+    /* the SysTick is started by the scheduler, until then the time is 0 */
+    systick_base = 0;
+    systick_last = 0;
+#endif
+    memset(task_stats, 0, sizeof(task_stats));
+    memset(isr_stats, 0, sizeof(isr_stats));
+    slice_start = 0;
+    slice_isr_cycles = 0;
+    isr_depth = 0;
+}
+
+/* must be called with interrupts disabled */
+static uint64_t now_locked(void)
+{
+#if !defined(GD32E23x)
+    uint32_t low = DWT->CYCCNT;
+    if (low < cyccnt_last)
+    {
+        cyccnt_high++;
+    }
+    cyccnt_last = low;
+    return ((uint64_t)cyccnt_high << 32) | low;
+#else
+    const uint32_t reload = SysTick->LOAD + 1U;
+    uint64_t base = systick_base;
+    uint32_t val = SysTick->VAL;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /* wrapped, but the SysTick interrupt did not run yet */
+        val = SysTick->VAL;
+        base += reload;
+    }
+    uint64_t value = base + (reload - 1U - val);
+    if (value < systick_last)
+    {
+        /* the SysTick interrupt is running but did not reach the tick hook yet */
+        value += reload;
+    }
+    systick_last = value;
+    return value;
+#endif
+}
+
+uint64_t runtime_stats_now(void)
+{
+    uint32_t primask = irq_save();
+    uint64_t value = now_locked();
+    irq_restore(primask);
+    return value;
+}
+
+uint64_t runtime_stats_cycles_to_us(uint64_t cycles)
+{
+    uint32_t cycles_per_us = SystemCoreClock / 1000000U;
+    return cycles / (cycles_per_us ? cycles_per_us : 1U);
+}
+
+void runtime_stats_tick(void)
+{
+    uint32_t primask = irq_save();
+#if defined(GD32E23x)
+    systick_base += SysTick->LOAD + 1U;
+#endif
+    /* at least one read per counter period to catch the 32-bit wrap */
+    (void)now_locked();
+    irq_restore(primask);
+}
+
+void runtime_stats_task_switched_out(uint32_t task_number)
+{
+    uint32_t primask = irq_save();
+    uint64_t now = now_locked();
+    task_stats[task_slot(task_number)].run_cycles += now - slice_start - slice_isr_cycles;
+    slice_start = now;
+    slice_isr_cycles = 0;
+    irq_restore(primask);
+}
+
+void runtime_stats_task_switched_in(uint32_t task_number)
+{
+    uint32_t slot = task_slot(task_number);
+    uint32_t primask = irq_save();
+    /* the kernel calls both hooks on every switch, even if it picks the same task again */
+    if (slot != current_slot || task_stats[slot].switches == 0)
+    {
+        task_stats[slot].switches++;
+        current_slot = slot;
+    }
+    irq_restore(primask);
+}
+
+void runtime_stats_isr_enter(void)
+{
+    uint32_t primask = irq_save();
+    if (isr_depth < RUNTIME_STATS_MAX_NESTING)
+    {
+        isr_stack[isr_depth].start = now_locked();
+        isr_stack[isr_depth].nested_cycles = 0;
+    }
+    isr_depth++;
+    irq_restore(primask);
+}
+
+static runtime_stats_isr_t *isr_slot(int32_t irqn)
+{
+    for (uint32_t i = 0; i < RUNTIME_STATS_MAX_ISRS - 1; i++)
+    {
+        if (isr_stats[i].count == 0)
+        {
+            isr_stats[i].irqn = irqn;
+            return &isr_stats[i];
+        }
+        if (isr_stats[i].irqn == irqn)
+        {
+            return &isr_stats[i];
+        }
+    }
+    isr_stats[RUNTIME_STATS_MAX_ISRS - 1].irqn = -1;
+    return &isr_stats[RUNTIME_STATS_MAX_ISRS - 1];
+}
+
+void runtime_stats_isr_exit(void)
+{
+    uint32_t primask = irq_save();
+    if (isr_depth == 0)
+    {
+        /* exit without enter */
+        irq_restore(primask);
+        return;
+    }
+    isr_depth--;
+    if (isr_depth < RUNTIME_STATS_MAX_NESTING)
+    {
+        uint64_t elapsed = now_locked() - isr_stack[isr_depth].start;
+        uint64_t own = elapsed - isr_stack[isr_depth].nested_cycles;
+        if (isr_depth > 0)
+        {
+            isr_stack[isr_depth - 1].nested_cycles += elapsed;
+        }
+        else
+        {
+            slice_isr_cycles += elapsed;
+        }
+        runtime_stats_isr_t *s = isr_slot((int32_t)__get_IPSR());
+        s->count++;
+        s->cycles += own;
+        if (own > s->max_cycles)
+        {
+            s->max_cycles = own > UINT32_MAX ? UINT32_MAX : (uint32_t)own;
+        }
+    }
+    irq_restore(primask);
+}
+
+int runtime_stats_get_task(uint32_t task_number, runtime_stats_task_t *stats)
+{
+    uint32_t slot = task_slot(task_number);
+    uint32_t primask = irq_save();
+    *stats = task_stats[slot];
+    if (slot == current_slot && stats->switches != 0)
+    {
+        /* add the running time slice, i.e. when called for the own task */
+        stats->run_cycles += now_locked() - slice_start - slice_isr_cycles;
+    }
+    irq_restore(primask);
+    return stats->switches != 0;
+}
+
+uint32_t runtime_stats_get_isrs(runtime_stats_isr_t *stats, uint32_t max)
+{
+    uint32_t n = 0;
+    uint32_t primask = irq_save();
+    for (uint32_t i = 0; i < RUNTIME_STATS_MAX_ISRS && n < max; i++)
+    {
+        if (isr_stats[i].count != 0)
+        {
+            stats[n++] = isr_stats[i];
+        }
+    }
+    irq_restore(primask);
+    return n;
+}
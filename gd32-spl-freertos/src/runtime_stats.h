@@ -0,0 +1,70 @@
+#ifndef RUNTIME_STATS_H_
+#define RUNTIME_STATS_H_
+
+#include <stdint.h>
+
+/* 64-bit run time accounting for FreeRTOS tasks and interrupts.
+ *
+ * Time is counted in CPU cycles by the DWT cycle counter, extended to 64 bit
+ * in software, so it does not wrap within the lifetime of the device. The
+ * Cortex-M23 (GD32E23x) has no DWT cycle counter, there the count is derived
+ * from the SysTick that drives the FreeRTOS tick.
+ *
+ * The hooks are wired up in FreeRTOSConfig.h (traceTASK_SWITCHED_IN/OUT and
+ * the run time stats macros) and in the tick hook. Interrupts are only
+ * accounted separately if their handler calls runtime_stats_isr_enter() at
+ * the beginning and runtime_stats_isr_exit() at the end, otherwise their
+ * time is counted for the interrupted task. */
+
+/* tasks are identified by their FreeRTOS task number (TaskStatus_t.xTaskNumber),
+ * tasks with a number >= RUNTIME_STATS_MAX_TASKS - 1 share the last slot. */
+#define RUNTIME_STATS_MAX_TASKS 8
+/* number of different interrupts that are accounted, others share the last slot */
+#define RUNTIME_STATS_MAX_ISRS 4
+/* maximum nesting depth of accounted interrupts */
+#define RUNTIME_STATS_MAX_NESTING 4
+/* the 32-bit counter FreeRTOS itself uses (vTaskGetRunTimeStats()) gets the
+ * cycle count divided by 2^RUNTIME_STATS_KERNEL_SHIFT */
+#define RUNTIME_STATS_KERNEL_SHIFT 8
+
+typedef struct
+{
+    uint64_t run_cycles; /* time in the running state, without accounted interrupts */
+    uint32_t switches;   /* number of times the task was switched in */
+} runtime_stats_task_t;
+
+typedef struct
+{
+    int32_t irqn;        /* exception number as in IPSR (IRQ number + 16), -1 for "other" */
+    uint32_t count;
+    uint64_t cycles;     /* without the time of nested accounted interrupts */
+    uint32_t max_cycles;
+} runtime_stats_isr_t;
+
+void runtime_stats_init(void);
+
+/* current time in CPU cycles since runtime_stats_init() */
+uint64_t runtime_stats_now(void);
+
+/* converts cycles to microseconds */
+uint64_t runtime_stats_cycles_to_us(uint64_t cycles);
+
+/* called from the tick hook, keeps the 64-bit extension of the counter up to date */
+void runtime_stats_tick(void);
+
+/* called by the kernel on every context switch */
+void runtime_stats_task_switched_out(uint32_t task_number);
+void runtime_stats_task_switched_in(uint32_t task_number);
+
+/* call at the start and the end of an interrupt handler */
+void runtime_stats_isr_enter(void);
+void runtime_stats_isr_exit(void);
+
+/* stats of one task, including the currently running time slice.
+ * Returns 0 if the task was never run. */
+int runtime_stats_get_task(uint32_t task_number, runtime_stats_task_t *stats);
+
+/* copies up to max interrupt stats, returns how many were copied */
+uint32_t runtime_stats_get_isrs(runtime_stats_isr_t *stats, uint32_t max);
+
+#endif /* RUNTIME_STATS_H_ */
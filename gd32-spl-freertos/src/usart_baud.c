@@ -0,0 +1,300 @@
+#ifdef PRINTF_AUTOBAUD
+#include <gd32_include.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "usart_baud.h"
+
+#if !(defined(GD32F10x) || defined(GD32F20x) || defined(GD32F30x) || defined(GD32F403) || defined(GD32E10X))
+#error "PRINTF_AUTOBAUD is not supported on this series"
+#endif
+
+#ifndef USE_ALTERNATE_USART0_PINS
+/* PA10 (USART0_RX) is also TIMER0_CH2 */
+#define AUTOBAUD_TIMER      TIMER0
+#define AUTOBAUD_TIMER_RCU  RCU_TIMER0
+#define AUTOBAUD_CHANNEL    TIMER_CH_2
+#define AUTOBAUD_FLAG       TIMER_FLAG_CH2
+#define AUTOBAUD_ON_APB2
+#else
+/* PB7 (USART0_RX remapped) is also TIMER3_CH1 */
+#define AUTOBAUD_TIMER      TIMER3
+#define AUTOBAUD_TIMER_RCU  RCU_TIMER3
+#define AUTOBAUD_CHANNEL    TIMER_CH_1
+#define AUTOBAUD_FLAG       TIMER_FLAG_CH1
+#endif
+
+/* bit times of the low pulse of the sync character 0x80 */
+#define AUTOBAUD_SYNC_BITS 8U
+#define AUTOBAUD_MIN_BAUD 1200U
+
+static const uint32_t standard_bauds[] = {1200U, 2400U, 4800U, 9600U, 19200U, 38400U, 57600U,
+                                          115200U, 230400U, 460800U, 500000U, 576000U, 921600U, 1000000U,
+                                          1500000U, 2000000U, 3000000U, 4000000U};
+
+static uint32_t cycles_per_ms;
+static uint32_t timer_overflows;
+
+static void cycles_start(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    cycles_per_ms = SystemCoreClock / 1000U;
+}
+
+static int expired(uint32_t start, uint32_t timeout_ms)
+{
+    return DWT->CYCCNT - start >= timeout_ms * cycles_per_ms;
+}
+
+uint32_t usart_baud_clock(uint32_t usart_periph)
+{
+    return rcu_clock_freq_get(usart_periph == USART0 ? CK_APB2 : CK_APB1);
+}
+
+uint32_t usart_baud_max(uint32_t usart_periph)
+{
+    return usart_baud_clock(usart_periph) / 16U;
+}
+
+void usart_baud_divider(uint32_t usart_periph, uint32_t baud, usart_baud_divider_t *result)
+{
+    uint32_t clock = usart_baud_clock(usart_periph);
+    result->requested = baud;
+    result->actual = 0;
+    result->error_ppm = INT32_MAX;
+    if (baud == 0)
+    {
+        return;
+    }
+    /* as usart_baudrate_set(): 12 bit integer and 4 bit fraction, rounded */
+    uint32_t div = (clock + baud / 2U) / baud;
+    if (div < 16U || div > 0xFFFFU)
+    {
+        return;
+    }
+    result->actual = clock / div;
+    result->error_ppm = (int32_t)(((int64_t)result->actual - baud) * 1000000 / baud);
+}
+
+/* timer clock: the APB clock, doubled if the APB is divided */
+static uint32_t timer_clock(void)
+{
+#ifdef AUTOBAUD_ON_APB2
+    uint32_t clock = rcu_clock_freq_get(CK_APB2);
+    return ((RCU_CFG0 & RCU_CFG0_APB2PSC) == RCU_APB2_CKAHB_DIV1) ? clock : 2U * clock;
+#else
+    uint32_t clock = rcu_clock_freq_get(CK_APB1);
+    return ((RCU_CFG0 & RCU_CFG0_APB1PSC) == RCU_APB1_CKAHB_DIV1) ? clock : 2U * clock;
+#endif
+}
+
+static void timer_start(void)
+{
+    timer_parameter_struct timer;
+
+    rcu_periph_clock_enable(AUTOBAUD_TIMER_RCU);
+    timer_deinit(AUTOBAUD_TIMER);
+    timer.prescaler = 0;
+    timer.alignedmode = TIMER_COUNTER_EDGE;
+    timer.counterdirection = TIMER_COUNTER_UP;
+    timer.period = 0xFFFFU;
+    timer.clockdivision = TIMER_CKDIV_DIV1;
+    timer.repetitioncounter = 0;
+    timer_init(AUTOBAUD_TIMER, &timer);
+    timer_overflows = 0;
+    timer_flag_clear(AUTOBAUD_TIMER, TIMER_FLAG_UP);
+    timer_enable(AUTOBAUD_TIMER);
+}
+
+/* time of the next edge in timer clocks, extended by the overflows */
+static int wait_edge(uint16_t polarity, uint32_t start, uint32_t timeout_ms, uint32_t *ticks)
+{
+    timer_ic_parameter_struct ic;
+
+    ic.icpolarity = polarity;
+    ic.icselection = TIMER_IC_SELECTION_DIRECTTI;
+    ic.icprescaler = TIMER_IC_PSC_DIV1;
+    ic.icfilter = 0;
+    timer_input_capture_config(AUTOBAUD_TIMER, AUTOBAUD_CHANNEL, &ic);
+    timer_flag_clear(AUTOBAUD_TIMER, AUTOBAUD_FLAG);
+    while (!expired(start, timeout_ms))
+    {
+        if (timer_flag_get(AUTOBAUD_TIMER, AUTOBAUD_FLAG))
+        {
+            uint32_t capture = timer_channel_capture_value_register_read(AUTOBAUD_TIMER, AUTOBAUD_CHANNEL);
+            uint32_t high = timer_overflows;
+            /* an overflow that is not counted yet came before a small capture */
+            if (timer_flag_get(AUTOBAUD_TIMER, TIMER_FLAG_UP) && capture < 0x8000U)
+            {
+                high++;
+            }
+            *ticks = (high << 16) | capture;
+            return 1;
+        }
+        if (timer_flag_get(AUTOBAUD_TIMER, TIMER_FLAG_UP))
+        {
+            timer_flag_clear(AUTOBAUD_TIMER, TIMER_FLAG_UP);
+            timer_overflows++;
+        }
+    }
+    return 0;
+}
+
+static uint32_t snap_to_standard(uint32_t baud)
+{
+    for (size_t i = 0; i < sizeof(standard_bauds) / sizeof(standard_bauds[0]); i++)
+    {
+        uint32_t diff = baud > standard_bauds[i] ? baud - standard_bauds[i] : standard_bauds[i] - baud;
+        if (diff <= standard_bauds[i] / 33U)
+        {
+            return standard_bauds[i];
+        }
+    }
+    return baud;
+}
+
+uint32_t usart_autobaud_measure(uint32_t timeout_ms)
+{
+    uint32_t clock = timer_clock();
+    uint32_t previous = 0;
+    uint32_t baud = 0;
+
+    cycles_start();
+    uint32_t start = DWT->CYCCNT;
+    timer_start();
+    while (1)
+    {
+        uint32_t fall, rise;
+        if (!wait_edge(TIMER_IC_POLARITY_FALLING, start, timeout_ms, &fall) ||
+            !wait_edge(TIMER_IC_POLARITY_RISING, start, timeout_ms, &rise))
+        {
+            baud = 0;
+            break;
+        }
+        uint32_t low = rise - fall;
+        if (low == 0)
+        {
+            continue;
+        }
+        baud = (uint32_t)(((uint64_t)clock * AUTOBAUD_SYNC_BITS + low / 2U) / low);
+        if (baud < AUTOBAUD_MIN_BAUD)
+        {
+            /* a break or noise */
+            previous = 0;
+            continue;
+        }
+        uint32_t diff = baud > previous ? baud - previous : previous - baud;
+        if (previous != 0 && diff <= previous / 33U)
+        {
+            baud = snap_to_standard((baud + previous) / 2U);
+            break;
+        }
+        previous = baud;
+    }
+    timer_deinit(AUTOBAUD_TIMER);
+    rcu_periph_clock_disable(AUTOBAUD_TIMER_RCU);
+    return baud;
+}
+
+static void write_text(uint32_t usart_periph, const char *text)
+{
+    while (*text)
+    {
+        usart_data_transmit(usart_periph, (uint8_t)*text++);
+        while (RESET == usart_flag_get(usart_periph, USART_FLAG_TBE))
+            ;
+    }
+    /* the rate may change right after this */
+    while (RESET == usart_flag_get(usart_periph, USART_FLAG_TC))
+        ;
+}
+
+/* a line of printable characters, the sync characters and \r are skipped */
+static int read_line(uint32_t usart_periph, char *line, size_t size, uint32_t timeout_ms)
+{
+    size_t len = 0;
+    uint32_t start = DWT->CYCCNT;
+
+    while (!expired(start, timeout_ms))
+    {
+        if (RESET != usart_flag_get(usart_periph, USART_FLAG_ORERR))
+        {
+            /* reading the data register clears the overrun */
+            usart_data_receive(usart_periph);
+        }
+        if (RESET == usart_flag_get(usart_periph, USART_FLAG_RBNE))
+        {
+            continue;
+        }
+        char c = (char)usart_data_receive(usart_periph);
+        if (c == '\n')
+        {
+            line[len] = '\0';
+            return 1;
+        }
+        if (c >= ' ' && c <= '~' && len < size - 1U)
+        {
+            line[len++] = c;
+        }
+    }
+    return 0;
+}
+
+uint32_t usart_baud_negotiate(uint32_t usart_periph, uint32_t baud)
+{
+    char line[32];
+    char reply[64];
+    uint32_t max = usart_baud_max(usart_periph);
+
+    cycles_start();
+    strcpy(line, "?");
+    do
+    {
+        if (strcmp(line, "?") == 0)
+        {
+            snprintf(reply, sizeof(reply), "AUTOBAUD %lu MAX %lu\r\n", (unsigned long)baud, (unsigned long)max);
+            write_text(usart_periph, reply);
+            continue;
+        }
+        if (strcmp(line, "GO") == 0)
+        {
+            break;
+        }
+        if (strncmp(line, "BAUD ", 5) != 0)
+        {
+            write_text(usart_periph, "ERR\r\n");
+            continue;
+        }
+        usart_baud_divider_t divider;
+        usart_baud_divider(usart_periph, strtoul(&line[5], NULL, 10), &divider);
+        if (divider.actual == 0 || divider.requested > max || labs(divider.error_ppm) > USART_BAUD_MAX_ERROR_PPM)
+        {
+            snprintf(reply, sizeof(reply), "ERR %lu %ld\r\n", (unsigned long)divider.requested,
+                     (long)divider.error_ppm);
+            write_text(usart_periph, reply);
+            continue;
+        }
+        snprintf(reply, sizeof(reply), "OK %lu %lu %ld\r\n", (unsigned long)divider.requested,
+                 (unsigned long)divider.actual, (long)divider.error_ppm);
+        write_text(usart_periph, reply);
+        usart_disable(usart_periph);
+        usart_baudrate_set(usart_periph, divider.requested);
+        usart_enable(usart_periph);
+        if (read_line(usart_periph, line, sizeof(line), USART_BAUD_WINDOW_MS) && strcmp(line, "SYNC") == 0)
+        {
+            baud = divider.requested;
+            snprintf(reply, sizeof(reply), "READY %lu\r\n", (unsigned long)baud);
+            write_text(usart_periph, reply);
+            break;
+        }
+        /* the host did not follow, back to the rate that worked */
+        usart_disable(usart_periph);
+        usart_baudrate_set(usart_periph, baud);
+        usart_enable(usart_periph);
+        snprintf(reply, sizeof(reply), "REVERT %lu\r\n", (unsigned long)baud);
+        write_text(usart_periph, reply);
+    } while (read_line(usart_periph, line, sizeof(line), USART_BAUD_WINDOW_MS));
+    return baud;
+}
+#endif
@@ -0,0 +1,69 @@
+#ifndef USART_BAUD_H_
+#define USART_BAUD_H_
+
+#include <stdint.h>
+
+/* Automatic baud rate detection and baud rate negotiation for the printf()
+ * USART (USART0), activated with -DPRINTF_AUTOBAUD.
+ *
+ * Detection: the host sends sync characters 0x80. On the line, the start bit
+ * and the seven 0 bits before the 1 in bit 7 are one low pulse of 8 bit
+ * times. A timer channel on the RX pin captures its falling and rising edge
+ * at the full timer clock (PA10 = TIMER0_CH2, with
+ * USE_ALTERNATE_USART0_PINS PB7 = TIMER3_CH1). Two pulses that agree within
+ * 3% give the baud rate, snapped to a standard rate within 3%. The edges are
+ * polled, which works up to about 2 Mbaud at 120 MHz.
+ *
+ * Negotiation: at the detected baud rate, the firmware sends
+ *   AUTOBAUD <baud> MAX <clock / 16>
+ * and accepts commands for USART_BAUD_WINDOW_MS after each line:
+ *   BAUD <rate>  the divider and its error are computed for the USART clock.
+ *                Above the maximum or USART_BAUD_MAX_ERROR_PPM off, the reply
+ *                is "ERR <rate> <error ppm>". Otherwise it is
+ *                "OK <rate> <actual rate> <error ppm>", then the USART
+ *                switches. The host switches too and sends "SYNC" within
+ *                USART_BAUD_WINDOW_MS, the reply is "READY <rate>" and the
+ *                negotiation ends. Without SYNC the old rate is restored
+ *                ("REVERT <rate>", which the host at the new rate may miss).
+ *   ?            repeats the AUTOBAUD line
+ *   GO           ends the negotiation
+ * scripts/autobaud.py is the host side.
+ *
+ * Both run with polling before the scheduler starts, timeouts are counted
+ * with the DWT cycle counter. Supported on the series with the timers and
+ * pins of the GD32F10x (GD32F10x, F20x, F30x, F403, E10x). */
+
+/* rates above this divider error are refused; sender and receiver together
+ * may be off by about 4% with 16x oversampling */
+#ifndef USART_BAUD_MAX_ERROR_PPM
+#define USART_BAUD_MAX_ERROR_PPM 20000
+#endif
+/* time for the next command and for the SYNC at a new rate */
+#ifndef USART_BAUD_WINDOW_MS
+#define USART_BAUD_WINDOW_MS 500U
+#endif
+
+typedef struct
+{
+    uint32_t requested;
+    uint32_t actual;   /* clock / divider */
+    int32_t error_ppm; /* (actual - requested) / requested */
+} usart_baud_divider_t;
+
+/* clock of the USART (APB2 for USART0, APB1 for the others) */
+uint32_t usart_baud_clock(uint32_t usart_periph);
+
+/* highest rate of the USART, with the smallest divider (16) */
+uint32_t usart_baud_max(uint32_t usart_periph);
+
+/* the divider usart_baudrate_set() programs for a rate and the resulting error */
+void usart_baud_divider(uint32_t usart_periph, uint32_t baud, usart_baud_divider_t *result);
+
+/* measures the sync characters on the RX pin of USART0, returns the baud
+ * rate or 0 if none arrived within timeout_ms (at most 30000) */
+uint32_t usart_autobaud_measure(uint32_t timeout_ms);
+
+/* the handshake above on a USART running at baud, returns the final rate */
+uint32_t usart_baud_negotiate(uint32_t usart_periph, uint32_t baud);
+
+#endif /* USART_BAUD_H_ */
@@ -1,4 +1,11 @@
 #include "gd32f30x.h"
+#ifdef TIMER_DEFERRED
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "defer.h"
+#include "printf_over_x.h"
+#endif
 
 #define LEDPORT     GPIOC
 #define LEDPIN      GPIO_PIN_13
@@ -44,7 +51,15 @@ uint32_t getTimerClkFrequency(uint32_t instance)
 }
 
 void config_timer(uint32_t timer_periph) {
+#ifdef TIMER_DEFERRED
+    /* FreeRTOS needs all priority bits as preemption priority, and a priority
+     * numerically >= configMAX_SYSCALL_INTERRUPT_PRIORITY for the interrupts
+     * that raise a deferred handler */
+    nvic_priority_group_set(NVIC_PRIGROUP_PRE4_SUB0);
+    nvic_irq_enable(TIMER2_IRQn, 6, 0);
+#else
     nvic_irq_enable(TIMER2_IRQn, 2, 2); // hardcode enable Timer2 interrupt in NVIC
+#endif
     /* enable clock input for Timer2 peirpheral */
     rcu_periph_clock_enable(RCU_AF);
     rcu_periph_clock_enable(RCU_TIMER2);
@@ -66,21 +81,80 @@ void config_timer(uint32_t timer_periph) {
     timer_enable(timer_periph);
 }
 
+uint8_t state = 0;
+
+#ifdef TIMER_DEFERRED
+/* the timer interrupt only clears its flag, the LED is toggled by this
+ * handler in the deferral task (bottom half) */
+defer_source_t timer_source;
+
+void timer_deferred(void *arg, uint32_t count)
+{
+    /* count > 1 if updates were merged, the LED state only depends on it being odd */
+    if (count & 1U) {
+        gpio_bit_write(LEDPORT, LEDPIN, state);
+        state ^= 1; // invert for next run
+    }
+}
+
+#define STACK_SIZE 256
+StaticTask_t xStatsTaskBuffer;
+StackType_t xStatsStack[STACK_SIZE];
+
+/* prints the ISR time, deferral latency and handler time */
+void vStatsTask(void *pvParameters)
+{
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(5000));
+        defer_print();
+    }
+}
+
+/* memory of the idle task, there is no dynamic allocation */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[configMINIMAL_STACK_SIZE];
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
 int main(void)
 {
     /* enable GPIO port */
     rcu_periph_clock_enable(LED_CLOCK);
     gpio_init(LEDPORT, GPIO_MODE_OUT_PP, GPIO_OSPEED_50MHZ, LEDPIN);
+#ifdef TIMER_DEFERRED
+    init_printf_transport();
+    printf("Starting deferred timer demo!\n");
+    defer_init();
+    defer_register(&timer_source, "TIMER2", timer_deferred, NULL);
+    xTaskCreateStatic(vStatsTask, "Stats", STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, xStatsStack, &xStatsTaskBuffer);
+    config_timer((uint32_t)TIMER2);
+    vTaskStartScheduler();
+#else
     config_timer((uint32_t)TIMER2);
+#endif
     while (1)
     {
         __WFI(); // wait for interrupt. not needed but debugging is easier :)
     }
 }
 
-uint8_t state = 0;
 void TIMER2_IRQHandler(void)
 {
+#ifdef TIMER_DEFERRED
+    BaseType_t woken = pdFALSE;
+    defer_isr_enter(&timer_source);
+    if (timer_interrupt_flag_get(TIMER2, TIMER_INT_FLAG_UP) != RESET) {
+        timer_interrupt_flag_clear(TIMER2, TIMER_INT_FLAG_UP);
+        defer_raise_from_isr(&timer_source, &woken);
+    }
+    defer_isr_exit(&timer_source, woken);
+#else
     // clear interrupt request to enable next run
     if (timer_interrupt_flag_get(TIMER2, TIMER_INT_FLAG_UP) != RESET) {
         timer_interrupt_flag_clear(TIMER2, TIMER_INT_FLAG_UP);
@@ -88,6 +162,7 @@ void TIMER2_IRQHandler(void)
         gpio_bit_write(LEDPORT, LEDPIN, state);
         state ^= 1; // invert for next run
     }
+#endif
 }
 
 void NMI_Handler(void) {}
@@ -116,11 +191,22 @@ void UsageFault_Handler(void)
         ;
 }
 
-void SVC_Handler(void)
+void DebugMon_Handler(void)
 {
 }
 
-void DebugMon_Handler(void)
+#ifdef TIMER_DEFERRED
+/* SVC_Handler and PendSV_Handler are the FreeRTOS port's (FreeRTOSConfig.h) */
+extern void xPortSysTickHandler(void);
+void SysTick_Handler(void)
+{
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+    {
+        xPortSysTickHandler();
+    }
+}
+#else
+void SVC_Handler(void)
 {
 }
 
@@ -131,3 +217,4 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
 }
+#endif
@@ -0,0 +1,304 @@
+#include <string.h>
+
+#include "frame_link.h"
+
+size_t frame_link_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t code_pos = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (src[i] == 0)
+        {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+            continue;
+        }
+        dst[out++] = src[i];
+        if (++code == 0xFF)
+        {
+            dst[code_pos] = code;
+            code_pos = out++;
+            code = 1;
+        }
+    }
+    dst[code_pos] = code;
+    return out;
+}
+
+size_t frame_link_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (in < len)
+    {
+        uint8_t code = src[in++];
+        if (code == 0 || in + code - 1U > len)
+        {
+            return (size_t)-1;
+        }
+        for (uint8_t i = 1; i < code; i++)
+        {
+            dst[out++] = src[in++];
+        }
+        /* a block shorter than 254 bytes stands for a 0, except at the end */
+        if (code != 0xFF && in < len)
+        {
+            dst[out++] = 0;
+        }
+    }
+    return out;
+}
+
+static void frame_link_transmit(frame_link_t *link, uint8_t flags, uint8_t seq, const uint8_t *data, size_t len)
+{
+    uint8_t raw[FRAME_LINK_RAW_MAX];
+    uint8_t encoded[FRAME_LINK_ENCODED_MAX];
+
+    if (link->rx_synced)
+    {
+        flags |= FRAME_LINK_FLAG_ACK;
+        link->ack_pending = 0;
+    }
+    raw[0] = flags;
+    raw[1] = seq;
+    raw[2] = link->rx_expected;
+    memcpy(&raw[FRAME_LINK_HEADER_SIZE], data, len);
+    len += FRAME_LINK_HEADER_SIZE;
+    uint32_t crc = frame_link_crc32(raw, len);
+    raw[len++] = (uint8_t)(crc >> 24);
+    raw[len++] = (uint8_t)(crc >> 16);
+    raw[len++] = (uint8_t)(crc >> 8);
+    raw[len++] = (uint8_t)crc;
+    size_t encoded_len = frame_link_cobs_encode(raw, len, encoded);
+    encoded[encoded_len++] = 0;
+    link->io->write(encoded, encoded_len);
+}
+
+void frame_link_init(frame_link_t *link, const frame_link_io_t *io, int reliable)
+{
+    memset(link, 0, sizeof(*link));
+    link->io = io;
+    link->reliable = reliable ? 1 : 0;
+    link->tx_sync = link->reliable;
+    /* the first frame_link_poll() sends the sync frame */
+    link->tx_timer = io->millis() - FRAME_LINK_RETRY_MS;
+}
+
+int frame_link_can_send(const frame_link_t *link)
+{
+    return !link->reliable || (!link->tx_sync && (uint8_t)(link->tx_next - link->tx_base) < FRAME_LINK_WINDOW);
+}
+
+int frame_link_send(frame_link_t *link, uint8_t channel, const void *data, size_t len)
+{
+    uint8_t flags = FRAME_LINK_FLAG_DATA | (uint8_t)(channel << 4);
+    if (len > FRAME_LINK_MTU)
+    {
+        return -1;
+    }
+    if (!link->reliable)
+    {
+        frame_link_transmit(link, flags, link->tx_next++, data, len);
+    }
+    else
+    {
+        if (!frame_link_can_send(link))
+        {
+            return 0;
+        }
+        frame_link_slot_t *slot = &link->slots[link->tx_next % FRAME_LINK_WINDOW];
+        slot->flags = flags | FRAME_LINK_FLAG_RELIABLE;
+        slot->len = (uint8_t)len;
+        memcpy(slot->data, data, len);
+        if (link->tx_next == link->tx_base)
+        {
+            link->tx_timer = link->io->millis();
+        }
+        frame_link_transmit(link, slot->flags, link->tx_next, slot->data, len);
+        link->tx_next++;
+    }
+    link->stats.frames_sent++;
+    link->stats.bytes_sent += len;
+    return 1;
+}
+
+/* Go-Back-N: everything from the oldest unacknowledged frame on */
+static void frame_link_retransmit(frame_link_t *link)
+{
+    for (uint8_t seq = link->tx_base; seq != link->tx_next; seq++)
+    {
+        frame_link_slot_t *slot = &link->slots[seq % FRAME_LINK_WINDOW];
+        frame_link_transmit(link, slot->flags, seq, slot->data, slot->len);
+        link->stats.retransmits++;
+    }
+    link->tx_dup_acks = 0;
+    link->tx_timer = link->io->millis();
+}
+
+/* dup_candidate: an ack only frame, the data frames of the other side
+ * repeat the same ack while nothing new arrived */
+static void frame_link_acked(frame_link_t *link, uint8_t ack, int dup_candidate)
+{
+    if (link->tx_sync)
+    {
+        /* the receiver took over the sequence number of the sync frame */
+        if (ack == link->tx_next)
+        {
+            link->tx_sync = 0;
+        }
+        return;
+    }
+    uint8_t acked = (uint8_t)(ack - link->tx_base);
+    if (acked == 0 && dup_candidate && link->tx_next != link->tx_base)
+    {
+        /* the receiver acknowledges every frame, the same ack again means
+         * a frame got lost and the ones after it were dropped. Repeating them
+         * now instead of after FRAME_LINK_RETRY_MS keeps the line busy. */
+        if (++link->tx_dup_acks == 2 && !link->tx_recovering)
+        {
+            link->tx_recovering = 1;
+            frame_link_retransmit(link);
+        }
+        return;
+    }
+    if (acked == 0 || acked > (uint8_t)(link->tx_next - link->tx_base))
+    {
+        /* nothing new or not a frame in flight */
+        return;
+    }
+    link->tx_base = ack;
+    link->tx_dup_acks = 0;
+    link->tx_recovering = 0;
+    link->tx_timer = link->io->millis();
+}
+
+static void frame_link_frame(frame_link_t *link, const uint8_t *raw, size_t len)
+{
+    if (len < FRAME_LINK_HEADER_SIZE + FRAME_LINK_CRC_SIZE || len > FRAME_LINK_RAW_MAX)
+    {
+        link->stats.framing_errors++;
+        return;
+    }
+    len -= FRAME_LINK_CRC_SIZE;
+    uint32_t crc = ((uint32_t)raw[len] << 24) | ((uint32_t)raw[len + 1] << 16) | ((uint32_t)raw[len + 2] << 8) |
+                   raw[len + 3];
+    if (crc != frame_link_crc32(raw, len))
+    {
+        link->stats.crc_errors++;
+        return;
+    }
+    uint8_t flags = raw[0];
+    uint8_t seq = raw[1];
+    if (flags & FRAME_LINK_FLAG_ACK)
+    {
+        frame_link_acked(link, raw[2], !(flags & (FRAME_LINK_FLAG_DATA | FRAME_LINK_FLAG_SYNC)));
+    }
+    if (flags & FRAME_LINK_FLAG_SYNC)
+    {
+        /* the sender (re)started, its next data frame has this number */
+        link->rx_synced = 1;
+        link->rx_expected = seq;
+        link->ack_pending = 1;
+        return;
+    }
+    if (!(flags & FRAME_LINK_FLAG_DATA))
+    {
+        return;
+    }
+    if (flags & FRAME_LINK_FLAG_RELIABLE)
+    {
+        if (!link->rx_synced)
+        {
+            /* the receiver (re)started */
+            link->rx_synced = 1;
+            link->rx_expected = seq;
+        }
+        /* acknowledged in any case, the ack of a duplicate may have been lost */
+        link->ack_pending = 1;
+        if (seq != link->rx_expected)
+        {
+            link->stats.duplicates++;
+            return;
+        }
+        link->rx_expected++;
+    }
+    else
+    {
+        if (link->rx_unreliable_synced)
+        {
+            link->stats.lost += (uint8_t)(seq - link->rx_unreliable_expected);
+        }
+        link->rx_unreliable_synced = 1;
+        link->rx_unreliable_expected = seq + 1U;
+    }
+    len -= FRAME_LINK_HEADER_SIZE;
+    link->stats.frames_received++;
+    link->stats.bytes_received += len;
+    if (link->io->receive != NULL)
+    {
+        link->io->receive(link->io->arg, flags >> 4, &raw[FRAME_LINK_HEADER_SIZE], len);
+    }
+}
+
+void frame_link_input(frame_link_t *link, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (data[i] != 0)
+        {
+            if (link->rx_len < sizeof(link->rx_buffer))
+            {
+                link->rx_buffer[link->rx_len++] = data[i];
+            }
+            else
+            {
+                link->rx_overflow = 1;
+            }
+            continue;
+        }
+        /* end of a frame, decoded in place: the output never overtakes the input */
+        if (link->rx_overflow)
+        {
+            link->stats.framing_errors++;
+        }
+        else if (link->rx_len > 0)
+        {
+            size_t raw_len = frame_link_cobs_decode(link->rx_buffer, link->rx_len, link->rx_buffer);
+            if (raw_len == (size_t)-1)
+            {
+                link->stats.framing_errors++;
+            }
+            else
+            {
+                frame_link_frame(link, link->rx_buffer, raw_len);
+            }
+        }
+        link->rx_len = 0;
+        link->rx_overflow = 0;
+    }
+}
+
+void frame_link_poll(frame_link_t *link)
+{
+    if (link->reliable && (link->tx_sync || link->tx_next != link->tx_base) &&
+        link->io->millis() - link->tx_timer >= FRAME_LINK_RETRY_MS)
+    {
+        if (link->tx_sync)
+        {
+            frame_link_transmit(link, FRAME_LINK_FLAG_RELIABLE | FRAME_LINK_FLAG_SYNC, link->tx_next, NULL, 0);
+            link->tx_timer = link->io->millis();
+        }
+        else
+        {
+            frame_link_retransmit(link);
+        }
+    }
+    if (link->ack_pending)
+    {
+        frame_link_transmit(link, 0, 0, NULL, 0);
+        link->stats.acks_sent++;
+    }
+}
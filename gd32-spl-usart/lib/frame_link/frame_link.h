@@ -0,0 +1,166 @@
+#ifndef FRAME_LINK_H_
+#define FRAME_LINK_H_
+
+/* Framing for binary data and text on one serial link.
+ *
+ * Every frame is COBS encoded and ends with a 0 byte, which appears nowhere
+ * else in the stream: after a lost or corrupted byte, the receiver drops one
+ * frame and continues with the next one. Before the encoding, a frame is
+ *   flags (1) | seq (1) | ack (1) | payload (0 .. FRAME_LINK_MTU) | CRC (4)
+ * flags: bit 0 reliable, bit 1 ack valid, bit 2 sync, bit 3 data, bits 4-7
+ * channel. The CRC is the CRC-32/MPEG-2 (polynomial 0x04C11DB7, initial
+ * value 0xFFFFFFFF, not reflected, big endian) of the bytes before it,
+ * computed by the CRC unit on the series that have one with a 32-bit data
+ * register (see frame_link_crc.c), otherwise in software.
+ *
+ * Unreliable links (reliable = 0) only send: every frame has a sequence
+ * number, the receiver counts the gaps as lost frames. This needs no receive
+ * path, e.g. for printf().
+ *
+ * Reliable links use Go-Back-N: up to FRAME_LINK_WINDOW frames are sent
+ * without waiting, the receiver accepts them in order only and returns the
+ * next expected sequence number in the ack field of its frames (an ack only
+ * frame if it has nothing to send). Frames that are not acknowledged within
+ * FRAME_LINK_RETRY_MS, or after two more ack only frames with the same ack,
+ * are sent again, from the oldest one on (data frames of the other side
+ * repeat an ack that did not move and do not count). The link stays saturated as long as the window
+ * holds more data than the line transfers in a round trip. After frame_link_init(), a sender repeats a frame with
+ * the sync flag and no data until it is acknowledged, it sets the expected
+ * sequence number of the receiver. A receiver that (re)started takes the
+ * number of the first frame, so a restart of either side is recovered.
+ *
+ * frame_link_t holds the state of one link. frame_link_input(),
+ * frame_link_poll() and frame_link_send() may all write frames and must not
+ * run at the same time. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* largest payload of a frame */
+#ifndef FRAME_LINK_MTU
+#define FRAME_LINK_MTU 64
+#endif
+/* frames in flight on a reliable link, at most 127 */
+#ifndef FRAME_LINK_WINDOW
+#define FRAME_LINK_WINDOW 8
+#endif
+/* time after which unacknowledged frames are sent again */
+#ifndef FRAME_LINK_RETRY_MS
+#define FRAME_LINK_RETRY_MS 100U
+#endif
+
+#define FRAME_LINK_HEADER_SIZE 3
+#define FRAME_LINK_CRC_SIZE 4
+#define FRAME_LINK_RAW_MAX (FRAME_LINK_HEADER_SIZE + FRAME_LINK_MTU + FRAME_LINK_CRC_SIZE)
+/* COBS adds one byte per 254 bytes and one at the start, plus the 0 at the end */
+#define FRAME_LINK_ENCODED_MAX (FRAME_LINK_RAW_MAX + FRAME_LINK_RAW_MAX / 254 + 2)
+
+#define FRAME_LINK_FLAG_RELIABLE 0x01U
+#define FRAME_LINK_FLAG_ACK 0x02U
+#define FRAME_LINK_FLAG_SYNC 0x04U
+#define FRAME_LINK_FLAG_DATA 0x08U
+
+/* channels used by the examples */
+#define FRAME_LINK_CHANNEL_TEXT 0
+#define FRAME_LINK_CHANNEL_TELEMETRY 1
+
+#if FRAME_LINK_WINDOW < 1 || FRAME_LINK_WINDOW > 127
+#error "FRAME_LINK_WINDOW must be between 1 and 127"
+#endif
+#if FRAME_LINK_MTU > 255
+#error "FRAME_LINK_MTU must not be larger than 255"
+#endif
+
+typedef struct
+{
+    /* sends the bytes of a frame, waits until they are sent or buffered */
+    void (*write)(const uint8_t *data, size_t len);
+    /* a millisecond counter */
+    uint32_t (*millis)(void);
+    /* called with the payload of every accepted data frame, may be NULL */
+    void (*receive)(void *arg, uint8_t channel, const uint8_t *data, size_t len);
+    void *arg;
+} frame_link_io_t;
+
+typedef struct
+{
+    uint32_t frames_sent;     /* data frames, without repetitions */
+    uint32_t bytes_sent;      /* their payload */
+    uint32_t retransmits;     /* data frames sent again */
+    uint32_t acks_sent;       /* ack only frames */
+    uint32_t frames_received; /* accepted data frames */
+    uint32_t bytes_received;  /* their payload */
+    uint32_t crc_errors;
+    uint32_t framing_errors;  /* invalid COBS, too short or too long */
+    uint32_t duplicates;      /* reliable frames out of order, dropped */
+    uint32_t lost;            /* gaps in the unreliable frames */
+} frame_link_stats_t;
+
+typedef struct
+{
+    uint8_t flags;
+    uint8_t len;
+    uint8_t data[FRAME_LINK_MTU];
+} frame_link_slot_t;
+
+typedef struct
+{
+    const frame_link_io_t *io;
+    uint8_t reliable;
+    /* sender */
+    uint8_t tx_base; /* oldest unacknowledged sequence number */
+    uint8_t tx_next;
+    uint8_t tx_sync; /* until the first ack arrived */
+    uint8_t tx_dup_acks;
+    uint8_t tx_recovering; /* repeated after duplicate acks */
+    uint32_t tx_timer;
+    frame_link_slot_t slots[FRAME_LINK_WINDOW];
+    /* receiver */
+    uint8_t rx_synced;
+    uint8_t rx_expected;
+    uint8_t rx_unreliable_synced;
+    uint8_t rx_unreliable_expected;
+    uint8_t ack_pending;
+    uint8_t rx_overflow;
+    size_t rx_len;
+    uint8_t rx_buffer[FRAME_LINK_ENCODED_MAX];
+    frame_link_stats_t stats;
+} frame_link_t;
+
+void frame_link_init(frame_link_t *link, const frame_link_io_t *io, int reliable);
+
+/* sends len bytes (at most FRAME_LINK_MTU) as one frame on a channel (0 ..
+ * 15). Returns 1 if it was sent, 0 if the window of a reliable link is
+ * full (call frame_link_input() / frame_link_poll() and try again) and -1
+ * if it is too long. */
+int frame_link_send(frame_link_t *link, uint8_t channel, const void *data, size_t len);
+
+/* 1 if frame_link_send() would not find the window full */
+int frame_link_can_send(const frame_link_t *link);
+
+/* processes received bytes, calls io->receive for accepted frames */
+void frame_link_input(frame_link_t *link, const uint8_t *data, size_t len);
+
+/* sends pending acks and repeats unacknowledged frames, call often */
+void frame_link_poll(frame_link_t *link);
+
+/* COBS encoding of len bytes into dst (at least len + len / 254 + 1 bytes,
+ * without the 0 at the end), returns the encoded length */
+size_t frame_link_cobs_encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/* decodes len COBS bytes (without the 0 at the end) into dst, returns the
+ * decoded length or (size_t)-1 if they are invalid */
+size_t frame_link_cobs_decode(const uint8_t *src, size_t len, uint8_t *dst);
+
+/* CRC-32/MPEG-2 of len bytes, see frame_link_crc.c */
+uint32_t frame_link_crc32(const uint8_t *data, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FRAME_LINK_H_ */
@@ -0,0 +1,78 @@
+#include <string.h>
+
+#include "frame_link.h"
+
+/* The CRC unit of these series computes the CRC-32/MPEG-2 over 32-bit words,
+ * most significant byte first, which is the same as over their bytes in
+ * that order. The words are fed with the CRC unit, the remaining bytes in
+ * software. Other series (GD32F3x0, F1x0, E23x: different API, E50x, L23x,
+ * W51x) and the host use the software only. */
+#if defined(GD32F10x)
+#include "gd32f10x.h"
+#elif defined(GD32F20x)
+#include "gd32f20x.h"
+#elif defined(GD32F30x)
+#include "gd32f30x.h"
+#elif defined(GD32F403)
+#include "gd32f403.h"
+#elif defined(GD32E10X)
+#include "gd32e10x.h"
+#elif defined(GD32F4xx)
+#include "gd32f4xx.h"
+#endif
+#if (defined(GD32F10x) || defined(GD32F20x) || defined(GD32F30x) || defined(GD32F403) || defined(GD32E10X) || \
+     defined(GD32F4xx)) && !defined(FRAME_LINK_SOFTWARE_CRC)
+#define FRAME_LINK_HARDWARE_CRC 1
+#endif
+
+/* one entry per 4 bits */
+static const uint32_t crc_table[16] = {
+    0x00000000U, 0x04C11DB7U, 0x09823B6EU, 0x0D4326D9U, 0x130476DCU, 0x17C56B6BU, 0x1A864DB2U, 0x1E475005U,
+    0x2608EDB8U, 0x22C9F00FU, 0x2F8AD6D6U, 0x2B4BCB61U, 0x350C9B64U, 0x31CD86D3U, 0x3C8EA00AU, 0x384FBDBDU,
+};
+
+static uint32_t crc_software(uint32_t crc, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= (uint32_t)data[i] << 24;
+        crc = (crc << 4) ^ crc_table[crc >> 28];
+        crc = (crc << 4) ^ crc_table[crc >> 28];
+    }
+    return crc;
+}
+
+#ifdef FRAME_LINK_HARDWARE_CRC
+uint32_t frame_link_crc32(const uint8_t *data, size_t len)
+{
+    static int clock_enabled;
+    uint32_t crc = 0xFFFFFFFFU;
+    size_t words = len / 4U;
+
+    if (words > 0)
+    {
+        /* the CRC unit is shared, e.g. by links in different tasks */
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        if (!clock_enabled)
+        {
+            rcu_periph_clock_enable(RCU_CRC);
+            clock_enabled = 1;
+        }
+        crc_data_register_reset();
+        for (size_t i = 0; i < words; i++)
+        {
+            uint32_t word;
+            memcpy(&word, &data[i * 4U], sizeof(word));
+            crc = crc_single_data_calculate(__REV(word));
+        }
+        __set_PRIMASK(primask);
+    }
+    return crc_software(crc, &data[words * 4U], len - words * 4U);
+}
+#else
+uint32_t frame_link_crc32(const uint8_t *data, size_t len)
+{
+    return crc_software(0xFFFFFFFFU, data, len);
+}
+#endif
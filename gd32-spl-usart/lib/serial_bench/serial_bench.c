@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "serial_bench.h"
+
+#define SERIAL_BENCH_LINE_MAX 32
+
+static uint8_t bench_buffer[SERIAL_BENCH_CHUNK_MAX];
+
+static void bench_reply(const serial_bench_io_t *io, const char *line)
+{
+    io->write((const uint8_t *)line, strlen(line));
+}
+
+/* echoes count bytes, ends early after the timeout */
+static void bench_echo(const serial_bench_io_t *io, uint32_t count)
+{
+    uint32_t last = io->millis();
+    while (count > 0 && io->millis() - last < SERIAL_BENCH_TIMEOUT_MS)
+    {
+        size_t len = io->read(bench_buffer, count < sizeof(bench_buffer) ? count : sizeof(bench_buffer));
+        if (len > 0)
+        {
+            io->write(bench_buffer, len);
+            count -= len;
+            last = io->millis();
+        }
+    }
+}
+
+/* receives count bytes of the pattern, ends early after the timeout.
+ *
+ * A byte that does not continue the pattern is an error. The byte after it
+ * tells why: if it continues the pattern from the wrong byte, bytes were
+ * lost before it and the pattern resyncs there. The lost bytes are missing
+ * from the received count, the wrong byte is not counted again. Otherwise
+ * the byte was corrupted and the pattern goes on as expected. */
+static void bench_sink(const serial_bench_io_t *io, uint32_t count)
+{
+    char reply[SERIAL_BENCH_LINE_MAX];
+    uint32_t received = 0;
+    uint32_t errors = 0;
+    uint8_t expected = 0;
+    uint8_t resync = 0;
+    int mismatch = 0;
+    uint32_t last = io->millis();
+    while (received < count && io->millis() - last < SERIAL_BENCH_TIMEOUT_MS)
+    {
+        uint32_t left = count - received;
+        size_t len = io->read(bench_buffer, left < sizeof(bench_buffer) ? left : sizeof(bench_buffer));
+        for (size_t i = 0; i < len; i++)
+        {
+            uint8_t byte = bench_buffer[i];
+            if (byte == expected)
+            {
+                mismatch = 0;
+                expected++;
+            }
+            else if (mismatch && byte == resync)
+            {
+                mismatch = 0;
+                errors--;
+                expected = (uint8_t)(byte + 1U);
+            }
+            else
+            {
+                mismatch = 1;
+                errors++;
+                resync = (uint8_t)(byte + 1U);
+                expected++;
+            }
+        }
+        if (len > 0)
+        {
+            received += len;
+            last = io->millis();
+        }
+    }
+    snprintf(reply, sizeof(reply), "DONE %lu %lu\n", (unsigned long)received, (unsigned long)errors);
+    bench_reply(io, reply);
+}
+
+/* sends count bytes of the pattern in writes of chunk bytes */
+static void bench_source(const serial_bench_io_t *io, uint32_t count, uint32_t chunk)
+{
+    uint32_t sent = 0;
+    if (chunk == 0 || chunk > sizeof(bench_buffer))
+    {
+        chunk = sizeof(bench_buffer);
+    }
+    while (sent < count)
+    {
+        uint32_t len = count - sent < chunk ? count - sent : chunk;
+        for (uint32_t i = 0; i < len; i++)
+        {
+            bench_buffer[i] = (uint8_t)(sent + i);
+        }
+        io->write(bench_buffer, len);
+        sent += len;
+    }
+}
+
+static void bench_command(const serial_bench_io_t *io, char *line)
+{
+    char *arg = line + 1;
+    uint32_t n = strtoul(arg, &arg, 10);
+    switch (line[0])
+    {
+    case '?':
+        bench_reply(io, "BENCH 1\n");
+        return;
+    case 'B':
+        if (n == 0)
+        {
+            break;
+        }
+        bench_reply(io, "OK\n");
+        io->set_baudrate(n);
+        return;
+    case 'E':
+        bench_reply(io, "OK\n");
+        bench_echo(io, n);
+        return;
+    case 'S':
+        bench_reply(io, "OK\n");
+        bench_sink(io, n);
+        return;
+    case 'O':
+        bench_reply(io, "OK\n");
+        bench_source(io, n, strtoul(arg, NULL, 10));
+        return;
+    default:
+        break;
+    }
+    bench_reply(io, "ERR\n");
+}
+
+void serial_bench_run(const serial_bench_io_t *io)
+{
+    char line[SERIAL_BENCH_LINE_MAX];
+    size_t len = 0;
+    for (;;)
+    {
+        uint8_t c;
+        if (io->read(&c, 1) == 0)
+        {
+            continue;
+        }
+        if (c == '\r')
+        {
+            continue;
+        }
+        if (c != '\n')
+        {
+            /* too long lines are cut */
+            if (len < sizeof(line) - 1)
+            {
+                line[len++] = (char)c;
+            }
+            continue;
+        }
+        line[len] = '\0';
+        if (len > 0)
+        {
+            bench_command(io, line);
+        }
+        len = 0;
+    }
+}
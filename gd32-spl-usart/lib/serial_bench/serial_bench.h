@@ -0,0 +1,59 @@
+#ifndef SERIAL_BENCH_H_
+#define SERIAL_BENCH_H_
+
+/* Target side of the serial benchmark, driven by scripts/serial_bench.py.
+ *
+ * The firmware waits for command lines (ended by '\n', '\r' is ignored) and
+ * answers each with a line:
+ *   "?"          -> "BENCH 1": identification
+ *   "B <baud>"   -> "OK", then the baud rate is changed
+ *   "E <n>"      -> "OK", then the next n bytes are echoed back
+ *   "S <n>"      -> "OK", then n bytes of the test pattern are received and
+ *                   checked -> "DONE <received> <errors>", the errors are
+ *                   wrong bytes, after lost ones the check resyncs
+ *   "O <n> <c>"  -> "OK", then n bytes of the test pattern are sent in
+ *                   writes of c bytes
+ * other lines   -> "ERR"
+ * The test pattern is a counting byte, starting at 0 with every command. If
+ * no byte arrives for SERIAL_BENCH_TIMEOUT_MS while echoing or receiving,
+ * the command ends early, so that a lost byte does not hang the benchmark.
+ *
+ * The I/O functions adapt it to a transport: the USART of this example, the
+ * Serial of an Arduino sketch, a pty on the host. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef SERIAL_BENCH_TIMEOUT_MS
+#define SERIAL_BENCH_TIMEOUT_MS 1000U
+#endif
+
+/* largest read and write, and the largest chunk of "O" */
+#ifndef SERIAL_BENCH_CHUNK_MAX
+#define SERIAL_BENCH_CHUNK_MAX 256U
+#endif
+
+typedef struct
+{
+    /* copies up to len received bytes, returns their number. Does not wait. */
+    size_t (*read)(uint8_t *data, size_t len);
+    /* sends len bytes, waits until they are sent or buffered */
+    void (*write)(const uint8_t *data, size_t len);
+    /* changes the baud rate after everything written so far was sent */
+    void (*set_baudrate)(uint32_t baudrate);
+    /* a millisecond counter */
+    uint32_t (*millis)(void);
+} serial_bench_io_t;
+
+/* runs the command loop, does not return */
+void serial_bench_run(const serial_bench_io_t *io);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SERIAL_BENCH_H_ */
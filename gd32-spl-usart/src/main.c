@@ -1,32 +1,13 @@
-#if defined(GD32F10x)
-#include "gd32f10x.h"
-#elif defined(GD32F1x0)
-#include "gd32f1x0.h"
-#elif defined (GD32F20x)
-#include "gd32f20x.h"
-#elif defined(GD32F3x0)
-#include "gd32f3x0.h"
-#elif defined(GD32F30x)
-#include "gd32f30x.h"
-#elif defined(GD32F4xx)
-#include "gd32f4xx.h"
-#elif defined(GD32F403)
-#include "gd32f403.h"
-#elif defined(GD32E10X)
-#include "gd32e10x.h"
-#elif defined(GD32E23x)
-#include "gd32e23x.h"
-#elif defined(GD32E50X)
-#include "gd32e50x.h"
-#elif defined(GD32L23x)
-#include "gd32l23x.h"
-#elif defined(GD32W51x)
-#include "gd32w51x.h"
-#else
-#error "Unknown chip series"
-#endif
+#include "gd32_include.h"
 #include <stdio.h>
 #include <string.h>
+#include "usart_rx.h"
+#ifdef SERIAL_BENCH
+#include "serial_bench.h"
+#endif
+#ifdef FRAME_LINK_DEMO
+#include "frame_link.h"
+#endif
 
 #ifndef USE_ALTERNATE_USART0_PINS
 /* settings for used USART (UASRT0) and pins, TX = PA9, RX = PA10 */
@@ -62,12 +43,121 @@
 #endif
 #endif 
 
+/* baud rate, e.g. -DUSART_BAUDRATE=921600U in the build_flags */
+#ifndef USART_BAUDRATE
+#define USART_BAUDRATE 115200U
+#endif
+
 /* enable this macro if you also want to test the receive path */
 /* on by default, comment this line if you want to transmit only*/
 #define ACTIVATE_RX_DEMO
 
 void systick_config(void);
 void delay_1ms(uint32_t count);
+uint32_t systick_millis(void);
+
+#if defined(SERIAL_BENCH) || defined(FRAME_LINK_DEMO)
+/* returns the bytes that were received, does not wait */
+static size_t usart_read(uint8_t *data, size_t len)
+{
+#ifdef USART_RX_DMA
+    return usart_rx_read(data, len);
+#else
+    if (len == 0 || RESET == usart_flag_get(USART, USART_FLAG_RBNE))
+        return 0;
+    data[0] = (uint8_t)usart_data_receive(USART);
+    return 1;
+#endif
+}
+#endif
+
+static void usart_write(const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        usart_data_transmit(USART, data[i]);
+        while (RESET == usart_flag_get(USART, USART_FLAG_TBE))
+            ;
+    }
+}
+
+#ifdef SERIAL_BENCH
+/* I/O of the serial benchmark (lib/serial_bench) on the USART */
+static void bench_set_baudrate(uint32_t baudrate)
+{
+    /* let the reply leave at the old baud rate */
+    while (RESET == usart_flag_get(USART, USART_FLAG_TC))
+        ;
+    usart_disable(USART);
+    usart_baudrate_set(USART, baudrate);
+    usart_enable(USART);
+}
+
+static const serial_bench_io_t bench_io = {usart_read, usart_write, bench_set_baudrate, systick_millis};
+#endif
+
+#ifdef FRAME_LINK_DEMO
+/* telemetry and printf() in frames on the USART (lib/frame_link), received
+ * by scripts/frame_link.py. A reliable link waits for the acks of the host. */
+#ifndef FRAME_LINK_DEMO_RELIABLE
+#define FRAME_LINK_DEMO_RELIABLE 1
+#endif
+
+/* one telemetry frame, little endian, the pattern bytes are counter + i */
+typedef struct
+{
+    uint32_t counter;
+    uint32_t millis;
+    uint32_t retransmits;
+    uint32_t crc_errors;
+    uint8_t pattern[32];
+} telemetry_t;
+
+static frame_link_t telemetry_link;
+static int link_active;
+static const frame_link_io_t link_io = {usart_write, systick_millis, NULL, NULL};
+
+static void link_pump(void)
+{
+    uint8_t data[64];
+    size_t len;
+    while ((len = usart_read(data, sizeof(data))) > 0)
+        frame_link_input(&telemetry_link, data, len);
+    frame_link_poll(&telemetry_link);
+}
+
+static void frame_link_demo(void)
+{
+    telemetry_t telemetry;
+    uint32_t last_report = systick_millis();
+
+    frame_link_init(&telemetry_link, &link_io, FRAME_LINK_DEMO_RELIABLE);
+    link_active = 1;
+    memset(&telemetry, 0, sizeof(telemetry));
+    while (1)
+    {
+        link_pump();
+        /* as many frames as the window allows, keeps the line busy */
+        if (frame_link_can_send(&telemetry_link))
+        {
+            telemetry.millis = systick_millis();
+            telemetry.retransmits = telemetry_link.stats.retransmits;
+            telemetry.crc_errors = telemetry_link.stats.crc_errors;
+            for (size_t i = 0; i < sizeof(telemetry.pattern); i++)
+                telemetry.pattern[i] = (uint8_t)(telemetry.counter + i);
+            frame_link_send(&telemetry_link, FRAME_LINK_CHANNEL_TELEMETRY, &telemetry, sizeof(telemetry));
+            telemetry.counter++;
+        }
+        if (systick_millis() - last_report >= 1000U)
+        {
+            last_report += 1000U;
+            printf("Link: sent %lu frames, %lu retransmits, %lu crc errors, %lu framing errors\n",
+                   (unsigned long)telemetry_link.stats.frames_sent, (unsigned long)telemetry_link.stats.retransmits,
+                   (unsigned long)telemetry_link.stats.crc_errors, (unsigned long)telemetry_link.stats.framing_errors);
+        }
+    }
+}
+#endif
 
 int main(void)
 {
@@ -94,19 +184,31 @@ int main(void)
     gpio_init(UART_TX_RX_GPIO, GPIO_MODE_IN_FLOATING, GPIO_OSPEED_50MHZ, UART_RX_GPIO_PIN);
 #endif
 
-    /* USART configure 115200 8N1 */
+    /* USART configure 8N1, 115200 baud by default */
     usart_deinit(USART);
     usart_word_length_set(USART, USART_WL_8BIT);
     usart_stop_bit_set(USART, USART_STB_1BIT);
     usart_parity_config(USART, USART_PM_NONE);
-    usart_baudrate_set(USART, 115200U);
+    usart_baudrate_set(USART, USART_BAUDRATE);
     usart_receive_config(USART, USART_RECEIVE_ENABLE);
     usart_transmit_config(USART, USART_TRANSMIT_ENABLE);
     usart_enable(USART);
+#if (defined(ACTIVATE_RX_DEMO) || defined(SERIAL_BENCH) || defined(FRAME_LINK_DEMO)) && defined(USART_RX_DMA)
+    /* receive with the DMA into a ring buffer, see usart_rx.h */
+    usart_rx_init();
+#endif
 
     /* short delay to make sure that the serial monitor was started before we print something */
     delay_1ms(1000);
 
+#ifdef SERIAL_BENCH
+    /* driven by scripts/serial_bench.py instead of the demo below */
+    serial_bench_run(&bench_io);
+#endif
+#ifdef FRAME_LINK_DEMO
+    frame_link_demo();
+#endif
+
     int i = 0;
     while (1)
     {
@@ -121,6 +223,14 @@ int main(void)
         // want that we can remove them and normalize to e.g. \n lineending.
         input[strcspn(input, "\r\n")] = '\0'; 
         printf("\nReceived %d bytes: %s\n", (int) strlen(input), input);
+#ifdef USART_RX_DMA
+        usart_rx_stats_t stats;
+        usart_rx_get_stats(&stats);
+        printf("RX total %lu bytes, %lu frames, lost %lu bytes, %lu overruns, %lu framing, %lu noise errors\n",
+               (unsigned long)stats.received, (unsigned long)stats.frames, (unsigned long)stats.lost,
+               (unsigned long)stats.hw_overruns, (unsigned long)stats.framing_errors,
+               (unsigned long)stats.noise_errors);
+#endif
 #else
         delay_1ms(500);
 #endif
@@ -131,6 +241,23 @@ int main(void)
 #include <errno.h>
 #include <sys/unistd.h> // STDOUT_FILENO, STDERR_FILENO
 
+#ifdef USART_RX_DMA
+int _read(int file, char *data, int len)
+{
+    if (file != STDIN_FILENO)
+    {
+        errno = EBADF;
+        return -1;
+    }
+    // wait for at least one byte, then return everything that is there.
+    // the DMA keeps receiving in the background, nothing is missed
+    // between the calls.
+    size_t count;
+    while ((count = usart_rx_read((uint8_t *)data, (size_t)len)) == 0)
+        ;
+    return (int)count;
+}
+#else
 int _read(int file, char *data, int len) {
     // wait until we get a receive interrupt
     while(RESET == usart_flag_get(USART, USART_FLAG_RBNE))
@@ -145,6 +272,7 @@ int _read(int file, char *data, int len) {
     // we might miss a few bytes though.
     return i;
 }
+#endif
 
 int _write(int file, char *data, int len)
 {
@@ -154,12 +282,20 @@ int _write(int file, char *data, int len)
         return -1;
     }
 
-    for (int i = 0; i < len; i++)
+#ifdef FRAME_LINK_DEMO
+    if (link_active)
     {
-        usart_data_transmit(USART, (uint8_t)data[i]);
-        while (RESET == usart_flag_get(USART, USART_FLAG_TBE))
-            ;
+        // text frames on their own channel, waits while the window is full
+        for (int i = 0; i < len; i += FRAME_LINK_MTU)
+        {
+            size_t n = (size_t)(len - i) < FRAME_LINK_MTU ? (size_t)(len - i) : FRAME_LINK_MTU;
+            while (frame_link_send(&telemetry_link, FRAME_LINK_CHANNEL_TEXT, &data[i], n) == 0)
+                link_pump();
+        }
+        return len;
     }
+#endif
+    usart_write((const uint8_t *)data, (size_t)len);
 
     // return # of bytes written - as best we can tell
     return len;
@@ -168,6 +304,7 @@ int _write(int file, char *data, int len)
 /* code for delaying using the SysTick */
 
 volatile static uint32_t delay;
+volatile static uint32_t millis;
 
 void systick_config(void)
 {
@@ -192,6 +329,11 @@ void delay_1ms(uint32_t count)
     }
 }
 
+uint32_t systick_millis(void)
+{
+    return millis;
+}
+
 void delay_decrement(void)
 {
     if (0U != delay)
@@ -202,5 +344,6 @@ void delay_decrement(void)
 
 void SysTick_Handler(void)
 {
+    millis++;
     delay_decrement();
 }
@@ -0,0 +1,195 @@
+#include "gd32_include.h"
+#include "usart_rx.h"
+
+#ifdef USART_RX_DMA
+
+#define RX_USART USART0
+#define RX_USART_IRQn USART0_IRQn
+#define RX_MASK (USART_RX_BUFFER_SIZE - 1U)
+
+#if defined(GD32F1x0) || defined(GD32F3x0) || defined(GD32E23x)
+/* one DMA controller, USART0_RX is on channel 2 without remapping */
+#define RX_DMA_CH DMA_CH2
+#define RX_DMA_IRQn DMA_Channel1_2_IRQn
+#define RX_DMA_IRQHandler DMA_Channel1_2_IRQHandler
+#define RX_DMA_ARGS RX_DMA_CH
+#define RX_RCU_DMA RCU_DMA
+#define RX_USART_DATA_ADDRESS ((uint32_t)&USART_RDATA(RX_USART))
+#else
+/* GD32F10x, F20x, F30x, F403, E10x: USART0_RX is on DMA0 channel 4 */
+#define RX_DMA_CH DMA_CH4
+#define RX_DMA_IRQn DMA0_Channel4_IRQn
+#define RX_DMA_IRQHandler DMA0_Channel4_IRQHandler
+#define RX_DMA_ARGS DMA0, RX_DMA_CH
+#define RX_RCU_DMA RCU_DMA0
+#define RX_USART_DATA_ADDRESS ((uint32_t)&USART_DATA(RX_USART))
+#endif
+
+static uint8_t rx_ring[USART_RX_BUFFER_SIZE];
+/* bytes written by the DMA and read by the application since the start.
+ * Only their difference matters, they may wrap around. */
+static volatile uint32_t rx_head;
+static uint32_t rx_tail;
+/* position of the DMA in the ring at the last update of rx_head */
+static volatile uint32_t rx_last_pos;
+static volatile usart_rx_stats_t rx_stats;
+
+/* adds the bytes written by the DMA since the last call to rx_head. Called
+ * from the interrupts, which come at least every half ring, and with the
+ * interrupts disabled. Only the position in the ring is known: if the DMA
+ * interrupt is blocked for a whole lap, the lap is not seen and its bytes
+ * are neither received nor counted as lost (see usart_rx.h). */
+static void rx_update_head(void)
+{
+    /* the counter counts down from the ring size, it is reloaded to the
+     * ring size after the last byte */
+    uint32_t pos = (USART_RX_BUFFER_SIZE - dma_transfer_number_get(RX_DMA_ARGS)) & RX_MASK;
+    uint32_t count = (pos - rx_last_pos) & RX_MASK;
+    rx_last_pos = pos;
+    rx_head = rx_head + count;
+    rx_stats.received = rx_stats.received + count;
+}
+
+void usart_rx_init(void)
+{
+    dma_parameter_struct dma_init_struct;
+
+    rcu_periph_clock_enable(RX_RCU_DMA);
+    dma_deinit(RX_DMA_ARGS);
+    dma_init_struct.direction = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.memory_addr = (uint32_t)rx_ring;
+    dma_init_struct.memory_inc = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+    dma_init_struct.number = USART_RX_BUFFER_SIZE;
+    dma_init_struct.periph_addr = RX_USART_DATA_ADDRESS;
+    dma_init_struct.periph_inc = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+    dma_init_struct.priority = DMA_PRIORITY_ULTRA_HIGH;
+    dma_init(RX_DMA_ARGS, &dma_init_struct);
+    dma_circulation_enable(RX_DMA_ARGS);
+    dma_memory_to_memory_disable(RX_DMA_ARGS);
+    dma_interrupt_enable(RX_DMA_ARGS, DMA_INT_HTF | DMA_INT_FTF);
+    dma_channel_enable(RX_DMA_ARGS);
+
+    /* the error interrupt reports overruns while the DMA is used */
+    usart_interrupt_enable(RX_USART, USART_INT_IDLE);
+    usart_interrupt_enable(RX_USART, USART_INT_ERR);
+    usart_dma_receive_config(RX_USART, USART_DENR_ENABLE);
+
+    NVIC_SetPriority(RX_DMA_IRQn, 1U);
+    NVIC_EnableIRQ(RX_DMA_IRQn);
+    NVIC_SetPriority(RX_USART_IRQn, 1U);
+    NVIC_EnableIRQ(RX_USART_IRQn);
+}
+
+size_t usart_rx_readable(void)
+{
+    __disable_irq();
+    rx_update_head();
+    uint32_t count = rx_head - rx_tail;
+    __enable_irq();
+    return count > USART_RX_BUFFER_SIZE ? USART_RX_BUFFER_SIZE / 2U : count;
+}
+
+size_t usart_rx_read(uint8_t *data, size_t len)
+{
+    __disable_irq();
+    rx_update_head();
+    uint32_t head = rx_head;
+    __enable_irq();
+
+    uint32_t count = head - rx_tail;
+    if (count > USART_RX_BUFFER_SIZE)
+    {
+        /* the DMA went around the ring before we read. The oldest half may
+         * be overwritten while we copy it, continue with the newest. */
+        uint32_t keep = USART_RX_BUFFER_SIZE / 2U;
+        rx_stats.lost = rx_stats.lost + (count - keep);
+        rx_tail = head - keep;
+        count = keep;
+    }
+    if (count > len)
+    {
+        count = len;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        data[i] = rx_ring[(rx_tail + i) & RX_MASK];
+    }
+    rx_tail += count;
+    return count;
+}
+
+void usart_rx_get_stats(usart_rx_stats_t *stats)
+{
+    __disable_irq();
+    rx_update_head();
+    stats->received = rx_stats.received;
+    stats->frames = rx_stats.frames;
+    stats->lost = rx_stats.lost;
+    stats->hw_overruns = rx_stats.hw_overruns;
+    stats->framing_errors = rx_stats.framing_errors;
+    stats->noise_errors = rx_stats.noise_errors;
+    __enable_irq();
+}
+
+void RX_DMA_IRQHandler(void)
+{
+    /* half and full transfer: the DMA passed the middle or the end of the ring */
+    dma_interrupt_flag_clear(RX_DMA_ARGS, DMA_INT_FLAG_G);
+    rx_update_head();
+}
+
+void USART0_IRQHandler(void)
+{
+    int idle = usart_flag_get(RX_USART, USART_FLAG_IDLE) != RESET;
+    int overrun = usart_flag_get(RX_USART, USART_FLAG_ORERR) != RESET;
+    /* a break, a wrong baud rate or an unplugged adapter; the error interrupt
+     * fires again until they are cleared */
+    int framing = usart_flag_get(RX_USART, USART_FLAG_FERR) != RESET;
+    int noise = usart_flag_get(RX_USART, USART_FLAG_NERR) != RESET;
+#if defined(GD32F1x0) || defined(GD32F3x0) || defined(GD32E23x)
+    if (idle)
+    {
+        usart_flag_clear(RX_USART, USART_FLAG_IDLE);
+    }
+    if (overrun)
+    {
+        usart_flag_clear(RX_USART, USART_FLAG_ORERR);
+    }
+    if (framing)
+    {
+        usart_flag_clear(RX_USART, USART_FLAG_FERR);
+    }
+    if (noise)
+    {
+        usart_flag_clear(RX_USART, USART_FLAG_NERR);
+    }
+#else
+    if (idle || overrun || framing || noise)
+    {
+        /* reading the status and then the data register clears all of them.
+         * The DMA already fetched the data, RBNE is not set. */
+        (void)usart_data_receive(RX_USART);
+    }
+#endif
+    if (idle)
+    {
+        rx_update_head();
+        rx_stats.frames = rx_stats.frames + 1U;
+    }
+    if (overrun)
+    {
+        rx_stats.hw_overruns = rx_stats.hw_overruns + 1U;
+    }
+    if (framing)
+    {
+        rx_stats.framing_errors = rx_stats.framing_errors + 1U;
+    }
+    if (noise)
+    {
+        rx_stats.noise_errors = rx_stats.noise_errors + 1U;
+    }
+}
+
+#endif /* USART_RX_DMA */
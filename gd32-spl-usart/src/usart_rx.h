@@ -0,0 +1,66 @@
+#ifndef USART_RX_H_
+#define USART_RX_H_
+
+/* Receive engine for USART0: the DMA writes every received byte into a ring
+ * buffer in circular mode, the CPU is not involved per byte. The write
+ * position is taken from the remaining transfer count of the DMA channel.
+ * The half and full transfer interrupts of the DMA keep track of the laps
+ * around the ring, the idle line interrupt of the USART marks the end of a
+ * frame (a pause of one character time after the last byte).
+ *
+ * If the application reads slower than the data arrives, the DMA overwrites
+ * the oldest data. This is detected on the next read: the read position is
+ * moved to the newest half of the ring and the skipped bytes are counted as
+ * lost. Overruns of the USART itself (the DMA did not fetch a byte in time)
+ * are counted separately, as are framing and noise errors (a break, a wrong
+ * baud rate or an unplugged adapter), which the error interrupt clears.
+ *
+ * The lost bytes are only detected within one lap: the half and full
+ * transfer interrupts must not be blocked for longer than the ring takes to
+ * fill, otherwise a whole lap goes unnoticed.
+ *
+ * Supported on the series with the DMA of the GD32F10x (GD32F10x, F20x,
+ * F30x, F403, E10x: DMA0 channel 4) and of the GD32F3x0 (GD32F1x0, F3x0,
+ * E23x: DMA channel 2), where USART_RX_DMA is defined. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(GD32F10x) || defined(GD32F20x) || defined(GD32F30x) || defined(GD32F403) || defined(GD32E10X) || \
+    defined(GD32F1x0) || defined(GD32F3x0) || defined(GD32E23x)
+#define USART_RX_DMA 1
+#endif
+
+/* size of the ring buffer in bytes, a power of two. 512 bytes hold 5.5 ms
+ * of data at 921600 baud. */
+#ifndef USART_RX_BUFFER_SIZE
+#define USART_RX_BUFFER_SIZE 512
+#endif
+
+#if (USART_RX_BUFFER_SIZE & (USART_RX_BUFFER_SIZE - 1)) != 0
+#error "USART_RX_BUFFER_SIZE must be a power of two"
+#endif
+
+typedef struct
+{
+    uint32_t received;    /* bytes written by the DMA */
+    uint32_t frames;      /* idle line events, i.e. ends of a frame */
+    uint32_t lost;        /* bytes overwritten before they were read */
+    uint32_t hw_overruns; /* overrun errors of the USART */
+    uint32_t framing_errors;
+    uint32_t noise_errors;
+} usart_rx_stats_t;
+
+/* starts the reception. Call after the USART was configured. */
+void usart_rx_init(void);
+
+/* number of bytes that can be read without waiting */
+size_t usart_rx_readable(void);
+
+/* copies up to len received bytes to data, returns their number. Does not
+ * wait, returns 0 if nothing was received. */
+size_t usart_rx_read(uint8_t *data, size_t len);
+
+void usart_rx_get_stats(usart_rx_stats_t *stats);
+
+#endif /* USART_RX_H_ */
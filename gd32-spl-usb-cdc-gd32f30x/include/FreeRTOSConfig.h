@@ -0,0 +1,58 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+* Application specific definitions, only used by the
+* genericGD32F303CC_deferred environment.
+*
+* See https://www.freertos.org/a00110.html
+*----------------------------------------------------------*/
+
+/* redirect FreeRTOS handler functions to *directly* be the ISR handler functions */
+#define xPortPendSVHandler PendSV_Handler
+#define vPortSVCHandler    SVC_Handler
+
+#define configASSERT( x )    if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ; ; ); }
+
+#define configUSE_PREEMPTION                             1
+#define configUSE_TIME_SLICING                           0
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION          0
+
+#define configUSE_IDLE_HOOK                              0
+#define configUSE_TICK_HOOK                              0
+extern uint32_t SystemCoreClock;
+#define configCPU_CLOCK_HZ                               ( ( unsigned long ) SystemCoreClock )
+#define configTICK_RATE_HZ                               ( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE                         ( ( unsigned short ) 128 )
+#define configTOTAL_HEAP_SIZE                            ( ( size_t ) ( 512 ) )
+#define configMAX_TASK_NAME_LEN                          ( 10 )
+#define configUSE_TRACE_FACILITY                         0
+#define configUSE_16_BIT_TICKS                           0
+#define configIDLE_SHOULD_YIELD                          1
+#define configUSE_CO_ROUTINES                            0
+
+#define configMAX_PRIORITIES                             ( 5 )
+#define configUSE_COUNTING_SEMAPHORES                    0
+#define configSUPPORT_DYNAMIC_ALLOCATION                 0
+#define configSUPPORT_STATIC_ALLOCATION                  1
+#define configUSE_MUTEXES                                0
+#define configUSE_TIMERS                                 0
+#define configUSE_MALLOC_FAILED_HOOK                     0
+#define configCHECK_FOR_STACK_OVERFLOW                   0
+
+/* don't use trust zone, MPU */
+#define configENABLE_TRUSTZONE 0
+#define configENABLE_MPU 0
+#define configENABLE_FPU 1
+
+#define INCLUDE_vTaskDelay                        1
+#define INCLUDE_xTaskGetSchedulerState            1
+
+#define configKERNEL_INTERRUPT_PRIORITY         255
+
+/* interrupts that call FreeRTOS functions (the deferred ones) must have a
+ * priority of 5 or lower (numerically >= 5), with the 4 priority bits of the
+ * GD32 */
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY    ( 5 << 4 )
+
+#endif /* FREERTOS_CONFIG_H */
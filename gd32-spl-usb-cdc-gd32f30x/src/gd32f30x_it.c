@@ -34,6 +34,13 @@ OF SUCH DAMAGE.
 
 #include "gd32f30x_it.h"
 #include "usbd_lld_int.h"
+#ifdef USB_DEFERRED
+#include "FreeRTOS.h"
+#include "task.h"
+#include "defer.h"
+
+extern defer_source_t usb_source;
+#endif
 
 /*!
     \brief      this function handles NMI exception
@@ -93,6 +100,7 @@ void UsageFault_Handler(void)
     while (1);
 }
 
+#ifndef USB_DEFERRED
 /*!
     \brief      this function handles SVC exception
     \param[in]  none
@@ -102,6 +110,7 @@ void UsageFault_Handler(void)
 void SVC_Handler(void)
 {
 }
+#endif /* USB_DEFERRED */
 
 /*!
     \brief      this function handles DebugMon exception
@@ -113,6 +122,7 @@ void DebugMon_Handler(void)
 {
 }
 
+#ifndef USB_DEFERRED
 /*!
     \brief      this function handles PendSV exception
     \param[in]  none
@@ -122,6 +132,9 @@ void DebugMon_Handler(void)
 void PendSV_Handler(void)
 {
 }
+#else
+/* SVC_Handler and PendSV_Handler are the FreeRTOS port's (FreeRTOSConfig.h) */
+#endif /* USB_DEFERRED */
 
 /*!
     \brief      this function handles USBD interrupt
@@ -131,13 +144,30 @@ void PendSV_Handler(void)
 */
 void USBD_LP_CAN0_RX0_IRQHandler (void)
 {
+#ifdef USB_DEFERRED
+    /* mask the (level triggered) interrupt until the deferred handler ran */
+    BaseType_t woken = pdFALSE;
+    defer_isr_enter(&usb_source);
+    NVIC_DisableIRQ(USBD_LP_CAN0_RX0_IRQn);
+    defer_raise_from_isr(&usb_source, &woken);
+    defer_isr_exit(&usb_source, woken);
+#else
     usbd_isr();
+#endif
 }
 
 #include "systick.h"
+#ifdef USB_DEFERRED
+extern void xPortSysTickHandler(void);
+#endif
 void SysTick_Handler(void)
 {
     delay_decrement();
+#ifdef USB_DEFERRED
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
+        xPortSysTickHandler();
+    }
+#endif
 }
 
 #ifdef USBD_LOWPWR_MODE_ENABLE
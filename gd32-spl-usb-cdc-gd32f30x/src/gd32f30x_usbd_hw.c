@@ -83,11 +83,21 @@ void gpio_config(void)
 */
 void nvic_config(void)
 {
+#ifdef USB_DEFERRED
+    /* FreeRTOS needs all priority bits as preemption priority, and a priority
+       numerically >= configMAX_SYSCALL_INTERRUPT_PRIORITY for the interrupts
+       that raise a deferred handler */
+    nvic_priority_group_set(NVIC_PRIGROUP_PRE4_SUB0);
+
+    /* enable the USB low priority interrupt */
+    nvic_irq_enable((uint8_t)USBD_LP_CAN0_RX0_IRQn, 6U, 0U);
+#else
     /* 2 bits for preemption priority, 2 bits for subpriority */
     nvic_priority_group_set(NVIC_PRIGROUP_PRE2_SUB2);
 
     /* enable the USB low priority interrupt */
     nvic_irq_enable((uint8_t)USBD_LP_CAN0_RX0_IRQn, 2U, 0U);
+#endif
 
     /* enable the USB low priority interrupt */
     nvic_irq_enable((uint8_t)USBD_HP_CAN0_TX_IRQn, 1U, 0U);
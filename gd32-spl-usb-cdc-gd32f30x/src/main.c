@@ -37,9 +37,62 @@ OF SUCH DAMAGE.
 #include "systick.h"
 #include "printf_over_x.h"
 #include <stdio.h>
+#ifdef USB_DEFERRED
+#include "FreeRTOS.h"
+#include "task.h"
+#include "defer.h"
+#include "usbd_lld_int.h"
+#endif
 
 usb_dev usbd_cdc;
 
+#ifdef USB_DEFERRED
+/* The USB interrupt is masked in the NVIC by its handler (gd32f30x_it.c),
+ * the USB events are processed by this handler in the deferral task, which
+ * unmasks the interrupt again. Events that come in meanwhile stay pending in
+ * the USB peripheral. */
+defer_source_t usb_source;
+
+static void usb_deferred(void *arg, uint32_t count)
+{
+    usbd_isr();
+    NVIC_EnableIRQ(USBD_LP_CAN0_RX0_IRQn);
+}
+
+#define STACK_SIZE 256
+StaticTask_t xCdcTaskBuffer;
+StackType_t xCdcStack[STACK_SIZE];
+StaticTask_t xStatsTaskBuffer;
+StackType_t xStatsStack[STACK_SIZE];
+
+static void cdc_loop(void);
+
+void vCdcTask(void *pvParameters)
+{
+    cdc_loop();
+}
+
+/* prints the ISR time, deferral latency and handler time of the USB interrupt */
+void vStatsTask(void *pvParameters)
+{
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(5000));
+        defer_print();
+    }
+}
+
+/* memory of the idle task, there is no dynamic allocation */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[configMINIMAL_STACK_SIZE];
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
 /*!
     \brief      main routine
     \param[in]  none
@@ -55,8 +108,14 @@ int main(void)
 
     printf("Start of USB-CDC Demo!\n");
 
+#ifdef USB_DEFERRED
+    /* the SysTick is started by the scheduler */
+    defer_init();
+    defer_register(&usb_source, "USB", usb_deferred, NULL);
+#else
     /* systick config */
     systick_config();
+#endif
 
     /* GPIO configuration */
     gpio_config();
@@ -70,6 +129,17 @@ int main(void)
     /* enabled USB pull-up */
     usbd_connect(&usbd_cdc);
 
+#ifdef USB_DEFERRED
+    xTaskCreateStatic(vCdcTask, "CDC", STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, xCdcStack, &xCdcTaskBuffer);
+    xTaskCreateStatic(vStatsTask, "Stats", STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, xStatsStack, &xStatsTaskBuffer);
+    vTaskStartScheduler();
+#else
+    cdc_loop();
+#endif
+}
+
+static void cdc_loop(void)
+{
     printf("Now waiting for USB device to be connected...\n");
     while (USBD_CONFIGURED != usbd_cdc.cur_status) {
         /* wait for standard USB enumeration is finished */
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""ENOB against throughput of the ADC oversampling (gd32-arduino-analog-read).
+
+"model" compiles the decimator of gd32-arduino-analog-read/lib/adc_oversample
+for the host (scripts/adc_oversample/host_model.c) and feeds it a synthetic
+input: a slow sine of 90% of the full scale plus Gaussian noise of --noise LSB
+rms, quantized by an ideal 12-bit ADC. For every ratio and noise level, it
+prints the bits of the results, the ENOB from the error against the noiseless
+input, and the result rate of the hardware oversampling: every sample takes
+the sample time plus 12.5 cycles of the ADC clock, the results come at
+clock / (cycles * ratio). The shift is log2(ratio) / 2 unless --shift is given,
+the results then have n more bits for ratio = 4^n.
+
+The model has no DNL/INL or reference noise; a real ADC has a lower ENOB at
+ratio 1 and gains less where its errors are not random.
+
+Usage:
+  python3 scripts/adc_oversample.py model
+  python3 scripts/adc_oversample.py model --noise 0,0.5,1 --ratios 1,4,16,64,256 --adc-clock 12000000
+"""
+import argparse
+import json
+import math
+import subprocess
+import sys
+import tempfile
+from os.path import abspath, dirname, join
+
+SCRIPT_DIR = dirname(abspath(__file__))
+TARGET_LIB = join(SCRIPT_DIR, "..", "gd32-arduino-analog-read", "lib", "adc_oversample")
+CONVERSION_CYCLES = 12.5
+
+
+def build_host_model(cc, build_dir):
+    exe = join(build_dir, "host_model")
+    result = subprocess.run([cc, "-O2", "-std=gnu11", "-Wall", "-o", exe, "-I" + TARGET_LIB,
+                             join(SCRIPT_DIR, "adc_oversample", "host_model.c"),
+                             join(TARGET_LIB, "adc_decimator.c"), "-lm"],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("error: building the host model failed\n%s" % result.stdout)
+    return exe
+
+
+def model(args):
+    rate = args.adc_clock / (args.sample_cycles + CONVERSION_CYCLES)
+    print("ADC clock %.0f Hz, %.1f + %.1f cycles per sample: %.0f samples/s" % (
+        args.adc_clock, args.sample_cycles, CONVERSION_CYCLES, rate))
+    print("%7s %6s %5s %5s %12s %8s" % ("noise", "ratio", "shift", "bits", "results/s", "ENOB"))
+    results = []
+    with tempfile.TemporaryDirectory() as build_dir:
+        exe = build_host_model(args.cc, build_dir)
+        for noise in args.noise:
+            for ratio in args.ratios:
+                shift = args.shift if args.shift is not None else int(math.log2(ratio)) // 2
+                out = subprocess.run([exe, str(ratio), str(shift), repr(noise), str(args.results), str(args.seed)],
+                                     stdout=subprocess.PIPE, universal_newlines=True)
+                if out.returncode != 0:
+                    sys.exit("error: the host model failed for ratio %d, shift %d" % (ratio, shift))
+                result = json.loads(out.stdout)
+                result["rate"] = rate / ratio
+                results.append(result)
+                print("%7.2f %6d %5d %5d %12.0f %8.2f" % (noise, ratio, shift, result["bits"], result["rate"],
+                                                          result["enob"]))
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+
+
+def parse_list(convert):
+    return lambda text: [convert(v) for v in text.split(",") if v]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+    p = sub.add_parser("model")
+    p.add_argument("--cc", default="gcc")
+    p.add_argument("--noise", type=parse_list(float), default=[0, 0.3, 1.0, 2.0],
+                   help="comma separated rms noise at the input in LSB")
+    p.add_argument("--ratios", type=parse_list(int), default=[1, 2, 4, 8, 16, 32, 64, 128, 256])
+    p.add_argument("--shift", type=int, help="fixed shift instead of log2(ratio) / 2")
+    p.add_argument("--adc-clock", type=float, default=20e6, help="Hz, APB2 / 6 on a GD32F303 at 120 MHz")
+    p.add_argument("--sample-cycles", type=float, default=55.5, help="sample time in ADC clock cycles")
+    p.add_argument("--results", type=int, default=65536, help="results per run")
+    p.add_argument("--seed", type=int, default=1)
+    p.add_argument("--json", metavar="FILE", help="write the results to a JSON file")
+    args = parser.parse_args()
+    {"model": model}[args.command](args)
+
+
+if __name__ == "__main__":
+    main()
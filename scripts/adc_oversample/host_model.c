@@ -0,0 +1,104 @@
+/* Host model of the ADC decimation (gd32-arduino-analog-read/lib/adc_oversample),
+ * used by scripts/adc_oversample.py:
+ *
+ *   host_model <ratio> <shift> <noise LSB rms> <results> <seed>
+ *     A sine of 90% of the full scale (one period over the results, so it
+ *     moves by less than an LSB during a result at 65536 results and does
+ *     not dither the ADC by itself) plus Gaussian noise goes into
+ *     an ideal 12-bit ADC (rounding, clipped), the samples through
+ *     adc_decimator_push(). The error of every result against the mean of
+ *     the noiseless input over its samples, without its mean (the offset of
+ *     the truncation), gives the SINAD relative to a full scale sine and the
+ *     ENOB = (SINAD - 1.76) / 6.02. Prints one JSON line. */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "adc_decimator.h"
+
+#define ADC_BITS 12
+#define ADC_MAX ((1 << ADC_BITS) - 1)
+#define PERIODS 1.0
+
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+static double next_uniform(void)
+{
+    /* xorshift64*, (0, 1) */
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return ((double)((rng * 0x2545F4914F6CDD1DULL) >> 11) + 0.5) / 9007199254740992.0;
+}
+
+static double next_gaussian(void)
+{
+    /* Box-Muller, one of the pair */
+    return sqrt(-2.0 * log(next_uniform())) * cos(2.0 * M_PI * next_uniform());
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 6)
+    {
+        fprintf(stderr, "usage: %s <ratio> <shift> <noise LSB rms> <results> <seed>\n", argv[0]);
+        return 2;
+    }
+    unsigned ratio = (unsigned)atoi(argv[1]);
+    unsigned shift = (unsigned)atoi(argv[2]);
+    double noise = atof(argv[3]);
+    long results = atol(argv[4]);
+    rng += (uint64_t)atol(argv[5]) * 0x9E3779B97F4A7C15ULL;
+
+    adc_decimator_t dec;
+    if (adc_decimator_init(&dec, (uint16_t)ratio, (uint8_t)shift) != 0 || results < 2)
+    {
+        fprintf(stderr, "invalid ratio, shift or number of results\n");
+        return 2;
+    }
+    double amplitude = 0.45 * (ADC_MAX + 1);
+    double mid = (ADC_MAX + 1) / 2.0;
+    double scale = (double)ratio / (double)(1U << shift);
+    long samples = results * (long)ratio;
+    double *errors = malloc(sizeof(double) * (size_t)results);
+    double ideal_sum = 0.0;
+    long n = 0;
+
+    for (long i = 0; i < samples; i++)
+    {
+        double x = mid + amplitude * sin(2.0 * M_PI * PERIODS * (double)i / (double)samples);
+        double v = floor(x + noise * next_gaussian() + 0.5);
+        uint16_t sample = (uint16_t)(v < 0.0 ? 0.0 : (v > ADC_MAX ? ADC_MAX : v));
+        uint32_t result;
+        ideal_sum += x;
+        if (adc_decimator_push(&dec, sample, &result))
+        {
+            /* the rounding ADC truncates x + 0.5, so against x + 0.5 a result
+             * only has the truncation of its samples and of the shift. Their
+             * constant part is the offset, which is removed with the mean
+             * below and does not count as noise. */
+            errors[n++] = (double)result - (ideal_sum + 0.5 * ratio) / (double)(1U << shift);
+            ideal_sum = 0.0;
+        }
+    }
+    double mean = 0.0;
+    for (long i = 0; i < n; i++)
+    {
+        mean += errors[i];
+    }
+    mean /= (double)n;
+    double power = 0.0;
+    for (long i = 0; i < n; i++)
+    {
+        power += (errors[i] - mean) * (errors[i] - mean);
+    }
+    double rms = sqrt(power / (double)n);
+    /* full scale sine: amplitude of half the range of the results */
+    double full_scale_rms = (ADC_MAX + 1) * scale / 2.0 / sqrt(2.0);
+    double sinad = 20.0 * log10(full_scale_rms / rms);
+    printf("{\"ratio\": %u, \"shift\": %u, \"bits\": %u, \"noise\": %g, \"results\": %ld, "
+           "\"error_rms_lsb\": %.6f, \"offset_lsb\": %.6f, \"sinad_db\": %.3f, \"enob\": %.3f}\n",
+           ratio, shift, adc_decimator_bits(&dec, ADC_BITS), noise, n, rms, mean, sinad, (sinad - 1.76) / 6.02);
+    free(errors);
+    return 0;
+}
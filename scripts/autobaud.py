@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Host side of the automatic baud rate detection and negotiation.
+
+Talks to a firmware built with PRINTF_AUTOBAUD (the genericGD32F303CC_autobaud
+environment of gd32-spl-freertos, see src/usart_baud.h) on a serial port on
+Linux (termios, no extra packages):
+  1. at --baud, sends the sync character 0x80 until the firmware, which
+     measures it with a timer, replies "AUTOBAUD <baud> MAX <max>". Start the
+     tool before resetting the board, the firmware waits 2 s for it.
+  2. for every rate of --target, highest first: "BAUD <rate>". The firmware
+     computes its divider and the error and replies "OK" or "ERR". After an
+     OK, both sides switch, the tool sends "SYNC" and waits for
+     "READY <rate>". If that fails, both go back, the tool checks the
+     firmware with "?" and tries the next rate. Without --target, "GO"
+     keeps the rate.
+  3. with --monitor, prints what the firmware sends at the final rate.
+Rates without a termios constant (e.g. 7500000) are set with termios2
+(BOTHER), the USB-UART adapter has to support them.
+
+"divider" prints the rates a USART clock can make, with the error of the
+divider, the same computation as the firmware.
+
+Usage:
+  python3 scripts/autobaud.py connect /dev/ttyUSB0 --target 4000000,3000000,2000000,921600 --monitor
+  python3 scripts/autobaud.py divider --clock 120000000 --bauds 921600,1000000,3000000,4000000
+"""
+import argparse
+import array
+import fcntl
+import os
+import select
+import sys
+import termios
+import time
+import tty
+
+SYNC_CHAR = b"\x80"
+SYNC_INTERVAL = 0.02
+# USART_BAUD_WINDOW_MS of the firmware
+WINDOW = 0.5
+# struct termios2 of Linux: 4 flags, c_line, 19 c_cc, c_ispeed, c_ospeed
+TCGETS2 = 0x802C542A
+TCSETS2 = 0x402C542B
+BOTHER = 0o010000
+CBAUD = 0o010017
+
+
+def set_baud(fd, baud):
+    speed = getattr(termios, "B%d" % baud, None)
+    if speed is not None:
+        attrs = termios.tcgetattr(fd)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+        return
+    buf = array.array("I", [0] * 11)
+    fcntl.ioctl(fd, TCGETS2, buf, True)
+    buf[2] = (buf[2] & ~CBAUD) | BOTHER
+    buf[9] = buf[10] = baud
+    fcntl.ioctl(fd, TCSETS2, buf)
+
+
+class Port:
+    def __init__(self, path, baud):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        set_baud(self.fd, baud)
+        self.pending = bytearray()
+
+    def close(self):
+        os.close(self.fd)
+
+    def write(self, data):
+        os.write(self.fd, data)
+        termios.tcdrain(self.fd)
+
+    def readline(self, timeout):
+        """a line without the line ending, None on a timeout"""
+        deadline = time.perf_counter() + timeout
+        while b"\n" not in self.pending:
+            left = deadline - time.perf_counter()
+            if left <= 0 or not select.select([self.fd], [], [], left)[0]:
+                return None
+            self.pending += os.read(self.fd, 256)
+        line, _, rest = bytes(self.pending).partition(b"\n")
+        self.pending = bytearray(rest)
+        return line.decode("ascii", "replace").strip()
+
+
+def autobaud(port, timeout):
+    deadline = time.perf_counter() + timeout
+    while time.perf_counter() < deadline:
+        port.write(SYNC_CHAR)
+        line = port.readline(SYNC_INTERVAL)
+        while line is not None:
+            fields = line.split()
+            if len(fields) == 4 and fields[0] == "AUTOBAUD" and fields[2] == "MAX":
+                return int(fields[1]), int(fields[3])
+            line = port.readline(0)
+    sys.exit("error: no reply to the sync characters")
+
+
+def negotiate(port, baud, targets):
+    """returns the final rate"""
+    for target in sorted(targets, reverse=True):
+        if target == baud:
+            continue
+        port.write(b"BAUD %d\n" % target)
+        reply = port.readline(WINDOW)
+        fields = (reply or "").split()
+        if len(fields) != 4 or fields[0] != "OK":
+            print("%d: refused (%s)" % (target, reply))
+            continue
+        print("%d: divider gives %s baud, %s ppm" % (target, fields[2], fields[3]))
+        set_baud(port.fd, target)
+        time.sleep(0.01)
+        port.pending.clear()
+        port.write(b"SYNC\n")
+        reply = port.readline(WINDOW / 2)
+        if reply == "READY %d" % target:
+            return target
+        print("%d: no sync (%s)" % (target, reply))
+        # the firmware went back at the latest when its window ended
+        set_baud(port.fd, baud)
+        time.sleep(WINDOW)
+        while port.readline(0.05) is not None:
+            pass
+        port.pending.clear()
+        port.write(b"?\n")
+        reply = port.readline(WINDOW)
+        if not reply or not reply.startswith("AUTOBAUD %d " % baud):
+            sys.exit("error: lost the firmware (%s)" % reply)
+    port.write(b"GO\n")
+    return baud
+
+
+def connect(args):
+    port = Port(args.port, args.baud)
+    try:
+        baud, maximum = autobaud(port, args.timeout)
+        print("firmware detected %d baud, maximum %d baud" % (baud, maximum))
+        final = negotiate(port, baud, [t for t in args.target if t <= maximum])
+        print("link at %d baud" % final)
+        if args.monitor:
+            while True:
+                if select.select([port.fd], [], [], 0.5)[0]:
+                    sys.stdout.write(os.read(port.fd, 4096).decode("utf-8", "replace"))
+                    sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        port.close()
+
+
+def divider(args):
+    print("%10s %10s %8s %10s" % ("baud", "actual", "divider", "error ppm"))
+    for baud in args.bauds:
+        div = (args.clock + baud // 2) // baud
+        if div < 16 or div > 0xFFFF:
+            print("%10d %10s %8s %10s" % (baud, "-", "-", "-"))
+            continue
+        actual = args.clock // div
+        print("%10d %10d %8.4f %10d" % (baud, actual, div / 16.0, int((actual - baud) * 1000000 / baud)))
+    print("maximum: %d baud" % (args.clock // 16))
+
+
+def parse_list(text):
+    return [int(v) for v in text.split(",") if v]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+    p = sub.add_parser("connect")
+    p.add_argument("port", help="serial port, e.g. /dev/ttyUSB0")
+    p.add_argument("--baud", type=int, default=115200, help="rate of the sync characters")
+    p.add_argument("--target", type=parse_list, default=[], help="comma separated rates to try, highest first")
+    p.add_argument("--timeout", type=float, default=10.0, help="seconds to wait for the firmware")
+    p.add_argument("--monitor", action="store_true", help="print the output of the firmware afterwards")
+    p = sub.add_parser("divider")
+    p.add_argument("--clock", type=int, default=120000000, help="USART clock in Hz (APB2 for USART0)")
+    p.add_argument("--bauds", type=parse_list,
+                   default=[115200, 230400, 460800, 921600, 1000000, 1500000, 2000000, 3000000, 4000000])
+    args = parser.parse_args()
+    {"connect": connect, "divider": divider}[args.command](args)
+
+
+if __name__ == "__main__":
+    main()
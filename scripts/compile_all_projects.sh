@@ -0,0 +1,46 @@
+#!/bin/sh
+# Builds every project of the repository, like compile_all_projects.bat.
+#
+# If an output folder is given, every build also writes a map file and the
+# firmware.elf and firmware.map of all environments are collected there as
+# <output>/<project>/<env>/, ready for scripts/size_report.py:
+#
+#   scripts/compile_all_projects.sh results/before
+#   ... change something ...
+#   scripts/compile_all_projects.sh results/after
+#   python3 scripts/size_report.py diff results/before results/after
+repo_dir=$(cd "$(dirname "$0")/.." && pwd)
+out_dir=$1
+failed=""
+
+if [ -n "$out_dir" ]; then
+    mkdir -p "$out_dir" && out_dir=$(cd "$out_dir" && pwd) || exit 1
+    # appended to the build_flags of every environment.
+    # overrides the -Wl,-Map=output.map of some projects, which is shared by all envs.
+    PLATFORMIO_BUILD_FLAGS="$PLATFORMIO_BUILD_FLAGS -Wl,-Map,\${BUILD_DIR}/firmware.map"
+    export PLATFORMIO_BUILD_FLAGS
+fi
+
+for project in "$repo_dir"/*/; do
+    project=${project%/}
+    echo "current directory: $project"
+    if [ ! -f "$project/platformio.ini" ]; then
+        echo "Folder has no platformio.ini, skipping."
+        continue
+    fi
+    (cd "$project" && pio run) || failed="$failed $(basename "$project")"
+    if [ -n "$out_dir" ]; then
+        for build in "$project"/.pio/build/*/; do
+            [ -f "$build/firmware.elf" ] || continue
+            dest="$out_dir/$(basename "$project")/$(basename "$build")"
+            mkdir -p "$dest"
+            cp "$build/firmware.elf" "$dest/"
+            [ -f "$build/firmware.map" ] && cp "$build/firmware.map" "$dest/"
+        done
+    fi
+done
+
+if [ -n "$failed" ]; then
+    echo "Failed projects:$failed"
+    exit 1
+fi
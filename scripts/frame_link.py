@@ -0,0 +1,346 @@
+#!/usr/bin/env python3
+"""Host side of the framing layer (gd32-spl-usart/lib/frame_link).
+
+Frames are COBS encoded and end with a 0 byte. Before the encoding, a frame is
+  flags (1) | seq (1) | ack (1) | payload | CRC-32/MPEG-2 (4, big endian)
+with the flags reliable (0x01), ack valid (0x02), sync (0x04), data (0x08)
+and the channel in the upper 4 bits, see frame_link.h.
+
+"monitor" receives the frames of the FRAME_LINK_DEMO firmware (the
+genericGD32F303CC_framed environments of gd32-spl-usart and gd32-spl-freertos)
+on a serial port: the text channel goes to stdout, the telemetry frames are
+checked and counted, once per second a line with the rates and errors is
+printed. Reliable frames are acknowledged, every one like the firmware does,
+so the target can repeat lost frames early. Without --ack the monitor only
+listens (for unreliable links).
+"decode" prints the frames in a file, e.g. a capture of the serial port.
+"faults" compiles the C library for the host (scripts/frame_link/host_test.c),
+checks that its frames are the same as the ones of this encoder, then runs
+two links on a simulated serial line with bit errors and prints the goodput:
+the payload bytes per second that arrived intact and in order, against the
+line rate at 8N1 (baud / 10).
+
+Usage:
+  python3 scripts/frame_link.py monitor /dev/ttyUSB0 --baud 921600
+  python3 scripts/frame_link.py decode capture.bin
+  python3 scripts/frame_link.py faults --bauds 115200,921600 --bers 0,1e-6,1e-5,1e-4
+  python3 scripts/frame_link.py faults --mtu 16 --window 16 --bers 1e-4,1e-3
+  python3 scripts/frame_link.py faults --reply 8 --bers 0,1e-5,1e-4
+"""
+import argparse
+import json
+import os
+import select
+import struct
+import subprocess
+import sys
+import tempfile
+import termios
+import time
+import tty
+from os.path import abspath, dirname, join
+
+SCRIPT_DIR = dirname(abspath(__file__))
+TARGET_LIB = join(SCRIPT_DIR, "..", "gd32-spl-usart", "lib", "frame_link")
+
+FLAG_RELIABLE = 0x01
+FLAG_ACK = 0x02
+FLAG_SYNC = 0x04
+FLAG_DATA = 0x08
+CHANNEL_TEXT = 0
+CHANNEL_TELEMETRY = 1
+# telemetry_t of gd32-spl-usart/src/main.c
+TELEMETRY = struct.Struct("<IIII32s")
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_pos = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(byte)
+        code += 1
+        if code == 0xFF:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+    out[code_pos] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    """returns None for invalid data"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        out += data[i:i + code - 1]
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def crc32_mpeg2(data):
+    crc = 0xFFFFFFFF
+    for byte in data:
+        crc ^= byte << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7) & 0xFFFFFFFF if crc & 0x80000000 else (crc << 1) & 0xFFFFFFFF
+    return crc
+
+
+def encode_frame(flags, seq, ack, payload=b""):
+    raw = bytes([flags, seq & 0xFF, ack & 0xFF]) + bytes(payload)
+    raw += struct.pack(">I", crc32_mpeg2(raw))
+    return cobs_encode(raw) + b"\0"
+
+
+def decode_frame(encoded):
+    """decodes one frame without its 0, returns (flags, seq, ack, payload) or an error string"""
+    raw = cobs_decode(encoded)
+    if raw is None or len(raw) < 7:
+        return "framing"
+    if struct.unpack(">I", raw[-4:])[0] != crc32_mpeg2(raw[:-4]):
+        return "crc"
+    return raw[0], raw[1], raw[2], raw[3:-4]
+
+
+class Deframer:
+    """splits a byte stream at the 0 bytes"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+
+    def feed(self, data):
+        frames = []
+        for byte in data:
+            if byte:
+                self.buffer.append(byte)
+            elif self.buffer:
+                frames.append(decode_frame(bytes(self.buffer)))
+                self.buffer.clear()
+        return frames
+
+
+class Receiver:
+    """receiving side of a link, like frame_link_t without sending data"""
+
+    def __init__(self):
+        self.synced = False
+        self.expected = 0
+        self.unreliable_expected = None
+        self.counters = {"frames": 0, "bytes": 0, "crc": 0, "framing": 0, "duplicates": 0, "lost": 0}
+
+    def frame(self, frame):
+        """returns (channel, payload) of an accepted data frame, else None, and whether to acknowledge"""
+        if isinstance(frame, str):
+            self.counters[frame] += 1
+            return None, False
+        flags, seq, _, payload = frame
+        if flags & FLAG_SYNC:
+            self.synced, self.expected = True, seq
+            return None, True
+        if not flags & FLAG_DATA:
+            return None, False
+        if flags & FLAG_RELIABLE:
+            if not self.synced:
+                self.synced, self.expected = True, seq
+            if seq != self.expected:
+                self.counters["duplicates"] += 1
+                return None, True
+            self.expected = (self.expected + 1) & 0xFF
+        else:
+            if self.unreliable_expected is not None:
+                self.counters["lost"] += (seq - self.unreliable_expected) & 0xFF
+            self.unreliable_expected = (seq + 1) & 0xFF
+        self.counters["frames"] += 1
+        self.counters["bytes"] += len(payload)
+        return (flags >> 4, payload), bool(flags & FLAG_RELIABLE)
+
+    def ack(self):
+        return encode_frame(FLAG_ACK, 0, self.expected)
+
+
+def open_port(port, baud):
+    fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    speed = getattr(termios, "B%d" % baud, None)
+    if speed is None:
+        sys.exit("error: baud rate %d is not supported by termios" % baud)
+    attrs = termios.tcgetattr(fd)
+    attrs[4] = attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def monitor(args):
+    fd = open_port(args.port, args.baud)
+    deframer = Deframer()
+    receiver = Receiver()
+    telemetry_errors = 0
+    next_counter = None
+    target = None
+    last = time.perf_counter()
+    last_bytes = 0
+    text = sys.stdout
+    try:
+        while True:
+            if select.select([fd], [], [], 0.1)[0]:
+                acks = 0
+                for frame in deframer.feed(os.read(fd, 4096)):
+                    data, ack = receiver.frame(frame)
+                    acks += ack
+                    if data is None:
+                        continue
+                    channel, payload = data
+                    if channel == CHANNEL_TEXT:
+                        text.write(payload.decode("utf-8", "replace"))
+                        text.flush()
+                    elif channel == CHANNEL_TELEMETRY and len(payload) == TELEMETRY.size:
+                        counter, millis, retransmits, crc_errors, pattern = TELEMETRY.unpack(payload)
+                        if pattern != bytes((counter + i) & 0xFF for i in range(len(pattern))):
+                            telemetry_errors += 1
+                        if next_counter is not None and counter != next_counter:
+                            telemetry_errors += 1
+                        next_counter = (counter + 1) & 0xFFFFFFFF
+                        target = (millis, retransmits, crc_errors)
+                if args.ack:
+                    # one ack per accepted or repeated frame, as the target counts duplicate acks
+                    os.write(fd, receiver.ack() * acks)
+            now = time.perf_counter()
+            if now - last >= 1.0:
+                c = receiver.counters
+                line = "# %.0f bytes/s, %d frames, %d crc errors, %d framing errors, %d duplicates, %d lost, " \
+                       "%d telemetry errors" % ((c["bytes"] - last_bytes) / (now - last), c["frames"], c["crc"],
+                                                c["framing"], c["duplicates"], c["lost"], telemetry_errors)
+                if target:
+                    line += ", target: %d retransmits, %d crc errors" % target[1:]
+                print(line, file=sys.stderr)
+                last, last_bytes = now, c["bytes"]
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+
+
+def decode(args):
+    with open(args.file, "rb") as f:
+        stream = f.read()
+    for frame in Deframer().feed(stream):
+        if isinstance(frame, str):
+            print("%s error" % frame)
+            continue
+        flags, seq, ack, payload = frame
+        names = [n for bit, n in [(FLAG_RELIABLE, "reliable"), (FLAG_ACK, "ack"), (FLAG_SYNC, "sync"),
+                                  (FLAG_DATA, "data")] if flags & bit]
+        print("channel %2d seq %3d ack %3d %-22s %3d bytes %s" % (flags >> 4, seq, ack, ",".join(names),
+                                                                 len(payload), payload.hex()))
+
+
+def build_host_test(cc, build_dir, args):
+    exe = join(build_dir, "host_test")
+    defines = ["-DFRAME_LINK_MTU=%d" % args.mtu, "-DFRAME_LINK_WINDOW=%d" % args.window,
+               "-DFRAME_LINK_RETRY_MS=%dU" % args.retry_ms]
+    result = subprocess.run([cc, "-O2", "-std=gnu11", "-Wall", "-o", exe, "-I" + TARGET_LIB] + defines +
+                            [join(SCRIPT_DIR, "frame_link", "host_test.c"), join(TARGET_LIB, "frame_link.c"),
+                             join(TARGET_LIB, "frame_link_crc.c")],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("error: building the host test failed\n%s" % result.stdout)
+    return exe
+
+
+def check_encoder(exe, mtu):
+    """the frames of "host_test encode" against this encoder and decoder"""
+    stream = subprocess.run([exe, "encode"], stdout=subprocess.PIPE, check=True).stdout
+    expected = bytearray()
+    for length in range(mtu + 1):
+        payload = bytes(0 if i % 5 == 0 else (length + i) & 0xFF for i in range(length))
+        expected += encode_frame(FLAG_DATA | (length % 16) << 4, length, 0, payload)
+        frame = decode_frame(encode_frame(FLAG_DATA, length, 0, payload)[:-1])
+        if isinstance(frame, str) or frame[3] != payload:
+            sys.exit("error: decoding a frame of %d bytes failed" % length)
+    if stream != bytes(expected):
+        sys.exit("error: the frames of the C library differ from the ones of the host encoder")
+    return mtu + 1
+
+
+def faults(args):
+    results = []
+    with tempfile.TemporaryDirectory() as build_dir:
+        exe = build_host_test(args.cc, build_dir, args)
+        print("encoder check: %d frames identical" % check_encoder(exe, args.mtu))
+        print("MTU %d, window %d, retry %d ms, %s%s" % (
+            args.mtu, args.window, args.retry_ms, "unreliable" if args.unreliable else "reliable",
+            ", %d byte frames back" % args.reply if args.reply else ""))
+        print("%8s %8s %11s %7s %9s %9s %9s %9s %9s" % ("baud", "BER", "goodput B/s", "line %", "frames",
+                                                        "retrans", "crc err", "lost", "integrity"))
+        for baud in args.bauds:
+            for ber in args.bers:
+                out = subprocess.run([exe, "faults", str(baud), str(args.seconds), repr(ber),
+                                      "0" if args.unreliable else "1", str(args.seed), str(args.reply)],
+                                     stdout=subprocess.PIPE, universal_newlines=True).stdout
+                result = json.loads(out)
+                result.update({"baud": baud, "ber": ber})
+                results.append(result)
+                print("%8d %8.0e %11.0f %7.1f %9d %9d %9d %9d %9d" % (
+                    baud, ber, result["goodput"], 100.0 * result["goodput"] / result["line_rate"],
+                    result["received"], result["retransmits"], result["crc_errors"] + result["framing_errors"],
+                    result["lost"], result["integrity_errors"]))
+                if args.reply:
+                    print("%17s reply goodput %.0f B/s, %d retransmits" % (
+                        "", result["reply_goodput"], result["reply_retransmits"]))
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+    if any(r["integrity_errors"] for r in results):
+        sys.exit("error: frames were delivered corrupted, repeated or out of order")
+    if any(r["ber"] == 0 and r["retransmits"] + r["reply_retransmits"] for r in results):
+        sys.exit("error: frames were repeated on a line without errors")
+
+
+def parse_list(convert):
+    return lambda text: [convert(v) for v in text.split(",") if v]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+    p = sub.add_parser("monitor")
+    p.add_argument("port", help="serial port, e.g. /dev/ttyUSB0")
+    p.add_argument("--baud", type=int, default=115200)
+    p.add_argument("--no-ack", dest="ack", action="store_false", help="only listen, for unreliable links")
+    p = sub.add_parser("decode")
+    p.add_argument("file", help="file with the received bytes")
+    p = sub.add_parser("faults")
+    p.add_argument("--cc", default="gcc")
+    p.add_argument("--bauds", type=parse_list(int), default=[921600], help="comma separated baud rates")
+    p.add_argument("--bers", type=parse_list(float), default=[0, 1e-6, 1e-5, 1e-4, 1e-3],
+                   help="comma separated bit error rates")
+    p.add_argument("--seconds", type=float, default=10.0, help="simulated time per run")
+    p.add_argument("--mtu", type=int, default=64, help="payload of the frames (FRAME_LINK_MTU)")
+    p.add_argument("--window", type=int, default=8, help="FRAME_LINK_WINDOW")
+    p.add_argument("--retry-ms", type=int, default=100, help="FRAME_LINK_RETRY_MS")
+    p.add_argument("--unreliable", action="store_true", help="without acks and repetitions")
+    p.add_argument("--reply", type=int, default=0,
+                   help="payload of the frames the receiver sends back, 0 for one-way traffic")
+    p.add_argument("--seed", type=int, default=1)
+    p.add_argument("--json", metavar="FILE", help="write the results to a JSON file")
+    args = parser.parse_args()
+    {"monitor": monitor, "decode": decode, "faults": faults}[args.command](args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,258 @@
+/* Host build of the framing layer (gd32-spl-usart/lib/frame_link), used by
+ * scripts/frame_link.py:
+ *
+ *   host_test faults <baud> <seconds> <bit error rate> <reliable> <seed> [<reply bytes>]
+ *     Two links on a simulated serial line with the given baud rate (8N1),
+ *     every data bit is flipped with the bit error rate, in both directions.
+ *     A sends telemetry frames of FRAME_LINK_MTU bytes whenever its window
+ *     allows and its transmitter is idle (like a blocking write on the
+ *     target), B receives and checks them. Prints one JSON line with the
+ *     goodput (payload bytes per second accepted by B) and the counters.
+ *     With reply bytes (optional, default 0), B sends frames of that size on
+ *     the text channel back to A in the same way, so that both directions
+ *     carry data frames with acks.
+ *   host_test encode
+ *     Writes the frames of payloads with 0 .. FRAME_LINK_MTU bytes to stdout,
+ *     to compare them with the encoder of the host tool.
+ *
+ * FRAME_LINK_MTU, FRAME_LINK_WINDOW and FRAME_LINK_RETRY_MS are set when
+ * compiling. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "frame_link.h"
+
+#define WIRE_SIZE 65536U
+
+typedef struct
+{
+    uint8_t data[WIRE_SIZE];
+    size_t head;
+    size_t tail;
+} wire_t;
+
+static wire_t wire_a_to_b;
+static wire_t wire_b_to_a;
+static uint64_t now_us;
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+static double bit_error_rate;
+
+static uint32_t next_random(void)
+{
+    /* xorshift64* */
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return (uint32_t)((rng * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+static void wire_put(wire_t *wire, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        if (wire->head - wire->tail == WIRE_SIZE)
+        {
+            fprintf(stderr, "wire overflow\n");
+            exit(1);
+        }
+        wire->data[wire->head++ % WIRE_SIZE] = data[i];
+    }
+}
+
+static int wire_idle(const wire_t *wire)
+{
+    return wire->head == wire->tail;
+}
+
+/* one byte time: the next byte arrives, with bit errors */
+static int wire_shift(wire_t *wire, uint8_t *byte)
+{
+    if (wire_idle(wire))
+    {
+        return 0;
+    }
+    *byte = wire->data[wire->tail++ % WIRE_SIZE];
+    for (int bit = 0; bit < 8; bit++)
+    {
+        if (next_random() < bit_error_rate * 4294967296.0)
+        {
+            *byte ^= (uint8_t)(1U << bit);
+        }
+    }
+    return 1;
+}
+
+static void write_a(const uint8_t *data, size_t len)
+{
+    wire_put(&wire_a_to_b, data, len);
+}
+
+static void write_b(const uint8_t *data, size_t len)
+{
+    wire_put(&wire_b_to_a, data, len);
+}
+
+static uint32_t sim_millis(void)
+{
+    return (uint32_t)(now_us / 1000U);
+}
+
+static uint32_t expected_counter;
+static uint32_t integrity_errors;
+static uint64_t goodput_bytes;
+static uint64_t reply_bytes;
+
+static void payload(uint32_t counter, uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        data[i] = (uint8_t)(counter * 31U + i);
+    }
+    if (len >= sizeof(counter))
+    {
+        memcpy(data, &counter, sizeof(counter));
+    }
+}
+
+static void receive_b(void *arg, uint8_t channel, const uint8_t *data, size_t len)
+{
+    uint8_t expected[FRAME_LINK_MTU];
+    uint32_t counter = expected_counter;
+    int reliable = *(const int *)arg;
+
+    if (len >= sizeof(counter))
+    {
+        memcpy(&counter, data, sizeof(counter));
+    }
+    /* an unreliable link may lose frames, but never reorder or repeat them */
+    if (reliable ? counter != expected_counter : counter < expected_counter)
+    {
+        integrity_errors++;
+    }
+    payload(counter, expected, len);
+    if (channel != FRAME_LINK_CHANNEL_TELEMETRY || len != FRAME_LINK_MTU || memcmp(data, expected, len) != 0)
+    {
+        integrity_errors++;
+    }
+    expected_counter = counter + 1U;
+    goodput_bytes += len;
+}
+
+static void receive_a(void *arg, uint8_t channel, const uint8_t *data, size_t len)
+{
+    (void)arg;
+    (void)data;
+    if (channel == FRAME_LINK_CHANNEL_TEXT)
+    {
+        reply_bytes += len;
+    }
+}
+
+static int faults(long baud, double seconds, int reliable, unsigned long seed, size_t reply)
+{
+    static frame_link_t a;
+    static frame_link_t b;
+    const frame_link_io_t io_a = {write_a, sim_millis, receive_a, NULL};
+    const frame_link_io_t io_b = {write_b, sim_millis, receive_b, &reliable};
+    const double byte_us = 10.0e6 / (double)baud;
+    uint8_t data[FRAME_LINK_MTU];
+    uint32_t counter = 0;
+    double time_us = 0.0;
+    uint8_t byte;
+
+    rng ^= seed * 0xD1B54A32D192ED03ULL;
+    frame_link_init(&a, &io_a, reliable);
+    frame_link_init(&b, &io_b, reliable);
+    while (time_us < seconds * 1e6)
+    {
+        time_us += byte_us;
+        now_us = (uint64_t)time_us;
+        if (wire_shift(&wire_a_to_b, &byte))
+        {
+            frame_link_input(&b, &byte, 1);
+        }
+        if (wire_shift(&wire_b_to_a, &byte))
+        {
+            frame_link_input(&a, &byte, 1);
+        }
+        /* a side only runs again when its transmitter is idle */
+        if (wire_idle(&wire_a_to_b))
+        {
+            frame_link_poll(&a);
+            if (wire_idle(&wire_a_to_b) && frame_link_can_send(&a))
+            {
+                payload(counter, data, sizeof(data));
+                frame_link_send(&a, FRAME_LINK_CHANNEL_TELEMETRY, data, sizeof(data));
+                counter++;
+            }
+        }
+        if (wire_idle(&wire_b_to_a))
+        {
+            frame_link_poll(&b);
+            if (reply != 0 && wire_idle(&wire_b_to_a) && frame_link_can_send(&b))
+            {
+                memset(data, 'r', reply);
+                frame_link_send(&b, FRAME_LINK_CHANNEL_TEXT, data, reply);
+            }
+        }
+    }
+    printf("{\"goodput\": %.1f, \"reply_goodput\": %.1f, \"line_rate\": %.1f, \"sent\": %lu, "
+           "\"retransmits\": %lu, \"reply_retransmits\": %lu, \"received\": %lu, "
+           "\"crc_errors\": %lu, \"framing_errors\": %lu, \"duplicates\": %lu, \"lost\": %lu, \"ack_crc_errors\": %lu, "
+           "\"integrity_errors\": %lu}\n",
+           (double)goodput_bytes / seconds, (double)reply_bytes / seconds, (double)baud / 10.0,
+           (unsigned long)a.stats.frames_sent, (unsigned long)a.stats.retransmits,
+           (unsigned long)b.stats.retransmits, (unsigned long)b.stats.frames_received,
+           (unsigned long)b.stats.crc_errors, (unsigned long)b.stats.framing_errors,
+           (unsigned long)b.stats.duplicates, (unsigned long)b.stats.lost, (unsigned long)a.stats.crc_errors,
+           (unsigned long)integrity_errors);
+    return integrity_errors != 0;
+}
+
+static void write_stdout(const uint8_t *data, size_t len)
+{
+    fwrite(data, 1, len, stdout);
+}
+
+static int encode(void)
+{
+    static frame_link_t link;
+    const frame_link_io_t io = {write_stdout, sim_millis, NULL, NULL};
+    uint8_t data[FRAME_LINK_MTU];
+
+    frame_link_init(&link, &io, 0);
+    for (size_t len = 0; len <= FRAME_LINK_MTU; len++)
+    {
+        /* with zeros, to exercise the COBS blocks */
+        for (size_t i = 0; i < len; i++)
+        {
+            data[i] = (i % 5U == 0) ? 0 : (uint8_t)(len + i);
+        }
+        frame_link_send(&link, (uint8_t)(len % 16U), data, len);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if ((argc == 7 || argc == 8) && strcmp(argv[1], "faults") == 0)
+    {
+        size_t reply = argc == 8 ? strtoul(argv[7], NULL, 0) : 0;
+        if (reply > FRAME_LINK_MTU)
+        {
+            fprintf(stderr, "reply bytes above FRAME_LINK_MTU\n");
+            return 2;
+        }
+        bit_error_rate = atof(argv[4]);
+        return faults(atol(argv[2]), atof(argv[3]), atoi(argv[5]), strtoul(argv[6], NULL, 0), reply);
+    }
+    if (argc == 2 && strcmp(argv[1], "encode") == 0)
+    {
+        return encode();
+    }
+    fprintf(stderr, "usage: %s faults <baud> <seconds> <bit error rate> <reliable> <seed> [<reply bytes>]\n"
+                    "       %s encode\n",
+            argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+"""Host simulator of the FreeRTOS examples on the POSIX port of FreeRTOS.
+
+Compiles an example project (its src/ and lib/FreeRTOS) with the host's gcc
+against the POSIX port in lib/FreeRTOS/src/portable/ThirdParty/GCC/Posix and
+the stub device header in scripts/freertos_sim/, so that the firmware logic
+can be run and checked without a board. Every task is a thread, the tick is a
+timer signal of 1 ms. printf() goes to stdout, GPIO writes are printed as
+
+  SIM GPIO t=<seconds> tick=<tick count> GPIOA.1=1
+
+The -D flags of [common_env_data] in the project's platformio.ini are used,
+more can be given with -D (e.g. -D PIO_FREERTOS_HEAP_TLSF). The stack monitor,
+the trace recorder, the tickless idle and the UART stream driver use Cortex-M
+registers or peripherals and are not supported.
+
+"timing" runs the simulation a few times and reports:
+  - the LED period jitter: the time between the GPIO edges against the
+    expected half period (--led-period-ms)
+  - the tick drift: the tick count against the host time, in ppm
+  - per task (from the TaskManager reports of gd32-spl-freertos): the
+    context switches per second and the run time per switch
+With --save-baseline the medians are written to a JSON file, with --baseline
+they are compared against one and the script fails if a metric got worse by
+more than --tolerance percent (plus a small absolute floor per metric, the
+host is noisy).
+
+All times are host times. The idle task spins, the simulation keeps one core
+busy. The stack sizes and high water marks mean nothing on the host.
+
+Usage:
+  python3 scripts/freertos_sim.py run gd32-spl-freertos --seconds 10
+  python3 scripts/freertos_sim.py run gd32-spl-freertos -D PIO_FREERTOS_HEAP_TLSF
+  python3 scripts/freertos_sim.py timing gd32-spl-freertos --save-baseline sim_baseline.json
+  python3 scripts/freertos_sim.py timing gd32-spl-freertos --baseline sim_baseline.json
+"""
+import argparse
+import json
+import os
+import re
+import signal
+import statistics
+import subprocess
+import sys
+from glob import glob
+from os.path import abspath, basename, dirname, isdir, isfile, join
+
+SCRIPT_DIR = dirname(abspath(__file__))
+SIM_DIR = join(SCRIPT_DIR, "freertos_sim")
+PORT_DIR = join("portable", "ThirdParty", "GCC", "Posix")
+# stdio calls are made with the tick blocked, see sim.c
+WRAPPED = ["printf", "vprintf", "puts", "putchar", "vAssertCalled"]
+UNSUPPORTED = ["PIO_FREERTOS_STACK_MONITOR", "PIO_FREERTOS_TRACE_RECORDER", "PIO_FREERTOS_TICKLESS",
+               "PIO_FREERTOS_UART_STREAM", "PRINTF_FRAMED", "PRINTF_AUTOBAUD"]
+
+GPIO_LINE = re.compile(r"SIM GPIO t=(\d+\.\d+) tick=(\d+) (GPIO[A-Z]\.\d+)=([01])")
+UPTIME_LINE = re.compile(r"Uptime: (\d+) s, interval: (\d+) us")
+TASK_LINE = re.compile(r'Task: "([^"]*)", Prio: \d+, Switches: (\d+), Runtime: (\d+) us')
+
+# absolute slack per metric on top of --tolerance
+FLOORS = {
+    "led_jitter_avg_ms": 1.0,
+    "led_jitter_max_ms": 5.0,
+    "tick_drift_ppm": 2000.0,
+    "switches_per_s": 5.0,
+    "us_per_switch": 20.0,
+}
+
+
+def run(cmd):
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("error: command failed: %s\n%s" % (" ".join(cmd), result.stdout))
+    return result.stdout
+
+
+def project_defines(project):
+    """-D flags of [common_env_data] in platformio.ini"""
+    defines = []
+    in_section = False
+    with open(join(project, "platformio.ini")) as f:
+        for line in f:
+            stripped = line.strip()
+            if stripped.startswith("["):
+                in_section = stripped == "[common_env_data]"
+            elif in_section and not stripped.startswith(";"):
+                defines += re.findall(r"-D(\w+(?:=\S+)?)", stripped)
+    return defines
+
+
+def build(args):
+    project = abspath(args.project)
+    lib = join(project, "lib", "FreeRTOS", "src")
+    port = join(lib, PORT_DIR)
+    if not isdir(port):
+        sys.exit("error: %s has no POSIX port in lib/FreeRTOS" % args.project)
+    defines = project_defines(project) + args.define
+    for define in UNSUPPORTED:
+        if define in defines:
+            sys.exit("error: %s is not supported in the simulator" % define)
+
+    sources = [f for f in glob(join(lib, "*.c")) if basename(f) != "mpu_wrappers.c"]
+    heap = "heap_tlsf.c" if "PIO_FREERTOS_HEAP_TLSF" in defines else "heap_4.c"
+    sources += [join(lib, "heap", heap)]
+    sources += glob(join(lib, "mpool", "*.c")) + glob(join(lib, "defer", "*.c"))
+    if "PIO_FREERTOS_WITH_CMSISOS2" in defines:
+        sources += [join(lib, "cmsis_os2", "cmsis_os2.c"), join(lib, "cmsis_os2", "os_systick.c")]
+    if "PIO_FREERTOS_MUTEX_PROFILER" in defines:
+        sources += glob(join(lib, "mutex_profiler", "*.c"))
+    sources += [join(port, "port.c"), join(port, "utils", "wait_for_event.c")]
+    sources += glob(join(project, "src", "*.c"))
+    sources += [join(SIM_DIR, "sim.c")]
+
+    includes = [SIM_DIR, join(project, "src"), lib, join(lib, "heap"), join(lib, "mpool"), join(lib, "defer"),
+                join(lib, "mutex_profiler"), join(lib, "cmsis_os2"), port, join(port, "utils")]
+
+    build_dir = join(project, ".pio", "sim")
+    os.makedirs(build_dir, exist_ok=True)
+    exe = join(build_dir, "firmware")
+    # like the target build, unused functions are dropped at link time
+    run([args.cc, "-O1", "-g", "-std=gnu11", "-o", exe,
+         "-ffunction-sections", "-fdata-sections",
+         "-Wno-pointer-to-int-cast", "-Wno-int-to-pointer-cast",
+         "-DGD32F30x", "-DFREERTOS_SIM"] +
+        ["-D" + d for d in defines] +
+        ["-I" + i for i in includes] +
+        sorted(sources) +
+        ["-lpthread", "-Wl,--gc-sections", "-Wl,--wrap=" + ",--wrap=".join(WRAPPED)])
+    return exe
+
+
+def simulate(exe, seconds):
+    """runs the simulation, returns its output"""
+    proc = subprocess.Popen([exe], stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True, errors="replace")
+    try:
+        out, _ = proc.communicate(timeout=seconds)
+        sys.exit("error: the simulation ended early (%d)\n%s" % (proc.returncode, out))
+    except subprocess.TimeoutExpired:
+        proc.send_signal(signal.SIGINT)
+        out, _ = proc.communicate()
+    return out
+
+
+def measure(out, args):
+    metrics = {}
+    edges = [(float(m.group(1)), int(m.group(2))) for m in GPIO_LINE.finditer(out)]
+    if len(edges) < 3:
+        sys.exit("error: less than 3 GPIO edges, run longer\n" + out)
+    # the first edge comes before the first delay
+    edges = edges[1:]
+    half_period = args.led_period_ms / 2.0
+    jitter = [abs((b[0] - a[0]) * 1000.0 - half_period) for a, b in zip(edges, edges[1:])]
+    metrics["led_jitter_avg_ms"] = sum(jitter) / len(jitter)
+    metrics["led_jitter_max_ms"] = max(jitter)
+    elapsed = edges[-1][0] - edges[0][0]
+    ticks = edges[-1][1] - edges[0][1]
+    tick_s = 1.0 / args.tick_rate_hz
+    metrics["tick_drift_ppm"] = abs(ticks * tick_s - elapsed) / elapsed * 1e6
+
+    # TaskManager reports: cumulative switches, run time within the interval
+    first = {}
+    last = {}
+    runtime = {}
+    uptimes = []
+    for line in out.splitlines():
+        m = UPTIME_LINE.search(line)
+        if m:
+            uptimes.append(int(m.group(1)))
+            continue
+        m = TASK_LINE.search(line)
+        if m:
+            name, switches, run_us = m.group(1), int(m.group(2)), int(m.group(3))
+            if name not in first:
+                first[name] = switches
+                runtime[name] = 0
+            else:
+                runtime[name] += run_us
+            last[name] = switches
+    if len(uptimes) >= 2:
+        seconds = uptimes[-1] - uptimes[0]
+        for name in sorted(first):
+            switches = last[name] - first[name]
+            metrics["task.%s.switches_per_s" % name] = switches / seconds if seconds else 0.0
+            if switches:
+                metrics["task.%s.us_per_switch" % name] = runtime[name] / switches
+    return metrics
+
+
+def floor(metric):
+    return FLOORS[metric.split(".")[-1]]
+
+
+def timing(args):
+    exe = build(args)
+    results = [measure(simulate(exe, args.seconds), args) for _ in range(args.runs)]
+    # metrics of all runs, tasks that did not report in every run are dropped
+    names = sorted(set.intersection(*[set(r) for r in results]))
+    medians = {name: statistics.median(r[name] for r in results) for name in names}
+
+    print("%-36s %12s" % ("metric", "median"))
+    for name in names:
+        print("%-36s %12.3f" % (name, medians[name]))
+
+    if args.save_baseline:
+        with open(args.save_baseline, "w") as f:
+            json.dump(medians, f, indent=2, sort_keys=True)
+            f.write("\n")
+        print("baseline written to %s" % args.save_baseline)
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        failed = 0
+        print("\n%-36s %12s %12s %12s" % ("metric", "baseline", "now", "limit"))
+        for name in sorted(baseline):
+            if name not in medians:
+                print("%-36s %12.3f %12s" % (name, baseline[name], "missing"))
+                failed += 1
+                continue
+            base = baseline[name]
+            # more switches are fine, longer or later is not
+            if name.endswith("switches_per_s"):
+                limit = base * (1.0 - args.tolerance / 100.0) - floor(name)
+                bad = medians[name] < limit
+            else:
+                limit = base * (1.0 + args.tolerance / 100.0) + floor(name)
+                bad = medians[name] > limit
+            print("%-36s %12.3f %12.3f %12.3f%s" % (name, base, medians[name], limit,
+                                                     "  REGRESSION" if bad else ""))
+            failed += bad
+        if failed:
+            sys.exit("error: %d metric(s) regressed" % failed)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+    for name in ["build", "run", "timing"]:
+        p = sub.add_parser(name)
+        p.add_argument("project", help="project folder, e.g. gd32-spl-freertos")
+        p.add_argument("-D", dest="define", action="append", default=[],
+                       help="additional define, e.g. PIO_FREERTOS_HEAP_TLSF")
+        p.add_argument("--cc", default="gcc")
+        if name == "run":
+            p.add_argument("--seconds", type=float, default=0,
+                           help="stop after this many seconds (default: run until Ctrl+C)")
+        if name == "timing":
+            p.add_argument("--seconds", type=float, default=10, help="length of each run")
+            p.add_argument("--runs", type=int, default=3, help="runs, the median is reported")
+            p.add_argument("--led-period-ms", type=float, default=1000)
+            p.add_argument("--tick-rate-hz", type=float, default=1000)
+            p.add_argument("--save-baseline", metavar="JSON")
+            p.add_argument("--baseline", metavar="JSON")
+            p.add_argument("--tolerance", type=float, default=50,
+                           help="allowed regression against the baseline in percent")
+    args = parser.parse_args()
+
+    if not isfile(join(args.project, "platformio.ini")):
+        sys.exit("error: %s is not a project folder" % args.project)
+    if args.command == "build":
+        print(build(args))
+    elif args.command == "run":
+        exe = build(args)
+        if args.seconds:
+            sys.stdout.write(simulate(exe, args.seconds))
+        else:
+            try:
+                subprocess.call([exe])
+            except KeyboardInterrupt:
+                pass
+    else:
+        timing(args)
+
+
+if __name__ == "__main__":
+    main()
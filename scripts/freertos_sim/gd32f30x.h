@@ -0,0 +1,216 @@
+/*
+ * Device header of the FreeRTOS host simulator (see freertos_sim.py).
+ *
+ * Takes the place of the SPL gd32f30x.h: the examples are compiled with
+ * -DGD32F30x -DFREERTOS_SIM and include it through their own gd32_include.h
+ * and RTE_Components.h. Only what the FreeRTOS examples use is provided. The
+ * peripheral functions are implemented in sim.c, GPIO writes are printed as
+ * "SIM GPIO" lines for the timing checks.
+ */
+#ifndef GD32F30X_H
+#define GD32F30X_H
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* interrupt numbers, only used as arguments of the NVIC stubs */
+typedef enum IRQn
+{
+    SVCall_IRQn = -5,
+    PendSV_IRQn = -2,
+    SysTick_IRQn = -1,
+    EXTI0_IRQn = 6,
+    USART0_IRQn = 37,
+} IRQn_Type;
+
+#define __NVIC_PRIO_BITS 4U
+
+typedef enum { RESET = 0, SET = !RESET } FlagStatus, bit_status;
+typedef enum { DISABLE = 0, ENABLE = !DISABLE } EventStatus, ControlStatus;
+
+#define BIT(x) ((uint32_t)((uint32_t)0x01U << (x)))
+
+/* core clock of the simulated CPU, one cycle is one nanosecond of host time */
+extern uint32_t SystemCoreClock;
+
+/* core peripherals. The cycle counter follows the host clock, it is updated
+ * on every access through DWT. */
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DHCSR;
+    volatile uint32_t DCRSR;
+    volatile uint32_t DCRDR;
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct
+{
+    volatile uint32_t CPUID;
+    volatile uint32_t ICSR;
+    volatile uint32_t VTOR;
+    volatile uint32_t AIRCR;
+    volatile uint32_t SCR;
+    volatile uint32_t CCR;
+    volatile uint32_t SHCSR;
+    volatile uint32_t CFSR;
+} SCB_Type;
+
+DWT_Type *sim_dwt(void);
+extern CoreDebug_Type sim_core_debug;
+extern SysTick_Type sim_systick;
+extern SCB_Type sim_scb;
+
+#define DWT       (sim_dwt())
+#define CoreDebug (&sim_core_debug)
+#define SysTick   (&sim_systick)
+#define SCB       (&sim_scb)
+
+#define DWT_CTRL_CYCCNTENA_Msk        (1UL)
+#define CoreDebug_DEMCR_TRCENA_Msk    (1UL << 24)
+#define SysTick_CTRL_ENABLE_Msk       (1UL)
+#define SysTick_CTRL_TICKINT_Msk      (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk    (1UL << 2)
+#define SCB_ICSR_PENDSTSET_Msk        (1UL << 26)
+#define SCB_ICSR_PENDSTCLR_Msk        (1UL << 25)
+
+/* interrupt masking is blocking the signals of the calling thread, the only
+ * interrupt is the tick of the POSIX port */
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_IPSR(void);
+
+#define __DSB() __sync_synchronize()
+#define __ISB() __sync_synchronize()
+#define __DMB() __sync_synchronize()
+#define __NOP() __asm volatile("nop")
+
+static inline void NVIC_SetPriority(IRQn_Type irqn, uint32_t priority) { (void)irqn; (void)priority; }
+static inline void NVIC_EnableIRQ(IRQn_Type irqn) { (void)irqn; }
+static inline void NVIC_DisableIRQ(IRQn_Type irqn) { (void)irqn; }
+static inline void NVIC_SetPendingIRQ(IRQn_Type irqn) { (void)irqn; }
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irqn) { (void)irqn; }
+
+/* GPIO, the port numbers are only used for the names in the log */
+#define GPIOA 0U
+#define GPIOB 1U
+#define GPIOC 2U
+#define GPIOD 3U
+#define GPIOE 4U
+
+#define GPIO_PIN_0  BIT(0)
+#define GPIO_PIN_1  BIT(1)
+#define GPIO_PIN_2  BIT(2)
+#define GPIO_PIN_3  BIT(3)
+#define GPIO_PIN_4  BIT(4)
+#define GPIO_PIN_5  BIT(5)
+#define GPIO_PIN_6  BIT(6)
+#define GPIO_PIN_7  BIT(7)
+#define GPIO_PIN_8  BIT(8)
+#define GPIO_PIN_9  BIT(9)
+#define GPIO_PIN_10 BIT(10)
+#define GPIO_PIN_11 BIT(11)
+#define GPIO_PIN_12 BIT(12)
+#define GPIO_PIN_13 BIT(13)
+#define GPIO_PIN_14 BIT(14)
+#define GPIO_PIN_15 BIT(15)
+
+#define GPIO_MODE_AIN         0x00U
+#define GPIO_MODE_IN_FLOATING 0x04U
+#define GPIO_MODE_IPD         0x28U
+#define GPIO_MODE_IPU         0x48U
+#define GPIO_MODE_OUT_OD      0x14U
+#define GPIO_MODE_OUT_PP      0x10U
+#define GPIO_MODE_AF_OD       0x1CU
+#define GPIO_MODE_AF_PP       0x18U
+
+#define GPIO_OSPEED_10MHZ 0x01U
+#define GPIO_OSPEED_2MHZ  0x02U
+#define GPIO_OSPEED_50MHZ 0x03U
+
+void gpio_init(uint32_t gpio_periph, uint32_t mode, uint32_t speed, uint32_t pin);
+void gpio_bit_set(uint32_t gpio_periph, uint32_t pin);
+void gpio_bit_reset(uint32_t gpio_periph, uint32_t pin);
+void gpio_bit_write(uint32_t gpio_periph, uint32_t pin, bit_status bit_value);
+FlagStatus gpio_output_bit_get(uint32_t gpio_periph, uint32_t pin);
+
+/* RCU */
+typedef enum
+{
+    RCU_GPIOA,
+    RCU_GPIOB,
+    RCU_GPIOC,
+    RCU_GPIOD,
+    RCU_GPIOE,
+    RCU_AF,
+    RCU_USART0,
+    RCU_USART1,
+    RCU_USART2,
+} rcu_periph_enum;
+
+static inline void rcu_periph_clock_enable(rcu_periph_enum periph) { (void)periph; }
+static inline void rcu_periph_clock_disable(rcu_periph_enum periph) { (void)periph; }
+
+/* USART, printf() goes to the host's stdout directly */
+#define USART0 0U
+#define USART1 1U
+#define USART2 2U
+
+#define USART_WL_8BIT          0U
+#define USART_WL_9BIT          1U
+#define USART_STB_1BIT         0U
+#define USART_STB_2BIT         2U
+#define USART_PM_NONE          0U
+#define USART_PM_EVEN          1U
+#define USART_PM_ODD           2U
+#define USART_RECEIVE_ENABLE   1U
+#define USART_RECEIVE_DISABLE  0U
+#define USART_TRANSMIT_ENABLE  1U
+#define USART_TRANSMIT_DISABLE 0U
+
+typedef enum
+{
+    USART_FLAG_RBNE,
+    USART_FLAG_TBE,
+    USART_FLAG_TC,
+} usart_flag_enum;
+
+static inline void usart_deinit(uint32_t usart_periph) { (void)usart_periph; }
+static inline void usart_word_length_set(uint32_t usart_periph, uint32_t wlen) { (void)usart_periph; (void)wlen; }
+static inline void usart_stop_bit_set(uint32_t usart_periph, uint32_t stblen) { (void)usart_periph; (void)stblen; }
+static inline void usart_parity_config(uint32_t usart_periph, uint32_t paritycfg) { (void)usart_periph; (void)paritycfg; }
+static inline void usart_baudrate_set(uint32_t usart_periph, uint32_t baudval) { (void)usart_periph; (void)baudval; }
+static inline void usart_receive_config(uint32_t usart_periph, uint32_t rxconfig) { (void)usart_periph; (void)rxconfig; }
+static inline void usart_transmit_config(uint32_t usart_periph, uint32_t txconfig) { (void)usart_periph; (void)txconfig; }
+static inline void usart_enable(uint32_t usart_periph) { (void)usart_periph; }
+void usart_data_transmit(uint32_t usart_periph, uint32_t data);
+static inline FlagStatus usart_flag_get(uint32_t usart_periph, usart_flag_enum flag)
+{
+    (void)usart_periph;
+    return flag == USART_FLAG_RBNE ? RESET : SET;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GD32F30X_H */
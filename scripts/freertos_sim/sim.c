@@ -0,0 +1,213 @@
+/*
+ * Host side of the FreeRTOS simulator (see freertos_sim.py): the peripheral
+ * functions of gd32f30x.h, the emulated cycle counter and the wrappers of
+ * the C library functions that are linked with -Wl,--wrap.
+ */
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "gd32f30x.h"
+
+uint32_t SystemCoreClock = 1000000000U;
+
+CoreDebug_Type sim_core_debug;
+SysTick_Type sim_systick;
+SCB_Type sim_scb;
+
+static DWT_Type sim_dwt_regs;
+static struct timespec sim_start;
+
+/* GPIO output registers, for the changes in the log */
+static uint32_t gpio_out[5];
+
+__attribute__((constructor)) static void sim_init(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &sim_start);
+    /* the timing checks read the output line by line */
+    setvbuf(stdout, NULL, _IOLBF, 0);
+}
+
+static uint64_t sim_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - sim_start.tv_sec) * 1000000000ULL + (uint64_t)now.tv_nsec -
+           (uint64_t)sim_start.tv_nsec;
+}
+
+DWT_Type *sim_dwt(void)
+{
+    /* value returned by the last access, a different one was written */
+    static uint32_t last_cyccnt;
+    static uint32_t offset;
+    uint32_t cycles = (uint32_t)sim_now_ns();
+    if (sim_dwt_regs.CYCCNT != last_cyccnt)
+    {
+        offset = cycles - sim_dwt_regs.CYCCNT;
+    }
+    if (sim_dwt_regs.CTRL & DWT_CTRL_CYCCNTENA_Msk)
+    {
+        sim_dwt_regs.CYCCNT = cycles - offset;
+    }
+    last_cyccnt = sim_dwt_regs.CYCCNT;
+    return &sim_dwt_regs;
+}
+
+/*-----------------------------------------------------------*/
+
+uint32_t __get_PRIMASK(void)
+{
+    sigset_t blocked;
+    pthread_sigmask(SIG_BLOCK, NULL, &blocked);
+    return sigismember(&blocked, SIGALRM) == 1 ? 1U : 0U;
+}
+
+void __set_PRIMASK(uint32_t primask)
+{
+    if (primask)
+        vPortDisableInterrupts();
+    else
+        vPortEnableInterrupts();
+}
+
+void __disable_irq(void)
+{
+    vPortDisableInterrupts();
+}
+
+void __enable_irq(void)
+{
+    vPortEnableInterrupts();
+}
+
+uint32_t __get_IPSR(void)
+{
+    /* the tick signal handler runs as the SysTick exception */
+    return xPortIsInsideInterrupt() ? 15U : 0U;
+}
+
+/* the tick comes from the POSIX port, the SysTick handlers of the examples are
+ * never called */
+void xPortSysTickHandler(void)
+{
+}
+
+/*-----------------------------------------------------------*/
+
+static void gpio_write(uint32_t gpio_periph, uint32_t pin, int value)
+{
+    char line[96];
+    uint32_t old = gpio_out[gpio_periph];
+    if (value)
+        gpio_out[gpio_periph] |= pin;
+    else
+        gpio_out[gpio_periph] &= ~pin;
+    for (uint32_t n = 0; n < 16; n++)
+    {
+        if ((pin & BIT(n)) && ((old ^ gpio_out[gpio_periph]) & BIT(n)))
+        {
+            uint64_t ns = sim_now_ns();
+            int len = snprintf(line, sizeof(line), "SIM GPIO t=%lu.%09lu tick=%lu GPIO%c.%lu=%d\n",
+                               (unsigned long)(ns / 1000000000ULL), (unsigned long)(ns % 1000000000ULL),
+                               (unsigned long)xTaskGetTickCount(), 'A' + (int)gpio_periph, (unsigned long)n,
+                               value ? 1 : 0);
+            UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+            fflush(stdout);
+            (void)!write(STDOUT_FILENO, line, (size_t)len);
+            portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+        }
+    }
+}
+
+void gpio_init(uint32_t gpio_periph, uint32_t mode, uint32_t speed, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)mode;
+    (void)speed;
+    (void)pin;
+}
+
+void gpio_bit_set(uint32_t gpio_periph, uint32_t pin)
+{
+    gpio_write(gpio_periph, pin, 1);
+}
+
+void gpio_bit_reset(uint32_t gpio_periph, uint32_t pin)
+{
+    gpio_write(gpio_periph, pin, 0);
+}
+
+void gpio_bit_write(uint32_t gpio_periph, uint32_t pin, bit_status bit_value)
+{
+    gpio_write(gpio_periph, pin, bit_value != RESET);
+}
+
+FlagStatus gpio_output_bit_get(uint32_t gpio_periph, uint32_t pin)
+{
+    return (gpio_out[gpio_periph] & pin) ? SET : RESET;
+}
+
+void usart_data_transmit(uint32_t usart_periph, uint32_t data)
+{
+    char c = (char)data;
+    (void)usart_periph;
+    (void)!write(STDOUT_FILENO, &c, 1);
+}
+
+/*-----------------------------------------------------------*/
+
+/* The stdio functions are called with the tick blocked. A task switched out
+ * while it holds the lock of stdout would block the next task that prints,
+ * and with it the whole simulation. */
+int __real_vprintf(const char *format, va_list ap);
+int __real_puts(const char *s);
+int __real_putchar(int c);
+
+int __wrap_vprintf(const char *format, va_list ap)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    int ret = __real_vprintf(format, ap);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+int __wrap_printf(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    int ret = __wrap_vprintf(format, ap);
+    va_end(ap);
+    return ret;
+}
+
+int __wrap_puts(const char *s)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    int ret = __real_puts(s);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+int __wrap_putchar(int c)
+{
+    UBaseType_t mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    int ret = __real_putchar(c);
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    return ret;
+}
+
+/* a failed configASSERT() ends the simulation instead of spinning forever */
+void __wrap_vAssertCalled(void)
+{
+    static const char msg[] = "SIM ASSERT failed\n";
+    fflush(stdout);
+    (void)!write(STDERR_FILENO, msg, sizeof(msg) - 1);
+    abort();
+}
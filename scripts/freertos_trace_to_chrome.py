@@ -0,0 +1,350 @@
+#!/usr/bin/env python3
+"""Converts a FreeRTOS RAM trace into the Chrome trace format.
+
+Reads the buffer of the trace recorder in lib/FreeRTOS/src/trace_recorder
+(see gd32-spl-freertos-as-cmsisos2), either as a binary dump made with the
+debugger or as the serial output of trace_recorder_dump(), and writes a JSON
+file for Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+
+Every task gets a track that shows when it was running and when it was ready
+but waiting for the CPU, with the kernel events (queue operations, priority
+inheritance, ...) as instant events. Interrupts recorded with
+trace_recorder_isr_enter() / _exit() get a track per exception number, the
+application markers a track per task. A short summary with the CPU load and
+the longest wait for the CPU of every task is printed to stderr.
+
+Usage:
+  (gdb) dump binary value trace.bin trace_recorder
+  python3 scripts/freertos_trace_to_chrome.py trace.bin -o trace.json
+  pio device monitor | tee serial.log
+  python3 scripts/freertos_trace_to_chrome.py serial.log -o trace.json
+"""
+import argparse
+import json
+import re
+import struct
+import sys
+
+MAGIC = 0x31435254  # "TRC1"
+HEADER = struct.Struct("<8I")
+RECORD = struct.Struct("<4I")
+CONTINUATION = 0x80000000
+
+# component numbers of freertos_evr.c and trace_recorder.h
+COMP_TASKS = 0xF0
+COMP_QUEUE = 0xF1
+COMP_RECORDER = 0xEE
+
+# message names per component, indexed by the message number
+EVENT_NAMES = {
+    0xF0: ["TaskCreate", "TaskCreateFailed", "TaskDelete", "TaskDelayUntil", "TaskDelay",
+           "TaskPrioritySet", "TaskSuspend", "TaskResume", "TaskResumeFromIsr",
+           "TaskIncrementTick", "IncreaseTickCount", "TaskSwitchedOut", "TaskSwitchedIn",
+           "TaskPriorityInherit", "TaskPriorityDisinherit", "MovedTaskToReadyState",
+           "PostMovedTaskToReadyState", "LowPowerIdleBegin", "LowPowerIdleEnd",
+           "TaskNotifyTakeBlock", "TaskNotifyTake", "TaskNotifyWaitBlock", "TaskNotifyWait",
+           "TaskNotify", "TaskNotifyFromIsr", "TaskNotifyGiveFromIsr"],
+    0xF1: ["QueueCreate", "QueueCreateFailed", "CreateMutex", "CreateMutexFailed",
+           "GiveMutexRecursive", "GiveMutexRecursiveFailed", "TakeMutexRecursive",
+           "TakeMutexRecursiveFailed", "CreateCountingSemaphore",
+           "CreateCountingSemaphoreFailed", "QueueSend", "QueueSendFailed", "QueueReceive",
+           "QueuePeek", "QueuePeekFromIsr", "QueueReceiveFailed", "QueueSendFromIsr",
+           "QueueSendFromIsrFailed", "QueueReceiveFromIsr", "QueueReceiveFromIsrFailed",
+           "QueuePeekFromIsrFailed", "QueueDelete", "QueueRegistryAdd",
+           "BlockingOnQueueReceive", "BlockingOnQueueSend", "QueuePeekFailed"],
+    0xF2: ["TimerCreate", "TimerCreateFailed", "TimerCommandSend", "TimerCommandReceived",
+           "TimerExpired", "PendFuncCall", "PendFuncCallFromIsr"],
+    0xF3: ["EventGroupCreate", "EventGroupCreateFailed", "EventGroupSyncBlock",
+           "EventGroupSyncEnd", "EventGroupWaitBitsBlock", "EventGroupWaitBitsEnd",
+           "EventGroupClearBits", "EventGroupClearBitsFromIsr", "EventGroupSetBits",
+           "EventGroupSetBitsFromIsr", "EventGroupDelete"],
+    0xF4: ["Malloc", "Free"],
+    0xF5: ["StreamBufferCreateFailed", "StreamBufferCreateStaticFailed", "StreamBufferCreate",
+           "StreamBufferDelete", "StreamBufferReset", "StreamBufferBlockingOnSend",
+           "StreamBufferSend", "StreamBufferSendFailed", "StreamBufferSendFromIsr",
+           "StreamBufferBlockingOnReceive", "StreamBufferReceive", "StreamBufferReceiveFailed",
+           "StreamBufferReceiveFromIsr"],
+    0xEE: ["IsrEnter", "IsrExit", "Mark", "Begin", "End"],
+}
+
+# events whose first value is a task handle
+TASK_EVENTS = {"TaskCreate", "TaskDelete", "TaskPrioritySet", "TaskSuspend", "TaskResume",
+               "TaskResumeFromIsr", "TaskPriorityInherit", "TaskPriorityDisinherit",
+               "TaskNotify", "TaskNotifyFromIsr", "TaskNotifyGiveFromIsr"}
+
+TRACE_LINE_RE = re.compile(r"TRACE:((?:\s+[0-9a-fA-F]{8})+)")
+
+
+def read_dump(path):
+    """returns the recorder structure as bytes, from a binary or a serial log"""
+    with open(path, "rb") as f:
+        data = f.read()
+    if len(data) >= 4 and struct.unpack_from("<I", data)[0] == MAGIC:
+        return data
+    # serial log: use the last complete dump
+    words = None
+    dump = b""
+    for line in data.decode("ascii", errors="replace").splitlines():
+        if "TRACE BEGIN" in line:
+            words = []
+        elif "TRACE END" in line and words is not None:
+            dump = b"".join(struct.pack("<I", int(w, 16)) for w in words)
+            words = None
+        elif words is not None:
+            m = TRACE_LINE_RE.search(line)
+            if m:
+                words += m.group(1).split()
+    if not dump:
+        sys.exit("%s: no trace found (neither a binary dump nor TRACE BEGIN / END lines)" % path)
+    return dump
+
+
+def parse(data):
+    """returns (header dict, names dict, list of records in order)"""
+    if len(data) < HEADER.size:
+        sys.exit("trace too short")
+    magic, version, num_records, num_names, name_len, freq, write_index, _running = \
+        HEADER.unpack_from(data)
+    if magic != MAGIC:
+        sys.exit("wrong magic 0x%08x, not a trace recorder dump" % magic)
+    if version != 1:
+        print("warning: unknown trace version %d" % version, file=sys.stderr)
+    offset = HEADER.size
+    names = {}
+    entry_size = 4 + name_len
+    for i in range(num_names):
+        obj, = struct.unpack_from("<I", data, offset + i * entry_size)
+        raw = data[offset + i * entry_size + 4:offset + (i + 1) * entry_size]
+        name = raw.split(b"\0", 1)[0].decode("ascii", errors="replace")
+        if name:
+            names[obj] = name
+    offset += num_names * entry_size
+    if len(data) < offset + num_records * RECORD.size:
+        sys.exit("trace truncated: expected %d records" % num_records)
+
+    # oldest record first
+    count = min(write_index, num_records)
+    first = write_index - count
+    raw_records = [RECORD.unpack_from(data, offset + (i % num_records) * RECORD.size)
+                   for i in range(first, write_index)]
+
+    # unwrap the 32 bit timestamps. Small steps backwards (timestamps derived
+    # from the SysTick around a tick) are clamped to 0.
+    records = []
+    now = 0
+    last = None
+    for timestamp, event_id, val1, val2 in raw_records:
+        if last is not None:
+            delta = (timestamp - last) & 0xFFFFFFFF
+            if delta < 0x80000000:
+                now += delta
+        last = timestamp
+        if event_id & CONTINUATION:
+            # second half of EventRecord4(), orphaned if its first half was overwritten
+            if records and records[-1]["id"] == event_id & ~CONTINUATION and len(records[-1]["vals"]) == 2:
+                records[-1]["vals"] += [val1, val2]
+            continue
+        records.append({"cycles": now, "id": event_id, "vals": [val1, val2]})
+    header = {"num_records": num_records, "write_index": write_index, "freq": freq or 1}
+    return header, names, records
+
+
+def event_name(event_id):
+    comp = (event_id >> 8) & 0xFF
+    msg = event_id & 0xFF
+    if comp == COMP_TASKS and msg == 0xFF:
+        return "TaskTrackingReset"
+    names = EVENT_NAMES.get(comp)
+    if names is not None and msg < len(names):
+        return names[msg]
+    return "event 0x%02x:0x%02x" % (comp, msg)
+
+
+class ChromeTrace:
+    PID = 1
+
+    def __init__(self, header, names):
+        self.freq = header["freq"]
+        self.names = names
+        self.events = []
+        self.tids = {}  # key -> tid
+        self.running = None  # (task, start cycles)
+        self.ready_since = {}  # task -> cycles
+        self.isr_stack = []  # exception numbers
+        self.isr_start = {}
+        self.markers_open = {}  # (task, marker) -> count
+        self.run_cycles = {}
+        self.max_wait = {}
+
+    def us(self, cycles):
+        return cycles * 1e6 / self.freq
+
+    def object_name(self, obj):
+        return self.names.get(obj, "0x%08x" % obj)
+
+    def tid(self, key, name, sort_index):
+        if key not in self.tids:
+            tid = len(self.tids) + 1
+            self.tids[key] = tid
+            self.events.append({"ph": "M", "pid": self.PID, "tid": tid, "name": "thread_name",
+                                "args": {"name": name}})
+            self.events.append({"ph": "M", "pid": self.PID, "tid": tid,
+                                "name": "thread_sort_index", "args": {"sort_index": sort_index}})
+        return self.tids[key]
+
+    def task_tid(self, task):
+        return self.tid(("task", task), self.object_name(task), 1000 + len(self.tids))
+
+    def marker_tid(self, task):
+        name = "%s markers" % (self.object_name(task) if task is not None else "kernel")
+        return self.tid(("markers", task), name, 2000 + len(self.tids))
+
+    def isr_tid(self, exception):
+        name = "ISR %d (IRQ %d)" % (exception, exception - 16) if exception >= 16 else "exception %d" % exception
+        return self.tid(("isr", exception), name, exception)
+
+    def context_tid(self):
+        """track of the code that recorded the event: ISR, task or kernel"""
+        if self.isr_stack:
+            return self.isr_tid(self.isr_stack[-1])
+        if self.running is not None:
+            return self.task_tid(self.running[0])
+        return self.tid(("kernel",), "kernel (no task)", 0)
+
+    def slice(self, tid, name, start, end, args=None):
+        ev = {"ph": "X", "pid": self.PID, "tid": tid, "name": name,
+              "ts": self.us(start), "dur": self.us(end - start)}
+        if args:
+            ev["args"] = args
+        self.events.append(ev)
+
+    def instant(self, tid, name, cycles, args=None):
+        ev = {"ph": "i", "s": "t", "pid": self.PID, "tid": tid, "name": name, "ts": self.us(cycles)}
+        if args:
+            ev["args"] = args
+        self.events.append(ev)
+
+    def switch_out(self, cycles):
+        if self.running is None:
+            return
+        task, start = self.running
+        self.slice(self.task_tid(task), "running", start, cycles)
+        self.run_cycles[task] = self.run_cycles.get(task, 0) + cycles - start
+        self.running = None
+
+    def add(self, rec):
+        cycles = rec["cycles"]
+        name = event_name(rec["id"])
+        comp = (rec["id"] >> 8) & 0xFF
+        vals = rec["vals"]
+
+        if name == "TaskSwitchedOut":
+            self.switch_out(cycles)
+        elif name == "TaskSwitchedIn":
+            task = vals[0]
+            self.switch_out(cycles)
+            ready = self.ready_since.pop(task, None)
+            if ready is not None and cycles > ready:
+                self.slice(self.task_tid(task), "ready (waiting for CPU)", ready, cycles)
+                self.max_wait[task] = max(self.max_wait.get(task, 0), cycles - ready)
+            self.running = (task, cycles)
+            self.task_tid(task)
+        elif name == "MovedTaskToReadyState":
+            task = vals[0]
+            if self.running is None or self.running[0] != task:
+                self.ready_since.setdefault(task, cycles)
+        elif comp == COMP_RECORDER:
+            self.add_recorder_event(name, cycles, vals)
+        elif name in ("TaskIncrementTick", "IncreaseTickCount", "PostMovedTaskToReadyState"):
+            pass
+        else:
+            args = {"val%d" % (i + 1): "0x%x" % v for i, v in enumerate(vals)}
+            label = name
+            if name in TASK_EVENTS:
+                label = "%s %s" % (name, self.object_name(vals[0]))
+                args["task"] = self.object_name(vals[0])
+                if name in ("TaskPriorityInherit", "TaskPriorityDisinherit", "TaskPrioritySet"):
+                    args["priority"] = vals[1]
+                    label += " -> prio %d" % vals[1]
+                    # on the track of the affected task, to make inversions visible
+                    self.instant(self.task_tid(vals[0]), label, cycles, args)
+                    return
+            elif comp in (COMP_QUEUE, 0xF2, 0xF3, 0xF5) and vals[0] in self.names:
+                label = "%s %s" % (name, self.names[vals[0]])
+                args["object"] = self.names[vals[0]]
+            self.instant(self.context_tid(), label, cycles, args)
+
+    def add_recorder_event(self, name, cycles, vals):
+        if name == "IsrEnter":
+            self.isr_stack.append(vals[0])
+            self.isr_start[vals[0]] = cycles
+        elif name == "IsrExit":
+            exception = vals[0]
+            start = self.isr_start.pop(exception, None)
+            if exception in self.isr_stack:
+                self.isr_stack.remove(exception)
+            if start is not None:
+                self.slice(self.isr_tid(exception), "ISR %d" % exception, start, cycles)
+        else:
+            marker = self.object_name(vals[0]) if vals[0] in self.names else "marker %d" % vals[0]
+            task = self.running[0] if self.running is not None and not self.isr_stack else None
+            tid = self.isr_tid(self.isr_stack[-1]) if self.isr_stack else self.marker_tid(task)
+            args = {"value": vals[1]}
+            if name == "Mark":
+                self.instant(tid, marker, cycles, args)
+            elif name == "Begin":
+                self.markers_open[(tid, marker)] = self.markers_open.get((tid, marker), 0) + 1
+                self.events.append({"ph": "B", "pid": self.PID, "tid": tid, "name": marker,
+                                    "ts": self.us(cycles), "args": args})
+            elif self.markers_open.get((tid, marker), 0) > 0:
+                # an end whose begin was overwritten in the ring is dropped
+                self.markers_open[(tid, marker)] -= 1
+                self.events.append({"ph": "E", "pid": self.PID, "tid": tid, "name": marker,
+                                    "ts": self.us(cycles), "args": args})
+
+    def finish(self, cycles):
+        self.switch_out(cycles)
+        for exception, start in self.isr_start.items():
+            self.slice(self.isr_tid(exception), "ISR %d" % exception, start, cycles)
+        for (tid, marker), count in self.markers_open.items():
+            for _ in range(count):
+                self.events.append({"ph": "E", "pid": self.PID, "tid": tid, "name": marker,
+                                    "ts": self.us(cycles)})
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a FreeRTOS RAM trace to the Chrome trace format")
+    parser.add_argument("input", help="binary dump of trace_recorder, or serial log with TRACE lines")
+    parser.add_argument("-o", "--output", help="JSON output (default: <input>.json)")
+    parser.add_argument("--freq", type=float, help="timestamp frequency in Hz (default: from the trace)")
+    args = parser.parse_args()
+
+    header, names, records = parse(read_dump(args.input))
+    if args.freq:
+        header["freq"] = args.freq
+    trace = ChromeTrace(header, names)
+    trace.events.append({"ph": "M", "pid": ChromeTrace.PID, "name": "process_name",
+                         "args": {"name": "FreeRTOS"}})
+    for rec in records:
+        trace.add(rec)
+    end = records[-1]["cycles"] if records else 0
+    trace.finish(end)
+
+    output = args.output or args.input + ".json"
+    with open(output, "w") as f:
+        json.dump({"traceEvents": trace.events, "displayTimeUnit": "ns"}, f)
+
+    lost = header["write_index"] - min(header["write_index"], header["num_records"])
+    print("%d events, %.3f ms at %.0f Hz, %d older records overwritten -> %s" % (
+        len(records), trace.us(end) / 1000.0, header["freq"], lost, output), file=sys.stderr)
+    for key in trace.tids:
+        if key[0] != "task":
+            continue
+        task = key[1]
+        load = 100.0 * trace.run_cycles.get(task, 0) / end if end else 0.0
+        print("  %-12s CPU %5.1f %%, longest wait for CPU %.1f us" % (
+            trace.object_name(task), load, trace.us(trace.max_wait.get(task, 0))), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
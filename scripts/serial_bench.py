@@ -0,0 +1,296 @@
+#!/usr/bin/env python3
+"""Serial throughput and latency benchmark against the serial_bench firmware.
+
+Drives a serial port on Linux (termios, no extra packages) that is connected
+to a firmware running the command loop of gd32-spl-usart/lib/serial_bench:
+the genericGD32F303CC_bench environments of gd32-spl-usart (USART0) and
+gd32-arduino-serials (Serial1 or the USB CDC). For every baud rate and chunk
+size it runs three tests:
+  - echo: the host writes a chunk and waits until it came back, repeated
+    --rounds times. Reports the round trip time percentiles and the bytes/s
+    in one direction.
+  - sink: the host sends --bytes bytes of a counting pattern in writes of
+    the chunk size, the target checks it. Reports the bytes/s up to the
+    reply of the target.
+  - source: the target sends --bytes bytes of the pattern in writes of the
+    chunk size, the host checks it.
+The errors are wrong and missing bytes; after lost bytes, the check resyncs
+on the pattern, so a lost byte counts once. "line %" is the throughput against
+the line rate at 8N1 (baud / 10), for a USB CDC the baud rate means nothing.
+
+"run" tests a real port; the firmware has to run at --start-baud (the
+baud rate of the build, 115200 by default). Before every baud rate, the
+target is switched with a "B" command. A QEMU machine with its serial on a
+pty (-serial pty) is used the same way.
+"sim" compiles the target for the host (scripts/serial_bench/host_target.c)
+and runs it on the slave side of a pty, to check the tool and the protocol
+without a board. A pty has no line rate, the numbers are only host numbers.
+
+Usage:
+  python3 scripts/serial_bench.py run /dev/ttyUSB0 --bauds 115200,460800,921600 --chunks 1,16,64,256
+  python3 scripts/serial_bench.py run /dev/ttyACM0 --chunks 64,512 --json cdc.json
+  python3 scripts/serial_bench.py sim --chunks 1,64
+"""
+import argparse
+import json
+import os
+import pty
+import select
+import subprocess
+import sys
+import tempfile
+import termios
+import time
+import tty
+from os.path import abspath, dirname, join
+
+SCRIPT_DIR = dirname(abspath(__file__))
+TARGET_LIB = join(SCRIPT_DIR, "..", "gd32-spl-usart", "lib", "serial_bench")
+# the target ends an echo or sink after this long without data (SERIAL_BENCH_TIMEOUT_MS)
+TARGET_TIMEOUT = 1.0
+# largest chunk of a target write (SERIAL_BENCH_CHUNK_MAX)
+TARGET_CHUNK_MAX = 256
+
+
+class Link:
+    """raw serial port with timeouts"""
+
+    def __init__(self, fd, sim=False):
+        self.fd = fd
+        self.sim = sim
+        tty.setraw(fd)
+
+    def set_baud(self, baud):
+        speed = getattr(termios, "B%d" % baud, None)
+        if speed is None:
+            sys.exit("error: baud rate %d is not supported by termios" % baud)
+        attrs = termios.tcgetattr(self.fd)
+        attrs[4] = attrs[5] = speed
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+
+    def write(self, data):
+        view = memoryview(data)
+        while view:
+            select.select([], [self.fd], [], 1.0)
+            n = os.write(self.fd, view)
+            view = view[n:]
+
+    def read(self, count, timeout):
+        """reads up to count bytes, returns less on a timeout"""
+        data = bytearray()
+        deadline = time.perf_counter() + timeout
+        while len(data) < count:
+            left = deadline - time.perf_counter()
+            if left <= 0 or not select.select([self.fd], [], [], left)[0]:
+                break
+            data += os.read(self.fd, count - len(data))
+        return bytes(data)
+
+    def readline(self, timeout):
+        line = bytearray()
+        deadline = time.perf_counter() + timeout
+        while not line.endswith(b"\n"):
+            left = deadline - time.perf_counter()
+            chunk = self.read(1, max(left, 0))
+            if not chunk:
+                break
+            line += chunk
+        return line.decode("ascii", "replace").strip()
+
+    def drain(self):
+        """waits until the target returned to the command loop, drops what it sent"""
+        time.sleep(TARGET_TIMEOUT * 1.2)
+        while self.read(4096, 0.05):
+            pass
+
+    def command(self, line, timeout=1.0):
+        self.write((line + "\n").encode("ascii"))
+        reply = self.readline(timeout)
+        if reply != "OK" and not reply.startswith("BENCH"):
+            raise RuntimeError("%r: unexpected reply %r" % (line, reply))
+        return reply
+
+
+def pattern(count):
+    return bytes(i & 0xff for i in range(count))
+
+
+def pattern_errors(data):
+    """wrong bytes in a received pattern, resyncs after lost bytes like the sink of the target"""
+    errors = 0
+    expected = 0
+    resync = None
+    for byte in data:
+        if byte == expected:
+            resync = None
+            expected = (expected + 1) & 0xff
+        elif byte == resync:
+            # the wrong byte was the first one after lost bytes
+            resync = None
+            errors -= 1
+            expected = (byte + 1) & 0xff
+        else:
+            resync = (byte + 1) & 0xff
+            errors += 1
+            expected = (expected + 1) & 0xff
+    return errors
+
+
+def percentile(values, p):
+    """nearest rank percentile of sorted values"""
+    if not values:
+        return 0.0
+    rank = max(0, min(len(values) - 1, int(round(p / 100.0 * len(values) + 0.5)) - 1))
+    return values[rank]
+
+
+def transfer_timeout(count, baud):
+    """time for count bytes at the line rate, with a generous margin"""
+    return 2.0 + 3.0 * count * 10.0 / baud
+
+
+def test_echo(link, baud, chunk, rounds):
+    data = pattern(chunk * rounds)
+    link.command("E %d" % len(data))
+    rtts = []
+    errors = 0
+    start = time.perf_counter()
+    for r in range(rounds):
+        sent = data[r * chunk:(r + 1) * chunk]
+        t0 = time.perf_counter()
+        link.write(sent)
+        back = link.read(chunk, transfer_timeout(2 * chunk, baud))
+        rtts.append(time.perf_counter() - t0)
+        errors += sum(a != b for a, b in zip(sent, back)) + chunk - len(back)
+        if len(back) < chunk:
+            # the rest of the echo is lost, the target times out
+            errors += len(data) - (r + 1) * chunk
+            link.drain()
+            break
+    elapsed = time.perf_counter() - start
+    rtts.sort()
+    return {"bytes_per_s": len(data) / elapsed if elapsed else 0.0, "errors": errors,
+            "rtt_us": {"p50": percentile(rtts, 50) * 1e6, "p90": percentile(rtts, 90) * 1e6,
+                       "p99": percentile(rtts, 99) * 1e6, "max": rtts[-1] * 1e6 if rtts else 0.0}}
+
+
+def test_sink(link, baud, chunk, count):
+    data = pattern(count)
+    link.command("S %d" % count)
+    start = time.perf_counter()
+    for offset in range(0, count, chunk):
+        link.write(data[offset:offset + chunk])
+    reply = link.readline(transfer_timeout(count, baud) + TARGET_TIMEOUT)
+    elapsed = time.perf_counter() - start
+    fields = reply.split()
+    if len(fields) != 3 or fields[0] != "DONE":
+        link.drain()
+        return {"bytes_per_s": 0.0, "errors": count, "reply": reply}
+    received, errors = int(fields[1]), int(fields[2])
+    return {"bytes_per_s": received / elapsed if elapsed else 0.0, "errors": errors + count - received}
+
+
+def test_source(link, baud, chunk, count):
+    link.command("O %d %d" % (count, chunk))
+    start = time.perf_counter()
+    data = link.read(count, transfer_timeout(count, baud))
+    elapsed = time.perf_counter() - start
+    errors = pattern_errors(data) + count - len(data)
+    if len(data) < count:
+        link.drain()
+    return {"bytes_per_s": len(data) / elapsed if elapsed else 0.0, "errors": errors}
+
+
+def benchmark(link, args):
+    results = []
+    current = args.start_baud
+    link.set_baud(current)
+    link.drain()
+    link.command("?")
+    print("%8s %6s %-7s %11s %7s %9s %9s %9s %9s %7s" % ("baud", "chunk", "test", "bytes/s", "line %",
+                                                       "p50 us", "p90 us", "p99 us", "max us", "errors"))
+    for baud in args.bauds:
+        if baud != current:
+            link.command("B %d" % baud)
+            link.set_baud(baud)
+            current = baud
+            # the target switches after its reply left
+            time.sleep(0.05)
+            link.command("?")
+        for chunk in args.chunks:
+            tests = [("echo", test_echo(link, baud, chunk, args.rounds)),
+                     ("sink", test_sink(link, baud, chunk, args.bytes))]
+            if chunk <= TARGET_CHUNK_MAX:
+                tests += [("source", test_source(link, baud, chunk, args.bytes))]
+            for name, result in tests:
+                result.update({"baud": baud, "chunk": chunk, "test": name})
+                results.append(result)
+                line_rate = "-" if link.sim else "%.1f" % (100.0 * result["bytes_per_s"] / (baud / 10.0))
+                rtt = result.get("rtt_us")
+                rtt_cols = ["%.0f" % rtt[k] for k in ["p50", "p90", "p99", "max"]] if rtt else ["-"] * 4
+                print("%8d %6d %-7s %11.0f %7s %9s %9s %9s %9s %7d" % tuple(
+                    [baud, chunk, name, result["bytes_per_s"], line_rate] + rtt_cols + [result["errors"]]))
+    if current != args.start_baud:
+        link.command("B %d" % args.start_baud)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+    return sum(r["errors"] for r in results)
+
+
+def build_host_target(cc, build_dir):
+    exe = join(build_dir, "host_target")
+    result = subprocess.run([cc, "-O2", "-std=gnu11", "-Wall", "-o", exe, "-I" + TARGET_LIB,
+                             join(SCRIPT_DIR, "serial_bench", "host_target.c"), join(TARGET_LIB, "serial_bench.c")],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        sys.exit("error: building the host target failed\n%s" % result.stdout)
+    return exe
+
+
+def parse_list(text):
+    return [int(v) for v in text.split(",") if v]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    sub = parser.add_subparsers(dest="command")
+    sub.required = True
+    for name in ["run", "sim"]:
+        p = sub.add_parser(name)
+        if name == "run":
+            p.add_argument("port", help="serial port, e.g. /dev/ttyUSB0")
+        else:
+            p.add_argument("--cc", default="gcc")
+        p.add_argument("--bauds", type=parse_list, default=[115200], help="comma separated baud rates")
+        p.add_argument("--start-baud", type=int, default=115200, help="baud rate the firmware starts with")
+        p.add_argument("--chunks", type=parse_list, default=[1, 16, 64, 256], help="comma separated chunk sizes")
+        p.add_argument("--rounds", type=int, default=200, help="echo round trips per chunk size")
+        p.add_argument("--bytes", type=int, default=20000, help="bytes per sink and source test")
+        p.add_argument("--json", metavar="FILE", help="write the results to a JSON file")
+    args = parser.parse_args()
+
+    if args.command == "run":
+        fd = os.open(args.port, os.O_RDWR | os.O_NOCTTY)
+        try:
+            errors = benchmark(Link(fd), args)
+        finally:
+            os.close(fd)
+    else:
+        with tempfile.TemporaryDirectory() as build_dir:
+            exe = build_host_target(args.cc, build_dir)
+            master, slave = pty.openpty()
+            target = subprocess.Popen([exe, os.ttyname(slave)])
+            try:
+                errors = benchmark(Link(master, sim=True), args)
+            finally:
+                target.kill()
+                target.wait()
+                os.close(master)
+                os.close(slave)
+    if errors:
+        sys.exit("error: %d byte errors" % errors)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,82 @@
+/* Host build of the serial benchmark target (gd32-spl-usart/lib/serial_bench)
+ * on a tty, e.g. the slave side of a pty. Used by "serial_bench.py sim" to
+ * check the host tool without a board:
+ *
+ *   host_target /dev/pts/<n>
+ *
+ * The baud rate commands are accepted and ignored, a pty has no line rate. */
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "serial_bench.h"
+
+static int tty;
+
+static size_t host_read(uint8_t *data, size_t len)
+{
+    /* waits a little when nothing is there, instead of spinning */
+    struct pollfd p = {tty, POLLIN, 0};
+    if (poll(&p, 1, 1) <= 0)
+    {
+        return 0;
+    }
+    ssize_t n = read(tty, data, len);
+    return n > 0 ? (size_t)n : 0;
+}
+
+static void host_write(const uint8_t *data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = write(tty, data, len);
+        if (n > 0)
+        {
+            data += n;
+            len -= (size_t)n;
+        }
+        else
+        {
+            struct pollfd p = {tty, POLLOUT, 0};
+            poll(&p, 1, 10);
+        }
+    }
+}
+
+static void host_set_baudrate(uint32_t baudrate)
+{
+    (void)baudrate;
+    tcdrain(tty);
+}
+
+static uint32_t host_millis(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000U + ts.tv_nsec / 1000000U);
+}
+
+int main(int argc, char **argv)
+{
+    static const serial_bench_io_t io = {host_read, host_write, host_set_baudrate, host_millis};
+    struct termios t;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <tty>\n", argv[0]);
+        return 2;
+    }
+    tty = open(argv[1], O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (tty < 0 || tcgetattr(tty, &t) != 0)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    cfmakeraw(&t);
+    tcsetattr(tty, TCSANOW, &t);
+    serial_bench_run(&io);
+    return 0;
+}
@@ -0,0 +1,323 @@
+#!/usr/bin/env python3
+"""Flash/RAM attribution report from GCC map files and ELF symbols.
+
+Attributes the flash and RAM usage of one or many builds to the libraries
+they come from (SPL, CMSIS-DSP, minimal-printf, FreeRTOS, newlib, ...),
+lists the functions above a size threshold and compares two sets of builds.
+
+A "build" is a folder with a firmware.map (and optionally a firmware.elf),
+as collected by compile_all_projects.sh, or a single map file. Function
+sizes are taken from the ELF symbol table when arm-none-eabi-nm is found,
+otherwise from the function sections in the map file.
+
+Usage:
+  python3 scripts/size_report.py report results/after
+  python3 scripts/size_report.py report gd32-spl-cmsis-dsp-optimized/output.map
+  python3 scripts/size_report.py diff results/before results/after
+"""
+import argparse
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+from os.path import basename, dirname, expanduser, isdir, isfile, join, relpath
+
+# first match wins, tested against the lowercase object path with "/" separators
+LIBRARIES = [
+    ("FreeRTOS", re.compile(r"freertos")),
+    ("CMSIS-DSP", re.compile(r"cmsis[_-]dsp|libarm_cortex")),
+    ("minimal-printf", re.compile(r"minimal-printf|mbed_printf")),
+    ("SPL", re.compile(r"frameworkspl|frameworkcmsis|/spl/")),
+    ("Arduino core", re.compile(r"frameworkarduino")),
+    ("mbed-os", re.compile(r"mbed-os|frameworkmbed")),
+    ("USB library", re.compile(r"usb_?(device|host|lib)|frameworkusb")),
+    ("libstdc++", re.compile(r"libstdc\+\+|libsupc\+\+")),
+    ("newlib", re.compile(r"/lib(c|c_nano|g|g_nano|m|nosys|rdimon|rdimon_nano)\.a")),
+    ("libgcc", re.compile(r"/libgcc\.a|/crt[a-z0-9]*\.o")),
+    ("LTO (unattributed)", re.compile(r"\.ltrans\d*\.ltrans\.o|\.ltrans\.o")),
+    ("application", re.compile(r"/src/")),
+]
+LIB_FOLDER_RE = re.compile(r"\.pio/build/[^/]+/(?:lib[0-9a-f]*/)?(?:lib)?([^/]+)/")
+
+NOBITS_RE = re.compile(r"bss|heap|stack|noinit", re.IGNORECASE)
+OUTPUT_SECTION_RE = re.compile(r"^(\.\S+|COMMON)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+load address\s+(0x[0-9a-fA-F]+))?)?\s*$")
+ADDR_SIZE_RE = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)(?:\s+load address\s+(0x[0-9a-fA-F]+))?\s*(\S.*)?$")
+INPUT_SECTION_RE = re.compile(r"^ (\.\S+|COMMON|\*fill\*)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s*(\S.*)?)?$")
+REGION_RE = re.compile(r"^(\S+)\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)")
+# .text.<name>, .text.startup.<name> (main), .text.unlikely.<name>, ...
+FUNCTION_SECTION_RE = re.compile(r"^\.text\.((startup|unlikely|hot|exit)\.)?")
+
+
+def classify(obj):
+    """library an object file of the map belongs to"""
+    if not obj:
+        return "<linker>"
+    path = obj.replace("\\", "/").lower()
+    for name, pattern in LIBRARIES:
+        if pattern.search(path):
+            return name
+    m = LIB_FOLDER_RE.search(obj.replace("\\", "/"))
+    if m:
+        return "lib " + m.group(1)
+    return "other"
+
+
+class Build:
+    def __init__(self, name, map_path, elf_path=None):
+        self.name = name
+        self.map_path = map_path
+        self.elf_path = elf_path
+        self.flash = {}      # library -> bytes
+        self.ram = {}        # library -> bytes
+        self.functions = {}  # function -> (bytes, library)
+        self.regions = {}
+
+    @property
+    def flash_total(self):
+        return sum(self.flash.values())
+
+    @property
+    def ram_total(self):
+        return sum(self.ram.values())
+
+
+def region_of(regions, address):
+    for name, (origin, length) in regions.items():
+        if length and origin <= address < origin + length:
+            return name
+    return None
+
+
+def is_flash(region):
+    return region is not None and re.search(r"flash|rom|text", region, re.IGNORECASE) is not None
+
+
+def parse_map(build):
+    """fills the per-library sizes and the function sizes from the map file"""
+    in_regions = in_map = False
+    out_name = out_lma = None
+    pending_out = pending_in = None
+    with open(build.map_path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\r\n")
+            if line.startswith("Memory Configuration"):
+                in_regions = True
+                continue
+            if line.startswith("Linker script and memory map"):
+                in_regions, in_map = False, True
+                continue
+            if in_regions:
+                m = REGION_RE.match(line)
+                if m and m.group(1) not in ("Name", "*default*"):
+                    build.regions[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+                continue
+            if not in_map:
+                continue
+            if pending_out is not None:
+                m = ADDR_SIZE_RE.match(line)
+                out_name, out_lma = pending_out, (int(m.group(3), 16) if m and m.group(3) else None)
+                pending_out = None
+                continue
+            if pending_in is not None:
+                m = ADDR_SIZE_RE.match(line)
+                if m:
+                    add_input(build, out_name, out_lma, pending_in, m.group(1), m.group(2), m.group(4))
+                pending_in = None
+                continue
+            m = OUTPUT_SECTION_RE.match(line)
+            if m and not line.startswith(" "):
+                if m.group(2) is None:
+                    pending_out = m.group(1)
+                else:
+                    out_name, out_lma = m.group(1), (int(m.group(4), 16) if m.group(4) else None)
+                continue
+            m = INPUT_SECTION_RE.match(line)
+            if m:
+                if m.group(2) is None:
+                    pending_in = m.group(1)
+                else:
+                    add_input(build, out_name, out_lma, m.group(1), m.group(2), m.group(3), m.group(4))
+
+
+def add_input(build, out_name, out_lma, section, address, size, obj):
+    address, size = int(address, 16), int(size, 16)
+    region = region_of(build.regions, address)
+    if size == 0 or region is None or out_name is None:
+        return  # discarded, debug info or linker script bookkeeping
+    nobits = NOBITS_RE.search(out_name) is not None
+    if section == "*fill*":
+        lib = "<heap+stack>" if NOBITS_RE.search(out_name) and re.search("heap|stack", out_name) else "<padding>"
+    else:
+        lib = classify(obj.strip() if obj else None)
+    if is_flash(region):
+        build.flash[lib] = build.flash.get(lib, 0) + size
+    else:
+        build.ram[lib] = build.ram.get(lib, 0) + size
+        # initialized data is stored in flash as well
+        if out_lma is not None and not nobits and is_flash(region_of(build.regions, out_lma)):
+            build.flash[lib] = build.flash.get(lib, 0) + size
+    if section.startswith(".text.") and not build.elf_path:
+        build.functions[FUNCTION_SECTION_RE.sub("", section)] = (size, lib)
+
+
+def find_nm(args):
+    if args.nm:
+        return args.nm
+    found = shutil.which("arm-none-eabi-nm")
+    if found:
+        return found
+    candidates = glob.glob(join(expanduser("~"), ".platformio", "packages", "toolchain-gccarmnoneeabi*", "bin", "arm-none-eabi-nm"))
+    return candidates[0] if candidates else None
+
+
+def parse_elf(build, nm):
+    """function sizes from the ELF symbol table. The library is looked up in the map file."""
+    out = subprocess.run([nm, "--print-size", "--size-sort", "--radix=d", build.elf_path],
+                         stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, universal_newlines=True).stdout
+    libs = map_function_libraries(build.map_path)
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in "tTwW":
+            build.functions[fields[3]] = (int(fields[1]), libs.get(fields[3], "?"))
+
+
+def map_function_libraries(map_path):
+    """symbol -> library, from the symbol lines that follow each input section"""
+    libs = {}
+    lib = None
+    pending = False
+    with open(map_path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\r\n")
+            if pending:
+                m = ADDR_SIZE_RE.match(line)
+                lib = classify(m.group(4)) if m and m.group(4) else None
+                pending = False
+                continue
+            m = INPUT_SECTION_RE.match(line)
+            if m:
+                if m.group(2) is None:
+                    pending = True
+                else:
+                    lib = classify(m.group(4).strip()) if m.group(4) else None
+                continue
+            m = re.match(r"^\s+0x[0-9a-fA-F]+\s+([A-Za-z_][\w.$]*)$", line)
+            if m and lib:
+                libs.setdefault(m.group(1), lib)
+    return libs
+
+
+def load_builds(path, nm):
+    """builds below path, keyed by their folder relative to path"""
+    builds = {}
+    if isfile(path):
+        elf = join(dirname(path), "firmware.elf")
+        builds[basename(path)] = Build(basename(path), path, elf if isfile(elf) else None)
+    elif isdir(path):
+        for root, dirs, files in os.walk(path):
+            dirs[:] = [d for d in dirs if d not in (".git",)]
+            for f in files:
+                if not f.endswith(".map"):
+                    continue
+                map_path = join(root, f)
+                elf = join(root, "firmware.elf")
+                name = relpath(map_path if f != "firmware.map" else root, path)
+                builds[name] = Build(name, map_path, elf if isfile(elf) else None)
+    else:
+        sys.exit("error: %s not found" % path)
+    if not builds:
+        sys.exit("error: no map files found in %s" % path)
+    for build in builds.values():
+        if build.elf_path and not nm:
+            build.elf_path = None
+        parse_map(build)
+        if build.elf_path:
+            parse_elf(build, nm)
+    return builds
+
+
+def print_table(header, rows):
+    widths = [max(len(str(r[i])) for r in rows + [header]) for i in range(len(header))]
+    for r in [header] + rows:
+        print("  ".join(str(c).rjust(w) if i else str(c).ljust(w) for i, (c, w) in enumerate(zip(r, widths))))
+
+
+def report(builds, args):
+    for name in sorted(builds):
+        b = builds[name]
+        print("== %s: flash %d bytes, RAM %d bytes%s" % (name, b.flash_total, b.ram_total,
+                                                          "" if b.elf_path else " (functions from map file)"))
+        libs = sorted(set(b.flash) | set(b.ram), key=lambda l: -b.flash.get(l, 0))
+        print_table(["library", "flash", "RAM"], [[l, b.flash.get(l, 0), b.ram.get(l, 0)] for l in libs])
+        big = sorted(((s, fn, lib) for fn, (s, lib) in b.functions.items() if s >= args.threshold), reverse=True)
+        if big:
+            print("functions >= %d bytes:" % args.threshold)
+            for size, fn, lib in big:
+                print("  %6d  %-40s %s" % (size, fn, lib))
+        print()
+
+
+def diff(old, new, args):
+    grown = 0
+    for name in sorted(set(old) | set(new)):
+        if name not in old or name not in new:
+            print("== %s: only in %s" % (name, "new" if name in new else "old"))
+            continue
+        a, b = old[name], new[name]
+        d_flash, d_ram = b.flash_total - a.flash_total, b.ram_total - a.ram_total
+        libs = sorted(set(a.flash) | set(b.flash) | set(a.ram) | set(b.ram))
+        lib_rows = [[l, a.flash.get(l, 0), b.flash.get(l, 0), "%+d" % (b.flash.get(l, 0) - a.flash.get(l, 0)),
+                     a.ram.get(l, 0), b.ram.get(l, 0), "%+d" % (b.ram.get(l, 0) - a.ram.get(l, 0))]
+                    for l in libs if a.flash.get(l, 0) != b.flash.get(l, 0) or a.ram.get(l, 0) != b.ram.get(l, 0)]
+        fn_rows = []
+        for fn in sorted(set(a.functions) | set(b.functions)):
+            sa, sb = a.functions.get(fn, (0, ""))[0], b.functions.get(fn, (0, ""))[0]
+            if abs(sb - sa) >= args.min_delta:
+                crossed = "  <-- now >= %d" % args.threshold if sa < args.threshold <= sb else ""
+                fn_rows.append((sb - sa, fn, sa, sb, crossed))
+        if not lib_rows and not fn_rows:
+            if not args.changed_only:
+                print("== %s: unchanged" % name)
+            continue
+        print("== %s: flash %+d bytes, RAM %+d bytes" % (name, d_flash, d_ram))
+        if lib_rows:
+            print_table(["library", "flash old", "flash new", "delta", "RAM old", "RAM new", "delta"], lib_rows)
+        for delta, fn, sa, sb, crossed in sorted(fn_rows, reverse=True):
+            print("  %+6d  %-40s %6d -> %6d%s" % (delta, fn, sa, sb, crossed))
+        print()
+        grown = max(grown, d_flash, d_ram)
+    if args.max_growth is not None and grown > args.max_growth:
+        print("error: a build grew by %d bytes, more than --max-growth %d" % (grown, args.max_growth))
+        return 1
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("command", choices=["report", "diff"])
+    parser.add_argument("paths", nargs="+", help="build folder(s) or map file(s); diff takes two")
+    parser.add_argument("--threshold", type=int, default=1024,
+                        help="flag functions with at least this many bytes (default 1024)")
+    parser.add_argument("--min-delta", type=int, default=16,
+                        help="diff: show functions that changed by at least this many bytes")
+    parser.add_argument("--changed-only", action="store_true", help="diff: hide unchanged builds")
+    parser.add_argument("--max-growth", type=int,
+                        help="diff: exit with 1 if any build's flash or RAM grew by more bytes")
+    parser.add_argument("--nm", help="nm executable (default: arm-none-eabi-nm from PATH or PlatformIO)")
+    parser.add_argument("--no-elf", action="store_true", help="ignore ELF files, use only the map files")
+    args = parser.parse_args()
+
+    nm = None if args.no_elf else find_nm(args)
+    if args.command == "report":
+        for path in args.paths:
+            report(load_builds(path, nm), args)
+        return 0
+    if len(args.paths) != 2:
+        parser.error("diff needs two paths")
+    return diff(load_builds(args.paths[0], nm), load_builds(args.paths[1], nm), args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Stack size recommendations from the stack monitor output of soak runs.
+
+Reads the serial logs of one or more runs of a firmware built with
+PIO_FREERTOS_STACK_MONITOR, takes the highest peak use of every task (and of
+the interrupt stack, "ISR") over all runs and recommends a stack size: the
+peak plus a margin, rounded up. The stack monitor prints these lines:
+
+  STACK: "<name>" size <words> peak <words> recommended <words>
+
+The defaults of the margin match the firmware (stack_monitor.h). Use
+--guard-words 15 for Cortex-M23 builds with the MPU guard. A log that ends
+with "STACK OVERFLOW" is reported, its peak values are a lower bound only.
+
+Usage:
+  python3 scripts/stack_recommend.py soak1.log soak2.log
+  python3 scripts/stack_recommend.py --margin-percent 50 soak.log
+"""
+import argparse
+import re
+import sys
+
+STACK_LINE = re.compile(r'STACK: "([^"]*)" size (\d+) peak (\d+)')
+OVERFLOW_LINE = re.compile(r'STACK OVERFLOW: "([^"]*)"')
+
+
+def recommend(peak, args):
+    margin = max(peak * args.margin_percent // 100, args.min_margin_words)
+    words = peak + margin + args.guard_words
+    return (words + args.round_words - 1) // args.round_words * args.round_words
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("logs", nargs="+", help="serial logs of the soak runs")
+    parser.add_argument("--margin-percent", type=int, default=25)
+    parser.add_argument("--min-margin-words", type=int, default=48)
+    parser.add_argument("--guard-words", type=int, default=0,
+                        help="words lost to the stack guard (15 with the Cortex-M23 MPU guard)")
+    parser.add_argument("--round-words", type=int, default=8)
+    parser.add_argument("--word-size", type=int, default=4, help="bytes per stack word")
+    args = parser.parse_args()
+
+    stacks = {}  # name -> [size, peak, number of reports]
+    overflows = []
+    for path in args.logs:
+        with open(path, errors="replace") as f:
+            for line in f:
+                m = STACK_LINE.search(line)
+                if m:
+                    name, size, peak = m.group(1), int(m.group(2)), int(m.group(3))
+                    entry = stacks.setdefault(name, [size, 0, 0])
+                    entry[0] = size
+                    entry[1] = max(entry[1], peak)
+                    entry[2] += 1
+                    continue
+                m = OVERFLOW_LINE.search(line)
+                if m:
+                    overflows.append((path, m.group(1)))
+    if not stacks:
+        sys.exit("error: no stack monitor output found (build with -DPIO_FREERTOS_STACK_MONITOR)")
+
+    header = ["stack", "size", "peak", "reports", "recommended", "saved bytes"]
+    rows = []
+    saved_total = 0
+    for name in sorted(stacks, key=lambda n: (n == "ISR", n)):
+        size, peak, reports = stacks[name]
+        rec = recommend(peak, args)
+        saved = (size - rec) * args.word_size
+        saved_total += saved
+        rows.append([name, str(size), str(peak), str(reports), str(rec), str(saved)])
+    widths = [max(len(r[i]) for r in rows + [header]) for i in range(len(header))]
+    for r in [header] + rows:
+        print("  ".join(c.ljust(w) for c, w in zip(r, widths)).rstrip())
+    print("\nTotal: %d bytes %s" % (abs(saved_total), "saved" if saved_total >= 0 else "more needed"))
+    print("(all sizes in %d-byte words, the ISR line is the interrupt stack of the linker script)" % args.word_size)
+
+    for path, name in overflows:
+        print("warning: %s: stack overflow of \"%s\", its peak is a lower bound" % (path, name))
+
+
+if __name__ == "__main__":
+    main()